@@ -91,9 +91,10 @@ products += multiSourceLibraries.map {
 var targets: [Target] = []
 targets.append(.target(name: "TestsUtils", path: "utils", sources: ["TestsUtils.swift"]))
 targets.append(.systemLibrary(name: "LibProc", path: "utils/LibProc"))
+targets.append(.systemLibrary(name: "PerfCounters", path: "utils/PerfCounters"))
 targets.append(
   .target(name: "DriverUtils",
-    dependencies: [.target(name: "TestsUtils"), "LibProc"],
+    dependencies: [.target(name: "TestsUtils"), "LibProc", "PerfCounters"],
     path: "utils",
     sources: ["DriverUtils.swift", "ArgParse.swift"]))
 
@@ -390,7 +390,8 @@ function (swift_benchmark_compile_archopts)
   set(common_options_driver
       "-c"
       "-target" "${target}"
-      "-${driver_opt}")
+      "-${driver_opt}"
+      "-I" "${srcdir}/utils/PerfCounters")
 
   if(SWIFT_BENCHMARK_GENERATE_DEBUG_INFO)
     list(APPEND common_options_driver "-g")
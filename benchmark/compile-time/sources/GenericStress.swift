@@ -0,0 +1,126 @@
+//===--- GenericStress.swift ----------------------------------------------===//
+//
+// This source file is part of the Swift.org open source project
+//
+// Copyright (c) 2014 - 2020 Apple Inc. and the Swift project authors
+// Licensed under Apache License v2.0 with Runtime Library Exception
+//
+// See https://swift.org/LICENSE.txt for license information
+// See https://swift.org/CONTRIBUTORS.txt for the list of Swift project authors
+//
+//===----------------------------------------------------------------------===//
+
+// Compile-time benchmark: generic signatures, conditional conformances and
+// deeply nested generic types.
+//
+// The wrappers below build generic types several levels deep and thread
+// associated-type requirements through them, which stresses generic
+// signature construction, requirement resolution and SILGen's handling of
+// abstraction patterns.
+
+protocol Measurable {
+  associatedtype Unit: Comparable
+  var measuredValue: Unit { get }
+}
+
+protocol Combinable {
+  static func combine(_ lhs: Self, _ rhs: Self) -> Self
+}
+
+struct Box<T> {
+  var value: T
+  init(_ value: T) { self.value = value }
+}
+
+struct Pair<A, B> {
+  var first: A
+  var second: B
+}
+
+struct Tagged<Tag, Value> {
+  var value: Value
+  init(_ value: Value) { self.value = value }
+}
+
+extension Box: Measurable where T: Measurable {
+  typealias Unit = T.Unit
+  var measuredValue: T.Unit { return value.measuredValue }
+}
+
+extension Box: Combinable where T: Combinable {
+  static func combine(_ lhs: Box, _ rhs: Box) -> Box {
+    return Box(T.combine(lhs.value, rhs.value))
+  }
+}
+
+extension Pair: Combinable where A: Combinable, B: Combinable {
+  static func combine(_ lhs: Pair, _ rhs: Pair) -> Pair {
+    return Pair(first: A.combine(lhs.first, rhs.first),
+                second: B.combine(lhs.second, rhs.second))
+  }
+}
+
+extension Int: Measurable {
+  var measuredValue: Int { return self }
+}
+
+extension Int: Combinable {
+  static func combine(_ lhs: Int, _ rhs: Int) -> Int { return lhs + rhs }
+}
+
+extension Double: Combinable {
+  static func combine(_ lhs: Double, _ rhs: Double) -> Double {
+    return lhs + rhs
+  }
+}
+
+func combineAll<T: Combinable>(_ values: [T]) -> T? {
+  guard var result = values.first else { return nil }
+  for value in values.dropFirst() {
+    result = T.combine(result, value)
+  }
+  return result
+}
+
+func maxMeasured<T: Measurable>(_ values: [T]) -> T.Unit? {
+  return values.map { $0.measuredValue }.max()
+}
+
+func deepNesting1(_ n: Int) -> Box<Box<Box<Box<Int>>>> {
+  return Box(Box(Box(Box(n))))
+}
+
+func deepNesting2(_ n: Int, _ x: Double) -> Pair<Box<Pair<Int, Double>>, Box<Int>> {
+  let inner = Pair(first: n, second: x)
+  return Pair(first: Box(inner), second: Box(n))
+}
+
+func deepNesting3<T: Combinable>(_ value: T) -> Box<Pair<Box<T>, Box<T>>> {
+  let boxed = Box(value)
+  return Box(Pair(first: boxed, second: Box.combine(boxed, boxed)))
+}
+
+func taggedPipeline(_ n: Int) -> Int {
+  enum Meters {}
+  enum Seconds {}
+  let distance = Tagged<Meters, Int>(n * 3)
+  let time = Tagged<Seconds, Int>(n + 1)
+  let nested = Tagged<Meters, Tagged<Seconds, Int>>(time)
+  return distance.value + nested.value.value
+}
+
+func conditionalUse(_ values: [Int]) -> Int {
+  let boxes = values.map { Box($0) }
+  let combined = combineAll(boxes)?.value ?? 0
+  let pairs = values.map { Pair(first: $0, second: Double($0)) }
+  let pairSum = combineAll(pairs)
+  return combined + Int(pairSum?.second ?? 0) + (maxMeasured(boxes) ?? 0)
+}
+
+func genericRecursion<T: Combinable>(_ value: T, depth: Int) -> Box<T> {
+  if depth == 0 {
+    return Box(value)
+  }
+  let inner = genericRecursion(value, depth: depth - 1)
+  return Box.combine(inner, inner)
+}
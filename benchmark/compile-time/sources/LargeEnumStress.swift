@@ -0,0 +1,151 @@
+//===--- LargeEnumStress.swift --------------------------------------------===//
+//
+// This source file is part of the Swift.org open source project
+//
+// Copyright (c) 2014 - 2020 Apple Inc. and the Swift project authors
+// Licensed under Apache License v2.0 with Runtime Library Exception
+//
+// See https://swift.org/LICENSE.txt for license information
+// See https://swift.org/CONTRIBUTORS.txt for the list of Swift project authors
+//
+//===----------------------------------------------------------------------===//
+
+// Compile-time benchmark: enum layout and switch emission.
+//
+// A wide multi-payload enum plus exhaustive switches over it exercises enum
+// layout strategy selection in IRGen (GenEnum), tag/payload packing and
+// SILGen's switch lowering. A companion trivial enum with many cases covers
+// the no-payload strategies.
+
+enum Token {
+  case identifier(String)
+  case integerLiteral(Int)
+  case floatLiteral(Double)
+  case stringLiteral(String)
+  case booleanLiteral(Bool)
+  case pair(Int, Int)
+  case triple(Int, Int, Int)
+  case range(lower: Int, upper: Int)
+  case annotated(name: String, value: Int)
+  case wrapped([Int])
+  case keyed([String: Int])
+  case optionalPayload(Int?)
+  case leftParen
+  case rightParen
+  case leftBrace
+  case rightBrace
+  case leftBracket
+  case rightBracket
+  case comma
+  case colon
+  case semicolon
+  case arrow
+  case equals
+  case plus
+  case minus
+  case star
+  case slash
+  case percent
+  case ampersand
+  case pipe
+  case caret
+  case tilde
+  case bang
+  case question
+  case atSign
+  case hash
+  case dollar
+  case backtick
+  case newline
+  case whitespace
+  case endOfFile
+}
+
+enum Opcode: Int {
+  case nop = 0
+  case load, store, move, push, pop, dup, swap, drop
+  case add, sub, mul, div, mod, neg, inc, dec
+  case and, or, xor, not, shl, shr, rol, ror
+  case cmpEq, cmpNe, cmpLt, cmpLe, cmpGt, cmpGe
+  case jump, jumpIf, jumpUnless, call, ret, halt
+  case loadConst, loadLocal, storeLocal, loadGlobal, storeGlobal
+  case makeArray, makeDict, index, slice, append, concat
+  case throwErr, catchErr, retry, yield, await_, resume
+}
+
+func tokenWidth(_ token: Token) -> Int {
+  switch token {
+  case .identifier(let name): return name.count
+  case .integerLiteral(let value): return String(value).count
+  case .floatLiteral(let value): return String(value).count
+  case .stringLiteral(let text): return text.count + 2
+  case .booleanLiteral(let flag): return flag ? 4 : 5
+  case .pair(let a, let b): return String(a).count + String(b).count + 1
+  case .triple(let a, let b, let c):
+    return String(a).count + String(b).count + String(c).count + 2
+  case .range(let lower, let upper):
+    return String(lower).count + String(upper).count + 3
+  case .annotated(let name, let value):
+    return name.count + String(value).count + 1
+  case .wrapped(let values): return values.count * 2
+  case .keyed(let table): return table.count * 4
+  case .optionalPayload(let value): return value.map { String($0).count } ?? 3
+  case .arrow: return 2
+  case .newline, .whitespace, .endOfFile: return 0
+  default: return 1
+  }
+}
+
+func isOperator(_ token: Token) -> Bool {
+  switch token {
+  case .plus, .minus, .star, .slash, .percent,
+       .ampersand, .pipe, .caret, .tilde, .bang,
+       .equals, .arrow, .question:
+    return true
+  default:
+    return false
+  }
+}
+
+func opcodeCost(_ opcode: Opcode) -> Int {
+  switch opcode {
+  case .nop: return 0
+  case .load, .store, .move, .push, .pop, .dup, .swap, .drop:
+    return 1
+  case .add, .sub, .and, .or, .xor, .not, .shl, .shr, .rol, .ror,
+       .inc, .dec, .neg:
+    return 1
+  case .mul: return 3
+  case .div, .mod: return 10
+  case .cmpEq, .cmpNe, .cmpLt, .cmpLe, .cmpGt, .cmpGe:
+    return 1
+  case .jump, .jumpIf, .jumpUnless: return 2
+  case .call, .ret: return 5
+  case .halt: return 1
+  case .loadConst, .loadLocal, .storeLocal: return 1
+  case .loadGlobal, .storeGlobal: return 2
+  case .makeArray, .makeDict: return 8
+  case .index, .slice, .append, .concat: return 4
+  case .throwErr, .catchErr, .retry: return 20
+  case .yield, .await_, .resume: return 15
+  }
+}
+
+func normalize(_ token: Token) -> Token {
+  switch token {
+  case .pair(let a, let b) where a == b:
+    return .integerLiteral(a)
+  case .triple(let a, let b, let c) where a == b && b == c:
+    return .integerLiteral(a)
+  case .range(let lower, let upper) where lower == upper:
+    return .integerLiteral(lower)
+  case .optionalPayload(.some(let value)):
+    return .integerLiteral(value)
+  case .optionalPayload(.none):
+    return .whitespace
+  case .wrapped(let values) where values.isEmpty:
+    return .whitespace
+  default:
+    return token
+  }
+}
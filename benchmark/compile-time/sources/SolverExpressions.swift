@@ -0,0 +1,85 @@
+//===--- SolverExpressions.swift ------------------------------------------===//
+//
+// This source file is part of the Swift.org open source project
+//
+// Copyright (c) 2014 - 2020 Apple Inc. and the Swift project authors
+// Licensed under Apache License v2.0 with Runtime Library Exception
+//
+// See https://swift.org/LICENSE.txt for license information
+// See https://swift.org/CONTRIBUTORS.txt for the list of Swift project authors
+//
+//===----------------------------------------------------------------------===//
+
+// Compile-time benchmark: operator- and literal-heavy expressions.
+//
+// Every expression below mixes unannotated literals, overloaded arithmetic
+// operators and implicit conversions, which forces the constraint solver to
+// explore a large disjunction space. The bodies are intentionally repetitive;
+// what matters is the number and shape of the expressions, not what they
+// compute.
+
+func arithmeticMix1(_ x: Double, _ n: Int) -> Double {
+  let a = x * 2 + 1.5 * x - 3 / x + Double(n) * 0.25
+  let b = a + x * x - 2.0 * a + 1 / (a + 1) + 0.5
+  let c = b * b + a * 2 - x / 4 + 3.5 - Double(n + 1)
+  return a + b + c + x * 0.125 - 1
+}
+
+func arithmeticMix2(_ x: Double, _ n: Int) -> Double {
+  let a = 1 + x + 2 * x + 3.0 / (x + 1) - Double(n) / 2
+  let b = x * a - a / 3 + 0.75 * x + Double(n * 2) - 1.25
+  let c = (a + b) * 0.5 - b * x + 2 / (b + 1) + Double(n)
+  return c - a * 0.0625 + b / 8 + 2.5
+}
+
+func arithmeticMix3(_ x: Float, _ n: Int) -> Float {
+  let a = x * 4 - 1.5 + Float(n) * 0.5 + 2 / (x + 1)
+  let b = a + a * x - 3.25 / a + Float(n - 1) * 0.125
+  let c = b - x * 2 + a / 4 + 1.75 - Float(n) / 3
+  return a * 0.5 + b - c / 2 + x
+}
+
+func literalCollections1() -> Int {
+  let table = [
+    "one": 1, "two": 2, "three": 3, "four": 4, "five": 5,
+    "six": 6, "seven": 7, "eight": 8, "nine": 9, "ten": 10,
+  ]
+  let rows = [
+    [1, 2, 3, 4], [5, 6, 7, 8], [9, 10, 11, 12], [13, 14, 15, 16],
+  ]
+  let mixed: [(String, Int, Double)] = [
+    ("a", 1, 1.5), ("b", 2, 2.5), ("c", 3, 3.5), ("d", 4, 4.5),
+  ]
+  return table.count + rows.count + mixed.count
+}
+
+func literalCollections2() -> Double {
+  let weights = [0.1, 0.25, 0.5, 0.75, 1.0, 1.5, 2.0, 3.0, 5.0, 8.0]
+  let pairs = [(1, 0.5), (2, 1.5), (3, 2.5), (4, 3.5), (5, 4.5)]
+  let nested = [["x": 1.0, "y": 2.0], ["x": 3.0, "y": 4.0]]
+  return weights.reduce(0, +)
+    + pairs.reduce(0) { $0 + Double($1.0) * $1.1 }
+    + nested.reduce(0) { $0 + ($1["x"] ?? 0) }
+}
+
+func closureChains(_ values: [Int]) -> Int {
+  let a = values.map { $0 * 2 }.filter { $0 > 4 }.reduce(0, +)
+  let b = values.map { $0 + 1 }.map { $0 * $0 }.filter { $0 % 2 == 0 }.count
+  let c = values.sorted { $0 < $1 }.prefix(3).reduce(1) { $0 * ($1 + 1) }
+  let d = values.compactMap { $0 > 0 ? $0 * 3 : nil }.reduce(0) { $0 + $1 / 2 }
+  return a + b + c + d
+}
+
+func ternaryCascade(_ n: Int, _ x: Double) -> Double {
+  let a = n > 0 ? x * 2 : x / 2
+  let b = n > 10 ? a + 1.5 : n > 5 ? a - 1.5 : a
+  let c = x > 1 ? b * 0.5 : x > 0 ? b * 2 : b
+  return n % 2 == 0 ? a + b + c : a - b + c * 1.25
+}
+
+func stringInterpolations(_ n: Int, _ x: Double) -> String {
+  let a = "value \(n) scaled by \(x * 2) gives \(Double(n) * x)"
+  let b = "sum \(n + 1 + 2 + 3), product \(x * 1.5 * 2.5)"
+  let c = "\(a.count) + \(b.count) = \(a.count + b.count)"
+  return a + b + c
+}
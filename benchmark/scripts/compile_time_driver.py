@@ -0,0 +1,242 @@
+#!/usr/bin/env python
+# -*- coding: utf-8 -*-
+
+# ===--- compile_time_driver.py ------------------------------------------===//
+#
+#  This source file is part of the Swift.org open source project
+#
+#  Copyright (c) 2014 - 2020 Apple Inc. and the Swift project authors
+#  Licensed under Apache License v2.0 with Runtime Library Exception
+#
+#  See https://swift.org/LICENSE.txt for license information
+#  See https://swift.org/CONTRIBUTORS.txt for the list of Swift project authors
+#
+# ===---------------------------------------------------------------------===//
+"""
+Driver for the compile-time benchmark suite in benchmark/compile-time.
+
+Compiles each source in the corpus several times through the Swift frontend
+with `-stats-output-dir`, parses the JSON statistics files the frontend
+emits, and reports the median value of every frontend phase timer across
+the runs. The medians can be written out as JSON and compared between two
+compiler builds with diff or a few lines of scripting.
+
+Example:
+    $ compile_time_driver.py --swiftc /path/to/build/bin/swiftc
+
+class `CompileTimeBenchmark` measures one corpus source.
+class `ReportFormatter` renders the collected medians.
+"""
+
+from __future__ import print_function
+
+import argparse
+import glob
+import json
+import os
+import shutil
+import subprocess
+import sys
+import tempfile
+
+DRIVER_DIR = os.path.dirname(os.path.realpath(__file__))
+SUITE_DIR = os.path.join(
+    os.path.dirname(DRIVER_DIR), "compile-time", "sources"
+)
+
+
+def median(values):
+    """Return the median of a non-empty list of numbers."""
+    values = sorted(values)
+    mid = len(values) // 2
+    if len(values) % 2 == 1:
+        return values[mid]
+    return (values[mid - 1] + values[mid]) / 2.0
+
+
+class CompileTimeBenchmark(object):
+    """Measures frontend phase times for a single corpus source.
+
+    Each measurement is one frontend invocation with a fresh
+    `-stats-output-dir`; the statistics file it leaves behind is parsed
+    and its numeric entries collected as one sample per statistic.
+    """
+
+    def __init__(self, source, swiftc, extra_args=None, _subprocess=None):
+        """Initialize with a source path and a swiftc to benchmark.
+
+        Optional parameters are for injecting dependencies -- used for
+        testing.
+        """
+        self.source = source
+        self.name = os.path.splitext(os.path.basename(source))[0]
+        self.swiftc = swiftc
+        self.extra_args = extra_args or []
+        self._subprocess = _subprocess or subprocess
+
+    def run_once(self):
+        """Compile the source once and return its statistics dictionary."""
+        stats_dir = tempfile.mkdtemp(prefix="compile-time-stats-")
+        try:
+            command = [
+                self.swiftc,
+                "-frontend",
+                "-c",
+                "-o",
+                os.devnull,
+                "-stats-output-dir",
+                stats_dir,
+            ] + self.extra_args + [self.source]
+            self._subprocess.check_call(command)
+            stats_files = glob.glob(os.path.join(stats_dir, "stats-*.json"))
+            if len(stats_files) != 1:
+                raise RuntimeError(
+                    "expected 1 stats file for {0}, found {1}".format(
+                        self.name, len(stats_files)
+                    )
+                )
+            with open(stats_files[0]) as stats_file:
+                stats = json.load(stats_file)
+            return {
+                key: value
+                for key, value in stats.items()
+                if isinstance(value, (int, float))
+            }
+        finally:
+            shutil.rmtree(stats_dir)
+
+    def measure(self, iterations):
+        """Compile the source `iterations` times and return medians.
+
+        Returns a dictionary from statistic name to the median of its
+        samples.
+        """
+        samples = {}
+        for _ in range(iterations):
+            for key, value in self.run_once().items():
+                samples.setdefault(key, []).append(value)
+        return {key: median(values) for key, values in samples.items()}
+
+
+class ReportFormatter(object):
+    """Renders the per-source medians gathered by the driver.
+
+    By default only wall-clock phase timers (`time.*.wall`) are shown,
+    since those are the numbers that gate compiler updates; `--all-stats`
+    includes every numeric statistic the frontend emitted.
+    """
+
+    def __init__(self, results, all_stats=False):
+        """Initialize with a {source name: {statistic: median}} mapping."""
+        self.results = results
+        self.all_stats = all_stats
+
+    def _reported_keys(self, medians):
+        keys = sorted(medians.keys())
+        if self.all_stats:
+            return keys
+        return [
+            key
+            for key in keys
+            if key.startswith("time.") and key.endswith(".wall")
+        ]
+
+    def text(self):
+        """Return the report as aligned plain text."""
+        lines = []
+        for name in sorted(self.results.keys()):
+            medians = self.results[name]
+            lines.append(name)
+            keys = self._reported_keys(medians)
+            width = max(len(key) for key in keys) if keys else 0
+            for key in keys:
+                lines.append(
+                    "  {0:<{1}}  {2}".format(key, width, medians[key])
+                )
+        return "\n".join(lines)
+
+    def json(self):
+        """Return the report as pretty-printed JSON."""
+        reported = {
+            name: {key: medians[key] for key in self._reported_keys(medians)}
+            for name, medians in self.results.items()
+        }
+        return json.dumps(reported, indent=2, sort_keys=True)
+
+
+def parse_args(args):
+    """Parse command line arguments and return the parsed namespace."""
+    parser = argparse.ArgumentParser(
+        epilog="Example: %(prog)s --swiftc /path/to/build/bin/swiftc"
+    )
+    parser.add_argument(
+        "--swiftc",
+        required=True,
+        help="the swiftc binary whose frontend should be benchmarked",
+    )
+    parser.add_argument(
+        "-i",
+        "--iterations",
+        type=int,
+        default=5,
+        help="number of compilations per source (default: 5)",
+    )
+    parser.add_argument(
+        "-t",
+        "--tests",
+        nargs="+",
+        help="run only the named corpus sources (without .swift)",
+    )
+    parser.add_argument(
+        "--all-stats",
+        action="store_true",
+        help="report all frontend statistics, not just phase wall times",
+    )
+    parser.add_argument(
+        "-o",
+        "--output",
+        help="write the medians as JSON to this file",
+    )
+    parser.add_argument(
+        "-Xfrontend",
+        action="append",
+        dest="extra_args",
+        default=[],
+        metavar="ARG",
+        help="pass an extra argument to each frontend invocation "
+        "(use -Xfrontend=ARG for arguments starting with a dash)",
+    )
+    return parser.parse_args(args)
+
+
+def main():
+    """Run the suite and print the report; return the exit status."""
+    args = parse_args(sys.argv[1:])
+    sources = sorted(glob.glob(os.path.join(SUITE_DIR, "*.swift")))
+    if args.tests:
+        sources = [
+            source
+            for source in sources
+            if os.path.splitext(os.path.basename(source))[0] in args.tests
+        ]
+    if not sources:
+        print("error: no benchmark sources selected", file=sys.stderr)
+        return 1
+
+    results = {}
+    for source in sources:
+        benchmark = CompileTimeBenchmark(
+            source, args.swiftc, extra_args=args.extra_args
+        )
+        results[benchmark.name] = benchmark.measure(args.iterations)
+
+    formatter = ReportFormatter(results, all_stats=args.all_stats)
+    print(formatter.text())
+    if args.output:
+        with open(args.output, "w") as output_file:
+            output_file.write(formatter.json() + "\n")
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
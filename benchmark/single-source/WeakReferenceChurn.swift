@@ -0,0 +1,74 @@
+//===--- WeakReferenceChurn.swift -----------------------------------------===//
+//
+// This source file is part of the Swift.org open source project
+//
+// Copyright (c) 2014 - 2020 Apple Inc. and the Swift project authors
+// Licensed under Apache License v2.0 with Runtime Library Exception
+//
+// See https://swift.org/LICENSE.txt for license information
+// See https://swift.org/CONTRIBUTORS.txt for the list of Swift project authors
+//
+//===----------------------------------------------------------------------===//
+
+import TestsUtils
+
+// This test checks the performance of creating and destroying weak
+// references. Forming the first weak reference to an object moves its
+// reference counts into a heap-allocated side table entry, so the churn
+// loop exercises side table allocation and deallocation, and the load
+// loop exercises reading through an existing side table.
+public var WeakReferenceChurn = BenchmarkInfo(
+  name: "WeakReferenceChurn",
+  runFunction: run_WeakReferenceChurn,
+  tags: [.runtime, .cpubench]
+)
+
+final class Referent {
+  var value: Int
+
+  init(_ value: Int) {
+    self.value = value
+  }
+}
+
+struct WeakBox {
+  weak var ref: Referent?
+}
+
+@inline(never)
+func testFormWeak(_ n: Int) -> Int {
+  var sum = 0
+  for i in 0..<n {
+    // A fresh referent each time around: forming the weak reference
+    // allocates a side table entry, and dropping both references frees it.
+    let obj = Referent(i)
+    let box = WeakBox(ref: obj)
+    if let o = box.ref {
+      sum += o.value
+    }
+  }
+  return sum
+}
+
+@inline(never)
+func testReadWeak(_ n: Int) -> Int {
+  let obj = Referent(1)
+  let box = WeakBox(ref: obj)
+  var sum = 0
+  for _ in 0..<n {
+    // The side table already exists; this measures weak loads alone.
+    if let o = box.ref {
+      sum += o.value
+    }
+  }
+  return sum
+}
+
+@inline(never)
+public func run_WeakReferenceChurn(_ N: Int) {
+  let iters = 10_000
+  for _ in 0..<N {
+    CheckResults(testFormWeak(iters) == (iters * (iters - 1)) / 2)
+    CheckResults(testReadWeak(iters) == iters)
+  }
+}
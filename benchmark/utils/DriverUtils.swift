@@ -12,6 +12,7 @@
 
 #if os(Linux)
 import Glibc
+import PerfCounters
 #elseif os(Windows)
 import MSVCRT
 #else
@@ -29,15 +30,34 @@ struct MeasurementMetadata {
   let yields: Int /// Yield Count
 }
 
+/// Hardware performance counter values for a single sample, per iteration.
+struct CounterSample {
+  var instructions = 0 /// Instructions Retired
+  var branchMisses = 0 /// Branch Mispredictions
+  var cacheMisses = 0 /// Cache Misses
+}
+
+/// Swift runtime memory counter values for a single sample, per iteration.
+struct MemorySample {
+  var allocations = 0 /// swift_allocObject calls
+  var retains = 0 /// swift_retain calls, including nonatomic and _n variants
+  var releases = 0 /// swift_release calls, including nonatomic and _n variants
+}
+
 struct BenchResults {
   typealias T = Int
   private let samples: [T]
   let meta: MeasurementMetadata?
+  let counters: CounterSample?
+  let memory: MemorySample?
   let stats: Stats
 
-  init(_ samples: [T], _ metadata: MeasurementMetadata?) {
+  init(_ samples: [T], _ metadata: MeasurementMetadata?,
+       _ counters: CounterSample? = nil, _ memory: MemorySample? = nil) {
     self.samples = samples.sorted()
     self.meta = metadata
+    self.counters = counters
+    self.memory = memory
     self.stats = self.samples.reduce(into: Stats(), Stats.collect)
   }
 
@@ -104,6 +124,12 @@ struct TestConfig {
   // Should we log the measurement metadata?
   let logMeta: Bool
 
+  // Should we log hardware performance counters?
+  let logCounters: Bool
+
+  // Should we log the runtime memory counters?
+  let logMemCounters: Bool
+
   /// After we run the tests, should the harness sleep to allow for utilities
   /// like leaks that require a PID to run on the test harness.
   let afterRunSleep: UInt32?
@@ -128,6 +154,8 @@ struct TestConfig {
       var verbose: Bool?
       var logMemory: Bool?
       var logMeta: Bool?
+      var logCounters: Bool?
+      var logMemCounters: Bool?
       var action: TestAction?
       var tests: [String]?
     }
@@ -175,6 +203,14 @@ struct TestConfig {
                   help: "log the change in maximum resident set size (MAX_RSS)")
     p.addArgument("--meta", \.logMeta, defaultValue: true,
                   help: "log the metadata (memory usage, context switches)")
+    p.addArgument("--counters", \.logCounters, defaultValue: true,
+                  help: "log the median hardware performance counters per\n" +
+                        "iteration (instructions retired, branch and cache\n" +
+                        "misses); Linux and macOS")
+    p.addArgument("--mem-counters", \.logMemCounters, defaultValue: true,
+                  help: "log the median runtime memory counters per iteration\n" +
+                        "(object allocations, retains, releases); requires a\n" +
+                        "runtime built with function counters")
     p.addArgument("--delim", \.delim,
                   help:"value delimiter used for log output; default: ,",
                   parser: { $0 })
@@ -206,6 +242,8 @@ struct TestConfig {
     verbose = c.verbose ?? false
     logMemory = c.logMemory ?? false
     logMeta = c.logMeta ?? false
+    logCounters = c.logCounters ?? false
+    logMemCounters = c.logMemCounters ?? false
     afterRunSleep = c.afterRunSleep
     action = c.action ?? .run
     tests = TestConfig.filterTests(registeredBenchmarks,
@@ -233,6 +271,8 @@ struct TestConfig {
         Verbose: \(verbose)
         LogMemory: \(logMemory)
         LogMeta: \(logMeta)
+        LogCounters: \(logCounters)
+        LogMemCounters: \(logMemCounters)
         SampleTime: \(sampleTime)
         NumIters: \(numIters ?? 0)
         Quantile: \(quantile ?? 0)
@@ -380,6 +420,187 @@ extension UInt64 {
   var microseconds: Int { return Int(self / 1000) }
 }
 
+/// Collects hardware performance counters around each measured sample.
+///
+/// Counting instructions retired, branch misses and cache misses makes a
+/// single sample far less susceptible to machine noise than wall time, so
+/// short runs on busy boxes still produce trustworthy numbers. On Linux the
+/// counters come from perf_event_open(2), counting user-mode events on this
+/// thread only; they are opened once and enabled just for the duration of a
+/// sample. On Darwin, where the dedicated counter API (kpc) is private, the
+/// instruction count is read from the process rusage accounting and the
+/// other counters report 0, as do counters the kernel refuses to open.
+final class HardwareCounters {
+#if os(Linux)
+  private let instructions: CInt
+  private let branchMisses: CInt
+  private let cacheMisses: CInt
+
+  init() {
+    instructions = swift_perf_open_instructions()
+    branchMisses = swift_perf_open_branch_misses()
+    cacheMisses = swift_perf_open_cache_misses()
+  }
+
+  deinit {
+    for fd in [instructions, branchMisses, cacheMisses] where fd >= 0 {
+      close(fd)
+    }
+  }
+
+  func start() {
+    for fd in [instructions, branchMisses, cacheMisses] where fd >= 0 {
+      swift_perf_event_reset_enable(fd)
+    }
+  }
+
+  func stop() {
+    for fd in [instructions, branchMisses, cacheMisses] where fd >= 0 {
+      swift_perf_event_disable(fd)
+    }
+  }
+
+  func read(numIters: Int) -> CounterSample {
+    func value(_ fd: CInt) -> Int {
+      guard fd >= 0 else { return 0 }
+      return Int(Swift.max(0, swift_perf_event_read(fd))) / numIters
+    }
+    return CounterSample(
+      instructions: value(instructions),
+      branchMisses: value(branchMisses),
+      cacheMisses: value(cacheMisses))
+  }
+#elseif canImport(Darwin)
+  private var startInstructions: UInt64 = 0
+  private var endInstructions: UInt64 = 0
+
+  func start() {
+    startInstructions = HardwareCounters.executedInstructions()
+  }
+
+  func stop() {
+    endInstructions = HardwareCounters.executedInstructions()
+  }
+
+  func read(numIters: Int) -> CounterSample {
+    return CounterSample(
+      instructions: Int(endInstructions &- startInstructions) / numIters)
+  }
+
+  private static func executedInstructions() -> UInt64 {
+    if #available(OSX 10.9, iOS 7.0, *) {
+      var u = rusage_info_v4()
+      withUnsafeMutablePointer(to: &u) { p in
+        p.withMemoryRebound(to: Optional<rusage_info_t>.self, capacity: 1) { up in
+          let _ = proc_pid_rusage(getpid(), RUSAGE_INFO_V4, up)
+        }
+      }
+      return u.ri_instructions
+    } else {
+      return 0
+    }
+  }
+#else
+  func start() {}
+  func stop() {}
+  func read(numIters: Int) -> CounterSample { return CounterSample() }
+#endif
+}
+
+/// Collects Swift runtime memory counters around each measured sample.
+///
+/// A runtime built with SWIFT_ENABLE_RUNTIME_FUNCTION_COUNTERS counts every
+/// call to swift_allocObject, swift_retain, swift_release and friends. Those
+/// counts characterize the memory traffic of a benchmark exactly, without
+/// the process-wide noise that makes MAX_RSS meaningful only for a single
+/// test. The entry points are resolved with dlsym so the driver still links
+/// and runs against a default runtime; the initializer fails there and the
+/// reported columns stay empty.
+final class RuntimeMemoryCounters {
+#if os(Linux) || canImport(Darwin)
+  private typealias GetCounters = @convention(c) (UnsafeMutableRawPointer) -> Void
+  private typealias SetMode = @convention(c) (CInt) -> CInt
+  private typealias GetNames =
+    @convention(c) () -> UnsafePointer<UnsafePointer<CChar>>
+  private typealias GetNumCounters = @convention(c) () -> UInt64
+
+  private let getCounters: GetCounters
+  private let setMode: SetMode
+  /// Indices into the counters state of the functions summed per column.
+  private let allocations: [Int]
+  private let retains: [Int]
+  private let releases: [Int]
+  /// Snapshots of the runtime's RuntimeFunctionCountersState: one UInt32
+  /// counter per tracked function, in the order of the name table.
+  private var startState: [UInt32]
+  private var endState: [UInt32]
+
+  init?() {
+    guard let handle = dlopen(nil, RTLD_NOW) else { return nil }
+    func symbol<T>(_ name: String, _: T.Type) -> T? {
+      guard let sym = dlsym(handle, name) else { return nil }
+      return unsafeBitCast(sym, to: T.self)
+    }
+    guard
+      let getCounters = symbol(
+        "_swift_getGlobalRuntimeFunctionCounters", GetCounters.self),
+      let setMode = symbol(
+        "_swift_setGlobalRuntimeFunctionCountersMode", SetMode.self),
+      let getNames = symbol("_swift_getRuntimeFunctionNames", GetNames.self),
+      let getNumCounters = symbol(
+        "_swift_getNumRuntimeFunctionCounters", GetNumCounters.self)
+    else { return nil }
+    self.getCounters = getCounters
+    self.setMode = setMode
+
+    let numCounters = Int(getNumCounters())
+    let names = getNames()
+    var nameToIndex: [String: Int] = [:]
+    for index in 0..<numCounters {
+      nameToIndex[String(cString: names[index])] = index
+    }
+    func indices(of tracked: [String]) -> [Int] {
+      return tracked.compactMap { nameToIndex[$0] }
+    }
+    allocations = indices(of: ["swift_allocObject"])
+    retains = indices(of: ["swift_retain", "swift_retain_n",
+                           "swift_nonatomic_retain", "swift_nonatomic_retain_n"])
+    releases = indices(of: ["swift_release", "swift_release_n",
+                            "swift_nonatomic_release",
+                            "swift_nonatomic_release_n"])
+    startState = [UInt32](repeating: 0, count: numCounters)
+    endState = startState
+  }
+
+  func start() {
+    getCounters(&startState)
+    _ = setMode(1)
+  }
+
+  func stop() {
+    _ = setMode(0)
+    getCounters(&endState)
+  }
+
+  func read(numIters: Int) -> MemorySample {
+    func delta(_ indices: [Int]) -> Int {
+      var total = 0
+      for i in indices { total += Int(endState[i] &- startState[i]) }
+      return total / numIters
+    }
+    return MemorySample(
+      allocations: delta(allocations),
+      retains: delta(retains),
+      releases: delta(releases))
+  }
+#else
+  init?() { return nil }
+  func start() {}
+  func stop() {}
+  func read(numIters: Int) -> MemorySample { return MemorySample() }
+#endif
+}
+
 /// Performance test runner that measures benchmarks and reports the results.
 final class TestRunner {
   let c: TestConfig
@@ -388,9 +609,23 @@ final class TestRunner {
   let baseline = TestRunner.getResourceUtilization()
   let schedulerQuantum = UInt64(10_000_000) // nanoseconds (== 10ms, macos)
   var yieldCount = 0
+  let counters: HardwareCounters?
+  var counterSamples: [CounterSample] = []
+  let memCounters: RuntimeMemoryCounters?
+  var memorySamples: [MemorySample] = []
 
   init(_ config: TestConfig) {
     self.c = config
+    self.counters = config.logCounters ? HardwareCounters() : nil
+    self.memCounters = config.logMemCounters ? RuntimeMemoryCounters() : nil
+    if config.logMemCounters && memCounters == nil {
+      print(
+      """
+      warning: Runtime memory counters are not available. The runtime was
+               built without SWIFT_ENABLE_RUNTIME_FUNCTION_COUNTERS; the
+               ALLOCS, RETAINS and RELEASES columns will be empty.
+      """)
+    }
     let now = timer.getTime()
     (start, end, lastYield) = (now, now, now)
   }
@@ -402,28 +637,6 @@ final class TestRunner {
     return timer.getTime()
   }
 
-#if os(Linux)
-  private static func getExecutedInstructions() -> UInt64 {
-    // FIXME: there is a Linux PMC API you can use to get this, but it's
-    // not quite so straightforward.
-    return 0
-  }
-#else
-  private static func getExecutedInstructions() -> UInt64 {
-    if #available(OSX 10.9, iOS 7.0, *) {
-      var u = rusage_info_v4()
-      withUnsafeMutablePointer(to: &u) { p in
-        p.withMemoryRebound(to: Optional<rusage_info_t>.self, capacity: 1) { up in
-          let _ = proc_pid_rusage(getpid(), RUSAGE_INFO_V4, up)
-        }
-      }
-      return u.ri_instructions
-    } else {
-      return 0
-    }
-  }
-#endif
-
   private static func getResourceUtilization() -> rusage {
 #if canImport(Darwin)
    let rusageSelf = RUSAGE_SELF
@@ -503,6 +716,8 @@ final class TestRunner {
     let now = yield()
     (start, end, lastYield) = (now, now, now)
     yieldCount = 0
+    counterSamples.removeAll(keepingCapacity: true)
+    memorySamples.removeAll(keepingCapacity: true)
   }
 
   /// Time in nanoseconds spent running the last function
@@ -516,14 +731,24 @@ final class TestRunner {
     name.withCString { p in startTrackingObjects(p) }
 #endif
 
+    counters?.start()
+    memCounters?.start()
     startMeasurement()
     fn(numIters)
     stopMeasurement()
+    memCounters?.stop()
+    counters?.stop()
 
 #if SWIFT_RUNTIME_ENABLE_LEAK_CHECKER
     name.withCString { p in stopTrackingObjects(p) }
 #endif
 
+    if let counters = counters {
+      counterSamples.append(counters.read(numIters: numIters))
+    }
+    if let memCounters = memCounters {
+      memorySamples.append(memCounters.read(numIters: numIters))
+    }
     return lastSampleTime.microseconds / numIters
   }
 
@@ -600,7 +825,38 @@ final class TestRunner {
       samples = samples.map { $0 * lf }
     }
 
-    return BenchResults(samples, collectMetadata())
+    return BenchResults(samples, collectMetadata(), collectCounters(),
+                        collectMemoryCounters())
+  }
+
+  /// Returns the median of the per-sample hardware counter values.
+  func collectCounters() -> CounterSample? {
+    guard counters != nil, !counterSamples.isEmpty else { return nil }
+    func median(_ series: [Int]) -> Int {
+      let sorted = series.sorted()
+      // Quantile estimate type R-1, same as `BenchResults.median`.
+      return sorted[Swift.max(0,
+        Int((Double(sorted.count) * 0.5).rounded(.up)) - 1)]
+    }
+    return CounterSample(
+      instructions: median(counterSamples.map { $0.instructions }),
+      branchMisses: median(counterSamples.map { $0.branchMisses }),
+      cacheMisses: median(counterSamples.map { $0.cacheMisses }))
+  }
+
+  /// Returns the median of the per-sample runtime memory counter values.
+  func collectMemoryCounters() -> MemorySample? {
+    guard memCounters != nil, !memorySamples.isEmpty else { return nil }
+    func median(_ series: [Int]) -> Int {
+      let sorted = series.sorted()
+      // Quantile estimate type R-1, same as `BenchResults.median`.
+      return sorted[Swift.max(0,
+        Int((Double(sorted.count) * 0.5).rounded(.up)) - 1)]
+    }
+    return MemorySample(
+      allocations: median(memorySamples.map { $0.allocations }),
+      retains: median(memorySamples.map { $0.retains }),
+      releases: median(memorySamples.map { $0.releases }))
   }
 
   var header: String {
@@ -623,7 +879,9 @@ final class TestRunner {
       (c.quantile.map(quantiles)
         ?? ["MIN", "MAX", "MEAN", "SD", "MEDIAN"].map(withUnit)) +
       (c.logMemory ? ["MAX_RSS(B)"] : []) +
-      (c.logMeta ? ["PAGES", "ICS", "YIELD"] : [])
+      (c.logMeta ? ["PAGES", "ICS", "YIELD"] : []) +
+      (c.logCounters ? ["INSTRUCTIONS", "BRANCH_MISS", "CACHE_MISS"] : []) +
+      (c.logMemCounters ? ["ALLOCS", "RETAINS", "RELEASES"] : [])
     ).joined(separator: c.delim)
   }
 
@@ -645,7 +903,11 @@ final class TestRunner {
             ?? [r.min,  r.max, r.mean, r.sd, r.median]) +
           (c.logMemory ? [r.meta?.maxRSS].compactMap { $0 } : []) +
           (c.logMeta ? r.meta.map {
-            [$0.pages, $0.ics, $0.yields] } ?? [] : [])
+            [$0.pages, $0.ics, $0.yields] } ?? [] : []) +
+          (c.logCounters ? r.counters.map {
+            [$0.instructions, $0.branchMisses, $0.cacheMisses] } ?? [] : []) +
+          (c.logMemCounters ? r.memory.map {
+            [$0.allocations, $0.retains, $0.releases] } ?? [] : [])
         return values.map {
           (c.delta && $0 == 0) ? "" : String($0) } // drop 0s in deltas
       }
@@ -0,0 +1,81 @@
+//===--- PerfCountersShim.h -----------------------------------------------===//
+//
+// This source file is part of the Swift.org open source project
+//
+// Copyright (c) 2014 - 2020 Apple Inc. and the Swift project authors
+// Licensed under Apache License v2.0 with Runtime Library Exception
+//
+// See https://swift.org/LICENSE.txt for license information
+// See https://swift.org/CONTRIBUTORS.txt for the list of Swift project authors
+//
+//===----------------------------------------------------------------------===//
+
+// Thin wrappers over perf_event_open(2), which is only reachable through the
+// variadic syscall(2) and therefore cannot be called from Swift directly.
+// Each counter is opened for the calling thread, counting user-mode events
+// only, and starts out disabled; it costs nothing until it is enabled around
+// a measured sample.
+
+#ifndef SWIFT_BENCHMARK_PERF_COUNTERS_SHIM_H
+#define SWIFT_BENCHMARK_PERF_COUNTERS_SHIM_H
+
+#if __has_include(<linux/perf_event.h>)
+
+#include <linux/perf_event.h>
+#include <string.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+
+static inline int _swift_perf_event_open(unsigned int type,
+                                         unsigned long long config) {
+  struct perf_event_attr attr;
+  memset(&attr, 0, sizeof(attr));
+  attr.type = type;
+  attr.size = sizeof(attr);
+  attr.config = config;
+  attr.disabled = 1;
+  attr.exclude_kernel = 1;
+  attr.exclude_hv = 1;
+  return (int)syscall(__NR_perf_event_open, &attr, 0, -1, -1, 0);
+}
+
+/// Open a counter of instructions retired for the calling thread.
+/// Returns a file descriptor, or -1 if the event is unavailable.
+static inline int swift_perf_open_instructions(void) {
+  return _swift_perf_event_open(PERF_TYPE_HARDWARE, PERF_COUNT_HW_INSTRUCTIONS);
+}
+
+/// Open a counter of mispredicted branches for the calling thread.
+static inline int swift_perf_open_branch_misses(void) {
+  return _swift_perf_event_open(PERF_TYPE_HARDWARE,
+                                PERF_COUNT_HW_BRANCH_MISSES);
+}
+
+/// Open a counter of last-level cache misses for the calling thread.
+static inline int swift_perf_open_cache_misses(void) {
+  return _swift_perf_event_open(PERF_TYPE_HARDWARE, PERF_COUNT_HW_CACHE_MISSES);
+}
+
+/// Zero the counter and start counting.
+static inline void swift_perf_event_reset_enable(int fd) {
+  ioctl(fd, PERF_EVENT_IOC_RESET, 0);
+  ioctl(fd, PERF_EVENT_IOC_ENABLE, 0);
+}
+
+/// Stop counting, leaving the counter value readable.
+static inline void swift_perf_event_disable(int fd) {
+  ioctl(fd, PERF_EVENT_IOC_DISABLE, 0);
+}
+
+/// Read the current counter value; returns -1 on failure.
+static inline long long swift_perf_event_read(int fd) {
+  long long value = 0;
+  if (read(fd, &value, sizeof(value)) != (ssize_t)sizeof(value))
+    return -1;
+  return value;
+}
+
+#endif // __has_include(<linux/perf_event.h>)
+
+#endif // SWIFT_BENCHMARK_PERF_COUNTERS_SHIM_H
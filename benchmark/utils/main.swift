@@ -176,6 +176,7 @@ import TwoSum
 import TypeFlood
 import UTF8Decode
 import Walsh
+import WeakReferenceChurn
 import WordCount
 import XorLoop
 
@@ -364,6 +365,7 @@ registerBenchmark(TwoSum)
 registerBenchmark(TypeFlood)
 registerBenchmark(UTF8Decode)
 registerBenchmark(Walsh)
+registerBenchmark(WeakReferenceChurn)
 registerBenchmark(WordCount)
 registerBenchmark(XorLoop)
 
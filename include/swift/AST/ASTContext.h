@@ -111,6 +111,7 @@ namespace swift {
   class SILBoxType;
   class SILTransform;
   class TypeAliasDecl;
+  class TypeRepr;
   class VarDecl;
   class UnifiedStatsReporter;
   class IndexSubset;
@@ -126,6 +127,10 @@ namespace syntax {
   class SyntaxArena;
 }
 
+namespace Demangle {
+  class ManglingCache;
+}
+
 /// The arena in which a particular ASTContext allocation will go.
 enum class AllocationArena {
   /// The permanent arena, which is tied to the lifetime of
@@ -188,6 +193,31 @@ public:
   ~ConstraintCheckerArenaRAII();
 };
 
+/// Leases a bump allocator for constraint solving from a pool owned by the
+/// ASTContext, whose lifetime is tied to the lifetime of this RAII object.
+///
+/// On destruction the allocator is reset--retaining its initial slab--and
+/// returned to the pool, so consecutive solver invocations reuse memory
+/// rather than repeatedly growing and freeing a fresh allocator.
+class SolverAllocatorRAII {
+  ASTContext &Self;
+  std::unique_ptr<llvm::BumpPtrAllocator> Allocator;
+
+public:
+  explicit SolverAllocatorRAII(ASTContext &self);
+
+  SolverAllocatorRAII(const SolverAllocatorRAII &) = delete;
+  SolverAllocatorRAII(SolverAllocatorRAII &&) = delete;
+
+  SolverAllocatorRAII &operator=(const SolverAllocatorRAII &) = delete;
+  SolverAllocatorRAII &operator=(SolverAllocatorRAII &&) = delete;
+
+  /// Retrieve the leased allocator.
+  llvm::BumpPtrAllocator &get() const { return *Allocator; }
+
+  ~SolverAllocatorRAII();
+};
+
 class SILLayout; // From SIL
 
 /// ASTContext - This object creates and owns the AST objects.
@@ -279,6 +309,22 @@ public:
   /// Cache of remapped types (useful for diagnostics).
   llvm::StringMap<Type> RemappedTypes;
 
+  /// Cache of types resolved from structurally identical type
+  /// representations in the same declaration context. Each entry records
+  /// the resolved type and the representation that produced it, so name
+  /// bindings can be replayed onto later occurrences. Maintained by
+  /// TypeResolution::resolveType.
+  llvm::StringMap<std::pair<Type, TypeRepr *>> ResolvedTypeReprCache;
+
+  /// Cache of whether a given function builder type supports a given
+  /// build operation. Each entry records the answer together with the
+  /// module load generation it was computed in, since a later-loaded
+  /// module can extend the builder. Maintained by the function builder
+  /// transform.
+  llvm::DenseMap<std::pair<NominalTypeDecl *, Identifier>,
+                 std::pair<bool, unsigned>>
+      FunctionBuilderSupportedOps;
+
   /// The # of times we have performed typo correction.
   unsigned NumTypoCorrections = 0;
 
@@ -446,6 +492,10 @@ public:
   /// specified string.
   Identifier getIdentifier(StringRef Str) const;
 
+  /// Retrieve the cache of remangling results used when resolving mangled
+  /// names to AST declarations.
+  Demangle::ManglingCache &getManglingCache() const;
+
   /// Decide how to interpret two precedence groups.
   Associativity associateInfixOperators(PrecedenceGroupDecl *left,
                                         PrecedenceGroupDecl *right) const;
@@ -922,6 +972,10 @@ public:
   /// Returns memory used exclusively by constraint solver.
   size_t getSolverMemory() const;
 
+  /// Returns the most memory any constraint solver arena has used at the
+  /// point of its teardown.
+  size_t getSolverMemoryHighWater() const;
+
   /// Retrieve the Swift name for the given Foundation entity, where
   /// "NS" prefix stripping will apply under omit-needless-words.
   StringRef getSwiftName(KnownFoundationEntity kind);
@@ -1006,6 +1060,30 @@ public:
   /// Retrieve the IRGen specific SIL passes.
   SILTransformCtors getIRGenSILTransforms() const;
 
+  /// Record which overload of the binary operator \p opName a solved
+  /// expression used for the given canonical operand and contextual types,
+  /// so that later expressions with the same shape can try it first.
+  void setSolvedBinaryOperatorOverload(Identifier opName, CanType lhsTy,
+                                       CanType rhsTy, CanType contextualTy,
+                                       ValueDecl *choice);
+
+  /// Retrieve the recorded overload of the binary operator \p opName for the
+  /// given canonical operand and contextual types, or \c nullptr if no
+  /// expression with this shape has been solved yet.
+  ValueDecl *getSolvedBinaryOperatorOverload(Identifier opName, CanType lhsTy,
+                                             CanType rhsTy,
+                                             CanType contextualTy) const;
+
+  /// Increment the success count persisted for the given operator overload
+  /// profile key. Has no effect unless \c
+  /// TypeCheckerOpts.SolverOverloadProfilePath is set.
+  void recordOperatorOverloadSuccess(StringRef profileKey);
+
+  /// Retrieve the success count persisted for the given operator overload
+  /// profile key in previous compiles, or 0 if the profile is disabled or
+  /// has no entry for the key.
+  unsigned getOperatorOverloadSuccessCount(StringRef profileKey);
+
 private:
   friend Decl;
   Optional<RawComment> getRawComment(const Decl *D);
@@ -1014,6 +1092,11 @@ private:
   Optional<StringRef> getBriefComment(const Decl *D);
   void setBriefComment(const Decl *D, StringRef Comment);
 
+  friend AbstractFunctionDecl;
+  Optional<uint64_t> getBodyFingerprint(const AbstractFunctionDecl *AFD) const;
+  void setBodyFingerprint(const AbstractFunctionDecl *AFD,
+                          uint64_t Fingerprint);
+
   friend TypeBase;
   friend ArchetypeType;
   friend OpaqueTypeDecl;
@@ -202,6 +202,11 @@ public: // for addReusedBodyScopes
   void addChild(ASTScopeImpl *child, ASTContext &);
   std::vector<ASTScopeImpl *> rescueASTAncestorScopesForReuseFromMe();
 
+  /// Remove every child from \p count onwards, disowning descendants so
+  /// that the scopes can be recreated. Used to roll the tree back to just
+  /// before the first top-level declaration changed by an edit.
+  void removeChildrenFrom(unsigned count, ScopeCreator &);
+
   /// When reexpanding, do we always create a new body?
   virtual NullablePtr<ASTScopeImpl> getParentOfASTAncestorScopesToBeRescued();
   std::vector<ASTScopeImpl *>
@@ -549,11 +554,32 @@ public:
   ScopeCreator *const scopeCreator;
   ASTScopeImpl *insertionPoint;
 
-  /// The number of \c Decls in the \c SourceFile that were already seen.
-  /// Since parsing can be interleaved with type-checking, on every
-  /// lookup, look at creating scopes for any \c Decls beyond this number.
+  /// A record of one top-level declaration whose scopes were already
+  /// created, fingerprinted so that an edit which replaces the declaration
+  /// can be detected and the tree rolled back to just before it, leaving
+  /// the scopes of unchanged siblings intact.
+  struct TopLevelDeclRecord {
+    /// The declaration, with its source range at expansion time; together
+    /// they fingerprint the scopes created for it.
+    Decl *decl;
+    SourceRange rangeWhenExpanded;
+
+    /// Where the declaration's scopes were inserted, and how many children
+    /// the insertion point had beforehand, so the insertion can be undone.
+    ASTScopeImpl *insertionPointBeforehand;
+    unsigned numChildrenBeforehand;
+
+    bool matches(const Decl *d) const {
+      return d == decl && d->getSourceRange() == rangeWhenExpanded;
+    }
+  };
+
+  /// The \c Decls in the \c SourceFile whose scopes were already created,
+  /// in source order. Since parsing can be interleaved with type-checking,
+  /// on every lookup, look at creating scopes for any \c Decls beyond
+  /// these.
   /// TODO: Unify with numberOfChildrenWhenLastExpanded
-  size_t numberOfDeclsAlreadySeen = 0;
+  SmallVector<TopLevelDeclRecord, 0> topLevelDeclsAlreadySeen;
 
   ASTSourceFileScope(SourceFile *SF, ScopeCreator *scopeCreator);
 
@@ -583,6 +609,15 @@ protected:
   void beCurrent() override;
   bool doesExpansionOnlyAddNewDeclsAtEnd() const override;
 
+private:
+  /// Remove the scopes created for every already-seen declaration from
+  /// \p firstChanged onwards, restoring the insertion point to what it was
+  /// just before that declaration was expanded. Returns false if the tree
+  /// diverged from the records and everything had to be rebuilt instead.
+  bool rollBackScopesForChangedDecls(unsigned firstChanged,
+                                     ScopeCreator &scopeCreator);
+
+protected:
   ScopeCreator &getScopeCreator() override;
 
 private:
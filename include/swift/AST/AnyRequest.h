@@ -161,6 +161,9 @@ private:
   const void *getRawStorage() const { return asDerived().getRawStorage(); }
 
 public:
+  /// Retrieve the type ID of the underlying request.
+  uint64_t getTypeID() const { return getVTable()->typeID; }
+
   /// Cast to a specific (known) type.
   template<typename Request>
   const Request &castTo() const {
@@ -6074,6 +6074,15 @@ public:
     Bits.AbstractFunctionDecl.Synthesized = value;
   }
 
+  /// Record a fingerprint for this function's delayed or skipped body
+  /// (xxHash64 of the body byte range). Phases that re-visit the file later
+  /// can compare fingerprints to prove a body unchanged without re-lexing it.
+  void setBodyFingerprint(uint64_t fingerprint);
+
+  /// Retrieve the fingerprint recorded for this function's delayed or skipped
+  /// body, if any.
+  Optional<uint64_t> getBodyFingerprint() const;
+
 public:
   /// Retrieve the source range of the function body.
   SourceRange getBodySourceRange() const;
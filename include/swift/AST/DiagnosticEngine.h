@@ -691,6 +691,13 @@ namespace swift {
     /// hadAnyError - return true if any *error* diagnostics have been emitted.
     bool hadAnyError() const { return state.hadAnyError(); }
 
+    /// The number of diagnostics currently deferred to the end of the
+    /// outermost open transaction. Lets code running inside a transaction
+    /// detect whether anything was diagnosed while it was open.
+    unsigned getTentativeDiagnosticCount() const {
+      return TentativeDiagnostics.size();
+    }
+
     bool hasFatalErrorOccurred() const {
       return state.hasFatalErrorOccurred();
     }
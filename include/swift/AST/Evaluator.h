@@ -20,6 +20,7 @@
 
 #include "swift/AST/AnyRequest.h"
 #include "swift/AST/EvaluatorDependencies.h"
+#include "swift/AST/RequestCache.h"
 #include "swift/Basic/AnyValue.h"
 #include "swift/Basic/Debug.h"
 #include "swift/Basic/Defer.h"
@@ -217,8 +218,11 @@ class Evaluator {
   /// is treated as a stack and is used to detect cycles.
   llvm::SetVector<ActiveRequest> activeRequests;
 
-  /// A cache that stores the results of requests.
-  llvm::DenseMap<AnyRequest, AnyValue> cache;
+  /// The per-request-kind caches that store the results of requests, keyed
+  /// by each request's type ID. Each entry owns a typed, open-addressed
+  /// table, so a cached lookup hashes the concrete request directly rather
+  /// than going through AnyRequest's type-erased hashing.
+  llvm::DenseMap<uint64_t, evaluator::PerRequestCache> requestCaches;
 
   /// Track the dependencies of each request.
   ///
@@ -276,6 +280,16 @@ class Evaluator {
     return reinterpret_cast<RequestFunction<Request> *>(abstractFn);
   }
 
+  /// Retrieve the typed result cache for the given request kind, creating
+  /// it if necessary.
+  template<typename Request>
+  evaluator::RequestCacheMap<Request> &getRequestCache() {
+    auto &entry = requestCaches[TypeID<Request>::value];
+    if (entry.isNull())
+      entry = evaluator::PerRequestCache::make<Request>();
+    return entry.template get<Request>();
+  }
+
 public:
   /// Construct a new evaluator that can emit cyclic-dependency
   /// diagnostics through the given diagnostics engine.
@@ -349,14 +363,18 @@ public:
            typename std::enable_if<!Request::hasExternalCache>::type* = nullptr>
   void cacheOutput(const Request &request,
                    typename Request::OutputType &&output) {
-    cache.insert({AnyRequest(request), std::move(output)});
+    getRequestCache<Request>().insert(
+        {evaluator::CacheKey<Request>(request), std::move(output)});
   }
 
   /// Clear the cache stored within this evaluator.
   ///
   /// Note that this does not clear the caches of requests that use external
   /// caching.
-  void clearCache() { cache.clear(); }
+  void clearCache() {
+    for (auto &entry : requestCaches)
+      entry.second.clear();
+  }
 
   /// Is the given request, or an equivalent, currently being evaluated?
   template <typename Request>
@@ -446,9 +464,10 @@ private:
   llvm::Expected<typename Request::OutputType>
   getResultCached(const Request &request) {
     // If we already have an entry for this request in the cache, return it.
+    auto &cache = getRequestCache<Request>();
     auto known = cache.find_as(request);
     if (known != cache.end()) {
-      auto r = known->second.template castTo<typename Request::OutputType>();
+      auto r = known->second;
       reportEvaluatedResult<Request>(request, r);
       return r;
     }
@@ -458,8 +477,10 @@ private:
     if (!result)
       return result;
 
-    // Cache the result.
-    cache.insert({AnyRequest(request), *result});
+    // Cache the result. The reference to the typed cache is still valid
+    // here: the table itself is heap-allocated, even if evaluating the
+    // request created caches for other request kinds.
+    cache.insert({evaluator::CacheKey<Request>(request), *result});
     return result;
   }
 
@@ -520,6 +541,11 @@ public:
   }
 
 public:
+  /// Print the cached value for the given request, if there is one, in the
+  /// form " -> <escaped value>".
+  void printCachedValue(const AnyRequest &request,
+                        llvm::raw_ostream &out) const;
+
   /// Print the dependencies of the given request as a tree.
   ///
   /// This is the core printing operation; most callers will want to use
@@ -48,10 +48,12 @@ private:
   void addAllDefinedDeclsOfAGivenType(std::vector<ContentsT> &contentsVec);
 
   /// At present, only nominals, protocols, and extensions have (body)
-  /// fingerprints
+  /// fingerprints. A nominal's fingerprint also covers the bodies of its
+  /// extensions in this file, so that a change inside an extension dirties
+  /// the nodes of the extended nominal.
   static Optional<std::string>
   getFingerprintIfAny(std::pair<const NominalTypeDecl *, const ValueDecl *>);
-  static Optional<std::string> getFingerprintIfAny(const Decl *d);
+  Optional<std::string> getFingerprintIfAny(const Decl *d) const;
 };
 
 } // namespace fine_grained_dependencies
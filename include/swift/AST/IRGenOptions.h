@@ -71,6 +71,12 @@ enum class IRGenEmbedMode : unsigned {
   EmbedBitcode
 };
 
+enum class IRGenLLVMLTOKind : unsigned {
+  None,
+  Thin,
+  Full,
+};
+
 using clang::PointerAuthSchema;
 
 struct PointerAuthOptions : clang::PointerAuthOptions {
@@ -220,6 +226,11 @@ public:
   /// Whether we should embed the bitcode file.
   IRGenEmbedMode EmbedMode : 2;
 
+  /// The LLVM LTO mode to emit for. In the thin and full modes, each
+  /// frontend job writes (summarized) bitcode into its object file output
+  /// and the linker performs the (thin-)link.
+  IRGenLLVMLTOKind LLVMLTOKind : 2;
+
   /// Add names to LLVM values.
   unsigned HasValueNamesSetting : 1;
   unsigned ValueNames : 1;
@@ -321,6 +332,7 @@ public:
         DisableSwiftSpecificLLVMOptzns(false), DisableLLVMSLPVectorizer(false),
         DisableFPElim(true), Playground(false), EmitStackPromotionChecks(false),
         FunctionSections(false), PrintInlineTree(false), EmbedMode(IRGenEmbedMode::None),
+        LLVMLTOKind(IRGenLLVMLTOKind::None),
         HasValueNamesSetting(false), ValueNames(false),
         EnableReflectionMetadata(true), EnableReflectionNames(true),
         EnableAnonymousContextMangledNames(false), ForcePublicLinkage(false),
@@ -345,7 +357,8 @@ public:
        << 'd' << DisableLLVMOptzns
        << 'D' << DisableSwiftSpecificLLVMOptzns
        << 'p' << GenerateProfile
-       << 's' << Sanitizers.toRaw();
+       << 's' << Sanitizers.toRaw()
+       << 'l' << (unsigned)LLVMLTOKind;
   }
 
   /// Should LLVM IR value names be emitted and preserved?
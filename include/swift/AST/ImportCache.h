@@ -19,6 +19,7 @@
 #define SWIFT_AST_IMPORT_CACHE_H
 
 #include "swift/AST/Module.h"
+#include "llvm/ADT/BitVector.h"
 #include "llvm/ADT/DenseMap.h"
 #include "llvm/ADT/FoldingSet.h"
 
@@ -114,6 +115,15 @@ class alignas(ModuleDecl::ImportedModule) ImportCache {
                             const DeclContext *>,
                  ArrayRef<ModuleDecl::AccessPathTy>> ShadowCache;
 
+  /// Dense indices assigned to modules in the order the cache first sees
+  /// them, used to represent import sets as bitsets.
+  llvm::DenseMap<const ModuleDecl *, unsigned> ModuleIndices;
+
+  /// For each known import set, a bitset over the dense module indices of
+  /// every module in the set, so membership queries are single bit tests
+  /// instead of walks over the transitive imports.
+  llvm::DenseMap<const ImportSet *, llvm::BitVector> ImportBitsets;
+
   ModuleDecl::AccessPathTy EmptyAccessPath;
 
   ArrayRef<ModuleDecl::AccessPathTy> allocateArray(
@@ -123,6 +133,9 @@ class alignas(ModuleDecl::ImportedModule) ImportCache {
   ImportSet &getImportSet(ASTContext &ctx,
                           ArrayRef<ModuleDecl::ImportedModule> topLevelImports);
 
+  unsigned getModuleIndex(const ModuleDecl *mod);
+  const llvm::BitVector &getImportBitset(const ImportSet &imports);
+
 public:
   ImportCache() {}
 
@@ -135,10 +148,10 @@ public:
   ArrayRef<ModuleDecl::AccessPathTy>
   getAllVisibleAccessPaths(const ModuleDecl *mod, const DeclContext *dc);
 
-  bool isImportedBy(const ModuleDecl *mod,
-                    const DeclContext *dc) {
-    return !getAllVisibleAccessPaths(mod, dc).empty();
-  }
+  /// Returns whether 'mod' is visible from 'dc', including transitively,
+  /// via re-exports. Cheaper than getAllVisibleAccessPaths() when the
+  /// access paths themselves are not needed.
+  bool isImportedBy(const ModuleDecl *mod, const DeclContext *dc);
 
   /// Returns all access paths in 'mod' that are visible from 'dc' if we
   /// subtract imports of 'other'.
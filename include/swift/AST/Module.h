@@ -248,6 +248,17 @@ private:
   std::unique_ptr<SourceLookupCache> Cache;
   SourceLookupCache &getSourceLookupCache() const;
 
+  /// A helper class to sneak around C++ access control rules.
+  class Impl;
+
+  /// Memoizes module-level operator and precedence group lookups, which
+  /// merge results across every file and re-exported import of this module
+  /// and would otherwise be recomputed by each file that queries a name.
+  /// The key pairs the name with the kind of decl being looked up; a \c None
+  /// value records a lookup that failed with an ambiguity.
+  llvm::SmallDenseMap<std::pair<Identifier, unsigned>, Optional<Decl *>, 8>
+      OperatorLookupCache;
+
   /// Tracks the file that will generate the module's entry point, either
   /// because it contains a class marked with \@UIApplicationMain
   /// or \@NSApplicationMain, or because it is a script file.
@@ -0,0 +1,189 @@
+//===--- RequestCache.h - Per-Request-Kind Result Caches --------*- C++ -*-===//
+//
+// This source file is part of the Swift.org open source project
+//
+// Copyright (c) 2020 Apple Inc. and the Swift project authors
+// Licensed under Apache License v2.0 with Runtime Library Exception
+//
+// See https://swift.org/LICENSE.txt for license information
+// See https://swift.org/CONTRIBUTORS.txt for the list of Swift project authors
+//
+//===----------------------------------------------------------------------===//
+//
+//  This file defines the typed, per-request-kind result caches used by the
+//  Evaluator class. Each request kind gets its own flat, open-addressed
+//  table keyed by the concrete request type, so cache lookups hash the
+//  request directly instead of going through AnyRequest's type-erased
+//  hashing and per-entry heap allocation.
+//
+//===----------------------------------------------------------------------===//
+
+#ifndef SWIFT_AST_REQUESTCACHE_H
+#define SWIFT_AST_REQUESTCACHE_H
+
+#include "swift/AST/AnyRequest.h"
+#include "llvm/ADT/DenseMap.h"
+#include "llvm/ADT/Optional.h"
+
+namespace swift {
+
+namespace evaluator {
+
+/// Wraps a concrete request for use as the key of its typed result cache,
+/// adding the empty and tombstone states that an open-addressed table
+/// requires but request types do not provide.
+template <typename Request>
+class CacheKey {
+  friend struct llvm::DenseMapInfo<CacheKey<Request>>;
+
+  enum class Kind : uint8_t {
+    Normal,
+    Empty,
+    Tombstone,
+  };
+
+  Kind kind;
+
+  /// The wrapped request; present only for normal keys.
+  llvm::Optional<Request> request;
+
+  explicit CacheKey(Kind kind) : kind(kind) {}
+
+public:
+  explicit CacheKey(const Request &request)
+      : kind(Kind::Normal), request(request) {}
+};
+
+/// The typed result cache for a single request kind.
+template <typename Request>
+using RequestCacheMap =
+    llvm::DenseMap<CacheKey<Request>, typename Request::OutputType>;
+
+/// Type-erased ownership of the typed result cache for a single request
+/// kind. The underlying table is created lazily, the first time a request
+/// of the corresponding kind caches a result.
+class PerRequestCache {
+  void *storage;
+  void (*deleter)(void *);
+  void (*clearer)(void *);
+  bool (*printer)(void *, const AnyRequest &, llvm::raw_ostream &);
+
+  PerRequestCache(void *storage, void (*deleter)(void *),
+                  void (*clearer)(void *),
+                  bool (*printer)(void *, const AnyRequest &,
+                                  llvm::raw_ostream &))
+      : storage(storage), deleter(deleter), clearer(clearer),
+        printer(printer) {}
+
+public:
+  PerRequestCache()
+      : storage(nullptr), deleter(nullptr), clearer(nullptr),
+        printer(nullptr) {}
+
+  PerRequestCache(PerRequestCache &&other)
+      : storage(other.storage), deleter(other.deleter),
+        clearer(other.clearer), printer(other.printer) {
+    other.storage = nullptr;
+  }
+
+  PerRequestCache &operator=(PerRequestCache &&other) {
+    if (&other != this) {
+      this->~PerRequestCache();
+      new (this) PerRequestCache(std::move(other));
+    }
+    return *this;
+  }
+
+  PerRequestCache(const PerRequestCache &) = delete;
+  PerRequestCache &operator=(const PerRequestCache &) = delete;
+
+  /// Create the cache for the given request kind.
+  template <typename Request>
+  static PerRequestCache make() {
+    using Map = RequestCacheMap<Request>;
+    return PerRequestCache(
+        new Map(),
+        [](void *ptr) { delete static_cast<Map *>(ptr); },
+        [](void *ptr) { static_cast<Map *>(ptr)->clear(); },
+        [](void *ptr, const AnyRequest &key, llvm::raw_ostream &out) -> bool {
+          auto *request = key.getAs<Request>();
+          if (!request)
+            return false;
+
+          auto &map = *static_cast<Map *>(ptr);
+          auto known = map.find_as(*request);
+          if (known == map.end())
+            return false;
+
+          simple_display(out, known->second);
+          return true;
+        });
+  }
+
+  bool isNull() const { return !storage; }
+
+  template <typename Request>
+  RequestCacheMap<Request> &get() const {
+    assert(storage && "Retrieving a cache that was never created");
+    return *static_cast<RequestCacheMap<Request> *>(storage);
+  }
+
+  /// If a result is cached for the given type-erased request, print it to
+  /// \p out and return true.
+  bool printCachedValue(const AnyRequest &request,
+                        llvm::raw_ostream &out) const {
+    return storage && printer(storage, request, out);
+  }
+
+  void clear() {
+    if (storage)
+      clearer(storage);
+  }
+
+  ~PerRequestCache() {
+    if (storage)
+      deleter(storage);
+  }
+};
+
+} // end namespace evaluator
+
+} // end namespace swift
+
+namespace llvm {
+
+template <typename Request>
+struct DenseMapInfo<swift::evaluator::CacheKey<Request>> {
+  using CacheKey = swift::evaluator::CacheKey<Request>;
+
+  static inline CacheKey getEmptyKey() {
+    return CacheKey(CacheKey::Kind::Empty);
+  }
+  static inline CacheKey getTombstoneKey() {
+    return CacheKey(CacheKey::Kind::Tombstone);
+  }
+  static unsigned getHashValue(const CacheKey &key) {
+    assert(key.kind == CacheKey::Kind::Normal &&
+           "Hashing an empty or tombstone key");
+    return hash_value(*key.request);
+  }
+  static unsigned getHashValue(const Request &request) {
+    return hash_value(request);
+  }
+  static bool isEqual(const CacheKey &lhs, const CacheKey &rhs) {
+    if (lhs.kind != rhs.kind)
+      return false;
+    if (lhs.kind != CacheKey::Kind::Normal)
+      return true;
+    return *lhs.request == *rhs.request;
+  }
+  static bool isEqual(const Request &lhs, const CacheKey &rhs) {
+    if (rhs.kind != CacheKey::Kind::Normal)
+      return false;
+    return lhs == *rhs.request;
+  }
+};
+
+} // end namespace llvm
+
+#endif // SWIFT_AST_REQUESTCACHE_H
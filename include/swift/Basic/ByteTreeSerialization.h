@@ -229,13 +229,16 @@ private:
 
 public:
   /// Write a binary serialization of \p Object to \p StreamWriter, prefixing
-  /// the stream by the specified ProtocolVersion.
+  /// the stream by the specified ProtocolVersion. The serialization starts at
+  /// the stream's current end, so any bytes already in \p Stream (e.g. a
+  /// transport header) are left untouched.
   template <typename T>
   typename std::enable_if<has_ObjectTraits<T>::value, void>::type
   static write(ExponentialGrowthAppendingBinaryByteStream &Stream,
                uint32_t ProtocolVersion, const T &Object,
                UserInfoMap &UserInfo) {
     llvm::BinaryStreamWriter StreamWriter(Stream);
+    StreamWriter.setOffset(Stream.getLength());
     ByteTreeWriter Writer(Stream, StreamWriter, UserInfo);
 
     auto Error = Writer.writeInteger(ProtocolVersion);
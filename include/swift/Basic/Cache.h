@@ -128,8 +128,27 @@ protected:
   /// Invokes \c remove on all keys.
   void removeAll();
 
+  /// Sets the maximum total cost of the values this cache will retain.  When
+  /// an insertion pushes the cache past its budget, least-recently-used
+  /// entries are evicted until it fits again.  A limit of zero (the default)
+  /// leaves the cache unbounded.
+  ///
+  /// This is a no-op on Darwin, where the system cache implementation sizes
+  /// itself and evicts in response to memory pressure on its own.
+  void setCostLimit(size_t Limit);
+
   /// Destroys cache.
   void destroy();
+
+public:
+  /// Evicts least-recently-used entries from every cache in the process until
+  /// each retains at most \p Fraction of its current total cost and entry
+  /// count.  Intended to be invoked from a memory-pressure handler; a
+  /// fraction of zero empties all caches.
+  ///
+  /// This is a no-op on Darwin, where the system cache implementation
+  /// registers for memory-pressure notifications itself.
+  static void trimAllCaches(double Fraction);
 };
 
 /// Caching mechanism, that is thread-safe and can evict its entries when there
@@ -192,6 +211,12 @@ public:
     removeAll();
   }
 
+  /// Caps the total cost of the values this cache retains; see
+  /// \c CacheImpl::setCostLimit().
+  void setCostLimit(size_t Limit) {
+    CacheImpl::setCostLimit(Limit);
+  }
+
 private:
   static uintptr_t keyHash(void *Key, void *UserData) {
     return KeyInfoT::getHashValue(*static_cast<KeyT*>(Key));
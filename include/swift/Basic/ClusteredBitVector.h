@@ -114,7 +114,19 @@ public:
 
   /// Add the low N bits from the given value to the vector.
   void add(size_t numBits, uint64_t value) {
-    append(fromAPInt(APInt(numBits, value)));
+    if (numBits == 0) {
+      return;
+    }
+    if (!Bits) {
+      Bits = APInt(numBits, value);
+      return;
+    }
+    // An APInt of 64 bits or fewer lives in its inline storage, so this
+    // temporary never allocates in practice.
+    APInt &v = Bits.getValue();
+    unsigned w = v.getBitWidth();
+    v = v.zext(w + numBits);
+    v.insertBits(APInt(numBits, value), w);
   }
 
   /// Append a number of clear bits to this vector.
@@ -268,11 +280,8 @@ public:
     if (numBits == 0) {
       return ClusteredBitVector();
     }
-    auto vec = APInt::getNullValue(numBits);
-    if (value) {
-      vec.flipAllBits();
-    }
-    return ClusteredBitVector(vec);
+    return ClusteredBitVector(value ? APInt::getAllOnesValue(numBits)
+                                    : APInt::getNullValue(numBits));
   }
 
   /// Pretty-print the vector.
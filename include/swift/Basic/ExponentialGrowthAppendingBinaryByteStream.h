@@ -11,8 +11,8 @@
 //===----------------------------------------------------------------------===//
 //
 /// Defines an \c llvm::WritableBinaryStream whose internal buffer grows
-/// exponentially in size as data is written to it. It is thus more efficient
-/// than llvm::AppendingBinaryByteStream if a lot of small data gets appended to
+/// as data is written to it. It is thus more efficient than
+/// llvm::AppendingBinaryByteStream if a lot of small data gets appended to
 /// it.
 ///
 //===----------------------------------------------------------------------===//
@@ -22,19 +22,62 @@
 
 #include "swift/Basic/LLVM.h"
 #include "llvm/ADT/ArrayRef.h"
+#include "llvm/Support/Allocator.h"
 #include "llvm/Support/BinaryByteStream.h"
+#include <memory>
+#include <vector>
 
 namespace swift {
 
 /// An implementation of WritableBinaryStream which can write at its end
 /// causing the underlying data to grow.  This class owns the underlying data.
+///
+/// While nothing has required the stream's contents to be contiguous, the
+/// data lives in a list of fixed-size chunks, so appending never copies what
+/// has already been written.  The first call to \c data() flattens the
+/// stream into a single buffer and it stays flat from then on; callers that
+/// only need the bytes shipped somewhere can avoid flattening entirely by
+/// using \c writeTo() or \c takeData().
 class ExponentialGrowthAppendingBinaryByteStream
     : public llvm::WritableBinaryStream {
-  /// The buffer holding the data.
-  SmallVector<uint8_t, 0> Data;
+  /// The size of each chunk. Must be a power of two.
+  static constexpr size_t ChunkSize = 32 * 1024;
+
+  /// The chunks holding the data while the stream has not been flattened.
+  /// Every chunk is \c ChunkSize bytes; \c StreamLength determines how much
+  /// of the last one is in use.
+  std::vector<std::unique_ptr<uint8_t[]>> Chunks;
+
+  /// The buffer holding the data once the stream has been flattened.
+  SmallVector<uint8_t, 0> FlatData;
+
+  /// Whether the data lives in \c FlatData rather than \c Chunks.
+  bool IsFlat = false;
+
+  /// The length of the stream, in either representation.
+  size_t StreamLength = 0;
+
+  /// Owns stable copies handed out for reads that straddle a chunk
+  /// boundary, in the same way llvm::MappedBlockStream keeps discontiguous
+  /// reads alive.
+  llvm::BumpPtrAllocator StraddleCopies;
 
   /// Data in the stream is always encoded in little-endian byte order.
   const llvm::support::endianness Endian = llvm::support::endianness::little;
+
+  /// Makes sure the stream can hold \p RequiredSize bytes and extends
+  /// \c StreamLength accordingly. Only used while the stream is chunked.
+  void ensureCapacity(size_t RequiredSize);
+
+  /// Copies \p Buffer into the chunks starting at \p Offset, splitting it
+  /// across chunk boundaries as needed. The capacity must already exist.
+  void copyIntoChunks(size_t Offset, ArrayRef<uint8_t> Buffer);
+
+  /// Collapses the chunks into \c FlatData. Afterwards the stream stays
+  /// flat, so references into \c FlatData remain stable across writes the
+  /// same way they did when this class was backed by a single buffer.
+  void flatten();
+
 public:
   ExponentialGrowthAppendingBinaryByteStream() = default;
 
@@ -48,9 +91,30 @@ public:
   llvm::Error readLongestContiguousChunk(uint32_t Offset,
                                          ArrayRef<uint8_t> &Buffer) override;
 
-  MutableArrayRef<uint8_t> data() { return Data; }
+  /// Returns the stream's contents as a single contiguous buffer,
+  /// materializing it if necessary.
+  MutableArrayRef<uint8_t> data() {
+    flatten();
+    return FlatData;
+  }
+
+  /// Move the stream's underlying buffer out of the stream. The stream is
+  /// empty afterwards. This allows handing the serialized bytes to a consumer
+  /// without copying them again.
+  SmallVector<uint8_t, 0> takeData() {
+    flatten();
+    SmallVector<uint8_t, 0> Result = std::move(FlatData);
+    FlatData.clear();
+    StreamLength = 0;
+    IsFlat = false;
+    return Result;
+  }
+
+  /// Writes the stream's contents to \p OS chunk by chunk, without ever
+  /// materializing them contiguously.
+  void writeTo(llvm::raw_ostream &OS) const;
 
-  uint32_t getLength() override { return Data.size(); }
+  uint32_t getLength() override { return StreamLength; }
 
   llvm::Error writeBytes(uint32_t Offset, ArrayRef<uint8_t> Buffer) override;
 
@@ -63,15 +127,31 @@ public:
       return Error;
     }
 
-    // Resize the internal buffer if needed.
-    uint32_t RequiredSize = Offset + sizeof(T);
-    if (RequiredSize > Data.size()) {
-      Data.resize(RequiredSize);
+    if (IsFlat) {
+      // Resize the internal buffer if needed.
+      uint32_t RequiredSize = Offset + sizeof(T);
+      if (RequiredSize > FlatData.size()) {
+        FlatData.resize(RequiredSize);
+        StreamLength = RequiredSize;
+      }
+      llvm::support::endian::write<T, llvm::support::unaligned>(
+        FlatData.data() + Offset, Value, Endian);
+      return llvm::Error::success();
     }
 
-    llvm::support::endian::write<T, llvm::support::unaligned>(
-      Data.data() + Offset, Value, Endian);
-
+    ensureCapacity(Offset + sizeof(T));
+    size_t Within = Offset & (ChunkSize - 1);
+    if (LLVM_LIKELY(Within + sizeof(T) <= ChunkSize)) {
+      llvm::support::endian::write<T, llvm::support::unaligned>(
+        Chunks[Offset / ChunkSize].get() + Within, Value, Endian);
+    } else {
+      // The value straddles a chunk boundary; render it and let
+      // copyIntoChunks split it.
+      uint8_t Bytes[sizeof(T)];
+      llvm::support::endian::write<T, llvm::support::unaligned>(Bytes, Value,
+                                                                Endian);
+      copyIntoChunks(Offset, Bytes);
+    }
     return llvm::Error::success();
   }
 
@@ -76,11 +76,31 @@ namespace swift {
   areFilesDifferent(const llvm::Twine &source, const llvm::Twine &destination,
                     bool allowDestinationErrors);
 
+  /// Copies the file at \p source to \p destination, replacing any file that
+  /// is already there. On file systems that support it (APFS via clonefile,
+  /// Linux via the FICLONE ioctl on btrfs/XFS and friends) the data blocks
+  /// are cloned copy-on-write instead of being duplicated; otherwise this
+  /// falls back to an ordinary copy.
+  std::error_code copyFileCloning(const llvm::Twine &source,
+                                  const llvm::Twine &destination);
+
   namespace vfs {
     llvm::ErrorOr<std::unique_ptr<llvm::MemoryBuffer>>
     getFileOrSTDIN(llvm::vfs::FileSystem &FS,
                    const llvm::Twine &Name, int64_t FileSize = -1,
                    bool RequiresNullTerminator = true, bool IsVolatile = false);
+
+    /// Open \p Name through \p FS, sharing one read-only (typically
+    /// memory-mapped) buffer per on-disk file across callers.
+    ///
+    /// The returned buffer is a zero-copy view of a process-wide cache entry
+    /// keyed by path and validated against the file's size and modification
+    /// time; the view keeps the underlying mapping alive, and a stale entry
+    /// is replaced when the file changes on disk. Intended for clients like
+    /// SourceKit that open the same large sources in many CompilerInstances
+    /// and would otherwise duplicate them in memory.
+    llvm::ErrorOr<std::unique_ptr<llvm::MemoryBuffer>>
+    getSharedBufferForFile(llvm::vfs::FileSystem &FS, const llvm::Twine &Name);
   } // end namespace vfs
 
 } // end namespace swift
@@ -406,7 +406,7 @@ public:
          bool PrettyPrint = true)
       : Stream(os), PrettyPrint(PrettyPrint), NeedBitValueComma(false),
         EnumerationMatchFound(false), UserInfo(UserInfo) {}
-  virtual ~Output() = default;
+  ~Output() = default;
 
   UserInfoMap &getUserInfo() {
     return UserInfo;
@@ -434,6 +434,12 @@ public:
   void scalarString(StringRef &, bool);
   void null();
 
+  /// The underlying output stream, for formatting scalars that never require
+  /// quoting directly into the output without a temporary buffer.  Any
+  /// necessary separators have already been emitted by the preflight methods
+  /// by the time a scalar is written.
+  llvm::raw_ostream &scalarStream() { return Stream; }
+
   template <typename T>
   void enumCase(T &Val, const char* Str, const T ConstVal) {
     if (matchEnumScalar(Str, Val == ConstVal)) {
@@ -662,7 +668,20 @@ jsonize(Output &out, T &Val, bool) {
 
 
 template<typename T>
-typename std::enable_if<has_ScalarTraits<T>::value,void>::type
+typename std::enable_if<has_ScalarTraits<T>::value &&
+                            std::is_arithmetic<T>::value,
+                        void>::type
+jsonize(Output &out, T &Val, bool) {
+  // All of the arithmetic scalar traits are defined in this header and never
+  // quote their output, so the value can be formatted straight into the
+  // output stream instead of through a temporary buffer.
+  ScalarTraits<T>::output(Val, out.scalarStream());
+}
+
+template<typename T>
+typename std::enable_if<has_ScalarTraits<T>::value &&
+                            !std::is_arithmetic<T>::value,
+                        void>::type
 jsonize(Output &out, T &Val, bool) {
   {
     SmallString<64> Storage;
@@ -531,6 +531,15 @@ namespace swift {
     /// Disable the shrink phase of the expression type checker.
     bool SolverDisableShrink = false;
 
+    /// Dump allocation statistics for the constraint solver arena whenever
+    /// one is torn down.
+    bool SolverArenaStats = false;
+
+    /// If non-empty, the path of a file in which operator overload success
+    /// frequencies are persisted across compiles and used to order
+    /// disjunction choices.
+    std::string SolverOverloadProfilePath;
+
     /// Enable experimental operator designated types feature.
     bool EnableOperatorDesignatedTypes = false;
     
@@ -214,12 +214,12 @@ private:
     while (Node * const cur = *next) {
       KeyType curKey = cur->getLocalKey();
 
-      // Compare the lookup key with the stored key in the node.
+      // Compare the lookup key with the stored key in the node.  Finding
+      // the common prefix in bulk lets the compiler vectorize the
+      // comparison for byte-sized key elements.
       size_t len = std::min(curKey.size(), lookupKey.size());
-      size_t i = 0;
-      for (; i != len; ++i) {
-         if (lookupKey[i] != curKey[i]) break;
-      }
+      size_t i = std::mismatch(lookupKey.begin(), lookupKey.begin() + len,
+                               curKey.begin()).first - lookupKey.begin();
 
       // If we didn't reach the end of the common length, then we have two
       // basic cases:
@@ -347,9 +347,9 @@ private:
       if (copy->Right) stack.push_back(&copy->Right);
       if (copy->Further) stack.push_back(&copy->Further);
     };
-    copyAndEnqueueChildren(&root);
+    copyAndPushChildren(&root);
     while (!stack.empty()) {
-      copyAndEnqueueChildren(stack.pop_back_val());
+      copyAndPushChildren(stack.pop_back_val());
     }
     return root;
   }
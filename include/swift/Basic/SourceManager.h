@@ -20,6 +20,7 @@
 #include "llvm/ADT/StringMap.h"
 #include "llvm/Support/SourceMgr.h"
 #include <map>
+#include <vector>
 
 namespace swift {
 
@@ -48,6 +49,15 @@ class SourceManager {
   std::map<const char *, VirtualFile> VirtualFiles;
   mutable std::pair<const char *, const VirtualFile*> CachedVFile = {nullptr, nullptr};
 
+  /// The byte offset of every newline in each buffer, computed on the first
+  /// line query for that buffer. Line and column lookups binary search this
+  /// instead of rescanning the buffer per query.
+  mutable llvm::DenseMap<unsigned, std::vector<unsigned>> NewlineOffsetsCache;
+
+  /// Returns the (sorted) newline offsets for \p BufferID, scanning the
+  /// buffer on the first request.
+  ArrayRef<unsigned> getNewlineOffsets(unsigned BufferID) const;
+
   Optional<unsigned> findBufferContainingLocInternal(SourceLoc Loc) const;
 public:
   SourceManager(llvm::IntrusiveRefCntPtr<llvm::vfs::FileSystem> FS =
@@ -206,24 +216,14 @@ public:
   ///
   /// This respects \c #sourceLocation directives.
   std::pair<unsigned, unsigned>
-  getLineAndColumn(SourceLoc Loc, unsigned BufferID = 0) const {
-    assert(Loc.isValid());
-    int LineOffset = getLineOffset(Loc);
-    int l, c;
-    std::tie(l, c) = LLVMSourceMgr.getLineAndColumn(Loc.Value, BufferID);
-    assert(LineOffset+l > 0 && "bogus line offset");
-    return { LineOffset + l, c };
-  }
+  getLineAndColumn(SourceLoc Loc, unsigned BufferID = 0) const;
 
   /// Returns the real line number for a source location.
   ///
   /// If \p BufferID is provided, \p Loc must come from that source buffer.
   ///
   /// This does not respect \c #sourceLocation directives.
-  unsigned getLineNumber(SourceLoc Loc, unsigned BufferID = 0) const {
-    assert(Loc.isValid());
-    return LLVMSourceMgr.FindLineNumber(Loc.Value, BufferID);
-  }
+  unsigned getLineNumber(SourceLoc Loc, unsigned BufferID = 0) const;
 
   StringRef getEntireTextForBuffer(unsigned BufferID) const;
 
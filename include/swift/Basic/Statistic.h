@@ -123,6 +123,19 @@ public:
     const TraceFormatter *Formatter;
   };
 
+  /// A balanced begin/end marker for one FrontendStatsTracer. Kept separately
+  /// from FrontendStatsEvent — which only records nonzero counter deltas — so
+  /// the tracer hierarchy can be replayed verbatim as a Chrome trace-event
+  /// flame graph.
+  struct FrontendStatsTraceMarker
+  {
+    uint64_t TimeUSec;
+    bool IsEntry;
+    StringRef EventName;
+    const void *Entity;
+    const TraceFormatter *Formatter;
+  };
+
   // We only write fine-grained trace entries when the user passed
   // -trace-stats-events, but we recycle the same FrontendStatsTracers to give
   // us some free recursion-save phase timings whenever -trace-stats-dir is
@@ -143,6 +156,7 @@ private:
   long maxChildRSS = 0;
   SmallString<128> StatsFilename;
   SmallString<128> TraceFilename;
+  SmallString<128> ChromeTraceFilename;
   SmallString<128> ProfileDirname;
   llvm::TimeRecord StartedTime;
   std::thread::id MainThreadID;
@@ -156,6 +170,7 @@ private:
   Optional<AlwaysOnFrontendCounters> FrontendCounters;
   Optional<AlwaysOnFrontendCounters> LastTracedFrontendCounters;
   Optional<std::vector<FrontendStatsEvent>> FrontendStatsEvents;
+  Optional<std::vector<FrontendStatsTraceMarker>> FrontendStatsTraceMarkers;
 
   // These are unique_ptr so we can use incomplete types here.
   std::unique_ptr<RecursionSafeTimers> RecursiveTimers;
@@ -221,6 +236,10 @@ public:
   StringRef EventName;
   const void *Entity;
   const UnifiedStatsReporter::TraceFormatter *Formatter;
+  /// Whether this tracer was pushed onto the always-on sampling profiler's
+  /// stack (see CompileTimeSampler in Statistic.cpp) and so must pop it when
+  /// destroyed. Tracked per tracer so move semantics hand the pop over.
+  bool InSampler = false;
   FrontendStatsTracer();
   FrontendStatsTracer(FrontendStatsTracer&& other);
   FrontendStatsTracer& operator=(FrontendStatsTracer&&);
@@ -21,7 +21,18 @@ namespace unicode {
 
 StringRef extractFirstExtendedGraphemeCluster(StringRef S);
 
+/// Returns true if \p S consists entirely of printable ASCII characters
+/// (0x20 through 0x7E). Scans a machine word at a time.
+bool isAllPrintableASCII(StringRef S);
+
 static inline bool isSingleExtendedGraphemeCluster(StringRef S) {
+  if (S.empty())
+    return false;
+  // Fast path: printable ASCII characters are one extended grapheme cluster
+  // each and never combine with a neighbor, so no decoding or property
+  // lookups are needed.
+  if (isAllPrintableASCII(S))
+    return S.size() == 1;
   StringRef First = extractFirstExtendedGraphemeCluster(S);
   if (First.empty())
     return false;
@@ -20,6 +20,8 @@
 #define SWIFT_DEMANGLING_DEMANGLER_H
 
 #include "swift/Demangling/Demangle.h"
+#include <string>
+#include <unordered_map>
 
 //#define NODE_FACTORY_DEBUGGING
 
@@ -333,6 +335,48 @@ public:
   }
 };
 
+/// A cache of remangling results, keyed by a fingerprint of the node tree.
+///
+/// This is useful for clients which remangle the same node trees over and
+/// over, e.g. when repeatedly resolving mangled names to AST declarations.
+/// Key trees are deep-copied into an arena owned by the cache, so entries
+/// stay valid after the demangler which produced the original tree is
+/// cleared or destroyed. Lookups verify candidates with a deep node
+/// comparison; the fingerprint is only used to find them.
+///
+/// The cache can only be used for node trees without symbolic references,
+/// the same restriction as the resolver-less mangleNode().
+class ManglingCache {
+  struct Key {
+    NodePointer Root;
+    size_t Hash;
+  };
+
+  struct Hasher {
+    size_t operator()(const Key &key) const { return key.Hash; }
+  };
+
+  struct Equals {
+    bool operator()(const Key &lhs, const Key &rhs) const;
+  };
+
+  /// Owns the key trees.
+  NodeFactory Factory;
+
+  std::unordered_map<Key, std::string, Hasher, Equals> Entries;
+
+  static size_t deepHash(NodePointer node, size_t hash);
+  NodePointer deepCopy(NodePointer node);
+
+  friend std::string mangleNode(NodePointer root, ManglingCache &cache);
+
+public:
+  size_t size() const { return Entries.size(); }
+};
+
+/// Remangle a demangled parse tree, memoizing the result in \p cache.
+std::string mangleNode(NodePointer root, ManglingCache &cache);
+
 /// Kinds of symbolic reference supported.
 enum class SymbolicReferenceKind : uint8_t {
   /// A symbolic reference to a context descriptor, representing the
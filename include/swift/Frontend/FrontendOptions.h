@@ -85,6 +85,10 @@ public:
   /// If indexing system modules, don't index the stdlib.
   bool IndexIgnoreStdlib = false;
 
+  /// Compact the index store after emitting index data. Only safe when no
+  /// other compilation is writing to the store.
+  bool IndexStoreCompact = false;
+
   /// The module for which we should verify all of the generic signatures.
   std::string VerifyGenericSignaturesInModule;
 
@@ -106,6 +110,7 @@ public:
     DumpTypeRefinementContexts,
 
     EmitImportedModules, ///< Emit the modules that this one imports
+    ScanDependencies,    ///< Lex imports and emit the dependency graph
     EmitPCH,             ///< Emit PCH of imported bridging header
 
     EmitSILGen, ///< Emit raw SIL
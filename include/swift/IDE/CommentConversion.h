@@ -21,6 +21,10 @@ namespace swift {
 class Decl;
 class DocComment;
 
+namespace markup {
+class MarkupContext;
+}
+
 namespace ide {
 
 /// If the declaration has a documentation comment, prints the comment to \p OS
@@ -29,6 +33,13 @@ namespace ide {
 /// \returns true if the declaration has a documentation comment.
 bool getDocumentationCommentAsXML(const Decl *D, raw_ostream &OS);
 
+/// Variant of \c getDocumentationCommentAsXML that parses the comment with a
+/// caller-owned \p MC, so that clients converting many comments can reuse a
+/// single pooled context (resetting it between declarations) instead of
+/// allocating a fresh arena per declaration.
+bool getDocumentationCommentAsXML(const Decl *D, raw_ostream &OS,
+                                  swift::markup::MarkupContext &MC);
+
 /// If the declaration has a documentation comment and a localization key,
 /// print it into the given output stream and return true. Else, return false.
 bool getLocalizationKey(const Decl *D, raw_ostream &OS);
@@ -49,7 +49,9 @@ class CompletionInstance {
   /// specified completion request.
   /// Returns \c if the callback was called. Returns \c false if the compiler
   /// argument has changed, primary file is not the same, the \c Offset is not
-  /// in function bodies, or the interface hash of the file has changed.
+  /// in function bodies, or the interface of the file has changed in a way
+  /// the completion could observe. Member-level edits in types the completion
+  /// does not depend on keep the cached instance alive.
   bool performCachedOperationIfPossible(
       const swift::CompilerInvocation &Invocation, llvm::hash_code ArgsHash,
       llvm::MemoryBuffer *completionBuffer, unsigned int Offset,
@@ -198,6 +198,14 @@ public:
   ~SyntaxModelContext();
 
   bool walk(SyntaxModelWalker &Walker);
+
+  /// Like \c walk, but skips AST subtrees entirely outside \p Range.
+  ///
+  /// Token nodes are still passed for the whole file, so the nodes emitted
+  /// inside \p Range are identical to the ones a full walk produces there;
+  /// nodes outside it may be missing AST-derived refinements. Intended for
+  /// clients that rebuild their model for the edited region only.
+  bool walk(SyntaxModelWalker &Walker, CharSourceRange Range);
 };
 
 } // namespace ide
@@ -225,6 +225,9 @@ struct ResolvedLoc {
   LabelRangeType LabelType;
   bool IsActive;
   bool IsInSelector;
+  /// Whether the occurrence is inside a comment rather than the AST. Such
+  /// occurrences have a null \c Node.
+  bool IsInComment = false;
 };
 
 /// Used by NameMatcher to track parent CallExprs when walking a checked AST.
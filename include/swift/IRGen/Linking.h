@@ -1211,10 +1211,14 @@ public:
   static LinkInfo get(IRGenModule &IGM, const LinkEntity &entity,
                       ForDefinition_t forDefinition);
 
+  /// If \p mangledName is non-empty it is used as the entity's name instead
+  /// of mangling it again, allowing callers with an IRGenModule to reuse its
+  /// mangled-name cache.
   static LinkInfo get(const UniversalLinkageInfo &linkInfo,
                       ModuleDecl *swiftModule,
                       const LinkEntity &entity,
-                      ForDefinition_t forDefinition);
+                      ForDefinition_t forDefinition,
+                      StringRef mangledName = StringRef());
 
   static LinkInfo get(const UniversalLinkageInfo &linkInfo, StringRef name,
                       SILLinkage linkage, ForDefinition_t isDefinition,
@@ -19,6 +19,7 @@
 
 namespace swift {
 class DependencyTracker;
+class DiagnosticEngine;
 class ModuleDecl;
 class SourceFile;
 
@@ -84,6 +85,22 @@ bool indexAndRecord(ModuleDecl *module, ArrayRef<std::string> indexUnitTokens,
 // FIXME: indexUnitTokens could be StringRef, but that creates an impedance
 // mismatch in the caller.
 
+/// Compact the index store at \p indexStorePath in place.
+///
+/// Removes unit files whose main source file no longer exists on disk, then
+/// removes record files that are no longer referenced by any remaining unit.
+/// Record files are content-addressed, so identical record blobs are already
+/// shared between units; compaction reclaims the ones orphaned by removed or
+/// rewritten units.
+///
+/// This must not run concurrently with builds writing to the same store:
+/// records are written before the unit that references them, so a concurrent
+/// build's new records would look unreferenced. It is intended to be invoked
+/// from a dedicated job after builds complete.
+///
+/// \returns true if an error occurred.
+bool compactIndexStore(StringRef indexStorePath, DiagnosticEngine &diags);
+
 } // end namespace index
 } // end namespace swift
 
@@ -57,12 +57,30 @@ public:
     return StringRef(Result.data(), Result.size());
   }
 
+  /// Deallocate all memory owned by this context, invalidating any markup
+  /// AST nodes created with it.
+  ///
+  /// Long-lived clients can keep a single context and reset it between
+  /// requests instead of constructing a fresh one per comment; the largest
+  /// allocator slab is retained across resets.
+  void reset() {
+    Allocator.Reset();
+  }
+
   LineList getLineList(swift::RawComment RC);
 };
 
 Document *parseDocument(MarkupContext &MC, StringRef String);
 Document *parseDocument(MarkupContext &MC, LineList &LL);
 
+/// Parse only the brief of a documentation comment.
+///
+/// Returns the leading paragraph of \p LL, or \c nullptr if the comment does
+/// not start with a paragraph. Unlike \c parseDocument, no markup AST is
+/// materialized for anything past the first paragraph, which makes this
+/// considerably cheaper for brief-only clients on heavily documented symbols.
+Paragraph *parseDocumentBrief(MarkupContext &MC, LineList &LL);
+
 } // namespace markup
 } // namespace swift
 
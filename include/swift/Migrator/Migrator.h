@@ -18,15 +18,22 @@
 #define SWIFT_MIGRATOR_MIGRATOR_H
 
 #include "swift/Migrator/MigrationState.h"
+#include "swift/Migrator/MigratorOptions.h"
 #include "swift/Syntax/References.h"
 
 namespace swift {
 class CompilerInstance;
+class SourceFile;
 
 namespace migrator {
 
-/// If needed, run the migrator on the compiler invocation's input file and emit
-/// a "replacement map" describing the requested changes to the source file.
+/// If needed, run the migrator on each of the compiler invocation's primary
+/// input files and emit a "replacement map" describing the requested changes
+/// to each source file.
+///
+/// All primaries share \p Instance, so a batch-mode frontend job pays for
+/// loading the SDK modules and the initial type check only once, rather than
+/// once per file.
 /// \return true on error.
 bool updateCodeAndEmitRemapIfNeeded(CompilerInstance *Instance,
                                     const CompilerInvocation &Invocation);
@@ -39,11 +46,19 @@ struct SyntacticPassOptions {
 struct Migrator {
   CompilerInstance *StartInstance;
   const CompilerInvocation &StartInvocation;
+  /// The primary input this migrator is responsible for. A batch-mode
+  /// frontend job runs one Migrator per primary over the shared
+  /// StartInstance.
+  std::string InputFilename;
+  /// The options for this primary, with the output paths already
+  /// disambiguated from the other primaries in the job.
+  MigratorOptions Opts;
   SourceManager SrcMgr;
   std::vector<RC<MigrationState>> States;
 
   Migrator(CompilerInstance *StartInstance,
-           const CompilerInvocation &StartInvocation);
+           const CompilerInvocation &StartInvocation,
+           StringRef InputFilename, const MigratorOptions &Opts);
 
   /// The maximum number of times to run the compiler over the input to get
   /// fix-its. Nullability changes may expose other fix-its in subsequent
@@ -95,8 +110,11 @@ struct Migrator {
   /// Get the options for the Migrator.
   const MigratorOptions &getMigratorOptions() const;
 
-  /// Get the filename of the input given by this->StartInvocation.
+  /// Get the filename of the primary input this migrator is responsible for.
   const StringRef getInputFilename() const;
+
+  /// Get the StartInstance's primary source file for this migrator's input.
+  SourceFile *getPrimarySourceFile() const;
 };
 
 } // end namespace migrator
@@ -24,6 +24,7 @@ namespace swift {
 namespace syntax {
   enum class TriviaKind;
   struct Trivia;
+  class SyntaxArena;
 }
 
 class ParsedTriviaPiece {
@@ -61,6 +62,14 @@ public:
   static syntax::Trivia
   convertToSyntaxTrivia(ArrayRef<ParsedTriviaPiece> pieces, SourceLoc loc,
                         const SourceManager &SM, unsigned bufferID);
+
+  /// Like the overload above, but copies any trivia text into \p Arena so the
+  /// resulting pieces need no individual text ownership and can live in
+  /// arena-allocated \c RawSyntax nodes.
+  static syntax::Trivia
+  convertToSyntaxTrivia(ArrayRef<ParsedTriviaPiece> pieces, SourceLoc loc,
+                        const SourceManager &SM, unsigned bufferID,
+                        syntax::SyntaxArena &Arena);
 };
 
 using ParsedTriviaList = SmallVector<ParsedTriviaPiece, 3>;
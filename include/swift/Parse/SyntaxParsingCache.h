@@ -63,20 +63,32 @@ class SyntaxParsingCache {
   /// The IDs of all syntax nodes that got reused are collected in this vector.
   std::unordered_set<SyntaxNodeId> ReusedNodeIds;
 
+  /// Number of calls to \c lookUp.
+  size_t LookupCount = 0;
+
+  /// Number of calls to \c lookUp that returned a reusable node.
+  size_t HitCount = 0;
+
+  /// Total source bytes covered by reused nodes.
+  size_t ReusedBytes = 0;
+
 public:
   SyntaxParsingCache(SourceFileSyntax OldSyntaxTree)
       : OldSyntaxTree(OldSyntaxTree) {}
 
   /// Add an edit that transformed the source file which created this cache into
-  /// the source file that is now being parsed incrementally. \c Start must be a
-  /// position from the *original* source file, and it must not overlap any
-  /// other edits previously added. For instance, given:
+  /// the source file that is now being parsed incrementally. \c Start and
+  /// \c End are positions from the *original* source file. For instance, given:
   ///   (aaa, bbb)
   ///   0123456789
   /// When you want to turn this into:
   ///   (c, dddd)
   ///   0123456789
   /// edits should be: { 1, 4, 1 } and { 6, 9, 4 }.
+  ///
+  /// Edits may be added in any order; overlapping or adjacent edits are merged
+  /// into a single edit so that arbitrary multi-edit batches, as delivered by
+  /// editor integrations, can be replayed against the old tree.
   void addEdit(size_t Start, size_t End, size_t ReplacementLength);
 
   /// Check if a syntax node of the given kind at the given position can be
@@ -87,6 +99,24 @@ public:
     return ReusedNodeIds;
   }
 
+  /// Number of \c lookUp calls made against this cache.
+  size_t getLookupCount() const { return LookupCount; }
+
+  /// Number of \c lookUp calls that found a reusable node.
+  size_t getHitCount() const { return HitCount; }
+
+  /// Total number of source bytes covered by reused nodes.
+  size_t getReusedBytes() const { return ReusedBytes; }
+
+  /// The fraction (0.0 to 1.0) of the new file, whose length is
+  /// \p FileLength, that was covered by reused syntax nodes instead of being
+  /// reparsed.
+  double getReuseRatio(size_t FileLength) const {
+    if (FileLength == 0)
+      return 0.0;
+    return double(ReusedBytes) / double(FileLength);
+  }
+
   /// Get the source regions of the new source file, represented by
   /// \p SyntaxTree that have been reused as part of the incremental parse.
   std::vector<SyntaxReuseRegion>
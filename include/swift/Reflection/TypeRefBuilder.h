@@ -268,6 +268,24 @@ private:
   /// Cache for field info lookups.
   std::unordered_map<std::string, RemoteRef<FieldDescriptor>> FieldTypeInfoCache;
 
+  /// Cache for builtin type descriptor lookups.
+  std::unordered_map<std::string,
+                     RemoteRef<BuiltinTypeDescriptor>> BuiltinTypeInfoCache;
+
+  /// Cache for capture descriptor lookups, keyed by remote address.
+  std::unordered_map<uint64_t, RemoteRef<CaptureDescriptor>>
+    CaptureDescriptorCache;
+
+  /// The number of ReflectionInfos that have already been indexed into the
+  /// descriptor caches above.
+  size_t ProcessedReflectionInfos = 0;
+
+  /// Decode and index the descriptors of any reflection infos that have not
+  /// been indexed yet. Each image is processed exactly once, in one pass
+  /// over its sections, so lookup misses never rescan sections they have
+  /// already decoded.
+  void populateDescriptorCaches();
+
   TypeConverter TC;
   MetadataSourceBuilder MSB;
 
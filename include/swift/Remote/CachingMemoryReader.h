@@ -0,0 +1,163 @@
+//===--- CachingMemoryReader.h - Coalescing reader wrapper ------*- C++ -*-===//
+//
+// This source file is part of the Swift.org open source project
+//
+// Copyright (c) 2014 - 2017 Apple Inc. and the Swift project authors
+// Licensed under Apache License v2.0 with Runtime Library Exception
+//
+// See https://swift.org/LICENSE.txt for license information
+// See https://swift.org/CONTRIBUTORS.txt for the list of Swift project authors
+//
+//===----------------------------------------------------------------------===//
+//
+//  This file declares an implementation of MemoryReader that caches the
+//  memory of another reader at page granularity. Against a live process
+//  every read is a syscall round trip, and metadata walks issue very many
+//  small reads of nearby values; serving them from cached pages coalesces
+//  those probes into a few larger remote reads.
+//
+//===----------------------------------------------------------------------===//
+
+#ifndef SWIFT_REMOTE_CACHINGMEMORYREADER_H
+#define SWIFT_REMOTE_CACHINGMEMORYREADER_H
+
+#include "swift/Remote/MemoryReader.h"
+
+#include <unordered_map>
+#include <unordered_set>
+
+namespace swift {
+namespace remote {
+
+/// A MemoryReader which serves reads from a page-granular cache of another
+/// reader's memory.
+///
+/// The cache never expires on its own: it assumes the remote process is
+/// suspended, or at least that the memory being inspected is not mutated,
+/// for the duration of the walk. Callers that resume the remote process
+/// must call invalidateCache().
+class CachingMemoryReader final : public MemoryReader {
+  std::shared_ptr<MemoryReader> Underlying;
+
+  static constexpr uint64_t PageSize = 4096;
+
+  /// The number of pages fetched in one remote read when a page misses.
+  static constexpr uint64_t ReadAheadPages = 4;
+
+  /// Cached page contents, keyed by page base address.
+  std::unordered_map<uint64_t, std::unique_ptr<uint8_t[]>> Pages;
+
+  /// Page bases which could not be read as whole pages. Requests touching
+  /// them fall back to exact reads from the underlying reader, which can
+  /// still succeed at the edge of a mapping.
+  std::unordered_set<uint64_t> FailedPages;
+
+  /// Returns the cached contents of the page at \p pageBase, fetching it
+  /// (and reading ahead) on a miss. Returns null if the page is unreadable.
+  const uint8_t *getPage(uint64_t pageBase) {
+    auto Found = Pages.find(pageBase);
+    if (Found != Pages.end())
+      return Found->second.get();
+    if (FailedPages.count(pageBase))
+      return nullptr;
+
+    // Fetch a run of pages in a single remote read. Metadata walks probe
+    // many small, nearby values, so the round trip is amortized over all
+    // later probes of the run.
+    uint64_t Run = ReadAheadPages;
+    while (Run > 1 && pageBase + Run * PageSize < pageBase)
+      Run /= 2;
+
+    auto Buf = std::unique_ptr<uint8_t[]>(new uint8_t[Run * PageSize]);
+    while (!Underlying->readBytes(RemoteAddress(pageBase), Buf.get(),
+                                  Run * PageSize)) {
+      // The run may span out of the mapping; retry with fewer pages.
+      if (Run == 1) {
+        FailedPages.insert(pageBase);
+        return nullptr;
+      }
+      Run /= 2;
+    }
+
+    for (uint64_t i = 0; i < Run; ++i) {
+      auto Page = std::unique_ptr<uint8_t[]>(new uint8_t[PageSize]);
+      memcpy(Page.get(), Buf.get() + i * PageSize, PageSize);
+      Pages.emplace(pageBase + i * PageSize, std::move(Page));
+    }
+    return Pages[pageBase].get();
+  }
+
+public:
+  explicit CachingMemoryReader(std::shared_ptr<MemoryReader> Underlying)
+      : Underlying(std::move(Underlying)) {}
+
+  bool queryDataLayout(DataLayoutQueryType type, void *inBuffer,
+                       void *outBuffer) override {
+    return Underlying->queryDataLayout(type, inBuffer, outBuffer);
+  }
+
+  RemoteAddress getSymbolAddress(const std::string &name) override {
+    return Underlying->getSymbolAddress(name);
+  }
+
+  bool readString(RemoteAddress address, std::string &dest) override {
+    return Underlying->readString(address, dest);
+  }
+
+  RemoteAbsolutePointer resolvePointer(RemoteAddress address,
+                                       uint64_t readValue) override {
+    return Underlying->resolvePointer(address, readValue);
+  }
+
+  bool readBytes(RemoteAddress address, uint8_t *dest,
+                 uint64_t size) override {
+    // Serve large reads (section loads) directly; caching them would only
+    // duplicate big buffers that are read once.
+    if (size > PageSize)
+      return Underlying->readBytes(address, dest, size);
+
+    uint64_t Addr = address.getAddressData();
+    if (Addr + size < Addr)
+      return false;
+
+    uint64_t Remaining = size;
+    while (Remaining > 0) {
+      uint64_t PageBase = Addr & ~(PageSize - 1);
+      uint64_t Offset = Addr - PageBase;
+      uint64_t Chunk = std::min(Remaining, PageSize - Offset);
+
+      if (auto *Page = getPage(PageBase)) {
+        memcpy(dest, Page + Offset, Chunk);
+      } else if (!Underlying->readBytes(RemoteAddress(Addr), dest, Chunk)) {
+        return false;
+      }
+
+      Addr += Chunk;
+      dest += Chunk;
+      Remaining -= Chunk;
+    }
+    return true;
+  }
+
+  /// Drop all cached contents. Must be called whenever the remote process
+  /// may have mutated memory, e.g. after it was resumed.
+  void invalidateCache() {
+    Pages.clear();
+    FailedPages.clear();
+  }
+
+  /// Drop cached contents overlapping [address, address + size).
+  void invalidateCache(RemoteAddress address, uint64_t size) {
+    uint64_t Addr = address.getAddressData() & ~(PageSize - 1);
+    uint64_t End = address.getAddressData() + size;
+    for (; Addr < End; Addr += PageSize) {
+      Pages.erase(Addr);
+      FailedPages.erase(Addr);
+    }
+  }
+};
+
+} // end namespace remote
+} // end namespace swift
+
+#endif // SWIFT_REMOTE_CACHINGMEMORYREADER_H
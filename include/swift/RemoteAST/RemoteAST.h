@@ -250,7 +250,13 @@ public:
   getUnderlyingTypeForOpaqueType(remote::RemoteAddress opaqueDescriptor,
                                  SubstitutionMap substitutions,
                                  unsigned ordinal);
-  
+
+  /// Discard all cached resolution results.
+  ///
+  /// Resolutions are cached for the lifetime of the context, so this must
+  /// be called whenever the remote process is resumed: the addresses of
+  /// dynamically-instantiated metadata may be reused for different types.
+  void invalidateCaches();
 };
 
 } // end namespace remoteAST
@@ -242,6 +242,16 @@ private:
 /// concurrent insertions but does not support removals or rebalancing of
 /// the tree.
 ///
+/// The tree layout is a deliberate trade, not an oversight: entries are
+/// allocated once and never move, so the entry addresses this map hands out
+/// are stable forever. The metadata caches built on top depend on that --
+/// the address of a cached entry escapes as the canonical Metadata pointer,
+/// and type identity is pointer identity. An open-addressed hash table with
+/// inline entries would probe faster, but it cannot grow without moving
+/// entries, and adding an indirection to fix that gives back the locality
+/// the layout was meant to buy. Lookups that are hot enough to care are
+/// expected to cache the returned entry pointer rather than re-probe.
+///
 /// The entry type must provide the following operations:
 ///
 ///   /// For debugging purposes only. Summarize this key as an integer value.
@@ -503,27 +513,41 @@ public:
   }
   
   void push_back(const ElemTy &elem) {
+    append(&elem, 1);
+  }
+
+  /// Append `numElems` elements copied from `elems`. The writer lock is
+  /// taken and the storage is grown at most once for the whole batch, so
+  /// appending many elements at startup is much cheaper than repeated
+  /// calls to `push_back`.
+  void append(const ElemTy *elems, size_t numElems) {
+    if (numElems == 0)
+      return;
+
     ScopedLock guard(WriterLock);
-    
+
     auto *storage = Elements.load(std::memory_order_relaxed);
     auto count = storage ? storage->Count.load(std::memory_order_relaxed) : 0;
-    if (count >= Capacity) {
+    if (count + numElems > Capacity) {
       auto newCapacity = std::max((size_t)16, count * 2);
+      while (newCapacity < count + numElems)
+        newCapacity *= 2;
       auto *newStorage = Storage::allocate(newCapacity);
       if (storage) {
         std::copy(storage->data(), storage->data() + count, newStorage->data());
         newStorage->Count.store(count, std::memory_order_relaxed);
         FreeList.push_back(storage);
       }
-      
+
       storage = newStorage;
       Capacity = newCapacity;
       Elements.store(storage, std::memory_order_release);
     }
-    
-    new(&storage->data()[count]) ElemTy(elem);
-    storage->Count.store(count + 1, std::memory_order_release);
-    
+
+    for (size_t i = 0; i < numElems; i++)
+      new(&storage->data()[count + i]) ElemTy(elems[i]);
+    storage->Count.store(count + numElems, std::memory_order_release);
+
     if (ReaderCount.load(std::memory_order_acquire) == 0)
       deallocateFreeList();
   }
@@ -17,6 +17,7 @@
 #ifndef SWIFT_RUNTIME_EXCLUSIVITY_H
 #define SWIFT_RUNTIME_EXCLUSIVITY_H
 
+#include <cstddef>
 #include <cstdint>
 
 #include "swift/Runtime/Config.h"
@@ -64,6 +65,18 @@ char *swift_getOrigOfReplaceable(char **OrigFnPtr);
 SWIFT_RUNTIME_EXPORT
 void swift_endAccess(ValueBuffer *buffer);
 
+/// Read the calling thread's access-tracking counters: the number of
+/// accesses currently tracked, the capacity of the tracking table, and the
+/// total number of accesses the thread has ever tracked. Null
+/// out-parameters are skipped.
+///
+/// Unlike swift_dumpTrackedAccesses, this is available in all build
+/// configurations so that the cost of tracking can be observed in
+/// production.
+SWIFT_RUNTIME_EXPORT
+void swift_getAccessTrackingCounters(size_t *liveCount, size_t *tableCapacity,
+                                     uint64_t *totalTracked);
+
 /// A flag which, if set, causes access tracking to be suspended.
 /// Accesses which begin while this flag is set will not be tracked,
 /// will not cause exclusivity failures, and do not need to be ended.
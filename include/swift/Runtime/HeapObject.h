@@ -599,6 +599,53 @@ WeakReference *swift_weakCopyAssign(WeakReference *dest, WeakReference *src);
 SWIFT_RUNTIME_EXPORT
 WeakReference *swift_weakTakeAssign(WeakReference *dest, WeakReference *src);
 
+/// Non-atomic versions of the weak reference operations above.  Like the
+/// other swift_nonatomic_* entry points, these may only be used when the
+/// referenced object is provably not accessed by any other thread; the
+/// savings come from replacing the compare-and-swap loops on the side
+/// table's reference counts with plain load/store pairs.
+
+/// \see swift_weakInit
+SWIFT_RUNTIME_EXPORT
+WeakReference *swift_nonatomic_weakInit(WeakReference *ref, HeapObject *value);
+
+/// \see swift_weakAssign
+SWIFT_RUNTIME_EXPORT
+WeakReference *swift_nonatomic_weakAssign(WeakReference *ref,
+                                          HeapObject *value);
+
+/// \see swift_weakLoadStrong
+SWIFT_RUNTIME_EXPORT
+HeapObject *swift_nonatomic_weakLoadStrong(WeakReference *ref);
+
+/// \see swift_weakTakeStrong
+SWIFT_RUNTIME_EXPORT
+HeapObject *swift_nonatomic_weakTakeStrong(WeakReference *ref);
+
+/// \see swift_weakDestroy
+SWIFT_RUNTIME_EXPORT
+void swift_nonatomic_weakDestroy(WeakReference *ref);
+
+/// \see swift_weakCopyInit
+SWIFT_RUNTIME_EXPORT
+WeakReference *swift_nonatomic_weakCopyInit(WeakReference *dest,
+                                            WeakReference *src);
+
+/// \see swift_weakTakeInit
+SWIFT_RUNTIME_EXPORT
+WeakReference *swift_nonatomic_weakTakeInit(WeakReference *dest,
+                                            WeakReference *src);
+
+/// \see swift_weakCopyAssign
+SWIFT_RUNTIME_EXPORT
+WeakReference *swift_nonatomic_weakCopyAssign(WeakReference *dest,
+                                              WeakReference *src);
+
+/// \see swift_weakTakeAssign
+SWIFT_RUNTIME_EXPORT
+WeakReference *swift_nonatomic_weakTakeAssign(WeakReference *dest,
+                                              WeakReference *src);
+
 /*****************************************************************************/
 /************************* OTHER REFERENCE-COUNTING **************************/
 /*****************************************************************************/
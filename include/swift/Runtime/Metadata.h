@@ -297,6 +297,21 @@ swift_getGenericMetadata(MetadataRequest request,
                          const void * const *arguments,
                          const TypeContextDescriptor *description);
 
+/// Fetch the canonical metadata for a specialization of a generic type
+/// whose metadata was fully instantiated at compile time.
+///
+/// \p candidate is a complete metadata record emitted into the binary,
+/// with its generic argument vector laid out exactly as a dynamic
+/// instantiation's would be. If no equivalent instantiation exists in the
+/// type's generic metadata cache yet, the candidate is adopted as the
+/// canonical record for its arguments, so first use pays no
+/// instantiation cost. Otherwise the previously cached metadata is
+/// returned and the candidate goes unused.
+SWIFT_RUNTIME_EXPORT SWIFT_CC(swift)
+MetadataResponse
+swift_getCanonicalSpecializedMetadata(MetadataRequest request,
+                                      const Metadata *candidate);
+
 /// Allocate a generic class metadata object.  This is intended to be
 /// called by the metadata instantiation function of a generic class.
 ///
@@ -101,6 +101,16 @@ int swift_decompose_double(double d,
 // In all cases, it returns the number of ASCII characters actually
 // written, or zero if the buffer was too small.
 size_t swift_format_double(double, char *dest, size_t length);
+
+// Format an array of `count` doubles into `dest`, converting each value
+// with `swift_format_double` and packing the results end-to-end, each
+// terminated by its zero byte.  Conversion stops early if the remaining
+// space cannot hold another result.
+//
+// Returns the number of values fully converted.  If `used` is non-null,
+// it receives the total number of bytes written, including terminators.
+size_t swift_format_double_batch(const double *values, size_t count,
+    char *dest, size_t length, size_t *used);
 #endif
 
 #if SWIFT_DTOA_FLOAT16_SUPPORT
@@ -153,6 +153,33 @@ private:
   /// Allocator that manages the memory of all the pieces of the SILModule.
   mutable llvm::BumpPtrAllocator BPA;
 
+  /// Layout constants for recycling instruction memory. Each instruction
+  /// allocation is preceded by a header recording its size class, and freed
+  /// blocks are kept on per-class free lists for reuse instead of
+  /// round-tripping through malloc. See SILModule::allocateInst().
+  enum : unsigned {
+    /// Bytes between the start of an instruction's memory block and the
+    /// instruction itself. Also the strongest supported alignment.
+    InstMemoryHeaderBytes = 16,
+    /// Rounding granularity for instruction blocks; each size class covers
+    /// one multiple of this.
+    InstMemoryGranularity = 32,
+    /// Number of size classes kept on free lists; larger blocks are returned
+    /// straight to malloc.
+    NumInstFreeLists = 16,
+  };
+
+  /// Heads of the per-size-class free lists of deallocated instruction
+  /// memory. A free block links to the next one through its first word.
+  ///
+  /// Declared before the function list so that it is destroyed after it:
+  /// tearing down the functions pushes their instructions onto these lists.
+  struct InstFreeListSet {
+    void *Heads[NumInstFreeLists] = {};
+    ~InstFreeListSet();
+  };
+  mutable InstFreeListSet InstFreeLists;
+
   /// The swift Module associated with this SILModule.
   ModuleDecl *TheSwiftModule;
 
@@ -423,7 +423,14 @@ public:
   ValueOwnershipKind getOwnershipKind() const;
 
   /// Verify that this SILValue and its uses respects ownership invariants.
-  void verifyOwnership(DeadEndBlocks *DEBlocks = nullptr) const;
+  ///
+  /// \p visitedBlocks is scratch space for the lifetime dataflow's visited
+  /// set. Callers that verify many values can pass the same set to reuse its
+  /// allocation; it must be empty on entry and is left in an unspecified
+  /// state. If null, a set local to this check is used.
+  void verifyOwnership(
+      DeadEndBlocks *DEBlocks = nullptr,
+      SmallPtrSetImpl<SILBasicBlock *> *visitedBlocks = nullptr) const;
 };
 
 /// A map from a ValueOwnershipKind that an operand can accept to a
@@ -278,7 +278,13 @@ public:
 
   virtual void invalidate(SILFunction *,
                           SILAnalysis::InvalidationKind K) override {
-    invalidate();
+    // The cached relations are value- and instruction-based and survive pure
+    // rearrangements of branches. Anything else flushes both caches: entries
+    // cannot be retired per function, because a query in one function may
+    // have used interprocedural side-effect or escape information about
+    // another one.
+    if (K & (InvalidationKind::Instructions | InvalidationKind::Calls))
+      invalidate();
   }
 
   /// Notify the analysis about a newly created function.
@@ -39,6 +39,11 @@ struct SILAnalysisKind {
   operator InnerTy() const { return value; }
 };
 
+/// Bump the -stats counter recording that the analysis of kind \p kind had to
+/// recompute information for a function. Out of line so that the templated
+/// caller does not need the statistic machinery; defined in Analysis.cpp.
+void countAnalysisRecomputation(SILAnalysisKind kind);
+
 /// The base class for all SIL-level analysis.
 class SILAnalysis : public DeleteNotificationHandler {
 public:
@@ -229,8 +234,10 @@ public:
     verifyFunction(f);
 
     auto &it = storage.FindAndConstruct(f);
-    if (!it.second)
+    if (!it.second) {
       it.second = newFunctionAnalysis(f);
+      countAnalysisRecomputation(getKind());
+    }
     return it.second.get();
   }
 
@@ -16,6 +16,7 @@
 #include "swift/SILOptimizer/PassManager/Passes.h"
 #include "llvm/ADT/ArrayRef.h"
 #include "llvm/ADT/DenseMap.h"
+#include "llvm/ADT/SmallPtrSet.h"
 #include "llvm/ADT/SmallVector.h"
 #include "llvm/Support/Casting.h"
 #include "llvm/Support/ErrorHandling.h"
@@ -98,6 +99,17 @@ class SILPassManager {
   /// Set to true when a pass invalidates an analysis.
   bool CurrentPassHasInvalidated = false;
 
+  /// The functions changed since the last -sil-verify-all verification of
+  /// the module, used to limit the verification after a module pass to what
+  /// the pass actually touched.
+  llvm::SmallPtrSet<SILFunction *, 16> FunctionsChangedSinceLastVerify;
+
+  /// Set to true when a change could not be attributed to specific
+  /// functions (e.g. everything was invalidated, or witness- or vtables
+  /// changed), forcing the next -sil-verify-all module verification to
+  /// cover the whole module.
+  bool WholeModuleChangedSinceLastVerify = false;
+
   /// True if we need to stop running passes and restart again on the
   /// same function.
   bool RestartPipeline = false;
@@ -154,6 +166,7 @@ public:
         AP->invalidate();
 
     CurrentPassHasInvalidated = true;
+    WholeModuleChangedSinceLastVerify = true;
 
     // Assume that all functions have changed. Clear all masks of all functions.
     CompletedPassesMap.clear();
@@ -188,6 +201,7 @@ public:
         AP->invalidate(F, K);
     
     CurrentPassHasInvalidated = true;
+    FunctionsChangedSinceLastVerify.insert(F);
     // Any change let all passes run again.
     CompletedPassesMap[F].reset();
   }
@@ -201,6 +215,7 @@ public:
         AP->invalidateFunctionTables();
 
     CurrentPassHasInvalidated = true;
+    WholeModuleChangedSinceLastVerify = true;
 
     // Assume that all functions have changed. Clear all masks of all functions.
     CompletedPassesMap.clear();
@@ -214,6 +229,10 @@ public:
         AP->notifyWillDeleteFunction(F);
 
     CurrentPassHasInvalidated = true;
+    // The function is going away; make sure we don't keep a dangling pointer
+    // to it, and verify everything else the next time around.
+    FunctionsChangedSinceLastVerify.erase(F);
+    WholeModuleChangedSinceLastVerify = true;
     // Any change let all passes run again.
     CompletedPassesMap[F].reset();
   }
@@ -278,6 +297,10 @@ private:
   /// the module.
   void runModulePass(unsigned TransIdx);
 
+  /// Verify the functions changed since the last verification, or the whole
+  /// module if changes could not be attributed to specific functions.
+  void verifyModuleChanges();
+
   /// Run the \p TransIdx'th pass on the function \p F.
   void runPassOnFunction(unsigned TransIdx, SILFunction *F);
 
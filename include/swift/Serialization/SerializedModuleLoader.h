@@ -16,8 +16,16 @@
 #include "swift/AST/FileUnit.h"
 #include "swift/AST/Module.h"
 #include "swift/AST/ModuleLoader.h"
+#include "llvm/ADT/StringMap.h"
+#include "llvm/ADT/StringSet.h"
 #include "llvm/Support/MemoryBuffer.h"
 
+namespace llvm {
+namespace vfs {
+class FileSystem;
+}
+}
+
 namespace swift {
 class ModuleFile;
 namespace file_types {
@@ -60,6 +68,26 @@ class SerializedModuleLoaderBase : public ModuleLoader {
 
   SmallVector<std::unique_ptr<llvm::MemoryBuffer>, 2> OrphanedMemoryBuffers;
 
+  /// Cached listings of module search path directories, keyed by path.
+  ///
+  /// Most imports probe most search paths and find nothing, so each directory
+  /// is enumerated once and the per-import existence checks are answered from
+  /// the cache instead of issuing a filesystem query per (import, path) pair.
+  /// The cache lives for a single compiler invocation, matching the
+  /// assumption the rest of import resolution already makes that search path
+  /// contents do not change mid-compilation. A None entry means enumeration
+  /// has not succeeded yet.
+  llvm::StringMap<Optional<llvm::StringSet<>>> SearchPathContentsCache;
+
+  /// Determines whether the directory \p directoryPath contains an entry
+  /// named \p entryName, using (and filling) #SearchPathContentsCache.
+  ///
+  /// Returns None if the directory could not be enumerated; the caller
+  /// should fall back to querying the filesystem directly.
+  Optional<bool> searchPathContains(llvm::vfs::FileSystem &fs,
+                                    StringRef directoryPath,
+                                    StringRef entryName);
+
 protected:
   ASTContext &Ctx;
   ModuleLoadingMode LoadMode;
@@ -29,7 +29,7 @@
 
 /// Minor version changes when new APIs are added in ABI- and source-compatible
 /// way.
-#define SWIFT_DEMANGLE_VERSION_MINOR 2
+#define SWIFT_DEMANGLE_VERSION_MINOR 3
 
 /// @}
 
@@ -57,6 +57,24 @@ size_t swift_demangle_getSimplifiedDemangledName(const char *MangledName,
                                                  char *OutputBuffer,
                                                  size_t Length);
 
+/// Demangle an array of Swift function names, reusing one demangler arena
+/// for all of them.  This is substantially faster than calling
+/// swift_demangle_getDemangledName in a loop when processing many symbols,
+/// e.g. during crash symbolication.
+///
+/// The results are written to \p OutputBuffer in input order, packed
+/// end-to-end, each terminated by a '\0' byte.  An input that is not a
+/// Swift-mangled function name contributes an empty string.  Conversion
+/// stops early if the remaining space cannot hold another result.
+///
+/// \returns the number of names processed.  If \p OutputUsed is not null,
+/// it receives the total number of bytes written, including terminators.
+SWIFT_DEMANGLE_LINKAGE
+size_t swift_demangle_getDemangledNames(const char *const *MangledNames,
+                                        size_t NumNames,
+                                        char *OutputBuffer, size_t Length,
+                                        size_t *OutputUsed);
+
 /// Demangle a Swift symbol and return the module name of the mangled entity.
 ///
 /// \returns the length of the demangled module name (even if greater than the
@@ -72,6 +72,16 @@ SWIFT_REMOTE_MIRROR_LINKAGE
 void
 swift_reflection_destroyReflectionContext(SwiftReflectionContextRef Context);
 
+/// Discards all remote memory cached by the reflection context.
+///
+/// The context caches remote reads at page granularity and assumes the
+/// inspected memory does not change. Call this whenever the remote process
+/// is resumed and its memory may have been mutated; subsequent queries will
+/// re-read remote memory.
+SWIFT_REMOTE_MIRROR_LINKAGE
+void
+swift_reflection_invalidateMemoryCache(SwiftReflectionContextRef Context);
+
 /// DEPRECATED. Add reflection sections for a loaded Swift image.
 ///
 /// You probably want to use \c swift_reflection_addImage instead.
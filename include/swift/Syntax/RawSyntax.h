@@ -233,10 +233,13 @@ class RawSyntax final
   /// An ID of this node that is stable across incremental parses
   SyntaxNodeId NodeId;
 
-  /// If this node was allocated using a \c SyntaxArena's bump allocator, a
-  /// reference to the arena to keep the underlying memory buffer of this node
-  /// alive. If this is a \c nullptr, the node owns its own memory buffer.
-  RC<SyntaxArena> Arena;
+  /// If this node was allocated using a \c SyntaxArena's bump allocator, the
+  /// arena that collectively owns it. Arena-allocated nodes are not reference
+  /// counted and are never destroyed individually; they die with the arena.
+  /// The pointer is non-owning — clients keep the arena alive through
+  /// \c SyntaxData, which retains the arena of its raw node. If this is a
+  /// \c nullptr, the node owns its own memory buffer and is reference counted.
+  SyntaxArena *Arena;
 
   union {
     uint64_t OpaqueBits;
@@ -323,26 +326,29 @@ public:
   ~RawSyntax();
 
   // This is a copy-pased implementation of llvm::ThreadSafeRefCountedBase with
-  // the difference that we do not delete the RawSyntax node's memory if the
-  // node was allocated within a SyntaxArena and thus doesn't own its memory.
-  void Retain() const { RefCount.fetch_add(1, std::memory_order_relaxed); }
+  // the difference that nodes allocated within a SyntaxArena are not reference
+  // counted at all: their storage is owned by the arena and freed wholesale
+  // when the arena is destroyed, so Retain/Release don't need to touch the
+  // atomic reference count for them.
+  void Retain() const {
+    if (Arena)
+      return;
+    RefCount.fetch_add(1, std::memory_order_relaxed);
+  }
 
   void Release() const {
+    if (Arena)
+      return;
     int NewRefCount = RefCount.fetch_sub(1, std::memory_order_acq_rel) - 1;
     assert(NewRefCount >= 0 && "Reference count was already zero.");
-    if (NewRefCount == 0) {
-      if (Arena) {
-        // The node was allocated inside a SyntaxArena and thus doesn't own its
-        // own memory region. Hence we cannot free it. It will be deleted once
-        // the last RawSyntax node allocated with it will release its reference
-        // to the arena.
-        this->~RawSyntax();
-      } else {
-        delete this;
-      }
-    }
+    if (NewRefCount == 0)
+      delete this;
   }
 
+  /// Return the arena this node was allocated in, or \c nullptr if the node
+  /// owns its own memory.
+  SyntaxArena *getArena() const { return Arena; }
+
   /// \name Factory methods.
   /// @{
 
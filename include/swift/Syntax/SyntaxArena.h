@@ -18,18 +18,34 @@
 #define SWIFT_SYNTAX_SYNTAXARENA_H
 
 #include "llvm/ADT/IntrusiveRefCntPtr.h"
+#include "llvm/ADT/SmallVector.h"
+#include "llvm/ADT/StringRef.h"
 #include "llvm/Support/Allocator.h"
 
+#include <cstring>
+
 namespace swift {
 namespace syntax {
 
 /// Memory manager for Syntax nodes.
+///
+/// All \c RawSyntax nodes of one tree are bump-allocated in an arena and
+/// collectively owned by it: nodes inside an arena are not reference counted
+/// and are never destroyed individually. Tearing down a tree is a single
+/// deallocation of the arena's slabs. Clients that hold on to syntax nodes
+/// keep the arena alive through \c SyntaxData, which retains a reference to
+/// the arena of its root raw node.
 class SyntaxArena : public llvm::ThreadSafeRefCountedBase<SyntaxArena> {
   SyntaxArena(const SyntaxArena &) = delete;
   void operator=(const SyntaxArena &) = delete;
 
   llvm::BumpPtrAllocator Allocator;
 
+  /// Arenas that contain nodes referenced from nodes allocated in this arena,
+  /// e.g. subtrees reused from a previous incremental parse. They are kept
+  /// alive for at least as long as this arena.
+  llvm::SmallVector<llvm::IntrusiveRefCntPtr<SyntaxArena>, 4> ChildArenas;
+
 public:
   SyntaxArena() {}
 
@@ -37,6 +53,28 @@ public:
   void *Allocate(size_t size, size_t alignment) {
     return Allocator.Allocate(size, alignment);
   }
+
+  /// Copy \p Str into this arena and return the stable arena-owned copy.
+  /// Token and trivia text copied this way needs no individual ownership and
+  /// dies with the arena.
+  llvm::StringRef copyString(llvm::StringRef Str) {
+    if (Str.empty())
+      return llvm::StringRef();
+    char *Data = static_cast<char *>(Allocate(Str.size(), 1));
+    memcpy(Data, Str.data(), Str.size());
+    return llvm::StringRef(Data, Str.size());
+  }
+
+  /// Record that nodes in this arena reference nodes that live in \p Arena,
+  /// keeping \p Arena alive for at least as long as this arena.
+  void addChildArena(llvm::IntrusiveRefCntPtr<SyntaxArena> Arena) {
+    if (!Arena || Arena.get() == this)
+      return;
+    for (const auto &Existing : ChildArenas)
+      if (Existing == Arena)
+        return;
+    ChildArenas.push_back(std::move(Arena));
+  }
 };
 
 } // namespace syntax
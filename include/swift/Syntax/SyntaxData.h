@@ -68,6 +68,13 @@ class SyntaxData final
   /// The shared raw syntax representing this syntax data node.
   const RC<RawSyntax> Raw;
 
+  /// If \c Raw is allocated in a \c SyntaxArena, a reference that keeps the
+  /// arena — and transitively every arena it references — alive for as long
+  /// as clients hold this node. Raw nodes inside an arena are not reference
+  /// counted, so this is what ties the lifetime of an arena-allocated tree to
+  /// the \c Syntax nodes handed out to clients.
+  const RC<SyntaxArena> Arena;
+
   /// The parent of this syntax.
   ///
   /// WARNING! Do not access this directly. Use getParent(),
@@ -88,7 +95,8 @@ class SyntaxData final
 
   SyntaxData(RC<RawSyntax> Raw, const SyntaxData *Parent = nullptr,
              CursorIndex IndexInParent = 0)
-      : Raw(Raw), Parent(Parent), IndexInParent(IndexInParent) {
+      : Raw(Raw), Arena(Raw ? Raw->getArena() : nullptr), Parent(Parent),
+        IndexInParent(IndexInParent) {
     auto *I = getTrailingObjects<AtomicCache<SyntaxData>>();
     for (auto *E = I + getNumChildren(); I != E; ++I)
       ::new (static_cast<void *>(I)) AtomicCache<SyntaxData>();
@@ -46,6 +46,7 @@
 #include "swift/AST/TypeCheckerDebugConsumer.h"
 #include "swift/Basic/Compiler.h"
 #include "swift/Basic/SourceManager.h"
+#include "swift/Demangling/Demangler.h"
 #include "swift/Basic/Statistic.h"
 #include "swift/Basic/StringExtras.h"
 #include "swift/Syntax/References.h"
@@ -53,11 +54,16 @@
 #include "swift/Strings.h"
 #include "swift/Subsystems.h"
 #include "llvm/ADT/DenseMap.h"
+#include "llvm/ADT/Hashing.h"
 #include "llvm/ADT/Statistic.h"
 #include "llvm/ADT/StringMap.h"
 #include "llvm/ADT/StringSwitch.h"
 #include "llvm/Support/Allocator.h"
 #include "llvm/Support/Compiler.h"
+#include "llvm/Support/FileSystem.h"
+#include "llvm/Support/MemoryBuffer.h"
+#include "llvm/Support/RWMutex.h"
+#include "llvm/Support/raw_ostream.h"
 #include <algorithm>
 #include <memory>
 
@@ -146,6 +152,50 @@ template <> struct DenseMapInfo<OverrideSignatureKey> {
 };
 } // namespace llvm
 
+namespace {
+
+/// A FoldingSet striped over several reader/writer-locked shards, selected
+/// by profile hash. Looking up an already-uniqued node--the overwhelmingly
+/// common case--takes only a shard's reader lock; writers contend only
+/// when two threads intern new nodes landing in the same shard.
+template <typename NodeTy, size_t NumShards = 16>
+class ShardedFoldingSet {
+  struct Shard {
+    mutable llvm::sys::RWMutex Mutex;
+    llvm::FoldingSet<NodeTy> Set;
+  };
+  Shard Shards[NumShards];
+
+  Shard &getShard(const llvm::FoldingSetNodeID &ID) {
+    return Shards[ID.ComputeHash() % NumShards];
+  }
+
+public:
+  /// Find the node with the given profile, if it has been interned.
+  NodeTy *findNode(const llvm::FoldingSetNodeID &ID) {
+    auto &shard = getShard(ID);
+    llvm::sys::ScopedReader readLock(shard.Mutex);
+    void *insertPos;
+    return shard.Set.FindNodeOrInsertPos(ID, insertPos);
+  }
+
+  /// Intern \p node. If a node with the same profile was interned in the
+  /// meantime, that node wins and is returned; \p node is abandoned to its
+  /// arena.
+  NodeTy *insertOrGetExisting(const llvm::FoldingSetNodeID &ID,
+                              NodeTy *node) {
+    auto &shard = getShard(ID);
+    llvm::sys::ScopedWriter writeLock(shard.Mutex);
+    void *insertPos;
+    if (auto *existing = shard.Set.FindNodeOrInsertPos(ID, insertPos))
+      return existing;
+    shard.Set.InsertNode(node, insertPos);
+    return node;
+  }
+};
+
+} // end anonymous namespace
+
 struct ASTContext::Implementation {
   Implementation();
   ~Implementation();
@@ -155,10 +205,27 @@ struct ASTContext::Implementation {
   /// The set of cleanups to be called when the ASTContext is destroyed.
   std::vector<std::function<void(void)>> Cleanups;
 
-  // FIXME: This is a StringMap rather than a StringSet because StringSet
-  // doesn't allow passing in a pre-existing allocator.
-  llvm::StringMap<Identifier::Aligner, llvm::BumpPtrAllocator&>
-  IdentifierTable;
+  /// Identifier interning is sharded so that concurrent clients — multiple
+  /// ASTContexts in SourceKit today, parallel parsing eventually — don't
+  /// contend on a single table. Strings are distributed over the shards by
+  /// hash; each shard owns its allocator so interning doesn't touch the main
+  /// ASTContext allocator either. Lookups of already-interned strings only
+  /// take the shard's reader lock.
+  enum : size_t { NumIdentifierShards = 16 };
+  struct IdentifierShard {
+    mutable llvm::sys::RWMutex Mutex;
+    llvm::BumpPtrAllocator Allocator;
+    // FIXME: This is a StringMap rather than a StringSet because StringSet
+    // doesn't allow passing in a pre-existing allocator.
+    llvm::StringMap<Identifier::Aligner, llvm::BumpPtrAllocator &> Table;
+    IdentifierShard() : Table(Allocator) {}
+  };
+  IdentifierShard IdentifierShards[NumIdentifierShards];
+
+  /// Memoizes remanglings of demangling node trees. The ASTDemangler
+  /// round-trips the same trees repeatedly when resolving mangled names
+  /// to declarations.
+  Demangle::ManglingCache TheManglingCache;
 
   /// The declaration of Swift.AssignmentPrecedence.
   PrecedenceGroupDecl *AssignmentPrecedence = nullptr;
@@ -263,6 +330,25 @@ struct ASTContext::Implementation {
   /// Map from Swift declarations to brief comments.
   llvm::DenseMap<const Decl *, StringRef> BriefComments;
 
+  /// Map from function declarations to fingerprints of their delayed or
+  /// skipped bodies (xxHash64 of the body byte range).
+  llvm::DenseMap<const AbstractFunctionDecl *, uint64_t> BodyFingerprints;
+
+  /// Memo of binary operator overloads chosen by previously solved
+  /// expressions, keyed on the operator name, the canonical operand types and
+  /// the canonical contextual type (or null if there was none).
+  llvm::DenseMap<std::pair<std::pair<const void *, TypeBase *>,
+                           std::pair<TypeBase *, TypeBase *>>,
+                 ValueDecl *>
+      SolvedBinaryOperatorOverloads;
+
+  /// Operator overload success counts loaded from and persisted to
+  /// \c TypeCheckerOpts.SolverOverloadProfilePath (lazily loaded on first
+  /// use, written back on context destruction if modified).
+  llvm::StringMap<unsigned> OverloadProfileCounts;
+  bool OverloadProfileLoaded = false;
+  bool OverloadProfileDirty = false;
+
   /// Map from declarations to foreign error conventions.
   /// This applies to both actual imported functions and to @objc functions.
   llvm::DenseMap<const AbstractFunctionDecl *,
@@ -336,7 +422,6 @@ struct ASTContext::Implementation {
 
     llvm::DenseMap<Type, ErrorType *> ErrorTypesWithOriginal;
     llvm::FoldingSet<TypeAliasType> TypeAliasTypes;
-    llvm::FoldingSet<TupleType> TupleTypes;
     llvm::DenseMap<llvm::PointerIntPair<TypeBase*, 3, unsigned>,
                    MetatypeType*> MetatypeTypes;
     llvm::DenseMap<llvm::PointerIntPair<TypeBase*, 3, unsigned>,
@@ -368,9 +453,6 @@ struct ASTContext::Implementation {
     llvm::DenseMap<GenericSignature, std::unique_ptr<GenericSignatureBuilder>>
       GenericSignatureBuilders;
 
-    /// The set of function types.
-    llvm::FoldingSet<FunctionType> FunctionTypes;
-
     /// The set of normal protocol conformances.
     llvm::FoldingSet<NormalProtocolConformance> NormalConformances;
 
@@ -407,6 +489,11 @@ struct ASTContext::Implementation {
     }
 
     size_t getTotalMemory() const;
+
+    /// Dump the number of entries in each of the type-uniquing tables,
+    /// which approximates how many nodes of each kind were allocated in
+    /// this arena.
+    void dumpAllocationStatistics(llvm::raw_ostream &os) const;
   };
 
   llvm::DenseMap<ModuleDecl*, ModuleType*> ModuleTypes;
@@ -434,11 +521,23 @@ struct ASTContext::Implementation {
   /// The permanent arena.
   Arena Permanent;
 
+  /// Striped, lock-guarded uniquing tables for the hottest permanent-arena
+  /// types, so concurrent clients can hash-cons them without serializing on
+  /// one table.
+  ShardedFoldingSet<TupleType> PermanentTupleTypes;
+  ShardedFoldingSet<FunctionType> PermanentFunctionTypes;
+
   /// Temporary arena used for a constraint solver.
   struct ConstraintSolverArena : public Arena {
     /// The allocator used for all allocations within this arena.
     llvm::BumpPtrAllocator &Allocator;
 
+    /// Solver-local counterparts of the sharded permanent-arena tables
+    /// above. A solver arena is owned by a single constraint system and is
+    /// never shared between threads, so plain tables suffice here.
+    llvm::FoldingSet<TupleType> TupleTypes;
+    llvm::FoldingSet<FunctionType> FunctionTypes;
+
     ConstraintSolverArena(llvm::BumpPtrAllocator &allocator)
       : Allocator(allocator) { }
 
@@ -446,11 +545,23 @@ struct ASTContext::Implementation {
     ConstraintSolverArena(ConstraintSolverArena &&) = delete;
     ConstraintSolverArena &operator=(const ConstraintSolverArena &) = delete;
     ConstraintSolverArena &operator=(ConstraintSolverArena &&) = delete;
+
+    /// Dumps the shared tables along with the solver-local ones.
+    void dumpAllocationStatistics(llvm::raw_ostream &os) const;
   };
 
   /// The current constraint solver arena, if any.
   std::unique_ptr<ConstraintSolverArena> CurrentConstraintSolverArena;
 
+  /// Bump allocators previously leased for constraint solving, kept around
+  /// (with their initial slabs intact) for reuse by later solver
+  /// invocations.
+  std::vector<std::unique_ptr<llvm::BumpPtrAllocator>> SolverAllocators;
+
+  /// The most memory any constraint solver arena has used, sampled when
+  /// the arena is torn down.
+  size_t SolverMemoryHighWater = 0;
+
   Arena &getArena(AllocationArena arena) {
     switch (arena) {
     case AllocationArena::Permanent:
@@ -462,7 +573,12 @@ struct ASTContext::Implementation {
     }
     llvm_unreachable("bad AllocationArena");
   }
-  
+
+  ConstraintSolverArena &getSolverArena() {
+    assert(CurrentConstraintSolverArena && "No constraint solver active?");
+    return *CurrentConstraintSolverArena;
+  }
+
   llvm::FoldingSet<SILLayout> SILLayouts;
 
   RC<syntax::SyntaxArena> TheSyntaxArena;
@@ -476,8 +592,7 @@ struct ASTContext::Implementation {
 };
 
 ASTContext::Implementation::Implementation()
-    : IdentifierTable(Allocator),
-      TheSyntaxArena(new syntax::SyntaxArena()) {}
+    : TheSyntaxArena(new syntax::SyntaxArena()) {}
 ASTContext::Implementation::~Implementation() {
   for (auto &cleanup : Cleanups)
     cleanup();
@@ -492,10 +607,46 @@ ConstraintCheckerArenaRAII(ASTContext &self, llvm::BumpPtrAllocator &allocator)
 }
 
 ConstraintCheckerArenaRAII::~ConstraintCheckerArenaRAII() {
-  Self.getImpl().CurrentConstraintSolverArena.reset(
+  // A bump arena only grows, so its teardown is where its memory use
+  // peaks; sample the high-water mark here.
+  auto &impl = Self.getImpl();
+  impl.SolverMemoryHighWater =
+      std::max(impl.SolverMemoryHighWater, Self.getSolverMemory());
+  if (auto *stats = Self.Stats)
+    stats->getFrontendCounters().MaxSolverMemory = impl.SolverMemoryHighWater;
+
+  if (Self.TypeCheckerOpts.SolverArenaStats) {
+    auto &arena = *impl.CurrentConstraintSolverArena;
+    llvm::errs() << "---Constraint solver arena---\n"
+                 << "  bytes allocated: "
+                 << arena.Allocator.getBytesAllocated() << "\n"
+                 << "  high-water mark: " << impl.SolverMemoryHighWater
+                 << "\n";
+    arena.dumpAllocationStatistics(llvm::errs());
+  }
+
+  impl.CurrentConstraintSolverArena.reset(
     (ASTContext::Implementation::ConstraintSolverArena *)Data);
 }
 
+SolverAllocatorRAII::SolverAllocatorRAII(ASTContext &self) : Self(self) {
+  auto &pool = self.getImpl().SolverAllocators;
+  if (pool.empty()) {
+    Allocator.reset(new llvm::BumpPtrAllocator());
+  } else {
+    Allocator = std::move(pool.back());
+    pool.pop_back();
+  }
+}
+
+SolverAllocatorRAII::~SolverAllocatorRAII() {
+  // Resetting frees all but the initial slab, so the pool keeps warm
+  // memory for the next solver invocation without pinning the peak of an
+  // unusually expensive expression.
+  Allocator->Reset();
+  Self.getImpl().SolverAllocators.push_back(std::move(Allocator));
+}
+
 static ModuleDecl *createBuiltinModule(ASTContext &ctx) {
   auto M = ModuleDecl::create(ctx.getIdentifier(BUILTIN_NAME), ctx);
   M->addFile(*new (ctx) BuiltinUnit(*M));
@@ -600,6 +751,20 @@ ASTContext::~ASTContext() {
   if (!graphPath.empty()) {
     evaluator.emitRequestEvaluatorGraphViz(graphPath);
   }
+
+  // Persist the operator overload profile if it picked up new entries. This
+  // is a best-effort heuristic cache; if several frontend jobs race on the
+  // same file the last writer wins, which is acceptable.
+  if (getImpl().OverloadProfileDirty) {
+    std::error_code ec;
+    llvm::raw_fd_ostream out(TypeCheckerOpts.SolverOverloadProfilePath, ec,
+                             llvm::sys::fs::F_None);
+    if (!ec) {
+      for (const auto &entry : getImpl().OverloadProfileCounts)
+        out << entry.second << '\t' << entry.first() << '\n';
+    }
+  }
+
   getImpl().~Implementation();
 }
 
@@ -629,6 +794,10 @@ RC<syntax::SyntaxArena> ASTContext::getSyntaxArena() const {
   return getImpl().TheSyntaxArena;
 }
 
+Demangle::ManglingCache &ASTContext::getManglingCache() const {
+  return getImpl().TheManglingCache;
+}
+
 /// getIdentifier - Return the uniqued and AST-Context-owned version of the
 /// specified string.
 Identifier ASTContext::getIdentifier(StringRef Str) const {
@@ -636,8 +805,21 @@ Identifier ASTContext::getIdentifier(StringRef Str) const {
   if (Str.data() == nullptr)
     return Identifier(nullptr);
 
+  auto &shard = getImpl().IdentifierShards[
+      llvm::hash_value(Str) % Implementation::NumIdentifierShards];
+
+  // Common case: the identifier has already been interned; finding it only
+  // needs the shard's reader lock.
+  {
+    llvm::sys::ScopedReader readLock(shard.Mutex);
+    auto I = shard.Table.find(Str);
+    if (I != shard.Table.end())
+      return Identifier(I->getKeyData());
+  }
+
+  llvm::sys::ScopedWriter writeLock(shard.Mutex);
   auto pair = std::make_pair(Str, Identifier::Aligner());
-  auto I = getImpl().IdentifierTable.insert(pair).first;
+  auto I = shard.Table.insert(pair).first;
   return Identifier(I->getKeyData());
 }
 
@@ -1849,6 +2031,88 @@ void ASTContext::setBriefComment(const Decl *D, StringRef Comment) {
   getImpl().BriefComments[D] = Comment;
 }
 
+Optional<uint64_t>
+ASTContext::getBodyFingerprint(const AbstractFunctionDecl *AFD) const {
+  auto Known = getImpl().BodyFingerprints.find(AFD);
+  if (Known == getImpl().BodyFingerprints.end())
+    return None;
+
+  return Known->second;
+}
+
+void ASTContext::setBodyFingerprint(const AbstractFunctionDecl *AFD,
+                                    uint64_t Fingerprint) {
+  getImpl().BodyFingerprints[AFD] = Fingerprint;
+}
+
+/// Build the memo key for a solved binary operator overload.
+static std::pair<std::pair<const void *, TypeBase *>,
+                 std::pair<TypeBase *, TypeBase *>>
+getBinaryOperatorMemoKey(Identifier opName, CanType lhsTy, CanType rhsTy,
+                         CanType contextualTy) {
+  return {{opName.getAsOpaquePointer(), contextualTy.getPointer()},
+          {lhsTy.getPointer(), rhsTy.getPointer()}};
+}
+
+void ASTContext::setSolvedBinaryOperatorOverload(Identifier opName,
+                                                 CanType lhsTy, CanType rhsTy,
+                                                 CanType contextualTy,
+                                                 ValueDecl *choice) {
+  auto key = getBinaryOperatorMemoKey(opName, lhsTy, rhsTy, contextualTy);
+  getImpl().SolvedBinaryOperatorOverloads[key] = choice;
+}
+
+ValueDecl *ASTContext::getSolvedBinaryOperatorOverload(
+    Identifier opName, CanType lhsTy, CanType rhsTy,
+    CanType contextualTy) const {
+  auto key = getBinaryOperatorMemoKey(opName, lhsTy, rhsTy, contextualTy);
+  auto &memo = getImpl().SolvedBinaryOperatorOverloads;
+  auto known = memo.find(key);
+  return known == memo.end() ? nullptr : known->second;
+}
+
+/// Load the operator overload profile from disk if it hasn't been read yet.
+/// Each line has the form "<count>\t<profile key>".
+static void loadOverloadProfileIfNeeded(ASTContext::Implementation &impl,
+                                        StringRef path) {
+  if (impl.OverloadProfileLoaded)
+    return;
+  impl.OverloadProfileLoaded = true;
+
+  auto buffer = llvm::MemoryBuffer::getFile(path);
+  if (!buffer)
+    return;
+
+  SmallVector<StringRef, 32> lines;
+  (*buffer)->getBuffer().split(lines, '\n', /*MaxSplit=*/-1,
+                               /*KeepEmpty=*/false);
+  for (StringRef line : lines) {
+    StringRef countStr, key;
+    std::tie(countStr, key) = line.split('\t');
+    unsigned count;
+    if (key.empty() || countStr.getAsInteger(10, count))
+      continue;
+    impl.OverloadProfileCounts[key] = count;
+  }
+}
+
+void ASTContext::recordOperatorOverloadSuccess(StringRef profileKey) {
+  if (TypeCheckerOpts.SolverOverloadProfilePath.empty())
+    return;
+  loadOverloadProfileIfNeeded(getImpl(),
+                              TypeCheckerOpts.SolverOverloadProfilePath);
+  ++getImpl().OverloadProfileCounts[profileKey];
+  getImpl().OverloadProfileDirty = true;
+}
+
+unsigned ASTContext::getOperatorOverloadSuccessCount(StringRef profileKey) {
+  if (TypeCheckerOpts.SolverOverloadProfilePath.empty())
+    return 0;
+  loadOverloadProfileIfNeeded(getImpl(),
+                              TypeCheckerOpts.SolverOverloadProfilePath);
+  return getImpl().OverloadProfileCounts.lookup(profileKey);
+}
+
 NormalProtocolConformance *
 ASTContext::getConformance(Type conformingType,
                            ProtocolDecl *protocol,
@@ -2100,9 +2364,13 @@ size_t ASTContext::getSolverMemory() const {
   return Size;
 }
 
+size_t ASTContext::getSolverMemoryHighWater() const {
+  // An arena that is still active may not have been sampled yet.
+  return std::max(getImpl().SolverMemoryHighWater, getSolverMemory());
+}
+
 size_t ASTContext::Implementation::Arena::getTotalMemory() const {
   return sizeof(*this) +
-    // TupleTypes ?
     llvm::capacity_in_bytes(MetatypeTypes) +
     llvm::capacity_in_bytes(ExistentialMetatypeTypes) +
     llvm::capacity_in_bytes(ArraySliceTypes) +
@@ -2119,7 +2387,6 @@ size_t ASTContext::Implementation::Arena::getTotalMemory() const {
     llvm::capacity_in_bytes(ClassTypes) +
     llvm::capacity_in_bytes(ProtocolTypes) +
     llvm::capacity_in_bytes(DynamicSelfTypes);
-    // FunctionTypes ?
     // UnboundGenericTypes ?
     // BoundGenericTypes ?
     // NormalConformances ?
@@ -2127,6 +2394,58 @@ size_t ASTContext::Implementation::Arena::getTotalMemory() const {
     // InheritedConformances ?
 }
 
+void ASTContext::Implementation::Arena::dumpAllocationStatistics(
+    llvm::raw_ostream &os) const {
+#define DUMP_TABLE(Name)                                                       \
+  do {                                                                         \
+    if (Name.size() != 0)                                                      \
+      os << "  " #Name ": " << Name.size() << "\n";                            \
+  } while (false)
+  DUMP_TABLE(ErrorTypesWithOriginal);
+  DUMP_TABLE(TypeAliasTypes);
+  DUMP_TABLE(MetatypeTypes);
+  DUMP_TABLE(ExistentialMetatypeTypes);
+  DUMP_TABLE(ArraySliceTypes);
+  DUMP_TABLE(DictionaryTypes);
+  DUMP_TABLE(OptionalTypes);
+  DUMP_TABLE(SimpleParenTypes);
+  DUMP_TABLE(ParenTypes);
+  DUMP_TABLE(ReferenceStorageTypes);
+  DUMP_TABLE(LValueTypes);
+  DUMP_TABLE(InOutTypes);
+  DUMP_TABLE(DependentMemberTypes);
+  DUMP_TABLE(DynamicSelfTypes);
+  DUMP_TABLE(EnumTypes);
+  DUMP_TABLE(StructTypes);
+  DUMP_TABLE(ClassTypes);
+  DUMP_TABLE(ProtocolTypes);
+  DUMP_TABLE(UnboundGenericTypes);
+  DUMP_TABLE(BoundGenericTypes);
+  DUMP_TABLE(ProtocolCompositionTypes);
+  DUMP_TABLE(LayoutConstraints);
+  DUMP_TABLE(OpaqueArchetypes);
+  DUMP_TABLE(GenericSignatures);
+  DUMP_TABLE(NormalConformances);
+  DUMP_TABLE(SelfConformances);
+  DUMP_TABLE(SpecializedConformances);
+  DUMP_TABLE(InheritedConformances);
+  DUMP_TABLE(SubstitutionMaps);
+#undef DUMP_TABLE
+}
+
+void ASTContext::Implementation::ConstraintSolverArena::
+dumpAllocationStatistics(llvm::raw_ostream &os) const {
+  Arena::dumpAllocationStatistics(os);
+#define DUMP_TABLE(Name)                                                       \
+  do {                                                                         \
+    if (Name.size() != 0)                                                      \
+      os << "  " #Name ": " << Name.size() << "\n";                            \
+  } while (false)
+  DUMP_TABLE(TupleTypes);
+  DUMP_TABLE(FunctionTypes);
+#undef DUMP_TABLE
+}
+
 void AbstractFunctionDecl::setForeignErrorConvention(
                                          const ForeignErrorConvention &conv) {
   assert(hasThrows() && "setting error convention on non-throwing decl");
@@ -2361,9 +2680,15 @@ Type TupleType::get(ArrayRef<TupleTypeElt> Fields, const ASTContext &C) {
   llvm::FoldingSetNodeID ID;
   TupleType::Profile(ID, Fields);
 
-  if (TupleType *TT
-        = C.getImpl().getArena(arena).TupleTypes.FindNodeOrInsertPos(ID,InsertPos))
+  if (arena == AllocationArena::Permanent) {
+    // Lock-striped path: finding an existing tuple type takes only a
+    // shard's reader lock.
+    if (TupleType *TT = C.getImpl().PermanentTupleTypes.findNode(ID))
+      return TT;
+  } else if (TupleType *TT = C.getImpl().getSolverArena().TupleTypes
+                                 .FindNodeOrInsertPos(ID, InsertPos)) {
     return TT;
+  }
 
   bool IsCanonical = true;   // All canonical elts means this is canonical.
   for (const TupleTypeElt &Elt : Fields) {
@@ -2379,7 +2704,9 @@ Type TupleType::get(ArrayRef<TupleTypeElt> Fields, const ASTContext &C) {
                          alignof(TupleType), arena);
   auto New = new (mem) TupleType(Fields, IsCanonical ? &C : nullptr, properties,
                                  hasElementWithOwnership);
-  C.getImpl().getArena(arena).TupleTypes.InsertNode(New, InsertPos);
+  if (arena == AllocationArena::Permanent)
+    return C.getImpl().PermanentTupleTypes.insertOrGetExisting(ID, New);
+  C.getImpl().getSolverArena().TupleTypes.InsertNode(New, InsertPos);
   return New;
 }
 
@@ -3033,9 +3360,14 @@ FunctionType *FunctionType::get(ArrayRef<AnyFunctionType::Param> params,
   const ASTContext &ctx = result->getASTContext();
 
   // Do we already have this generic function type?
-  void *insertPos;
-  if (auto funcTy =
-        ctx.getImpl().getArena(arena).FunctionTypes.FindNodeOrInsertPos(id, insertPos)) {
+  void *insertPos = nullptr;
+  if (arena == AllocationArena::Permanent) {
+    // Lock-striped path: finding an existing function type takes only a
+    // shard's reader lock.
+    if (auto funcTy = ctx.getImpl().PermanentFunctionTypes.findNode(id))
+      return funcTy;
+  } else if (auto funcTy = ctx.getImpl().getSolverArena().FunctionTypes
+                               .FindNodeOrInsertPos(id, insertPos)) {
     return funcTy;
   }
 
@@ -3057,7 +3389,9 @@ FunctionType *FunctionType::get(ArrayRef<AnyFunctionType::Param> params,
   auto funcTy = new (mem) FunctionType(params, result, info,
                                        isCanonical ? &ctx : nullptr,
                                        properties);
-  ctx.getImpl().getArena(arena).FunctionTypes.InsertNode(funcTy, insertPos);
+  if (arena == AllocationArena::Permanent)
+    return ctx.getImpl().PermanentFunctionTypes.insertOrGetExisting(id, funcTy);
+  ctx.getImpl().getSolverArena().FunctionTypes.InsertNode(funcTy, insertPos);
   return funcTy;
 }
 
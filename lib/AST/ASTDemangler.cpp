@@ -250,7 +250,7 @@ Type ASTBuilder::resolveOpaqueType(NodePointer opaqueDescriptor,
     auto definingDecl = opaqueDescriptor->getChild(0);
     auto definingGlobal = Factory.createNode(Node::Kind::Global);
     definingGlobal->addChild(definingDecl, Factory);
-    auto mangledName = mangleNode(definingGlobal);
+    auto mangledName = mangleNode(definingGlobal, Ctx.getManglingCache());
     
     auto moduleNode = findModuleNode(definingDecl);
     if (!moduleNode)
@@ -930,7 +930,7 @@ ASTBuilder::findDeclContext(NodePointer node) {
       if (!module) return nullptr;
 
       // Look up the local type by its mangling.
-      auto mangledName = Demangle::mangleNode(node);
+      auto mangledName = Demangle::mangleNode(node, Ctx.getManglingCache());
       auto decl = module->lookupLocalType(mangledName);
       if (!decl) return nullptr;
 
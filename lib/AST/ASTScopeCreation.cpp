@@ -1111,6 +1111,24 @@ void ASTScopeImpl::disownDescendants(ScopeCreator &scopeCreator) {
   removeChildren();
 }
 
+void ASTScopeImpl::removeChildrenFrom(unsigned count,
+                                      ScopeCreator &scopeCreator) {
+  if (storedChildren.size() <= count)
+    return;
+  clearCachedSourceRangesOfMeAndAncestors();
+  const unsigned numRemoved = storedChildren.size() - count;
+  while (storedChildren.size() > count) {
+    auto *c = storedChildren.back();
+    c->disownDescendants(scopeCreator);
+    c->emancipate();
+    scopeCreator.scopedNodes.erase(c);
+    storedChildren.pop_back();
+  }
+  // Scopes rescued from above in the AST are always trailing children, so
+  // any among the removed ones are gone now.
+  astAncestorScopeCount -= std::min(astAncestorScopeCount, numRemoved);
+}
+
 #pragma mark implementations of expansion
 
 ASTScopeImpl *
@@ -1231,17 +1249,72 @@ ASTSourceFileScope::expandAScopeThatCreatesANewInsertionPoint(
     ScopeCreator &scopeCreator) {
   ASTScopeAssert(SF, "Must already have a SourceFile.");
   ArrayRef<Decl *> decls = SF->getTopLevelDecls();
-  // Assume that decls are only added at the end, in source order
-  ArrayRef<Decl *> newDecls = decls.slice(numberOfDeclsAlreadySeen);
-  std::vector<ASTNode> newNodes(newDecls.begin(), newDecls.end());
-  insertionPoint =
-      scopeCreator.addSiblingsToScopeTree(insertionPoint, this, newNodes);
+
+  // Determine how many already-seen declarations are unchanged. An edit
+  // that replaces or removes a declaration invalidates its record and every
+  // record after it, since later scopes can be nested in earlier insertion
+  // points.
+  unsigned numUnchanged = 0;
+  while (numUnchanged < topLevelDeclsAlreadySeen.size() &&
+         numUnchanged < decls.size() &&
+         topLevelDeclsAlreadySeen[numUnchanged].matches(decls[numUnchanged]))
+    ++numUnchanged;
+
+  if (numUnchanged < topLevelDeclsAlreadySeen.size()) {
+    if (!rollBackScopesForChangedDecls(numUnchanged, scopeCreator))
+      numUnchanged = 0;
+  }
+
+  // Create scopes for the remaining declarations one at a time, in source
+  // order, recording where each insertion happened so that it can be undone
+  // if the declaration is later edited.
+  for (auto *d : decls.slice(numUnchanged)) {
+    TopLevelDeclRecord record{d, d->getSourceRange(), insertionPoint,
+                              unsigned(insertionPoint->getChildren().size())};
+    std::vector<ASTNode> newNodes(1, d);
+    insertionPoint =
+        scopeCreator.addSiblingsToScopeTree(insertionPoint, this, newNodes);
+    topLevelDeclsAlreadySeen.push_back(record);
+  }
   // Too slow to perform all the time:
   //    ASTScopeAssert(scopeCreator->containsAllDeclContextsFromAST(),
   //           "ASTScope tree missed some DeclContexts or made some up");
   return {insertionPoint, "Next time decls are added they go here."};
 }
 
+bool ASTSourceFileScope::rollBackScopesForChangedDecls(
+    unsigned firstChanged, ScopeCreator &scopeCreator) {
+  // If the tree has diverged from the records--e.g. because an insertion
+  // point was itself reexpanded--give up and rebuild every declaration's
+  // scopes.
+  for (unsigned i = firstChanged, e = topLevelDeclsAlreadySeen.size(); i != e;
+       ++i) {
+    auto &record = topLevelDeclsAlreadySeen[i];
+    if (record.insertionPointBeforehand->getChildren().size() <
+        record.numChildrenBeforehand) {
+      disownDescendants(scopeCreator);
+      topLevelDeclsAlreadySeen.clear();
+      insertionPoint = this;
+      return false;
+    }
+  }
+
+  // Remove the changed declarations' scopes in reverse source order, so
+  // that each record's insertion point is still wired into the tree when
+  // the record is processed.
+  auto *restoredInsertionPoint =
+      topLevelDeclsAlreadySeen[firstChanged].insertionPointBeforehand;
+  for (unsigned i = topLevelDeclsAlreadySeen.size(); i-- != firstChanged;) {
+    auto &record = topLevelDeclsAlreadySeen[i];
+    record.insertionPointBeforehand->removeChildrenFrom(
+        record.numChildrenBeforehand, scopeCreator);
+  }
+  topLevelDeclsAlreadySeen.erase(topLevelDeclsAlreadySeen.begin() + firstChanged,
+                                 topLevelDeclsAlreadySeen.end());
+  insertionPoint = restoredInsertionPoint;
+  return true;
+}
+
 AnnotatedInsertionPoint
 ParameterListScope::expandAScopeThatCreatesANewInsertionPoint(
     ScopeCreator &scopeCreator) {
@@ -1908,10 +1981,19 @@ void ASTScopeImpl::beCurrent() {}
 bool ASTScopeImpl::isCurrentIfWasExpanded() const { return true; }
 
 void ASTSourceFileScope::beCurrent() {
-  numberOfDeclsAlreadySeen = SF->getTopLevelDecls().size();
+  // Expansion records each top-level declaration as its scopes are created.
 }
 bool ASTSourceFileScope::isCurrentIfWasExpanded() const {
-  return SF->getTopLevelDecls().size() == numberOfDeclsAlreadySeen;
+  // Only compare declaration identities here; this runs on every lookup,
+  // and in-place mutations of a declaration are caught by the currency
+  // checks of the scopes within it.
+  ArrayRef<Decl *> decls = SF->getTopLevelDecls();
+  if (decls.size() != topLevelDeclsAlreadySeen.size())
+    return false;
+  for (unsigned i = 0, e = decls.size(); i != e; ++i)
+    if (decls[i] != topLevelDeclsAlreadySeen[i].decl)
+      return false;
+  return true;
 }
 
 void IterableTypeScope::beCurrent() { portion->beCurrent(this); }
@@ -32,6 +32,7 @@
 #include "swift/AST/Type.h"
 #include "swift/AST/TypeVisitor.h"
 #include "swift/Basic/LLVM.h"
+#include "swift/Basic/Statistic.h"
 
 #include "clang/AST/ASTContext.h"
 #include "clang/Basic/TargetInfo.h"
@@ -329,26 +330,20 @@ ClangTypeConverter::reverseBuiltinTypeMapping(StructType *type) {
       // Map UInt to uintptr_t
       auto swiftUIntType = getNamedSwiftType(stdlib, "UInt");
       auto clangUIntPtrType = ctx.getCanonicalType(ctx.getUIntPtrType());
-      Cache.insert({swiftUIntType, clangUIntPtrType});
+      Cache.insert({swiftUIntType->getCanonicalType(), clangUIntPtrType});
 
       // Map Int to intptr_t
       auto swiftIntType = getNamedSwiftType(stdlib, "Int");
       auto clangIntPtrType = ctx.getCanonicalType(ctx.getIntPtrType());
-      Cache.insert({swiftIntType, clangIntPtrType});
+      Cache.insert({swiftIntType->getCanonicalType(), clangIntPtrType});
     }
     StdlibTypesAreCached = true;
   }
 
-  auto it = Cache.find(Type(type));
+  auto it = Cache.find(type->getCanonicalType());
   if (it != Cache.end())
     return it->second;
 
-  it = Cache.find(type->getCanonicalType());
-  if (it != Cache.end()) {
-    Cache.insert({Type(type), it->second});
-    return it->second;
-  }
-
   return clang::QualType();
 }
 
@@ -702,9 +697,14 @@ clang::QualType ClangTypeConverter::visit(Type type) {
 }
 
 clang::QualType ClangTypeConverter::convert(Type type) {
-  auto it = Cache.find(type);
-  if (it != Cache.end())
+  // Look up the canonical type so that sugared spellings share an entry.
+  auto canTy = type->getCanonicalType();
+  auto it = Cache.find(canTy);
+  if (it != Cache.end()) {
+    if (Context.Stats)
+      Context.Stats->getFrontendCounters().ClangTypeConverterCacheHit++;
     return it->second;
+  }
 
   // Try to do this without making cache entries for obvious cases.
   if (auto nominal = type->getAs<NominalType>()) {
@@ -727,8 +727,16 @@ clang::QualType ClangTypeConverter::convert(Type type) {
   }
 
   // If that failed, convert the type, cache, and return.
+  if (Context.Stats)
+    Context.Stats->getFrontendCounters().ClangTypeConverterCacheMiss++;
+
   clang::QualType result = visit(type);
-  Cache.insert({type, result});
+
+  // Don't cache types allocated in the constraint solver's arena; they are
+  // torn down with the constraint system, and the entry would outlive its
+  // key.
+  if (!canTy->hasTypeVariable())
+    Cache.insert({canTy, result});
   return result;
 }
 
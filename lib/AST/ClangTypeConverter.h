@@ -32,7 +32,11 @@ class ClangTypeConverter :
 
   using super = TypeVisitor<ClangTypeConverter, clang::QualType>;
 
-  llvm::DenseMap<Type, clang::QualType> Cache;
+  /// Memoized lowerings, keyed on the canonical type so different sugared
+  /// spellings of a type share one entry. Entries are never invalidated:
+  /// only permanent-arena types are cached, and the converter lives as long
+  /// as the ASTContext that owns them.
+  llvm::DenseMap<CanType, clang::QualType> Cache;
   llvm::DenseMap<const clang::Decl *, swift::Decl *> ReversedExportMap;
 
   bool StdlibTypesAreCached = false;
@@ -6743,6 +6743,17 @@ void AbstractFunctionDecl::setBody(BraceStmt *S, BodyKind NewBodyKind) {
   }
 }
 
+void AbstractFunctionDecl::setBodyFingerprint(uint64_t fingerprint) {
+  assert((getBodyKind() == BodyKind::Unparsed ||
+          getBodyKind() == BodyKind::Skipped) &&
+         "Only delayed or skipped bodies have a fingerprint");
+  getASTContext().setBodyFingerprint(this, fingerprint);
+}
+
+Optional<uint64_t> AbstractFunctionDecl::getBodyFingerprint() const {
+  return getASTContext().getBodyFingerprint(this);
+}
+
 SourceRange AbstractFunctionDecl::getBodySourceRange() const {
   switch (getBodyKind()) {
   case BodyKind::None:
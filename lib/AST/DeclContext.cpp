@@ -954,11 +954,10 @@ Optional<std::string> IterableDeclContext::getBodyFingerprint() const {
 
 bool IterableDeclContext::areTokensHashedForThisBodyInsteadOfInterfaceHash()
     const {
-  // Do not keep separate hashes for extension bodies because the dependencies
-  // can miss the addition of a member in an extension because there is nothing
-  // corresponding to the fingerprinted nominal dependency node.
-  if (isa<ExtensionDecl>(this))
-    return false;
+  // Extensions keep separate hashes, too: the dependency graph folds an
+  // extension's fingerprint into the nodes of the extended nominal, so the
+  // addition of a member in an extension still dirties the right dependents
+  // without perturbing the file's interface hash.
   return getASTContext().LangOpts.EnableTypeFingerprints;
 }
 
@@ -973,6 +973,13 @@ DiagnosticEngine::diagnosticInfoForDiagnostic(const Diagnostic &diagnostic) {
       diagnostic.getRanges(), diagnostic.getFixIts(), diagnostic.isChildNote());
 }
 
+/// Actually leave the active diagnostic and deliver it to the consumers.
+///
+/// Note that no message text is produced here: the DiagnosticInfo handed to
+/// each consumer carries the format string and the still-boxed arguments,
+/// and rendering via formatDiagnosticText happens inside whichever consumer
+/// decides to display the diagnostic. A consumer that filters, counts, or
+/// re-encodes by ID never pays for formatting at all.
 void DiagnosticEngine::emitDiagnostic(const Diagnostic &diagnostic) {
   if (auto info = diagnosticInfoForDiagnostic(diagnostic)) {
     SmallVector<DiagnosticInfo, 1> childInfo;
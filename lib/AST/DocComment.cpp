@@ -291,15 +291,8 @@ bool extractSimpleField(
 void swift::printBriefComment(RawComment RC, llvm::raw_ostream &OS) {
   markup::MarkupContext MC;
   markup::LineList LL = MC.getLineList(RC);
-  auto *markupDoc = markup::parseDocument(MC, LL);
-
-  auto children = markupDoc->getChildren();
-  if (children.empty())
-    return;
-  auto FirstParagraph = dyn_cast<swift::markup::Paragraph>(children.front());
-  if (!FirstParagraph)
-    return;
-  swift::markup::printInlinesUnder(FirstParagraph, OS);
+  if (auto *Brief = markup::parseDocumentBrief(MC, LL))
+    swift::markup::printInlinesUnder(Brief, OS);
 }
 
 swift::markup::CommentParts
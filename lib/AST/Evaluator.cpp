@@ -147,11 +147,7 @@ void Evaluator::printDependencies(
   }
 
   // Print the cached value, if known.
-  auto cachedValue = cache.find(request);
-  if (cachedValue != cache.end()) {
-    out << " -> ";
-    printEscapedString(cachedValue->second.getAsString(), out);
-  }
+  printCachedValue(request, out);
 
   if (!visitedAnywhere.insert(request).second) {
     // We've already seed this node. Check whether it's part of a cycle.
@@ -204,6 +200,23 @@ void Evaluator::printDependencies(
   }
 }
 
+void Evaluator::printCachedValue(const AnyRequest &request,
+                                 llvm::raw_ostream &out) const {
+  auto known = requestCaches.find(request.getTypeID());
+  if (known == requestCaches.end())
+    return;
+
+  std::string value;
+  {
+    llvm::raw_string_ostream valueOut(value);
+    if (!known->second.printCachedValue(request, valueOut))
+      return;
+  }
+
+  out << " -> ";
+  printEscapedString(value, out);
+}
+
 void Evaluator::dumpDependencies(const AnyRequest &request) const {
   printDependencies(request, llvm::dbgs());
 }
@@ -311,11 +324,7 @@ void Evaluator::printDependenciesGraphviz(llvm::raw_ostream &out) const {
     out << " [label=\"";
     printEscapedString(request.getAsString(), out);
 
-    auto cachedValue = cache.find(request);
-    if (cachedValue != cache.end()) {
-      out << " -> ";
-      printEscapedString(cachedValue->second.getAsString(), out);
-    }
+    printCachedValue(request, out);
     out << "\"";
 
     if (auto color = getColor(request)) {
@@ -50,6 +50,16 @@ Optional<SourceFileDepGraph> SourceFileDepGraph::loadFromPath(StringRef path) {
   return loadFromBuffer(*bufferOrError.get());
 }
 
+/// Parse a serialized SourceFileDepGraph out of a swiftdeps buffer.
+///
+/// The on-disk form is YAML on purpose: the incremental system leans heavily
+/// on swiftdeps files being readable and diffable while the scheme is still
+/// evolving, and that outweighs parse speed at the current scale. A
+/// directly-mappable binary image would also not save
+/// as much as it appears: the driver does not use a SourceFileDepGraph in
+/// place but integrates each node into its own ModuleDepGraph
+/// representation, so the per-node traversal happens regardless of how the
+/// bytes were decoded.
 Optional<SourceFileDepGraph>
 SourceFileDepGraph::loadFromBuffer(llvm::MemoryBuffer &buffer) {
   SourceFileDepGraph fg;
@@ -41,6 +41,7 @@
 #include "llvm/ADT/SetVector.h"
 #include "llvm/ADT/SmallVector.h"
 #include "llvm/Support/FileSystem.h"
+#include "llvm/Support/MD5.h"
 #include "llvm/Support/Path.h"
 #include "llvm/Support/YAMLParser.h"
 
@@ -588,12 +589,44 @@ Optional<std::string> FrontendSourceFileDepGraphFactory::getFingerprintIfAny(
   return None;
 }
 Optional<std::string>
-FrontendSourceFileDepGraphFactory::getFingerprintIfAny(const Decl *d) {
-  if (const auto *idc = dyn_cast<IterableDeclContext>(d)) {
-    auto result = idc->getBodyFingerprint();
-    assert((!result || !result->empty()) &&
-           "Fingerprint should never be empty");
-    return result;
+FrontendSourceFileDepGraphFactory::getFingerprintIfAny(const Decl *d) const {
+  const auto *idc = dyn_cast<IterableDeclContext>(d);
+  if (!idc)
+    return None;
+
+  SmallVector<std::string, 4> fingerprints;
+  if (auto bodyFP = idc->getBodyFingerprint()) {
+    assert(!bodyFP->empty() && "Fingerprint should never be empty");
+    fingerprints.push_back(std::move(*bodyFP));
   }
-  return None;
+
+  // Extensions in this file can add members to the nominal, and their body
+  // tokens are hashed separately from the file's interface hash, so changes
+  // there must surface through the nominal's fingerprint. Extensions in
+  // other files contribute to their own file's nodes for this nominal.
+  if (const auto *nominal = dyn_cast<NominalTypeDecl>(d)) {
+    for (auto *ED : nominal->getExtensions()) {
+      if (ED->getParentSourceFile() != SF)
+        continue;
+      if (auto extFP = ED->getBodyFingerprint()) {
+        assert(!extFP->empty() && "Fingerprint should never be empty");
+        fingerprints.push_back(std::move(*extFP));
+      }
+    }
+  }
+
+  if (fingerprints.empty())
+    return None;
+  if (fingerprints.size() == 1)
+    return fingerprints.front();
+
+  // Combine the fingerprints, in source order, into one stable hash.
+  llvm::MD5 hash;
+  for (const auto &fp : fingerprints)
+    hash.update(fp);
+  llvm::MD5::MD5Result result;
+  hash.final(result);
+  llvm::SmallString<32> combined;
+  llvm::MD5::stringifyResult(result, combined);
+  return combined.str().str();
 }
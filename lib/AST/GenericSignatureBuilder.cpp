@@ -118,6 +118,10 @@ STATISTIC(NumRewriteRhsSimplified,
           "# of rewrite rule right-hand sides simplified");
 STATISTIC(NumRewriteRhsSimplifiedToLhs,
           "# of rewrite rule right-hand sides simplified to lhs (and removed)");
+STATISTIC(NumCanonicalTypeParameterCacheHits,
+          "# of canonical type parameter cache hits");
+STATISTIC(NumCanonicalTypeParameterCacheMisses,
+          "# of canonical type parameter cache misses");
 STATISTIC(NumRewriteRulesRedundant,
           "# of rewrite rules that are redundant (and removed)");
 
@@ -448,6 +452,15 @@ struct GenericSignatureBuilder::Implementation {
   /// increased every time a new rule gets added.
   unsigned RewriteGeneration = 0;
 
+  /// Memoized normal forms computed by \c getCanonicalTypeParameter(),
+  /// keyed by the canonical form of the query type. Entries are only
+  /// valid for the rewrite generation at which they were recorded.
+  llvm::DenseMap<CanType, Type> CanonicalTypeParameterCache;
+
+  /// The rewrite generation for which the entries of
+  /// \c CanonicalTypeParameterCache were computed.
+  unsigned CanonicalTypeParameterCacheGeneration = 0;
+
   /// The generation at which the term-rewriting system was last minimized.
   unsigned LastRewriteMinimizedGeneration = 0;
 
@@ -3375,6 +3388,26 @@ bool GenericSignatureBuilder::addSameTypeRewriteRule(CanType type1,
 }
 
 Type GenericSignatureBuilder::getCanonicalTypeParameter(Type type) {
+  // Consult the memoized normal forms, flushing them if the rewrite system
+  // has picked up new rules since they were recorded. The cache is bypassed
+  // during minimization, because rules are temporarily disabled there and
+  // normal forms computed in that state do not hold generally.
+  CanType cacheKey;
+  if (!Impl->MinimizingRewriteSystem) {
+    cacheKey = type->getCanonicalType();
+    if (Impl->CanonicalTypeParameterCacheGeneration != Impl->RewriteGeneration) {
+      Impl->CanonicalTypeParameterCache.clear();
+      Impl->CanonicalTypeParameterCacheGeneration = Impl->RewriteGeneration;
+    } else {
+      auto known = Impl->CanonicalTypeParameterCache.find(cacheKey);
+      if (known != Impl->CanonicalTypeParameterCache.end()) {
+        ++NumCanonicalTypeParameterCacheHits;
+        return known->second;
+      }
+    }
+    ++NumCanonicalTypeParameterCacheMisses;
+  }
+
   auto initialPath = RewritePath::createPath(type);
   auto genericParamType =
     GenericTypeParamType::get(initialPath.getBase()->Depth,
@@ -3434,7 +3467,10 @@ Type GenericSignatureBuilder::getCanonicalTypeParameter(Type type) {
     currentType = DependentMemberType::get(currentType, path[startIndex++]);
   } while (true);
 
-  return formDependentType(genericParamType, path);
+  auto result = formDependentType(genericParamType, path);
+  if (cacheKey)
+    Impl->CanonicalTypeParameterCache.insert({cacheKey, result});
+  return result;
 }
 
 #pragma mark Equivalence classes
@@ -189,6 +189,37 @@ ImportSet &ImportCache::getImportSet(const DeclContext *dc) {
   return result;
 }
 
+unsigned ImportCache::getModuleIndex(const ModuleDecl *mod) {
+  return ModuleIndices.try_emplace(mod, ModuleIndices.size()).first->second;
+}
+
+const llvm::BitVector &ImportCache::getImportBitset(const ImportSet &imports) {
+  auto found = ImportBitsets.find(&imports);
+  if (found != ImportBitsets.end())
+    return found->second;
+
+  llvm::BitVector bits;
+  for (auto next : imports.getAllImports()) {
+    unsigned index = getModuleIndex(next.second);
+    if (index >= bits.size())
+      bits.resize(index + 1);
+    bits.set(index);
+  }
+  return ImportBitsets.try_emplace(&imports, std::move(bits)).first->second;
+}
+
+bool ImportCache::isImportedBy(const ModuleDecl *mod, const DeclContext *dc) {
+  // Build the bitset for 'dc' first: if 'mod' has no index yet, it may
+  // still be about to receive one from this very import set.
+  auto &bits = getImportBitset(getImportSet(dc));
+
+  auto known = ModuleIndices.find(mod);
+  if (known == ModuleIndices.end())
+    return false;
+
+  return known->second < bits.size() && bits.test(known->second);
+}
+
 ArrayRef<ModuleDecl::AccessPathTy> ImportCache::allocateArray(
     ASTContext &ctx,
     SmallVectorImpl<ModuleDecl::AccessPathTy> &results) {
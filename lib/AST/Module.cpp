@@ -1043,6 +1043,7 @@ namespace {
 
   template <>
   struct OperatorLookup<PrefixOperatorDecl> {
+    static const unsigned cacheKind = 0;
     static PrefixOperatorDecl *lookup(Evaluator &eval,
                                       const OperatorLookupDescriptor &desc) {
       // We can return the first prefix operator. All prefix operators of the
@@ -1055,6 +1056,7 @@ namespace {
 
   template <>
   struct OperatorLookup<InfixOperatorDecl> {
+    static const unsigned cacheKind = 1;
     static InfixOperatorDecl *lookup(Evaluator &eval,
                                      const OperatorLookupDescriptor &desc) {
       // Return the first result if it exists.
@@ -1066,6 +1068,7 @@ namespace {
 
   template <>
   struct OperatorLookup<PostfixOperatorDecl> {
+    static const unsigned cacheKind = 2;
     static PostfixOperatorDecl *lookup(Evaluator &eval,
                                        const OperatorLookupDescriptor &desc) {
       // We can return the first postfix operator. All postfix operators of the
@@ -1078,6 +1081,7 @@ namespace {
 
   template <>
   struct OperatorLookup<PrecedenceGroupDecl> {
+    static const unsigned cacheKind = 3;
     static PrecedenceGroupDecl *lookup(Evaluator &eval,
                                        const OperatorLookupDescriptor &desc) {
       // Return the first result if it exists.
@@ -1088,6 +1092,16 @@ namespace {
   };
 } // end anonymous namespace
 
+/// A helper class to sneak around C++ access control rules.
+class ModuleDecl::Impl {
+public:
+  /// Only intended for use by lookupOperatorDeclForName.
+  static decltype(ModuleDecl::OperatorLookupCache) &
+  getOperatorLookupCache(ModuleDecl &M) {
+    return M.OperatorLookupCache;
+  }
+};
+
 /// A helper class to sneak around C++ access control rules.
 class SourceFile::Impl {
 public:
@@ -1243,19 +1257,38 @@ template<typename OP_DECL>
 static Optional<OP_DECL *>
 lookupOperatorDeclForName(ModuleDecl *M, SourceLoc Loc, Identifier Name,
                           bool isCascading) {
-  OP_DECL *result = nullptr;
+  // The merged result for a module is queried again for the same name by
+  // every file and module that imports it, so memoize it here. A cached
+  // None records an ambiguity; its diagnostics were emitted by the lookup
+  // that populated the cache.
+  auto &cache = ModuleDecl::Impl::getOperatorLookupCache(*M);
+  auto key = std::make_pair(Name, OperatorLookup<OP_DECL>::cacheKind);
+  auto known = cache.find(key);
+  if (known != cache.end()) {
+    if (!known->second.hasValue())
+      return None;
+    return cast_or_null<OP_DECL>(known->second.getValue());
+  }
+
+  Optional<OP_DECL *> result = nullptr;
   for (const FileUnit *File : M->getFiles()) {
     auto next = lookupOperatorDeclForName<OP_DECL>(*File, Loc, Name, false,
                                                    isCascading);
-    if (!next.hasValue())
-      return next;
+    if (!next.hasValue()) {
+      result = next;
+      break;
+    }
 
     // FIXME: Diagnose ambiguity.
-    if (*next && result)
-      return None;
+    if (*next && *result) {
+      result = None;
+      break;
+    }
     if (*next)
       result = *next;
   }
+
+  cache[key] = result.hasValue() ? Optional<Decl *>(*result) : None;
   return result;
 }
 
@@ -2225,6 +2258,7 @@ bool SourceFile::shouldCrossImport() const {
 
 void ModuleDecl::clearLookupCache() {
   getASTContext().getImportCache().clear();
+  OperatorLookupCache.clear();
 
   if (!Cache)
     return;
@@ -1216,6 +1216,15 @@ void NominalTypeDecl::prepareLookupTable() {
   }
 }
 
+/// Whether any known extension of \p nominal can answer a lookup by name
+/// without materializing its full member list.
+static bool anyExtensionHasLazyMembers(NominalTypeDecl *nominal) {
+  for (auto *e : nominal->getExtensions())
+    if (e->hasLazyMembers())
+      return true;
+  return false;
+}
+
 static TinyPtrVector<ValueDecl *>
 maybeFilterOutAttrImplements(TinyPtrVector<ValueDecl *> decls,
                              DeclName name,
@@ -1252,11 +1261,15 @@ DirectLookupRequest::evaluate(Evaluator &evaluator,
   const auto flags = desc.Options;
   auto *decl = desc.DC;
 
-  // We only use NamedLazyMemberLoading when a user opts-in and we have
-  // not yet loaded all the members into the IDC list in the first place.
+  // We only use NamedLazyMemberLoading when a user opts-in and some of the
+  // members--the nominal's own or those of one of its extensions--have not
+  // yet been loaded into the IDC lists in the first place. A fully-loaded
+  // nominal with lazy extensions (e.g. a source-defined class extended by
+  // an imported module) would otherwise force every extension's members.
   ASTContext &ctx = decl->getASTContext();
-  const bool useNamedLazyMemberLoading = (ctx.LangOpts.NamedLazyMemberLoading &&
-                                          decl->hasLazyMembers());
+  const bool useNamedLazyMemberLoading =
+      (ctx.LangOpts.NamedLazyMemberLoading &&
+       (decl->hasLazyMembers() || anyExtensionHasLazyMembers(decl)));
   const bool disableAdditionalExtensionLoading =
       flags.contains(NominalTypeDecl::LookupDirectFlags::IgnoreNewExtensions);
   const bool includeAttrImplements =
@@ -1289,15 +1302,17 @@ DirectLookupRequest::evaluate(Evaluator &evaluator,
     // was registered since the last time we searched. Ask the loaders to give
     // us a hand.
     DeclBaseName baseName(name.getBaseName());
-    populateLookupTableEntryFromLazyIDCLoader(ctx, Table, baseName, decl);
+    if (decl->hasLazyMembers())
+      populateLookupTableEntryFromLazyIDCLoader(ctx, Table, baseName, decl);
 
     if (!disableAdditionalExtensionLoading) {
       populateLookupTableEntryFromExtensions(ctx, Table, baseName, decl);
-    }
 
-    // FIXME: If disableAdditionalExtensionLoading is true, we should
-    // not mark the entry as complete.
-    Table.markLazilyComplete(baseName);
+      // Only remember the name as complete when the extensions were
+      // consulted too; otherwise a later unrestricted lookup would wrongly
+      // skip them.
+      Table.markLazilyComplete(baseName);
+    }
   }
 
   // Look for a declaration with this name.
@@ -22,6 +22,7 @@
 #include "swift/AST/FileUnit.h"
 #include "swift/AST/Module.h"
 #include "swift/AST/PrettyStackTrace.h"
+#include "swift/AST/SourceFile.h"
 #include "swift/AST/Types.h"
 #include "swift/Basic/PrimitiveParsing.h"
 #include "swift/Basic/SourceManager.h"
@@ -168,9 +169,19 @@ RawComment Decl::getRawComment(bool SerializedOK) const {
       Context.setRawComment(this, C->Raw);
       return C->Raw;
     }
+
+    // Remember that the search came up empty so the USR computation and
+    // comment table probes above don't run again for the next request.
+    // A search that wasn't allowed to consult the serialized source
+    // information isn't exhaustive unless the decl is in a source file,
+    // where the doc comment attribute is the only possible source.
+    if (SerializedOK || isa<SourceFile>(Unit))
+      Context.setRawComment(this, RawComment());
+    return RawComment();
   }
 
-  // Give up.
+  // There is nowhere else to look.
+  Context.setRawComment(this, RawComment());
   return RawComment();
 }
 
@@ -14,12 +14,16 @@
 #include "Darwin/Cache-Mac.cpp"
 #else
 
-//  This file implements a default caching implementation that never evicts
-//  its entries.
+//  This file implements a default caching implementation that keeps its
+//  entries in least-recently-used order. Entries are evicted when a cache
+//  exceeds its cost budget, or when a memory-pressure handler asks every
+//  cache in the process to shed weight via \c trimAllCaches().
 
 #include "swift/Basic/Cache.h"
 #include "llvm/ADT/DenseMap.h"
 #include "llvm/Support/Mutex.h"
+#include <algorithm>
+#include <vector>
 
 using namespace swift::sys;
 using llvm::StringRef;
@@ -33,12 +37,47 @@ struct DefaultCacheKey {
   DefaultCacheKey(void *Key, CacheImpl::CallBacks *CBs) : Key(Key), CBs(CBs) {}
 };
 
+/// A cache entry, linked into its cache's LRU list.  The most recently used
+/// entry is at the head of the list.
+struct DefaultCacheEntry {
+  void *Key;
+  void *Value;
+  size_t Cost;
+  DefaultCacheEntry *Prev = nullptr;
+  DefaultCacheEntry *Next = nullptr;
+
+  DefaultCacheEntry(void *Key, void *Value, size_t Cost)
+      : Key(Key), Value(Value), Cost(Cost) {}
+};
+
 struct DefaultCache {
   llvm::sys::Mutex Mux;
   CacheImpl::CallBacks CBs;
-  llvm::DenseMap<DefaultCacheKey, void *> Entries;
+  llvm::DenseMap<DefaultCacheKey, DefaultCacheEntry *> Entries;
+  DefaultCacheEntry *MostRecent = nullptr;
+  DefaultCacheEntry *LeastRecent = nullptr;
+  size_t TotalCost = 0;
+  size_t CostLimit = 0; ///< Zero means unbounded.
 
   explicit DefaultCache(CacheImpl::CallBacks CBs) : CBs(std::move(CBs)) { }
+
+  // All of the following require Mux to be locked by the caller.
+  void unlink(DefaultCacheEntry *Entry);
+  void linkAsMostRecent(DefaultCacheEntry *Entry);
+  void evict(DefaultCacheEntry *Entry);
+  void evictDownTo(size_t CostTarget, size_t CountTarget);
+};
+
+/// All caches created in this process, so that a memory-pressure response
+/// can trim every one of them.
+struct CacheRegistry {
+  llvm::sys::Mutex Mux;
+  std::vector<DefaultCache *> Caches;
+
+  static CacheRegistry &get() {
+    static CacheRegistry Registry;
+    return Registry;
+  }
 };
 } // end anonymous namespace
 
@@ -67,8 +106,49 @@ template<> struct DenseMapInfo<DefaultCacheKey> {
 };
 } // namespace llvm
 
+void DefaultCache::unlink(DefaultCacheEntry *Entry) {
+  if (Entry->Prev)
+    Entry->Prev->Next = Entry->Next;
+  else
+    MostRecent = Entry->Next;
+  if (Entry->Next)
+    Entry->Next->Prev = Entry->Prev;
+  else
+    LeastRecent = Entry->Prev;
+  Entry->Prev = Entry->Next = nullptr;
+}
+
+void DefaultCache::linkAsMostRecent(DefaultCacheEntry *Entry) {
+  Entry->Next = MostRecent;
+  if (MostRecent)
+    MostRecent->Prev = Entry;
+  else
+    LeastRecent = Entry;
+  MostRecent = Entry;
+}
+
+void DefaultCache::evict(DefaultCacheEntry *Entry) {
+  // Erase the map entry before destroying the key; the map hashes through it.
+  Entries.erase(DefaultCacheKey(Entry->Key, &CBs));
+  unlink(Entry);
+  TotalCost -= Entry->Cost;
+  CBs.keyDestroyCB(Entry->Key, nullptr);
+  CBs.valueReleaseCB(Entry->Value, nullptr);
+  delete Entry;
+}
+
+void DefaultCache::evictDownTo(size_t CostTarget, size_t CountTarget) {
+  while (LeastRecent &&
+         (TotalCost > CostTarget || Entries.size() > CountTarget))
+    evict(LeastRecent);
+}
+
 CacheImpl::ImplTy CacheImpl::create(StringRef Name, const CallBacks &CBs) {
-  return new DefaultCache(CBs);
+  DefaultCache *DCache = new DefaultCache(CBs);
+  CacheRegistry &Registry = CacheRegistry::get();
+  llvm::sys::ScopedLock L(Registry.Mux);
+  Registry.Caches.push_back(DCache);
+  return DCache;
 }
 
 void CacheImpl::setAndRetain(void *Key, void *Value, size_t Cost) {
@@ -81,22 +161,37 @@ void CacheImpl::setAndRetain(void *Key, void *Value, size_t Cost) {
   // If there is no existing entry, retain the value and insert the entry.
   if (Entry == DCache.Entries.end()) {
     DCache.CBs.valueRetainCB(Value, nullptr);
-    DCache.Entries[CKey] = Value;
+    DefaultCacheEntry *NewEntry = new DefaultCacheEntry(Key, Value, Cost);
+    DCache.Entries[CKey] = NewEntry;
+    DCache.linkAsMostRecent(NewEntry);
+    DCache.TotalCost += Cost;
+    if (DCache.CostLimit)
+      DCache.evictDownTo(DCache.CostLimit, size_t(-1));
     return;
   }
 
   // If there is an existing entry, the the original key and the new key are ==.
   // Swap the new key into the map and destroy the original key.
+  DefaultCacheEntry *ExistingEntry = Entry->second;
   std::swap(Entry->first.Key, Key);
+  ExistingEntry->Key = Entry->first.Key;
   DCache.CBs.keyDestroyCB(Key, nullptr);
 
   // Replace the value, if necessary.
-  if (Entry->second != Value) {
+  if (ExistingEntry->Value != Value) {
     DCache.CBs.valueRetainCB(Value, nullptr);
-    std::swap(Entry->second, Value);
+    std::swap(ExistingEntry->Value, Value);
     DCache.CBs.valueReleaseCB(Value, nullptr);
   }
 
+  // Storing counts as a use; update the cost and the recency order.
+  DCache.TotalCost += Cost - ExistingEntry->Cost;
+  ExistingEntry->Cost = Cost;
+  DCache.unlink(ExistingEntry);
+  DCache.linkAsMostRecent(ExistingEntry);
+  if (DCache.CostLimit)
+    DCache.evictDownTo(DCache.CostLimit, size_t(-1));
+
   // FIXME: Not thread-safe! It should avoid deleting the value until
   // 'releaseValue is called on it.
 }
@@ -110,7 +205,9 @@ bool CacheImpl::getAndRetain(const void *Key, void **Value_out) {
   if (Entry != DCache.Entries.end()) {
     // FIXME: Not thread-safe! It should avoid deleting the value until
     // 'releaseValue is called on it.
-    *Value_out = Entry->second;
+    DCache.unlink(Entry->second);
+    DCache.linkAsMostRecent(Entry->second);
+    *Value_out = Entry->second->Value;
     return true;
   }
   return false;
@@ -127,9 +224,7 @@ bool CacheImpl::remove(const void *Key) {
   DefaultCacheKey CKey(const_cast<void*>(Key), &DCache.CBs);
   auto Entry = DCache.Entries.find(CKey);
   if (Entry != DCache.Entries.end()) {
-    DCache.CBs.keyDestroyCB(Entry->first.Key, nullptr);
-    DCache.CBs.valueReleaseCB(Entry->second, nullptr);
-    DCache.Entries.erase(Entry);
+    DCache.evict(Entry->second);
     return true;
   }
   return false;
@@ -139,15 +234,50 @@ void CacheImpl::removeAll() {
   DefaultCache &DCache = *static_cast<DefaultCache*>(Impl);
   llvm::sys::ScopedLock L(DCache.Mux);
 
-  for (auto Entry : DCache.Entries) {
-    DCache.CBs.keyDestroyCB(Entry.first.Key, nullptr);
-    DCache.CBs.valueReleaseCB(Entry.second, nullptr);
+  DefaultCacheEntry *Entry = DCache.MostRecent;
+  while (Entry) {
+    DefaultCacheEntry *Next = Entry->Next;
+    DCache.CBs.keyDestroyCB(Entry->Key, nullptr);
+    DCache.CBs.valueReleaseCB(Entry->Value, nullptr);
+    delete Entry;
+    Entry = Next;
   }
   DCache.Entries.clear();
+  DCache.MostRecent = DCache.LeastRecent = nullptr;
+  DCache.TotalCost = 0;
+}
+
+void CacheImpl::setCostLimit(size_t Limit) {
+  DefaultCache &DCache = *static_cast<DefaultCache*>(Impl);
+  llvm::sys::ScopedLock L(DCache.Mux);
+  DCache.CostLimit = Limit;
+  if (Limit)
+    DCache.evictDownTo(Limit, size_t(-1));
+}
+
+void CacheImpl::trimAllCaches(double Fraction) {
+  if (Fraction < 0)
+    Fraction = 0;
+  CacheRegistry &Registry = CacheRegistry::get();
+  llvm::sys::ScopedLock RegistryLock(Registry.Mux);
+  for (DefaultCache *DCache : Registry.Caches) {
+    llvm::sys::ScopedLock L(DCache->Mux);
+    // Trim by entry count as well as by cost, so that caches whose values
+    // all report zero cost still shrink.
+    DCache->evictDownTo(size_t(DCache->TotalCost * Fraction),
+                        size_t(DCache->Entries.size() * Fraction));
+  }
 }
 
 void CacheImpl::destroy() {
   removeAll();
+  {
+    CacheRegistry &Registry = CacheRegistry::get();
+    llvm::sys::ScopedLock L(Registry.Mux);
+    auto &Caches = Registry.Caches;
+    Caches.erase(std::find(Caches.begin(), Caches.end(),
+                           static_cast<DefaultCache*>(Impl)));
+  }
   delete static_cast<DefaultCache*>(Impl);
 }
 
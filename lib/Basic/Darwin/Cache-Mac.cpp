@@ -65,6 +65,14 @@ void CacheImpl::removeAll() {
   cache_remove_all(static_cast<cache_t*>(Impl));
 }
 
+void CacheImpl::setCostLimit(size_t Limit) {
+  // libcache sizes itself; there is no per-cache budget to configure.
+}
+
+void CacheImpl::trimAllCaches(double Fraction) {
+  // libcache registers for memory-pressure notifications itself.
+}
+
 void CacheImpl::destroy() {
   cache_destroy(static_cast<cache_t*>(Impl));
 }
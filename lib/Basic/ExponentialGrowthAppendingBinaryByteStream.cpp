@@ -11,17 +11,80 @@
 //===----------------------------------------------------------------------===//
 
 #include "swift/Basic/ExponentialGrowthAppendingBinaryByteStream.h"
+#include "llvm/Support/raw_ostream.h"
 
 using namespace llvm;
 using namespace swift;
 
+constexpr size_t ExponentialGrowthAppendingBinaryByteStream::ChunkSize;
+
+void ExponentialGrowthAppendingBinaryByteStream::ensureCapacity(
+    size_t RequiredSize) {
+  assert(!IsFlat && "only used while the stream is chunked");
+  while (Chunks.size() * ChunkSize < RequiredSize) {
+    // make_unique value-initializes the chunk, so bytes that are skipped
+    // over by appends at the very end of the stream read back as zero.
+    Chunks.push_back(std::make_unique<uint8_t[]>(ChunkSize));
+  }
+  if (RequiredSize > StreamLength) {
+    StreamLength = RequiredSize;
+  }
+}
+
+void ExponentialGrowthAppendingBinaryByteStream::copyIntoChunks(
+    size_t Offset, ArrayRef<uint8_t> Buffer) {
+  while (!Buffer.empty()) {
+    size_t Within = Offset & (ChunkSize - 1);
+    size_t BytesInChunk = std::min(Buffer.size(), ChunkSize - Within);
+    ::memcpy(Chunks[Offset / ChunkSize].get() + Within, Buffer.data(),
+             BytesInChunk);
+    Offset += BytesInChunk;
+    Buffer = Buffer.drop_front(BytesInChunk);
+  }
+}
+
+void ExponentialGrowthAppendingBinaryByteStream::flatten() {
+  if (IsFlat) {
+    return;
+  }
+  FlatData.resize(StreamLength);
+  for (size_t Offset = 0; Offset < StreamLength; Offset += ChunkSize) {
+    size_t BytesInChunk = std::min(ChunkSize, StreamLength - Offset);
+    ::memcpy(FlatData.data() + Offset, Chunks[Offset / ChunkSize].get(),
+             BytesInChunk);
+  }
+  Chunks.clear();
+  IsFlat = true;
+}
+
 Error ExponentialGrowthAppendingBinaryByteStream::readBytes(
     uint32_t Offset, uint32_t Size, ArrayRef<uint8_t> &Buffer) {
   if (auto Error = checkOffsetForRead(Offset, Size)) {
     return Error;
   }
-  
-  Buffer = ArrayRef<uint8_t>(Data.data() + Offset, Size);
+
+  if (IsFlat) {
+    Buffer = ArrayRef<uint8_t>(FlatData.data() + Offset, Size);
+    return Error::success();
+  }
+
+  size_t Within = Offset & (ChunkSize - 1);
+  if (Size == 0 || Within + Size <= ChunkSize) {
+    Buffer = ArrayRef<uint8_t>(
+        Size == 0 ? nullptr : Chunks[Offset / ChunkSize].get() + Within, Size);
+    return Error::success();
+  }
+
+  // The range straddles a chunk boundary, so hand out a stable copy.
+  uint8_t *Copy = StraddleCopies.Allocate<uint8_t>(Size);
+  for (size_t I = 0; I < Size; ) {
+    size_t ChunkOffset = (Offset + I) & (ChunkSize - 1);
+    size_t BytesInChunk = std::min(size_t(Size) - I, ChunkSize - ChunkOffset);
+    ::memcpy(Copy + I, Chunks[(Offset + I) / ChunkSize].get() + ChunkOffset,
+             BytesInChunk);
+    I += BytesInChunk;
+  }
+  Buffer = ArrayRef<uint8_t>(Copy, Size);
   return Error::success();
 }
 
@@ -31,12 +94,39 @@ Error ExponentialGrowthAppendingBinaryByteStream::readLongestContiguousChunk(
     return Error;
   }
 
-  Buffer = ArrayRef<uint8_t>(Data.data() + Offset, Data.size() - Offset);
+  if (IsFlat) {
+    Buffer = ArrayRef<uint8_t>(FlatData.data() + Offset,
+                               FlatData.size() - Offset);
+    return Error::success();
+  }
+
+  size_t Within = Offset & (ChunkSize - 1);
+  size_t BytesInChunk =
+      std::min(ChunkSize - Within, StreamLength - size_t(Offset));
+  Buffer = ArrayRef<uint8_t>(Chunks[Offset / ChunkSize].get() + Within,
+                             BytesInChunk);
   return Error::success();
 }
 
 void ExponentialGrowthAppendingBinaryByteStream::reserve(size_t Size) {
-  Data.reserve(Size);
+  if (IsFlat) {
+    FlatData.reserve(Size);
+  } else {
+    Chunks.reserve((Size + ChunkSize - 1) / ChunkSize);
+  }
+}
+
+void ExponentialGrowthAppendingBinaryByteStream::writeTo(raw_ostream &OS)
+    const {
+  if (IsFlat) {
+    OS.write(reinterpret_cast<const char *>(FlatData.data()), FlatData.size());
+    return;
+  }
+  for (size_t Offset = 0; Offset < StreamLength; Offset += ChunkSize) {
+    size_t BytesInChunk = std::min(ChunkSize, StreamLength - Offset);
+    OS.write(reinterpret_cast<const char *>(Chunks[Offset / ChunkSize].get()),
+             BytesInChunk);
+  }
 }
 
 Error ExponentialGrowthAppendingBinaryByteStream::writeBytes(
@@ -47,14 +137,19 @@ Error ExponentialGrowthAppendingBinaryByteStream::writeBytes(
   if (auto Error = checkOffsetForWrite(Offset, Buffer.size())) {
     return Error;
   }
-  
-  // Resize the internal buffer if needed.
-  uint32_t RequiredSize = Offset + Buffer.size();
-  if (RequiredSize > Data.size()) {
-    Data.resize(RequiredSize);
-  }
 
-  ::memcpy(Data.data() + Offset, Buffer.data(), Buffer.size());
+  if (IsFlat) {
+    // Resize the internal buffer if needed.
+    uint32_t RequiredSize = Offset + Buffer.size();
+    if (RequiredSize > FlatData.size()) {
+      FlatData.resize(RequiredSize);
+      StreamLength = RequiredSize;
+    }
+    ::memcpy(FlatData.data() + Offset, Buffer.data(), Buffer.size());
+    return Error::success();
+  }
 
+  ensureCapacity(Offset + Buffer.size());
+  copyIntoChunks(Offset, Buffer);
   return Error::success();
 }
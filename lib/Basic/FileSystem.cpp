@@ -14,6 +14,7 @@
 
 #include "swift/Basic/LLVM.h"
 #include "clang/Basic/FileManager.h"
+#include "llvm/ADT/StringMap.h"
 #include "llvm/ADT/Twine.h"
 #include "llvm/Support/Errc.h"
 #include "llvm/Support/FileSystem.h"
@@ -22,6 +23,23 @@
 #include "llvm/Support/Signals.h"
 #include "llvm/Support/VirtualFileSystem.h"
 
+#include <memory>
+#include <mutex>
+
+#if defined(__APPLE__) && __has_include(<sys/clonefile.h>)
+#include <sys/clonefile.h>
+#define SWIFT_HAS_CLONEFILE 1
+#endif
+
+#if defined(__linux__)
+#include <sys/ioctl.h>
+// Defined in <linux/fs.h>, which conflicts with other system headers; spell
+// out the ioctl number instead (it is part of the kernel ABI).
+#if !defined(FICLONE)
+#define FICLONE _IOW(0x94, 9, int)
+#endif
+#endif
+
 using namespace swift;
 
 namespace {
@@ -260,6 +278,43 @@ std::error_code swift::moveFileIfDifferent(const llvm::Twine &source,
   llvm_unreachable("Unhandled FileDifference in switch");
 }
 
+std::error_code swift::copyFileCloning(const llvm::Twine &source,
+                                       const llvm::Twine &destination) {
+  namespace fs = llvm::sys::fs;
+
+#if defined(SWIFT_HAS_CLONEFILE)
+  SmallString<128> sourceBuf;
+  SmallString<128> destBuf;
+  StringRef sourcePath = source.toNullTerminatedStringRef(sourceBuf);
+  StringRef destPath = destination.toNullTerminatedStringRef(destBuf);
+
+  // clonefile refuses to replace an existing file, so clear the destination
+  // first; it's fine if there was nothing there.
+  (void)fs::remove(destPath);
+  if (::clonefile(sourcePath.data(), destPath.data(), 0) == 0)
+    return std::error_code();
+  // Fall through to a plain copy; the source may be on a file system that
+  // doesn't support cloning.
+#elif defined(__linux__)
+  OpenFileRAII sourceFile;
+  if (std::error_code error = fs::openFileForRead(source, sourceFile.fd))
+    return error;
+
+  OpenFileRAII destFile;
+  if (std::error_code error = fs::openFileForWrite(
+          destination, destFile.fd, fs::CD_CreateAlways, fs::OF_None))
+    return error;
+
+  if (::ioctl(destFile.fd, FICLONE, sourceFile.fd) == 0)
+    return std::error_code();
+  // The file system doesn't support cloning (or source and destination live
+  // on different ones); fall through to a plain copy. copy_file truncates
+  // the destination we just created.
+#endif
+
+  return fs::copy_file(source, destination);
+}
+
 llvm::ErrorOr<std::unique_ptr<llvm::MemoryBuffer>>
 swift::vfs::getFileOrSTDIN(llvm::vfs::FileSystem &FS,
                            const llvm::Twine &Filename,
@@ -274,3 +329,71 @@ swift::vfs::getFileOrSTDIN(llvm::vfs::FileSystem &FS,
   return FS.getBufferForFile(Filename, FileSize,
                              RequiresNullTerminator, IsVolatile);
 }
+
+namespace {
+/// A zero-copy view of a cached memory buffer that keeps the underlying
+/// buffer alive for as long as the view exists.
+class SharedBufferView : public llvm::MemoryBuffer {
+  std::shared_ptr<llvm::MemoryBuffer> Owner;
+
+public:
+  explicit SharedBufferView(std::shared_ptr<llvm::MemoryBuffer> Buffer)
+      : Owner(std::move(Buffer)) {
+    init(Owner->getBufferStart(), Owner->getBufferEnd(),
+         /*RequiresNullTerminator=*/true);
+  }
+
+  BufferKind getBufferKind() const override { return Owner->getBufferKind(); }
+
+  StringRef getBufferIdentifier() const override {
+    return Owner->getBufferIdentifier();
+  }
+};
+
+/// A cached file buffer together with the stat information it was loaded
+/// under, used to detect when the on-disk file has changed.
+struct SharedBufferCacheEntry {
+  std::shared_ptr<llvm::MemoryBuffer> Buffer;
+  uint64_t Size;
+  int64_t ModificationTime;
+};
+} // end anonymous namespace
+
+llvm::ErrorOr<std::unique_ptr<llvm::MemoryBuffer>>
+swift::vfs::getSharedBufferForFile(llvm::vfs::FileSystem &FS,
+                                   const llvm::Twine &Filename) {
+  static std::mutex CacheMutex;
+  static llvm::StringMap<SharedBufferCacheEntry> Cache;
+
+  llvm::SmallString<256> NameBuf;
+  llvm::StringRef NameRef = Filename.toStringRef(NameBuf);
+
+  auto Status = FS.status(NameRef);
+  if (!Status)
+    return Status.getError();
+  uint64_t Size = Status->getSize();
+  int64_t ModificationTime =
+      Status->getLastModificationTime().time_since_epoch().count();
+
+  {
+    std::lock_guard<std::mutex> Lock(CacheMutex);
+    auto Known = Cache.find(NameRef);
+    if (Known != Cache.end() && Known->second.Size == Size &&
+        Known->second.ModificationTime == ModificationTime) {
+      return std::unique_ptr<llvm::MemoryBuffer>(
+          new SharedBufferView(Known->second.Buffer));
+    }
+  }
+
+  auto BufferOrErr = FS.getBufferForFile(NameRef, Size);
+  if (!BufferOrErr)
+    return BufferOrErr.getError();
+  std::shared_ptr<llvm::MemoryBuffer> Shared = std::move(*BufferOrErr);
+
+  {
+    std::lock_guard<std::mutex> Lock(CacheMutex);
+    Cache[NameRef] = {Shared, Size, ModificationTime};
+  }
+  return std::unique_ptr<llvm::MemoryBuffer>(
+      new SharedBufferView(std::move(Shared)));
+}
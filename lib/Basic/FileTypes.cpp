@@ -82,6 +82,7 @@ bool file_types::isTextual(ID Id) {
   case file_types::TY_SwiftModuleInterfaceFile:
   case file_types::TY_PrivateSwiftModuleInterfaceFile:
   case file_types::TY_SwiftOverlayFile:
+  case file_types::TY_JSONDependencies:
     return true;
   case file_types::TY_Image:
   case file_types::TY_Object:
@@ -151,6 +152,7 @@ bool file_types::isAfterLLVM(ID Id) {
   case file_types::TY_BitstreamOptRecord:
   case file_types::TY_SwiftModuleInterfaceFile:
   case file_types::TY_PrivateSwiftModuleInterfaceFile:
+  case file_types::TY_JSONDependencies:
     return false;
   case file_types::TY_INVALID:
     llvm_unreachable("Invalid type ID.");
@@ -199,6 +201,7 @@ bool file_types::isPartOfSwiftCompilation(ID Id) {
   case file_types::TY_ModuleTrace:
   case file_types::TY_YAMLOptRecord:
   case file_types::TY_BitstreamOptRecord:
+  case file_types::TY_JSONDependencies:
     return false;
   case file_types::TY_INVALID:
     llvm_unreachable("Invalid type ID.");
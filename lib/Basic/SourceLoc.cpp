@@ -15,6 +15,8 @@
 #include "llvm/Support/MemoryBuffer.h"
 #include "llvm/Support/PrettyStackTrace.h"
 #include "llvm/Support/raw_ostream.h"
+#include <algorithm>
+#include <cstring>
 
 using namespace swift;
 
@@ -241,6 +243,74 @@ bool SourceManager::isOwning(SourceLoc Loc) const {
   return findBufferContainingLocInternal(Loc).hasValue();
 }
 
+/// Appends the offset of every '\n' in \p Text to \p Offsets, scanning a
+/// machine word of bytes at a time.
+static void scanForNewlines(StringRef Text, std::vector<unsigned> &Offsets) {
+  using WordType = uintptr_t;
+  const WordType OneBytes = WordType(~0ULL) / 0xFF; // 0x01 in every byte.
+  const WordType HighBits = OneBytes * 0x80;        // 0x80 in every byte.
+
+  const char *Begin = Text.begin();
+  const char *End = Text.end();
+  const char *Ptr = Begin;
+  for (; Ptr + sizeof(WordType) <= End; Ptr += sizeof(WordType)) {
+    WordType Word;
+    memcpy(&Word, Ptr, sizeof(WordType));
+    // The usual zero-byte test, applied to the bytes XORed with '\n'. It can
+    // produce a false positive for a byte adjacent to a real match, but that
+    // only costs rescanning this word a byte at a time.
+    WordType XorNL = Word ^ (OneBytes * '\n');
+    if ((XorNL - OneBytes) & ~XorNL & HighBits) {
+      for (unsigned i = 0; i != sizeof(WordType); ++i) {
+        if (Ptr[i] == '\n')
+          Offsets.push_back(Ptr - Begin + i);
+      }
+    }
+  }
+  for (; Ptr != End; ++Ptr) {
+    if (*Ptr == '\n')
+      Offsets.push_back(Ptr - Begin);
+  }
+}
+
+ArrayRef<unsigned> SourceManager::getNewlineOffsets(unsigned BufferID) const {
+  auto Known = NewlineOffsetsCache.find(BufferID);
+  if (Known != NewlineOffsetsCache.end())
+    return Known->second;
+
+  std::vector<unsigned> Offsets;
+  scanForNewlines(LLVMSourceMgr.getMemoryBuffer(BufferID)->getBuffer(),
+                  Offsets);
+  return NewlineOffsetsCache[BufferID] = std::move(Offsets);
+}
+
+std::pair<unsigned, unsigned>
+SourceManager::getLineAndColumn(SourceLoc Loc, unsigned BufferID) const {
+  assert(Loc.isValid());
+  int LineOffset = getLineOffset(Loc);
+  if (BufferID == 0)
+    BufferID = findBufferContainingLoc(Loc);
+  unsigned Offset = getLocOffsetInBuffer(Loc, BufferID);
+  ArrayRef<unsigned> Newlines = getNewlineOffsets(BufferID);
+  // The line number is the count of newlines before the location, plus one;
+  // the column counts from the character after the last of those newlines.
+  auto NextNewline = std::lower_bound(Newlines.begin(), Newlines.end(), Offset);
+  unsigned Line = (NextNewline - Newlines.begin()) + 1;
+  unsigned LineStart = Line == 1 ? 0 : *(NextNewline - 1) + 1;
+  assert(LineOffset + (int)Line > 0 && "bogus line offset");
+  return { LineOffset + (int)Line, Offset - LineStart + 1 };
+}
+
+unsigned SourceManager::getLineNumber(SourceLoc Loc, unsigned BufferID) const {
+  assert(Loc.isValid());
+  if (BufferID == 0)
+    BufferID = findBufferContainingLoc(Loc);
+  unsigned Offset = getLocOffsetInBuffer(Loc, BufferID);
+  ArrayRef<unsigned> Newlines = getNewlineOffsets(BufferID);
+  return (std::lower_bound(Newlines.begin(), Newlines.end(), Offset) -
+          Newlines.begin()) + 1;
+}
+
 void SourceRange::widen(SourceRange Other) {
   if (Other.Start.Value.getPointer() < Start.Value.getPointer())
     Start = Other.Start;
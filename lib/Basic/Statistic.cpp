@@ -19,15 +19,19 @@
 #include "swift/AST/Expr.h"
 #include "swift/SIL/SILFunction.h"
 #include "swift/Driver/CoarseGrainedDependencyGraph.h"
+#include "llvm/ADT/ArrayRef.h"
 #include "llvm/ADT/DenseMap.h"
+#include "llvm/ADT/StringExtras.h"
 #include "llvm/Config/config.h"
 #include "llvm/Support/FileSystem.h"
 #include "llvm/Support/Path.h"
 #include "llvm/Support/Process.h"
 #include "llvm/Support/raw_ostream.h"
 #include "llvm/Support/SaveAndRestore.h"
+#include <atomic>
 #include <chrono>
 #include <limits>
+#include <mutex>
 
 #if LLVM_ON_UNIX
 #if HAVE_UNISTD_H
@@ -93,12 +97,152 @@ makeTraceFileName(StringRef ProgramName,
   return makeFileName("trace", ProgramName, AuxName, "csv");
 }
 
+static std::string
+makeChromeTraceFileName(StringRef ProgramName,
+                        StringRef AuxName) {
+  return makeFileName("trace", ProgramName, AuxName, "json");
+}
+
 static std::string
 makeProfileDirName(StringRef ProgramName,
                    StringRef AuxName) {
   return makeFileName("profile", ProgramName, AuxName, "dir");
 }
 
+// Always-on sampled profiling of the FrontendStatsTracer stack, enabled
+// fleet-wide by pointing SWIFT_COMPILE_SAMPLING_PROFILE_DIR at a directory
+// (in the spirit of SWIFTC_MAXIMUM_DETERMINISM above) rather than by a
+// frontend flag. Unlike the opt-in machinery below, which reads rusage
+// counters at every tracer transition, this only maintains the event-name
+// stack and, at most once per sampling period, credits the elapsed time to
+// the stack that was active since the last sample, into a fixed-size ring
+// buffer. On process exit the ring is aggregated into folded-stack histogram
+// lines — the flamegraph input format the hierarchical profilers below
+// already use — in a file beside the build's other records.
+class CompileTimeSampler {
+  static const unsigned RingSize = 8192;
+  static const unsigned MaxPaths = 2048;
+  static const uint64_t SamplePeriodUSec = 10000;
+
+  struct Sample {
+    unsigned PathID;
+    uint64_t USec;
+  };
+
+  std::string Dirname;
+  std::mutex Mtx;
+  StringMap<unsigned> PathIDs;
+  std::vector<std::string> Paths;
+  std::vector<Sample> Ring;
+  uint64_t RingNext = 0;
+  std::atomic<uint64_t> LastSampleUSec;
+
+  static uint64_t nowUSec() {
+    return std::chrono::duration_cast<std::chrono::microseconds>(
+               std::chrono::steady_clock::now().time_since_epoch())
+        .count();
+  }
+
+  CompileTimeSampler(StringRef Dir)
+      : Dirname(Dir), Ring(RingSize, Sample{0, 0}),
+        LastSampleUSec(nowUSec()) {
+    // ID 0 is the overflow bucket, used once MaxPaths distinct stacks have
+    // been interned.
+    Paths.push_back("<truncated>");
+  }
+
+  static std::unique_ptr<CompileTimeSampler> make() {
+    if (const char *Dir = ::getenv("SWIFT_COMPILE_SAMPLING_PROFILE_DIR"))
+      if (Dir[0] != '\0')
+        return std::unique_ptr<CompileTimeSampler>(new CompileTimeSampler(Dir));
+    return nullptr;
+  }
+
+  static SmallVectorImpl<StringRef> &getThreadStack() {
+    static thread_local SmallVector<StringRef, 16> Stack;
+    return Stack;
+  }
+
+  unsigned internPath(StringRef Path) {
+    auto I = PathIDs.find(Path);
+    if (I != PathIDs.end())
+      return I->second;
+    if (Paths.size() >= MaxPaths)
+      return 0;
+    unsigned ID = Paths.size();
+    PathIDs[Path] = ID;
+    Paths.push_back(Path.str());
+    return ID;
+  }
+
+  void sampleIfDue(ArrayRef<StringRef> Stack) {
+    uint64_t Now = nowUSec();
+    if (Now - LastSampleUSec.load(std::memory_order_relaxed) <
+        SamplePeriodUSec)
+      return;
+    std::lock_guard<std::mutex> Lock(Mtx);
+    uint64_t Last = LastSampleUSec.load(std::memory_order_relaxed);
+    if (Now - Last < SamplePeriodUSec)
+      return;
+    LastSampleUSec.store(Now, std::memory_order_relaxed);
+    if (Stack.empty())
+      return;
+    SmallString<256> Path;
+    for (auto Name : Stack) {
+      if (!Path.empty())
+        Path += ';';
+      Path += Name;
+    }
+    Ring[RingNext++ % RingSize] = {internPath(Path), Now - Last};
+  }
+
+public:
+  /// Returns the process-wide sampler, or null when the environment variable
+  /// is not set. The instance is destroyed — and its histogram written — at
+  /// process exit.
+  static CompileTimeSampler *get() {
+    static std::unique_ptr<CompileTimeSampler> Instance = make();
+    return Instance.get();
+  }
+
+  void tracerPushed(StringRef EventName) {
+    // Sample before pushing: the elapsed period predates the new frame.
+    auto &Stack = getThreadStack();
+    sampleIfDue(Stack);
+    Stack.push_back(EventName);
+  }
+
+  void tracerPopped() {
+    // Sample before popping: the elapsed period includes the dying frame.
+    auto &Stack = getThreadStack();
+    sampleIfDue(Stack);
+    if (!Stack.empty())
+      Stack.pop_back();
+  }
+
+  ~CompileTimeSampler() {
+    uint64_t Filled = std::min(RingNext, uint64_t(RingSize));
+    if (Filled == 0)
+      return;
+    std::vector<uint64_t> USecs(Paths.size(), 0);
+    for (uint64_t I = 0; I < Filled; ++I)
+      USecs[Ring[I].PathID] += Ring[I].USec;
+    SmallString<256> Filename(Dirname);
+    path::append(Filename, makeFileName("samples", "frontend", "all",
+                                        "folded"));
+    std::error_code EC;
+    raw_fd_ostream Stream(Filename, EC, fs::F_Append | fs::F_Text);
+    if (EC) {
+      // We're on the exit path of an otherwise-healthy build; don't complain.
+      return;
+    }
+    for (size_t I = 0; I != USecs.size(); ++I) {
+      if (USecs[I] != 0)
+        Stream << Paths[I] << ' ' << USecs[I] << '\n';
+    }
+  }
+};
+
 // LLVM's statistics-reporting machinery is sensitive to filenames containing
 // YAML-quote-requiring characters, which occur surprisingly often in the wild;
 // we only need a recognizable and likely-unique name for a target here, not an
@@ -341,6 +485,7 @@ UnifiedStatsReporter::UnifiedStatsReporter(StringRef ProgramName,
     currentProcessExitStatus(EXIT_FAILURE),
     StatsFilename(Directory),
     TraceFilename(Directory),
+    ChromeTraceFilename(Directory),
     ProfileDirname(Directory),
     StartedTime(llvm::TimeRecord::getCurrentTime()),
     MainThreadID(std::this_thread::get_id()),
@@ -354,13 +499,17 @@ UnifiedStatsReporter::UnifiedStatsReporter(StringRef ProgramName,
 {
   path::append(StatsFilename, makeStatsFileName(ProgramName, AuxName));
   path::append(TraceFilename, makeTraceFileName(ProgramName, AuxName));
+  path::append(ChromeTraceFilename,
+               makeChromeTraceFileName(ProgramName, AuxName));
   path::append(ProfileDirname, makeProfileDirName(ProgramName, AuxName));
   EnableStatistics(/*PrintOnExit=*/false);
   SharedTimer::enableCompilationTimers();
   if (TraceEvents || ProfileEvents || ProfileEntities)
     LastTracedFrontendCounters.emplace();
-  if (TraceEvents)
+  if (TraceEvents) {
     FrontendStatsEvents.emplace();
+    FrontendStatsTraceMarkers.emplace();
+  }
   if (ProfileEvents)
     EventProfilers =std::make_unique<StatsProfilers>();
   if (ProfileEntities)
@@ -479,6 +628,10 @@ FrontendStatsTracer::FrontendStatsTracer(
     SavedTime = llvm::TimeRecord::getCurrentTime();
     Reporter->saveAnyFrontendStatsEvents(*this, true);
   }
+  if (auto *Sampler = CompileTimeSampler::get()) {
+    Sampler->tracerPushed(EventName);
+    InSampler = true;
+  }
 }
 
 FrontendStatsTracer::FrontendStatsTracer() = default;
@@ -491,7 +644,9 @@ FrontendStatsTracer::operator=(FrontendStatsTracer&& other)
   EventName = other.EventName;
   Entity = other.Entity;
   Formatter = other.Formatter;
+  InSampler = other.InSampler;
   other.Reporter = nullptr;
+  other.InSampler = false;
   return *this;
 }
 
@@ -500,15 +655,19 @@ FrontendStatsTracer::FrontendStatsTracer(FrontendStatsTracer&& other)
     SavedTime(other.SavedTime),
     EventName(other.EventName),
     Entity(other.Entity),
-    Formatter(other.Formatter)
+    Formatter(other.Formatter),
+    InSampler(other.InSampler)
 {
   other.Reporter = nullptr;
+  other.InSampler = false;
 }
 
 FrontendStatsTracer::~FrontendStatsTracer()
 {
   if (Reporter)
     Reporter->saveAnyFrontendStatsEvents(*this, false);
+  if (InSampler)
+    CompileTimeSampler::get()->tracerPopped();
 }
 
 // Copy any interesting process-wide resource accounting stats to
@@ -638,12 +797,36 @@ UnifiedStatsReporter::saveAnyFrontendStatsEvents(
 #undef FRONTEND_STATISTIC
   }
 
+  if (FrontendStatsTraceMarkers) {
+    auto NowUS = uint64_t(1000000.0 * Now.getProcessTime());
+    FrontendStatsTraceMarkers->push_back(
+        {NowUS, IsEntry, T.EventName, T.Entity, T.Formatter});
+  }
+
   // Save all counters (changed or otherwise).
   Last = Curr;
 }
 
 UnifiedStatsReporter::TraceFormatter::~TraceFormatter() {}
 
+// Entity names can contain arbitrary source text; keep the emitted trace
+// valid JSON by escaping quotes, backslashes and control characters.
+static void writeJSONEscaped(raw_ostream &OS, StringRef Str) {
+  for (unsigned char c : Str) {
+    switch (c) {
+    case '"': OS << "\\\""; break;
+    case '\\': OS << "\\\\"; break;
+    case '\n': OS << "\\n"; break;
+    case '\t': OS << "\\t"; break;
+    default:
+      if (c < 0x20)
+        OS << "\\u00" << llvm::hexdigit(c >> 4) << llvm::hexdigit(c & 0xF);
+      else
+        OS << c;
+    }
+  }
+}
+
 UnifiedStatsReporter::~UnifiedStatsReporter()
 {
   assert(MainThreadID == std::this_thread::get_id());
@@ -753,6 +936,41 @@ UnifiedStatsReporter::flushTracesAndProfiles() {
     }
   }
 
+  if (FrontendStatsTraceMarkers) {
+    std::error_code EC;
+    raw_fd_ostream jstream(ChromeTraceFilename, EC, fs::F_Append | fs::F_Text);
+    if (EC) {
+      llvm::errs() << "Error opening trace-events file '"
+                   << ChromeTraceFilename << "' for writing\n";
+      return;
+    }
+    // Chrome trace-event "JSON array format". Viewers pair each "B" with the
+    // nearest following "E" on the same pid/tid, which reproduces the tracer
+    // stack exactly since markers were recorded in push/pop order.
+    jstream << "[\n";
+    const char *delim = "";
+    SmallString<64> Name;
+    for (auto const &M : *FrontendStatsTraceMarkers) {
+      Name.clear();
+      {
+        llvm::raw_svector_ostream NameOS(Name);
+        NameOS << M.EventName;
+        if (M.Formatter) {
+          NameOS << ' ';
+          M.Formatter->traceName(M.Entity, NameOS);
+        }
+      }
+      jstream << delim << "{\"name\":\"";
+      writeJSONEscaped(jstream, Name);
+      jstream << "\",\"cat\":\"frontend\",\"ph\":\""
+              << (M.IsEntry ? 'B' : 'E')
+              << "\",\"ts\":" << M.TimeUSec
+              << ",\"pid\":1,\"tid\":1}";
+      delim = ",\n";
+    }
+    jstream << "\n]\n";
+  }
+
   if (EventProfilers || EntityProfilers) {
     std::error_code EC = llvm::sys::fs::create_directories(ProfileDirname);
     if (EC) {
@@ -787,6 +1005,7 @@ UnifiedStatsReporter::flushTracesAndProfiles() {
   }
   LastTracedFrontendCounters.reset();
   FrontendStatsEvents.reset();
+  FrontendStatsTraceMarkers.reset();
   EventProfilers.reset();
   EntityProfilers.reset();
 }
@@ -13,6 +13,7 @@
 #include "swift/Basic/Unicode.h"
 #include "llvm/ADT/SmallVector.h"
 #include "llvm/Support/ConvertUTF.h"
+#include <cstring>
 
 using namespace swift;
 
@@ -45,12 +46,54 @@ static inline bool graphemeBreakOverride(llvm::UTF32 lhs, llvm::UTF32 rhs) {
   return false;
 }
 
+bool swift::unicode::isAllPrintableASCII(StringRef S) {
+  const char *Ptr = S.data();
+  const char *End = Ptr + S.size();
+
+  // A byte outside 0x20..0x7E either has its high bit set, is below 0x20, or
+  // is DEL; check a machine word of bytes at a time with the usual masks.
+  using WordType = uintptr_t;
+  const WordType OneBytes = WordType(~0ULL) / 0xFF; // 0x01 in every byte.
+  const WordType HighBits = OneBytes * 0x80;        // 0x80 in every byte.
+  for (; Ptr + sizeof(WordType) <= End; Ptr += sizeof(WordType)) {
+    WordType Word;
+    memcpy(&Word, Ptr, sizeof(WordType));
+    if (Word & HighBits)
+      return false;
+    // With all high bits clear, a byte borrows past its high bit when
+    // subtracting 0x20 iff it is below 0x20. A borrow can ripple into the
+    // next byte only if this byte already failed, so false positives don't
+    // matter.
+    if ((Word - OneBytes * 0x20) & HighBits)
+      return false;
+    // A byte equals DEL iff XORing with 0x7F yields zero; use the usual
+    // zero-byte test.
+    WordType XorDel = Word ^ (OneBytes * 0x7F);
+    if ((XorDel - OneBytes) & ~XorDel & HighBits)
+      return false;
+  }
+  for (; Ptr != End; ++Ptr) {
+    unsigned char C = *Ptr;
+    if (C < 0x20 || C >= 0x7F)
+      return false;
+  }
+  return true;
+}
+
 StringRef swift::unicode::extractFirstExtendedGraphemeCluster(StringRef S) {
   // Extended grapheme cluster segmentation algorithm as described in Unicode
   // Standard Annex #29.
   if (S.empty())
     return StringRef();
 
+  // Fast path: a printable ASCII character followed by any other ASCII
+  // character (or the end of the string) is always a complete cluster; only
+  // CR and non-ASCII combining sequences can extend past one character.
+  unsigned char First = S[0];
+  if (First >= 0x20 && First < 0x7F &&
+      (S.size() == 1 || static_cast<unsigned char>(S[1]) < 0x80))
+    return S.take_front(1);
+
   const llvm::UTF8 *SourceStart =
     reinterpret_cast<const llvm::UTF8 *>(S.data());
 
@@ -647,6 +647,12 @@ getNormalInvocationArguments(std::vector<std::string> &invocationArgStrs,
     }
   }
 
+  // Enable implicit module builds into a shared cache. PCMs are compiled
+  // lazily, one at a time, as this importer's single Clang instance first
+  // reaches each module; the instance (and the ASTContext it feeds) is not
+  // thread-safe, so parallelism across PCMs comes from concurrent frontend
+  // jobs instead: Clang's module cache uses lock files so that racing
+  // compilations each build disjoint modules and share the results.
   const std::string &moduleCachePath = importerOpts.ModuleCachePath;
   if (!moduleCachePath.empty()) {
     invocationArgStrs.push_back("-fmodules-cache-path=");
@@ -875,6 +881,15 @@ ClangImporter::getPCHFilename(const ClangImporterOptions &ImporterOptions,
 }
 
 
+/// Return the path of a usable bridging header PCH, building one if needed.
+///
+/// This is designed so that a multi-job build validates the header chain
+/// once, not once per frontend: the PCH's filename is keyed by the Swift
+/// invocation hash and the Clang module hash, so a stale configuration
+/// misses by name, and the driver passes -pch-disable-validation to the
+/// per-file frontend jobs after the initial -emit-pch invocation has
+/// validated the header closure, which skips the ASTReader dependency
+/// checks here entirely.
 Optional<std::string>
 ClangImporter::getOrCreatePCH(const ClangImporterOptions &ImporterOptions,
                               StringRef SwiftPCHHash) {
@@ -3756,6 +3771,15 @@ void ClangImporter::Implementation::lookupAllObjCMembers(
   }
 }
 
+/// Load the members of a context that import under the given Swift name.
+///
+/// This is the narrow end of member import: the serialized lookup table is
+/// keyed by Swift base name, so only Clang decls that can actually answer
+/// the query are materialized, rather than the whole container. There is no
+/// cheaper "summary" tier below full import -- a candidate can only be
+/// ranked by overload resolution once it has a Swift type, and producing
+/// that type is the import. Paths that intentionally want everything, like
+/// code completion's lookupClassMembers, pay for everything.
 TinyPtrVector<ValueDecl *>
 ClangImporter::Implementation::loadNamedMembers(
     const IterableDeclContext *IDC, DeclBaseName N, uint64_t contextData) {
@@ -1790,6 +1790,16 @@ NameImporter::importMacroName(const clang::IdentifierInfo *clangIdentifier,
   return swiftCtx.getIdentifier(name);
 }
 
+/// Import a name for the given decl, with results memoized per (decl,
+/// version) for the lifetime of this NameImporter.
+///
+/// This cache is deliberately in-memory only. The persistent, cross-job
+/// artifact is the SwiftLookupTable serialized into each PCM, which maps
+/// Swift base names back to Clang decls; a sidecar of full ImportedNames
+/// would not buy more than that, because an ImportedName is built from
+/// process-local objects (ASTContext-interned Identifiers, effective
+/// contexts holding Clang decl pointers) that have no stable on-disk form
+/// to map back in.
 ImportedName NameImporter::importName(const clang::NamedDecl *decl,
                                       ImportNameVersion version,
                                       clang::DeclarationName givenName) {
@@ -94,7 +94,7 @@ void SubstitutionEntry::deepHash(Node *node) {
   }
 }
 
-bool SubstitutionEntry::deepEquals(Node *lhs, Node *rhs) const {
+static bool deepNodeEquals(Node *lhs, Node *rhs) {
   if (lhs->getKind() != rhs->getKind())
     return false;
   if (lhs->hasIndex()) {
@@ -116,13 +116,17 @@ bool SubstitutionEntry::deepEquals(Node *lhs, Node *rhs) const {
 
   for (auto li = lhs->begin(), ri = rhs->begin(), le = lhs->end();
        li != le; ++li, ++ri) {
-    if (!deepEquals(*li, *ri))
+    if (!deepNodeEquals(*li, *ri))
       return false;
   }
-  
+
   return true;
 }
 
+bool SubstitutionEntry::deepEquals(Node *lhs, Node *rhs) const {
+  return deepNodeEquals(lhs, rhs);
+}
+
 // Find a substitution and return its index.
 // Returns -1 if no substitution is found.
 int RemanglerBase::findSubstitution(const SubstitutionEntry &entry) {
@@ -2517,6 +2521,60 @@ void Remangler::mangleAccessorFunctionReference(Node *node) {
 
 } // anonymous namespace
 
+//////////////////////////////////
+// ManglingCache member functions //
+//////////////////////////////////
+
+bool ManglingCache::Equals::operator()(const Key &lhs, const Key &rhs) const {
+  if (lhs.Hash != rhs.Hash)
+    return false;
+  return deepNodeEquals(lhs.Root, rhs.Root);
+}
+
+size_t ManglingCache::deepHash(NodePointer node, size_t hash) {
+  hash = 33 * hash + (size_t)node->getKind();
+  if (node->hasIndex()) {
+    hash = 33 * hash + (size_t)node->getIndex();
+  } else if (node->hasText()) {
+    for (char c : node->getText())
+      hash = 33 * hash + (unsigned char)c;
+  }
+  for (NodePointer child : *node)
+    hash = deepHash(child, hash);
+  return hash;
+}
+
+NodePointer ManglingCache::deepCopy(NodePointer node) {
+  NodePointer copy;
+  if (node->hasIndex())
+    copy = Factory.createNode(node->getKind(), node->getIndex());
+  else if (node->hasText())
+    copy = Factory.createNode(node->getKind(), node->getText());
+  else
+    copy = Factory.createNode(node->getKind());
+  for (NodePointer child : *node)
+    copy->addChild(deepCopy(child), Factory);
+  return copy;
+}
+
+std::string Demangle::mangleNode(NodePointer node, ManglingCache &cache) {
+  if (!node)
+    return "";
+
+  ManglingCache::Key key = {node, ManglingCache::deepHash(node, 0)};
+  auto it = cache.Entries.find(key);
+  if (it != cache.Entries.end())
+    return it->second;
+
+  std::string result = mangleNode(node);
+
+  // Copy the key tree into the cache's arena so the entry survives the
+  // demangler that owns \p node.
+  key.Root = cache.deepCopy(node);
+  cache.Entries.insert({key, result});
+  return result;
+}
+
 /// The top-level interface to the remangler.
 std::string Demangle::mangleNode(NodePointer node) {
   return mangleNode(node, [](SymbolicReferenceKind, const void *) -> NodePointer {
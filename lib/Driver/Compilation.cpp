@@ -15,6 +15,7 @@
 #include "swift/AST/DiagnosticEngine.h"
 #include "swift/AST/DiagnosticsDriver.h"
 #include "swift/AST/FineGrainedDependencies.h"
+#include "swift/Basic/FileSystem.h"
 #include "swift/Basic/OutputFileMap.h"
 #include "swift/Basic/Program.h"
 #include "swift/Basic/STLExtras.h"
@@ -1266,35 +1267,59 @@ namespace driver {
     }
 
     /// Build a vector of partition indices, one per Job: the i'th index says
-    /// which batch of the partition the i'th Job will be assigned to. If we are
-    /// shuffling due to -driver-batch-seed, the returned indices will not be
-    /// arranged in contiguous runs. We shuffle partition-indices here, not
-    /// elements themselves, to preserve the invariant that each batch is a
-    /// subsequence of the full set of inputs, not just a subset.
+    /// which batch of the partition the i'th Job will be assigned to.
+    ///
+    /// By default, jobs are assigned in input order to whichever partition
+    /// has the smallest accumulated primary input size, so that batches
+    /// represent roughly equal amounts of work rather than equal numbers of
+    /// files and the build isn't bounded by one partition that happens to
+    /// hold the largest inputs. If we are shuffling due to
+    /// -driver-batch-seed, jobs are instead spread count-evenly and
+    /// pseudo-randomly. Either way, each job's assigned indices are chosen
+    /// (or shuffled) rather than the elements themselves, to preserve the
+    /// invariant that each batch is a subsequence of the full set of inputs,
+    /// not just a subset.
     std::vector<size_t>
     assignJobsToPartitions(size_t PartitionSize,
-                           size_t NumJobs) {
-      size_t Remainder = NumJobs % PartitionSize;
-      size_t TargetSize = NumJobs / PartitionSize;
+                           ArrayRef<const Job *> Batchable) {
+      size_t NumJobs = Batchable.size();
       std::vector<size_t> PartitionIndex;
       PartitionIndex.reserve(NumJobs);
-      for (size_t P = 0; P < PartitionSize; ++P) {
-        // Spread remainder evenly across partitions by adding 1 to the target
-        // size of the first Remainder of them.
-        size_t FillCount = TargetSize + ((P < Remainder) ? 1 : 0);
-        std::fill_n(std::back_inserter(PartitionIndex), FillCount, P);
-      }
+
       if (Comp.getBatchSeed() != 0) {
+        size_t Remainder = NumJobs % PartitionSize;
+        size_t TargetSize = NumJobs / PartitionSize;
+        for (size_t P = 0; P < PartitionSize; ++P) {
+          // Spread remainder evenly across partitions by adding 1 to the
+          // target size of the first Remainder of them.
+          size_t FillCount = TargetSize + ((P < Remainder) ? 1 : 0);
+          std::fill_n(std::back_inserter(PartitionIndex), FillCount, P);
+        }
         std::minstd_rand gen(Comp.getBatchSeed());
         std::shuffle(PartitionIndex.begin(), PartitionIndex.end(), gen);
+        assert(PartitionIndex.size() == NumJobs);
+        return PartitionIndex;
+      }
+
+      std::vector<uint64_t> AccumulatedSize(PartitionSize, 0);
+      for (const Job *Cmd : Batchable) {
+        size_t Lightest = std::min_element(AccumulatedSize.begin(),
+                                           AccumulatedSize.end()) -
+                          AccumulatedSize.begin();
+        PartitionIndex.push_back(Lightest);
+        // Count every job as at least one unit so that zero-sized (or
+        // unstattable) inputs still spread across partitions.
+        AccumulatedSize[Lightest] +=
+            std::max<uint64_t>(getPrimaryInputSize(Cmd), 1);
       }
       assert(PartitionIndex.size() == NumJobs);
       return PartitionIndex;
     }
 
     /// Create \c NumberOfParallelCommands batches and assign each job to a
-    /// batch either filling each partition in order or, if seeded with a
-    /// nonzero value, pseudo-randomly (but determinstically and nearly-evenly).
+    /// batch either by balancing accumulated primary input size or, if seeded
+    /// with a nonzero value, pseudo-randomly (but deterministically and
+    /// nearly-evenly by count).
     void partitionIntoBatches(std::vector<const Job *> Batchable,
                               BatchPartition &Partition) {
       if (Comp.getShowJobLifecycle()) {
@@ -1304,7 +1329,7 @@ namespace driver {
 
       assert(!Partition.empty());
       auto PartitionIndex = assignJobsToPartitions(Partition.size(),
-                                                   Batchable.size());
+                                                   Batchable);
       assert(PartitionIndex.size() == Batchable.size());
       auto const &TC = Comp.getToolChain();
       for_each(Batchable, PartitionIndex, [&](const Job *Cmd, size_t Idx) {
@@ -1451,12 +1476,45 @@ namespace driver {
     /// them together into \p BatchJob instances (also inserted into \p
     /// BatchJobs), and enqueue all \c PendingExecution jobs (whether batched or
     /// not) into the \c TaskQueue for execution.
+    ///
+    /// Batching is the driver's mechanism for amortizing frontend process
+    /// startup -- argument parsing, stdlib and SDK module loads -- across
+    /// many files: one process, many primary files. Hosting frontend
+    /// invocations on threads inside the driver instead is not an option,
+    /// because a frontend invocation assumes it owns the process (LLVM
+    /// command-line option globals, signal-based crash handling, exit on
+    /// fatal errors). The degenerate single-job case avoids the extra
+    /// process a different way; see performSingleCommand's ExecuteInPlace.
+    /// Return the size of the primary input of a compile job, or 0 if it
+    /// cannot be determined. Used as a cheap proxy for expected compile time.
+    static uint64_t getPrimaryInputSize(const Job *Cmd) {
+      if (auto *CJA = dyn_cast<CompileJobAction>(&Cmd->getSource()))
+        if (const InputAction *IA = CJA->findSingleSwiftInput()) {
+          uint64_t size;
+          if (!llvm::sys::fs::file_size(IA->getInputArg().getValue(), size))
+            return size;
+        }
+      return 0;
+    }
+
     void formBatchJobsAndAddPendingJobsToTaskQueue() {
 
-      // If batch mode is not enabled, just transfer the set of pending jobs to
-      // the task queue, as-is.
+      // If batch mode is not enabled, transfer the set of pending jobs to
+      // the task queue with the biggest primary inputs first. The queue
+      // starts jobs in the order they were added as execution slots free up,
+      // so handing over the most expensive compiles early keeps them from
+      // being started last and serializing the tail of the build; ties keep
+      // the deterministic compilation-input order.
       if (!Comp.getBatchModeEnabled()) {
-        transferJobsToTaskQueue(PendingExecution, "standard");
+        SmallVector<const Job *, 16> sortedBySize(PendingExecution.begin(),
+                                                  PendingExecution.end());
+        std::stable_sort(sortedBySize.begin(), sortedBySize.end(),
+                         [](const Job *lhs, const Job *rhs) {
+                           return getPrimaryInputSize(lhs) >
+                                  getPrimaryInputSize(rhs);
+                         });
+        transferJobsToTaskQueue(sortedBySize, "standard");
+        PendingExecution.clear();
         return;
       }
 
@@ -1922,9 +1980,8 @@ int Compilation::performJobsImpl(bool &abnormalExit,
                            InputInfo);
 
     if (OutputCompilationRecordForModuleOnlyBuild) {
-      // TODO: Optimize with clonefile(2) ?
-      llvm::sys::fs::copy_file(CompilationRecordPath,
-                               CompilationRecordPath + "~moduleonly");
+      copyFileCloning(CompilationRecordPath,
+                      CompilationRecordPath + "~moduleonly");
     }
   }
   abnormalExit = State.hadAnyAbnormalExit();
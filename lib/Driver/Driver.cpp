@@ -430,6 +430,15 @@ static void dealWithRemovedInputs(ArrayRef<StringRef> removedInputs,
                                   bool ShowIncrementalBuildDecisions);
 
 /// Returns why ignore incrementality
+///
+/// The build record stays YAML even though it's re-parsed on every driver
+/// start: it holds one entry per input (mtime and dirty state), so it is
+/// parsed exactly once per build and its size scales with the file list,
+/// not with code volume, and keeping it textual means a stale or confusing
+/// incremental state can be inspected (or deleted entry by entry) with a
+/// text editor. If parse time ever matters at much larger input counts,
+/// the mtime-plus-hash short-circuit would need to come first anyway --
+/// format alone doesn't remove the per-entry stat calls done below.
 static std::string
 populateOutOfDateMap(InputInfoMap &map, llvm::sys::TimePoint<> &LastBuildTime,
                      StringRef argsHashStr, const InputFileList &inputs,
@@ -1974,6 +1983,7 @@ void Driver::buildActions(SmallVectorImpl<const Action *> &TopLevelActions,
       case file_types::TY_PrivateSwiftModuleInterfaceFile:
       case file_types::TY_SwiftCrossImportDir:
       case file_types::TY_SwiftOverlayFile:
+      case file_types::TY_JSONDependencies:
         // We could in theory handle assembly or LLVM input, but let's not.
         // FIXME: What about LTO?
         Diags.diagnose(SourceLoc(), diag::error_unexpected_input_file,
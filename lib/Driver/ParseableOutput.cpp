@@ -253,13 +253,21 @@ struct ObjectTraits<Message> {
 } // namespace swift
 
 static void emitMessage(raw_ostream &os, Message &msg) {
-  std::string JSONString;
-  llvm::raw_string_ostream BufferStream(JSONString);
+  // Each message is length-prefixed, so it has to be rendered to a buffer
+  // before any of it can be written out; this is not discretionary
+  // buffering. Assemble the prefix and body into one record and emit it
+  // with a single write, so a consumer blocking on the (unbuffered) stream
+  // sees whole records arrive as soon as the event happens and never reads
+  // a prefix without its body.
+  SmallString<256> JSONString;
+  llvm::raw_svector_ostream BufferStream(JSONString);
   json::Output yout(BufferStream);
   yout << msg;
-  BufferStream.flush();
-  os << JSONString.length() << '\n';
-  os << JSONString << '\n';
+
+  SmallString<256> Record;
+  llvm::raw_svector_ostream RecordStream(Record);
+  RecordStream << JSONString.size() << '\n' << JSONString << '\n';
+  os << RecordStream.str();
 }
 
 void parseable_output::emitBeganMessage(raw_ostream &os, const Job &Cmd,
@@ -180,6 +180,17 @@ toolchains::GenericUnix::constructInvocation(const DynamicLinkJobAction &job,
 #endif
   }
 
+  // In LTO modes the compile jobs emitted LLVM bitcode into their object
+  // file outputs; have clang drive the corresponding (thin-)link through the
+  // linker's LTO plugin.
+  if (const Arg *A = context.Args.getLastArg(options::OPT_lto)) {
+    StringRef LTOKind = A->getValue();
+    if (LTOKind == "llvm-thin")
+      Arguments.push_back("-flto=thin");
+    else if (LTOKind == "llvm-full")
+      Arguments.push_back("-flto=full");
+  }
+
   // Configure the toolchain.
   //
   // By default use the system `clang` to perform the link.  We use `clang` for
@@ -19,6 +19,7 @@
 #include "swift/Option/SanitizerOptions.h"
 #include "swift/Strings.h"
 #include "llvm/ADT/STLExtras.h"
+#include "llvm/ADT/StringSwitch.h"
 #include "llvm/ADT/Triple.h"
 #include "llvm/Option/Arg.h"
 #include "llvm/Option/ArgList.h"
@@ -697,9 +698,15 @@ static bool ParseTypeCheckerArgs(TypeCheckerOptions &Opts, ArgList &Args,
     Opts.DebugForbidTypecheckPrefix = A->getValue();
   }
 
+  if (const Arg *A = Args.getLastArg(OPT_solver_overload_profile_path)) {
+    Opts.SolverOverloadProfilePath = A->getValue();
+  }
+
   if (Args.getLastArg(OPT_solver_disable_shrink))
     Opts.SolverDisableShrink = true;
 
+  Opts.SolverArenaStats |= Args.hasArg(OPT_solver_arena_stats);
+
   return HadError;
 }
 
@@ -1331,6 +1338,19 @@ static bool ParseIRGenArgs(IRGenOptions &Opts, ArgList &Args,
   else if (Args.hasArg(OPT_embed_bitcode_marker))
     Opts.EmbedMode = IRGenEmbedMode::EmbedMarker;
 
+  if (const Arg *A = Args.getLastArg(options::OPT_lto)) {
+    auto LLVMLTOKind =
+        llvm::StringSwitch<Optional<IRGenLLVMLTOKind>>(A->getValue())
+            .Case("llvm-thin", IRGenLLVMLTOKind::Thin)
+            .Case("llvm-full", IRGenLLVMLTOKind::Full)
+            .Default(llvm::None);
+    if (LLVMLTOKind)
+      Opts.LLVMLTOKind = LLVMLTOKind.getValue();
+    else
+      Diags.diagnose(SourceLoc(), diag::error_invalid_arg_value,
+                     A->getAsString(Args), A->getValue());
+  }
+
   if (Opts.EmbedMode == IRGenEmbedMode::EmbedBitcode) {
     // Keep track of backend options so we can embed them in a separate data
     // section and use them when building from the bitcode. This can be removed
@@ -1531,18 +1551,15 @@ static bool ParseMigratorArgs(MigratorOptions &Opts,
   }
 
   if (Opts.shouldRunMigrator()) {
-    assert(!FrontendOpts.InputsAndOutputs.isWholeModule());
-    // FIXME: In order to support batch mode properly, the migrator would have
-    // to support having one remap file path and one migrated file path per
-    // primary input. The easiest way to do this would be to move processing of
-    // these paths into FrontendOptions, like other supplementary outputs, and
-    // to call migrator::updateCodeAndEmitRemapIfNeeded once for each primary
-    // file.
+    // The migrator runs once per primary input, deriving per-primary remap
+    // and migrated-file paths from the configured ones when there is more
+    // than one, so batch-mode jobs are fine.
     //
-    // Supporting WMO would be similar, but WMO is set up to only produce one
-    // supplementary output for the whole compilation instead of one per input,
-    // so it's probably not worth it.
-    FrontendOpts.InputsAndOutputs.assertMustNotBeMoreThanOnePrimaryInput();
+    // Supporting WMO would require teaching it to migrate several files from
+    // one invocation, but WMO is set up to only produce one supplementary
+    // output for the whole compilation instead of one per input, so it's
+    // probably not worth it.
+    assert(!FrontendOpts.InputsAndOutputs.isWholeModule());
 
     // Always disable typo-correction in the migrator.
     LangOpts.TypoCorrectionLimit = 0;
@@ -44,6 +44,9 @@
 #include "llvm/Support/Path.h"
 #include "llvm/Support/Process.h"
 
+#include <atomic>
+#include <thread>
+
 using namespace swift;
 
 CompilerInstance::CompilerInstance() = default;
@@ -443,6 +446,15 @@ void CompilerInstance::setUpDiagnosticOptions() {
 // 5. ClangImporter: This must come after all the Swift module loaders because
 //    in the presence of overlays and mixed-source frameworks, we want to prefer
 //    the overlay or framework module over the underlying Clang module.
+//
+// All of these loaders are built per CompilerInstance and die with it; what
+// makes repeated invocations tolerable is that their expensive inputs live
+// on disk across processes: serialized modules are memory-mapped (so the OS
+// keeps hot ones resident), PCMs sit in the shared Clang module cache, and
+// compiled interfaces in the prebuilt/interface caches. Keeping loaded
+// modules warm in-process instead would mean an ASTContext that outlives an
+// invocation, and the ASTContext has no way to evict or re-validate decls
+// against a changed world -- that is the role the on-disk caches play.
 bool CompilerInstance::setUpModuleLoaders() {
   if (hasSourceImport()) {
     bool enableLibraryEvolution =
@@ -983,6 +995,46 @@ void CompilerInstance::parseLibraryFile(
   performImportResolution(*NextInput);
 }
 
+/// Touch the contents of the given source buffers on a few background
+/// threads.
+///
+/// The parse loop itself has to stay serial for now — ASTContext's identifier
+/// table and allocator, the request evaluator's cache, and DiagnosticEngine
+/// are all single-threaded — but the dominant cold-build cost of a large WMO
+/// parse phase is faulting in hundreds of source files. Reading one byte per
+/// page ahead of the parser overlaps that I/O with parsing. The workers only
+/// perform read accesses on immutable buffers and are joined before this
+/// function returns.
+static void prefetchInputBuffers(SourceManager &SM,
+                                 ArrayRef<unsigned> bufferIDs) {
+  const unsigned numWorkers =
+      std::min<unsigned>(std::thread::hardware_concurrency(), 4);
+  if (bufferIDs.size() < 8 || numWorkers < 2)
+    return;
+
+  static std::atomic<unsigned char> prefetchSink;
+  std::atomic<size_t> nextBuffer(0);
+  auto prefetchWorker = [&] {
+    unsigned char sum = 0;
+    while (true) {
+      size_t idx = nextBuffer.fetch_add(1, std::memory_order_relaxed);
+      if (idx >= bufferIDs.size())
+        break;
+      StringRef text = SM.getEntireTextForBuffer(bufferIDs[idx]);
+      for (size_t i = 0, e = text.size(); i < e; i += 4096)
+        sum += (unsigned char)text[i];
+    }
+    // Publish the checksum so the page reads cannot be optimized away.
+    prefetchSink.fetch_add(sum, std::memory_order_relaxed);
+  };
+
+  SmallVector<std::thread, 4> workers;
+  for (unsigned i = 0; i < numWorkers; ++i)
+    workers.emplace_back(prefetchWorker);
+  for (auto &worker : workers)
+    worker.join();
+}
+
 bool CompilerInstance::parsePartialModulesAndLibraryFiles(
     const ImplicitImports &implicitImports) {
   FrontendStatsTracer tracer(getStatsReporter(),
@@ -998,7 +1050,9 @@ bool CompilerInstance::parsePartialModulesAndLibraryFiles(
       hadLoadError = true;
   }
 
-  // Then parse all the library files.
+  // Then parse all the library files. Warm the buffers on background threads
+  // first so the serial parse loop doesn't stall on page faults.
+  prefetchInputBuffers(SourceMgr, InputSourceCodeBufferIDs);
   for (auto BufferID : InputSourceCodeBufferIDs) {
     if (BufferID != MainBufferID) {
       parseLibraryFile(BufferID, implicitImports);
@@ -41,6 +41,7 @@ bool FrontendOptions::needsProperModuleName(ActionType action) {
   case ActionType::DumpScopeMaps:
   case ActionType::DumpTypeRefinementContexts:
   case ActionType::DumpPCM:
+  case ActionType::ScanDependencies:
     return false;
   case ActionType::EmitPCH:
   case ActionType::EmitSILGen:
@@ -96,6 +97,7 @@ bool FrontendOptions::isActionImmediate(ActionType action) {
   case ActionType::EmitBC:
   case ActionType::EmitObject:
   case ActionType::EmitImportedModules:
+  case ActionType::ScanDependencies:
   case ActionType::DumpTypeInfo:
   case ActionType::EmitPCM:
   case ActionType::DumpPCM:
@@ -202,6 +204,9 @@ FrontendOptions::formatForPrincipalOutputFileForAction(ActionType action) {
   case ActionType::EmitImportedModules:
     return TY_ImportedModules;
 
+  case ActionType::ScanDependencies:
+    return TY_JSONDependencies;
+
   case ActionType::EmitPCM:
     return TY_ClangModuleFile;
   }
@@ -224,6 +229,7 @@ bool FrontendOptions::canActionEmitDependencies(ActionType action) {
   case ActionType::Immediate:
   case ActionType::REPL:
   case ActionType::DumpPCM:
+  case ActionType::ScanDependencies:
     return false;
   case ActionType::ResolveImports:
   case ActionType::Typecheck:
@@ -263,6 +269,7 @@ bool FrontendOptions::canActionEmitReferenceDependencies(ActionType action) {
   case ActionType::REPL:
   case ActionType::EmitPCM:
   case ActionType::DumpPCM:
+  case ActionType::ScanDependencies:
     return false;
   case ActionType::Typecheck:
   case ActionType::MergeModules:
@@ -309,6 +316,7 @@ bool FrontendOptions::canActionEmitObjCHeader(ActionType action) {
   case ActionType::REPL:
   case ActionType::EmitPCM:
   case ActionType::DumpPCM:
+  case ActionType::ScanDependencies:
     return false;
   case ActionType::Typecheck:
   case ActionType::MergeModules:
@@ -344,6 +352,7 @@ bool FrontendOptions::canActionEmitLoadedModuleTrace(ActionType action) {
   case ActionType::REPL:
   case ActionType::EmitPCM:
   case ActionType::DumpPCM:
+  case ActionType::ScanDependencies:
     return false;
   case ActionType::ResolveImports:
   case ActionType::Typecheck:
@@ -385,6 +394,7 @@ bool FrontendOptions::canActionEmitModule(ActionType action) {
   case ActionType::REPL:
   case ActionType::EmitPCM:
   case ActionType::DumpPCM:
+  case ActionType::ScanDependencies:
     return false;
   case ActionType::MergeModules:
   case ActionType::EmitModuleOnly:
@@ -427,6 +437,7 @@ bool FrontendOptions::canActionEmitInterface(ActionType action) {
   case ActionType::REPL:
   case ActionType::EmitPCM:
   case ActionType::DumpPCM:
+  case ActionType::ScanDependencies:
     return false;
   case ActionType::Typecheck:
   case ActionType::MergeModules:
@@ -465,6 +476,7 @@ bool FrontendOptions::doesActionProduceOutput(ActionType action) {
   case ActionType::EmitBC:
   case ActionType::EmitObject:
   case ActionType::EmitImportedModules:
+  case ActionType::ScanDependencies:
   case ActionType::MergeModules:
   case ActionType::CompileModuleFromInterface:
   case ActionType::DumpTypeInfo:
@@ -507,6 +519,7 @@ bool FrontendOptions::doesActionProduceTextualOutput(ActionType action) {
   case ActionType::DumpScopeMaps:
   case ActionType::DumpTypeRefinementContexts:
   case ActionType::EmitImportedModules:
+  case ActionType::ScanDependencies:
   case ActionType::EmitSILGen:
   case ActionType::EmitSIL:
   case ActionType::EmitAssembly:
@@ -532,6 +545,7 @@ bool FrontendOptions::doesActionGenerateSIL(ActionType action) {
   case ActionType::DumpScopeMaps:
   case ActionType::DumpTypeRefinementContexts:
   case ActionType::EmitImportedModules:
+  case ActionType::ScanDependencies:
   case ActionType::EmitPCH:
   case ActionType::CompileModuleFromInterface:
   case ActionType::EmitPCM:
@@ -578,6 +592,7 @@ bool FrontendOptions::doesActionGenerateIR(ActionType action) {
   case ActionType::EmitSIBGen:
   case ActionType::EmitSIB:
   case ActionType::EmitImportedModules:
+  case ActionType::ScanDependencies:
   case ActionType::EmitPCM:
   case ActionType::DumpPCM:
     return false;
@@ -385,6 +385,16 @@ class ModuleInterfaceLoaderImpl {
     auto normalizedTargetTriple =
         getTargetSpecificModuleTriple(SubInvocation.getLangOptions().Target);
 
+    // Normalize the paths in the key so that the same interface doesn't get
+    // separate cache entries just because different clients of a shared cache
+    // directory spell its path differently ("a//b", "a/./b", and so on).
+    llvm::SmallString<128> normalizedInterfacePath(interfacePath);
+    path::remove_dots(normalizedInterfacePath, /*remove_dot_dot=*/true);
+    path::native(normalizedInterfacePath);
+    llvm::SmallString<128> normalizedSDKPath(SubInvocation.getSDKPath());
+    path::remove_dots(normalizedSDKPath, /*remove_dot_dot=*/true);
+    path::native(normalizedSDKPath);
+
     llvm::hash_code H = hash_combine(
         // Start with the compiler version (which will be either tag names or
         // revs). Explicitly don't pass in the "effective" language version --
@@ -395,7 +405,7 @@ class ModuleInterfaceLoaderImpl {
         // Simplest representation of input "identity" (not content) is just a
         // pathname, and probably all we can get from the VFS in this regard
         // anyways.
-        interfacePath,
+        normalizedInterfacePath.str(),
 
         // Include the normalized target triple. In practice, .swiftinterface
         // files will be in target-specific subdirectories and would have
@@ -407,7 +417,7 @@ class ModuleInterfaceLoaderImpl {
 
         // The SDK path is going to affect how this module is imported, so
         // include it.
-        SubInvocation.getSDKPath(),
+        normalizedSDKPath.str(),
 
         // Whether or not we're tracking system dependencies affects the
         // invalidation behavior of this cache item.
@@ -421,8 +421,8 @@ public:
     if (protocolsToPrint.empty())
       return;
 
+    StreamPrinter printer(out);
     for (const auto &protoAndAvailability : protocolsToPrint) {
-      StreamPrinter printer(out);
       // FIXME: Shouldn't this be an implicit conversion?
       TinyPtrVector<const DeclAttribute *> attrs;
       attrs.insert(attrs.end(), protoAndAvailability.second.begin(),
@@ -487,6 +487,15 @@ bool swift::emitSwiftInterface(raw_ostream &out,
       Opts.PreserveTypesAsWritten, Opts.PrintFullConvention, Opts.PrintSPIs);
   InheritedProtocolCollector::PerTypeMap inheritedProtocolMap;
 
+  // Print each top-level decl into a reused in-memory chunk and stream the
+  // chunk out once the decl is complete. The printer emits many tiny tokens;
+  // appending them to a small vector and handing the file stream one write
+  // per decl is cheaper than pushing every token through the (possibly
+  // unbuffered) output stream, while peak memory stays at one decl rather
+  // than the whole interface.
+  SmallString<256> chunk;
+  llvm::raw_svector_ostream chunkOS(chunk);
+
   SmallVector<Decl *, 16> topLevelDecls;
   M->getTopLevelDecls(topLevelDecls);
   for (const Decl *D : topLevelDecls) {
@@ -499,8 +508,10 @@ bool swift::emitSwiftInterface(raw_ostream &out,
       continue;
     }
 
-    D->print(out, printOptions);
-    out << "\n";
+    chunk.clear();
+    D->print(chunkOS, printOptions);
+    chunkOS << "\n";
+    out << chunkOS.str();
   }
 
   // Print dummy extensions for any protocols that were indirectly conformed to.
@@ -23,6 +23,7 @@
 #include "swift/FrontendTool/FrontendTool.h"
 #include "ImportedModules.h"
 #include "ReferenceDependencies.h"
+#include "ScanDependencies.h"
 #include "TBD.h"
 
 #include "swift/Subsystems.h"
@@ -1254,6 +1255,11 @@ static bool performCompile(CompilerInstance &Instance,
   if (Action == FrontendOptions::ActionType::CompileModuleFromInterface)
     return buildModuleFromInterface(Invocation, Instance);
 
+  // Scanning only lexes the inputs; it must not load the standard library or
+  // touch any other state the full frontend would set up.
+  if (Action == FrontendOptions::ActionType::ScanDependencies)
+    return scanDependencies(Invocation, Instance);
+
   if (Invocation.getInputKind() == InputFileKind::LLVM)
     return compileLLVMIR(Invocation, Instance);
 
@@ -1755,6 +1761,10 @@ static bool emitIndexDataIfNeeded(SourceFile *PrimarySourceFile,
     }
   }
 
+  if (opts.IndexStoreCompact &&
+      index::compactIndexStore(opts.IndexStorePath, Instance.getDiags()))
+    return true;
+
   return false;
 }
 
@@ -0,0 +1,258 @@
+//===--- ScanDependencies.cpp -- fast module dependency scanning ----------===//
+//
+// This source file is part of the Swift.org open source project
+//
+// Copyright (c) 2014 - 2020 Apple Inc. and the Swift project authors
+// Licensed under Apache License v2.0 with Runtime Library Exception
+//
+// See https://swift.org/LICENSE.txt for license information
+// See https://swift.org/CONTRIBUTORS.txt for the list of Swift project authors
+//
+//===----------------------------------------------------------------------===//
+
+#include "ScanDependencies.h"
+#include "swift/AST/ASTContext.h"
+#include "swift/AST/DiagnosticEngine.h"
+#include "swift/AST/DiagnosticsFrontend.h"
+#include "swift/AST/SearchPathOptions.h"
+#include "swift/Basic/LLVM.h"
+#include "swift/Basic/Platform.h"
+#include "swift/Basic/SourceManager.h"
+#include "swift/Frontend/Frontend.h"
+#include "swift/Frontend/FrontendOptions.h"
+#include "swift/Parse/Lexer.h"
+#include "swift/Strings.h"
+#include "llvm/ADT/MapVector.h"
+#include "llvm/ADT/SetVector.h"
+#include "llvm/ADT/SmallString.h"
+#include "llvm/Support/FileSystem.h"
+#include "llvm/Support/FormatVariadic.h"
+#include "llvm/Support/JSON.h"
+#include "llvm/Support/Path.h"
+#include "llvm/Support/VirtualFileSystem.h"
+
+using namespace swift;
+
+namespace {
+/// A module discovered while scanning, together with the imports lexed out of
+/// its textual interface when one is available.
+struct ScannedModule {
+  /// How the module is provided on the search paths.
+  enum class Kind {
+    SourceFiles,    ///< The module under compilation.
+    SwiftInterface, ///< A textual interface whose imports we can lex.
+    SwiftBinary,    ///< A binary module; its imports are opaque to the lexer.
+    Unresolved,     ///< Not found: a Clang module or a missing dependency.
+  };
+
+  Kind kind = Kind::Unresolved;
+  std::string path;
+  std::vector<std::string> imports;
+};
+} // end anonymous namespace
+
+/// Collect the top-level names of the modules imported by the given buffer.
+///
+/// This lexes the buffer without building a syntax tree or AST: every
+/// 'import' keyword is assumed to begin an import declaration, and the first
+/// identifier of its import path names the top-level module.
+static void scanImportsInBuffer(const SourceManager &SM,
+                                const LangOptions &LangOpts, unsigned bufferID,
+                                LexerMode mode,
+                                llvm::SetVector<std::string> &imports) {
+  Lexer lexer(LangOpts, SM, bufferID, /*Diags=*/nullptr, mode,
+              HashbangMode::Allowed, CommentRetentionMode::None);
+  Token Tok;
+  do {
+    lexer.lex(Tok);
+    if (Tok.isNot(tok::kw_import))
+      continue;
+
+    lexer.lex(Tok);
+    // Skip over any import kind, as in 'import func Swift.min'.
+    if (Tok.isKeyword())
+      lexer.lex(Tok);
+
+    if (Tok.is(tok::identifier))
+      imports.insert(Tok.getText().str());
+  } while (Tok.isNot(tok::eof));
+}
+
+/// Return the base names to try for a target-specific file within a
+/// '.swiftmodule' directory, from most to least desirable. This mirrors the
+/// lookup performed by the serialized module loader.
+static void getTargetModuleBasenames(const llvm::Triple &target,
+                                     SmallVectorImpl<std::string> &names) {
+  names.push_back(getTargetSpecificModuleTriple(target).str());
+  names.push_back(target.getArchName().str());
+}
+
+static bool tryModuleFile(llvm::vfs::FileSystem &fs, StringRef path,
+                          ScannedModule::Kind kind, ScannedModule &result) {
+  auto status = fs.status(path);
+  if (!status || status->isDirectory())
+    return false;
+  result.kind = kind;
+  result.path = path.str();
+  return true;
+}
+
+/// Look for \p moduleName in the directory \p dir, preferring a binary module
+/// over a textual interface the way the serialized module loader does.
+static bool findModuleInDirectory(llvm::vfs::FileSystem &fs, StringRef dir,
+                                  StringRef moduleName,
+                                  ArrayRef<std::string> targetBasenames,
+                                  ScannedModule &result) {
+  SmallString<256> base(dir);
+  llvm::sys::path::append(base, moduleName);
+  base += ".swiftmodule";
+
+  // '<name>.swiftmodule' is either a flat file or a directory of
+  // target-specific module files.
+  auto status = fs.status(base);
+  if (status && status->isDirectory()) {
+    for (const auto &targetName : targetBasenames) {
+      SmallString<256> path(base);
+      llvm::sys::path::append(path, targetName);
+      path += ".swiftmodule";
+      if (tryModuleFile(fs, path, ScannedModule::Kind::SwiftBinary, result))
+        return true;
+      path.resize(path.size() - strlen("swiftmodule"));
+      path += "swiftinterface";
+      if (tryModuleFile(fs, path, ScannedModule::Kind::SwiftInterface, result))
+        return true;
+    }
+    return false;
+  }
+
+  if (tryModuleFile(fs, base, ScannedModule::Kind::SwiftBinary, result))
+    return true;
+
+  base.resize(base.size() - strlen("swiftmodule"));
+  base += "swiftinterface";
+  return tryModuleFile(fs, base, ScannedModule::Kind::SwiftInterface, result);
+}
+
+/// Resolve \p moduleName against the compiler's module search paths.
+static ScannedModule resolveModule(const SearchPathOptions &searchPathOpts,
+                                   const llvm::Triple &target,
+                                   llvm::vfs::FileSystem &fs,
+                                   StringRef moduleName) {
+  ScannedModule result;
+  SmallVector<std::string, 4> targetBasenames;
+  getTargetModuleBasenames(target, targetBasenames);
+
+  for (StringRef dir : searchPathOpts.ImportSearchPaths)
+    if (findModuleInDirectory(fs, dir, moduleName, targetBasenames, result))
+      return result;
+
+  for (const auto &framework : searchPathOpts.FrameworkSearchPaths) {
+    SmallString<256> frameworkDir(framework.Path);
+    llvm::sys::path::append(frameworkDir, moduleName);
+    frameworkDir += ".framework";
+    llvm::sys::path::append(frameworkDir, "Modules");
+    if (findModuleInDirectory(fs, frameworkDir, moduleName, targetBasenames,
+                              result))
+      return result;
+  }
+
+  for (StringRef dir : searchPathOpts.RuntimeLibraryImportPaths)
+    if (findModuleInDirectory(fs, dir, moduleName, targetBasenames, result))
+      return result;
+
+  return result;
+}
+
+static StringRef getScannedModuleKindName(ScannedModule::Kind kind) {
+  switch (kind) {
+  case ScannedModule::Kind::SourceFiles:
+    return "source";
+  case ScannedModule::Kind::SwiftInterface:
+    return "swiftinterface";
+  case ScannedModule::Kind::SwiftBinary:
+    return "swiftmodule";
+  case ScannedModule::Kind::Unresolved:
+    return "unknown";
+  }
+  llvm_unreachable("unhandled kind");
+}
+
+bool swift::scanDependencies(CompilerInvocation &Invocation,
+                             CompilerInstance &Instance) {
+  ASTContext &Context = Instance.getASTContext();
+  const FrontendOptions &opts = Invocation.getFrontendOptions();
+  SourceManager &SM = Instance.getSourceMgr();
+  auto fs = SM.getFileSystem();
+
+  // Seed the graph with the module under compilation, whose imports come
+  // from lexing the input source files directly.
+  llvm::SetVector<std::string> mainImports;
+  for (unsigned bufferID : Instance.getInputBufferIDs())
+    scanImportsInBuffer(SM, Context.LangOpts, bufferID, LexerMode::Swift,
+                        mainImports);
+
+  llvm::MapVector<std::string, ScannedModule> modules;
+  SmallVector<std::string, 8> worklist;
+
+  ScannedModule mainModule;
+  mainModule.kind = ScannedModule::Kind::SourceFiles;
+  mainModule.imports.assign(mainImports.begin(), mainImports.end());
+  modules.insert({opts.ModuleName, std::move(mainModule)});
+  worklist.append(mainImports.begin(), mainImports.end());
+
+  // Chase textual interfaces to close the graph transitively. Binary modules
+  // and Clang modules become leaves; decoding their dependency records would
+  // defeat the purpose of a lexer-only scan.
+  while (!worklist.empty()) {
+    std::string name = worklist.pop_back_val();
+    if (modules.count(name) || name == BUILTIN_NAME)
+      continue;
+
+    ScannedModule module = resolveModule(Invocation.getSearchPathOptions(),
+                                         Context.LangOpts.Target, *fs, name);
+    if (module.kind == ScannedModule::Kind::SwiftInterface) {
+      if (auto buffer = fs->getBufferForFile(module.path)) {
+        unsigned bufferID = SM.addNewSourceBuffer(std::move(*buffer));
+        llvm::SetVector<std::string> imports;
+        scanImportsInBuffer(SM, Context.LangOpts, bufferID,
+                            LexerMode::SwiftInterface, imports);
+        module.imports.assign(imports.begin(), imports.end());
+        worklist.append(imports.begin(), imports.end());
+      }
+    }
+    modules.insert({std::move(name), std::move(module)});
+  }
+
+  std::string path = opts.InputsAndOutputs.getSingleOutputFilename();
+  std::error_code EC;
+  llvm::raw_fd_ostream out(path, EC, llvm::sys::fs::F_None);
+
+  if (out.has_error() || EC) {
+    Context.Diags.diagnose(SourceLoc(), diag::error_opening_output, path,
+                           EC.message());
+    out.clear_error();
+    return true;
+  }
+
+  llvm::json::Array moduleArray;
+  for (const auto &entry : modules) {
+    const ScannedModule &module = entry.second;
+    llvm::json::Object obj;
+    obj["name"] = entry.first;
+    obj["kind"] = getScannedModuleKindName(module.kind);
+    if (!module.path.empty())
+      obj["path"] = module.path;
+    llvm::json::Array importsArray;
+    for (const auto &import : module.imports)
+      importsArray.push_back(import);
+    obj["imports"] = std::move(importsArray);
+    moduleArray.push_back(std::move(obj));
+  }
+
+  llvm::json::Object root;
+  root["mainModuleName"] = opts.ModuleName;
+  root["modules"] = std::move(moduleArray);
+  out << llvm::formatv("{0:2}", llvm::json::Value(std::move(root))) << '\n';
+
+  return Context.hadError();
+}
@@ -0,0 +1,28 @@
+//===--- ScanDependencies.h -- fast module dependency scanning ------------===//
+//
+// This source file is part of the Swift.org open source project
+//
+// Copyright (c) 2014 - 2020 Apple Inc. and the Swift project authors
+// Licensed under Apache License v2.0 with Runtime Library Exception
+//
+// See https://swift.org/LICENSE.txt for license information
+// See https://swift.org/CONTRIBUTORS.txt for the list of Swift project authors
+//
+//===----------------------------------------------------------------------===//
+
+#ifndef SWIFT_FRONTENDTOOL_SCANDEPENDENCIES_H
+#define SWIFT_FRONTENDTOOL_SCANDEPENDENCIES_H
+
+namespace swift {
+
+class CompilerInvocation;
+class CompilerInstance;
+
+/// Scan the import declarations of the instance's input files by lexing them,
+/// resolve the imported names against the module search paths, and emit the
+/// transitive module dependency graph as JSON.
+bool scanDependencies(CompilerInvocation &Invocation,
+                      CompilerInstance &Instance);
+} // end namespace swift
+
+#endif
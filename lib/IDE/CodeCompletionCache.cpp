@@ -102,12 +102,6 @@ CodeCompletionCache::~CodeCompletionCache() {}
 /// cached results. This isn't expected to change very often.
 static constexpr uint32_t onDiskCompletionCacheVersion = 1;
 
-static StringRef copyString(llvm::BumpPtrAllocator &Allocator, StringRef Str) {
-  char *Mem = Allocator.Allocate<char>(Str.size());
-  std::copy(Str.begin(), Str.end(), Mem);
-  return StringRef(Mem, Str.size());
-}
-
 static ArrayRef<StringRef> copyStringArray(llvm::BumpPtrAllocator &Allocator,
                                            ArrayRef<StringRef> Arr) {
   StringRef *Buff = Allocator.Allocate<StringRef>(Arr.size());
@@ -124,14 +118,33 @@ static ArrayRef<std::pair<StringRef, StringRef>> copyStringPairArray(
   return llvm::makeArrayRef(Buff, Arr.size());
 }
 
-/// Deserializes CodeCompletionResults from \p in and stores them in \p V.
+/// A BumpPtrAllocator bundled with the memory buffer its strings point into.
+///
+/// Deserialized results reference the buffer's string blob in place rather
+/// than copying it, so the buffer has to live exactly as long as the
+/// allocator: everything that imports results from a sink retains the
+/// sink's allocator (\see copyCodeCompletionResults).
+namespace {
+struct BufferOwningAllocator {
+  std::unique_ptr<llvm::MemoryBuffer> Buffer;
+  llvm::BumpPtrAllocator Allocator;
+};
+} // end anonymous namespace
+
+/// Deserializes CodeCompletionResults from \p in and stores them in \p V,
+/// taking ownership of the buffer since the results use its strings in place.
 /// \see writeCacheModule.
-static bool readCachedModule(llvm::MemoryBuffer *in,
+static bool readCachedModule(std::unique_ptr<llvm::MemoryBuffer> in,
                              const CodeCompletionCache::Key &K,
                              CodeCompletionCache::Value &V,
                              bool allowOutOfDate = false) {
-  const char *cursor = in->getBufferStart();
-  const char *end = in->getBufferEnd();
+  auto owner = std::make_shared<BufferOwningAllocator>();
+  owner->Buffer = std::move(in);
+  V.Sink.Allocator = CodeCompletionResultSink::AllocatorPtr(
+      owner, &owner->Allocator);
+
+  const char *cursor = owner->Buffer->getBufferStart();
+  const char *end = owner->Buffer->getBufferEnd();
 
   auto read32le = [end](const char *&cursor) {
     auto result = llvm::support::endian::read32le(cursor);
@@ -181,7 +194,7 @@ static bool readCachedModule(llvm::MemoryBuffer *in,
 
     const char *p = strings + index;
     auto size = read32le(p);
-    return copyString(*V.Sink.Allocator, StringRef(p, size));
+    return StringRef(p, size);
   };
 
   // CHUNKS
@@ -444,14 +457,19 @@ static std::string getName(StringRef cacheDirectory,
 
 Optional<CodeCompletionCache::ValueRefCntPtr>
 OnDiskCodeCompletionCache::get(const Key &K) {
-  // Try to find the cached file.
-  auto bufferOrErr = llvm::MemoryBuffer::getFile(getName(cacheDirectory, K));
+  // Try to map the cached file; the deserialized results use its string
+  // blob in place, so no null terminator is needed and large modules avoid
+  // being copied into memory.
+  auto bufferOrErr = llvm::MemoryBuffer::getFile(getName(cacheDirectory, K),
+                                                 /*FileSize=*/-1,
+                                                 /*RequiresNullTerminator=*/
+                                                 false);
   if (!bufferOrErr)
     return None;
 
   // Read the cached results, failing if they are out of date.
   auto V = CodeCompletionCache::createValue();
-  if (!readCachedModule(bufferOrErr.get().get(), K, *V))
+  if (!readCachedModule(std::move(bufferOrErr.get()), K, *V))
     return None;
 
   return V;
@@ -486,8 +504,10 @@ std::error_code OnDiskCodeCompletionCache::set(const Key &K, ValueRefCntPtr V) {
 
 Optional<CodeCompletionCache::ValueRefCntPtr>
 OnDiskCodeCompletionCache::getFromFile(StringRef filename) {
-  // Try to find the cached file.
-  auto bufferOrErr = llvm::MemoryBuffer::getFile(filename);
+  // Try to map the cached file.
+  auto bufferOrErr = llvm::MemoryBuffer::getFile(filename, /*FileSize=*/-1,
+                                                 /*RequiresNullTerminator=*/
+                                                 false);
   if (!bufferOrErr)
     return None;
 
@@ -497,7 +517,7 @@ OnDiskCodeCompletionCache::getFromFile(StringRef filename) {
 
   // Read the cached results.
   auto V = CodeCompletionCache::createValue();
-  if (!readCachedModule(bufferOrErr.get().get(), K, *V,
+  if (!readCachedModule(std::move(bufferOrErr.get()), K, *V,
                         /*allowOutOfDate*/ true))
     return None;
 
@@ -445,6 +445,12 @@ std::string ide::extractPlainTextFromComment(const StringRef Text) {
 }
 
 bool ide::getDocumentationCommentAsXML(const Decl *D, raw_ostream &OS) {
+  swift::markup::MarkupContext MC;
+  return getDocumentationCommentAsXML(D, OS, MC);
+}
+
+bool ide::getDocumentationCommentAsXML(const Decl *D, raw_ostream &OS,
+                                       swift::markup::MarkupContext &MC) {
   auto MaybeClangNode = D->getClangNode();
   if (MaybeClangNode) {
     if (auto *CD = MaybeClangNode.getAsDecl()) {
@@ -458,7 +464,6 @@ bool ide::getDocumentationCommentAsXML(const Decl *D, raw_ostream &OS) {
     return false;
   }
 
-  swift::markup::MarkupContext MC;
   auto DC = getCascadingDocComment(MC, D);
   if (!DC)
     return false;
@@ -18,6 +18,7 @@
 #include "swift/AST/Module.h"
 #include "swift/AST/PrettyStackTrace.h"
 #include "swift/AST/SourceFile.h"
+#include "swift/AST/TypeRepr.h"
 #include "swift/Basic/LangOptions.h"
 #include "swift/Basic/PrettyStackTrace.h"
 #include "swift/Basic/SourceManager.h"
@@ -26,6 +27,7 @@
 #include "swift/Parse/Lexer.h"
 #include "swift/Parse/PersistentParserState.h"
 #include "swift/Subsystems.h"
+#include "llvm/ADT/DenseSet.h"
 #include "llvm/ADT/Hashing.h"
 #include "llvm/Support/MemoryBuffer.h"
 
@@ -162,6 +164,128 @@ static DeclContext *getEquivalentDeclContextFromSourceFile(DeclContext *DC,
   return newDC;
 }
 
+/// Return \p D as an \c IterableDeclContext if its member list carries a
+/// token fingerprint, i.e. it is a nominal type or an extension.
+static IterableDeclContext *getAsIterableDeclContext(Decl *D) {
+  if (auto *NTD = dyn_cast<NominalTypeDecl>(D))
+    return NTD;
+  if (auto *ext = dyn_cast<ExtensionDecl>(D))
+    return ext;
+  return nullptr;
+}
+
+/// Return the name of the type whose member list is covered by \p D's body
+/// fingerprint: the name of the nominal type itself, or the written name of
+/// the extended type for an extension. Returns an empty identifier if the
+/// name cannot be determined without name lookup.
+static Identifier getFingerprintedMemberListName(const Decl *D) {
+  if (auto *NTD = dyn_cast<NominalTypeDecl>(D))
+    return NTD->getName();
+
+  auto *ext = cast<ExtensionDecl>(D);
+  auto *repr = ext->getExtendedTypeRepr();
+  if (auto *identRepr = dyn_cast_or_null<IdentTypeRepr>(repr))
+    return identRepr->getComponentRange().back()->getNameRef()
+        .getBaseIdentifier();
+  return Identifier();
+}
+
+/// Append \p D and every nominal type and extension nested inside it to
+/// \p changed.
+static void collectAllMemberLists(Decl *D, SmallVectorImpl<Decl *> &changed) {
+  changed.push_back(D);
+  for (auto *member : getAsIterableDeclContext(D)->getMembers())
+    if (getAsIterableDeclContext(member))
+      collectAllMemberLists(member, changed);
+}
+
+/// Compare the member token fingerprints of the nominal types and extensions
+/// in two structurally identical decl hierarchies, appending each decl of
+/// \p newDecls whose member list differs from its counterpart in \p oldDecls
+/// to \p changed. Returns \c false if a fingerprint is unavailable or the two
+/// hierarchies unexpectedly diverge, in which case the caller must not reuse
+/// the AST.
+template <typename OldRange, typename NewRange>
+static bool collectChangedMemberLists(const OldRange &oldDecls,
+                                      const NewRange &newDecls,
+                                      SmallVectorImpl<Decl *> &changed) {
+  auto oldI = oldDecls.begin(), oldE = oldDecls.end();
+  auto newI = newDecls.begin(), newE = newDecls.end();
+  while (true) {
+    while (oldI != oldE && (*oldI)->isImplicit())
+      ++oldI;
+    while (newI != newE && (*newI)->isImplicit())
+      ++newI;
+    if (oldI == oldE || newI == newE)
+      return oldI == oldE && newI == newE;
+
+    auto *oldIDC = getAsIterableDeclContext(*oldI);
+    auto *newIDC = getAsIterableDeclContext(*newI);
+    if ((oldIDC != nullptr) != (newIDC != nullptr))
+      return false;
+    if (newIDC) {
+      auto oldFingerprint = oldIDC->getBodyFingerprint();
+      auto newFingerprint = newIDC->getBodyFingerprint();
+      if (!oldFingerprint || !newFingerprint)
+        return false;
+      if (*oldFingerprint != *newFingerprint) {
+        // The member lists differ, so nested types cannot be paired up;
+        // conservatively treat every nested member list as changed too.
+        collectAllMemberLists(*newI, changed);
+      } else if (!collectChangedMemberLists(oldIDC->getMembers(),
+                                            newIDC->getMembers(), changed)) {
+        return false;
+      }
+    }
+    ++oldI;
+    ++newI;
+  }
+}
+
+/// Check that a completion performed in \p completionDC on the cached AST
+/// cannot observe the member list changes in \p changed: the completion
+/// context is not nested inside any of the changed types, and nothing in the
+/// new buffer outside of the changed decls themselves mentions their names.
+/// Indirect references still reach the changed type through some decl whose
+/// interface names it, and that name is in the buffer.
+static bool isCompletionUnaffectedByChangedMembers(
+    ArrayRef<Decl *> changed, ASTContext &ctx, SourceManager &SM,
+    unsigned bufferID, const DeclContext *completionDC) {
+  llvm::DenseSet<Identifier> changedNames;
+  for (auto *D : changed) {
+    Identifier name = getFingerprintedMemberListName(D);
+    if (name.empty())
+      return false;
+    changedNames.insert(name);
+  }
+
+  // If the completion context is nested inside a changed type or an
+  // extension of one, unqualified lookup observes the changed members
+  // without naming the type.
+  for (auto *DC = completionDC; DC; DC = DC->getParent()) {
+    auto *D = DC->getAsDecl();
+    if (!D || !(isa<NominalTypeDecl>(D) || isa<ExtensionDecl>(D)))
+      continue;
+    if (changedNames.count(getFingerprintedMemberListName(D)))
+      return false;
+  }
+
+  // Otherwise the changed members are only reachable by naming the changed
+  // type somewhere in the buffer.
+  for (const auto &token : tokenize(ctx.LangOpts, SM, bufferID)) {
+    if (!token.is(tok::identifier))
+      continue;
+    if (!changedNames.count(ctx.getIdentifier(token.getText())))
+      continue;
+    auto isInsideChangedDecl = [&](Decl *D) {
+      return SM.rangeContainsTokenLoc(D->getSourceRange(), token.getLoc());
+    };
+    if (llvm::none_of(changed, isInsideChangedDecl))
+      return false;
+  }
+  return true;
+}
+
 } // namespace
 
 bool CompletionInstance::performCachedOperationIfPossible(
@@ -212,8 +336,6 @@ bool CompletionInstance::performCachedOperationIfPossible(
       new (*tmpCtx) SourceFile(*tmpM, oldSF->Kind, tmpBufferID,
                                SourceFile::ImplicitModuleImportKind::None);
   tmpSF->enableInterfaceHash();
-  // Ensure all non-function-body tokens are hashed into the interface hash
-  tmpCtx->LangOpts.EnableTypeFingerprints = false;
 
   // Couldn't find any completion token?
   auto *newState = tmpSF->getDelayedParserState();
@@ -233,6 +355,21 @@ bool CompletionInstance::performCachedOperationIfPossible(
     if (oldInterfaceHash != newInterfaceHash)
       return false;
 
+    // With type fingerprints enabled, the interface hash does not cover the
+    // member lists of types and extensions. Compare those separately, so
+    // that a member-level edit discards the AST only when the completion
+    // could actually observe it.
+    SmallVector<Decl *, 4> changedMemberLists;
+    if (!collectChangedMemberLists(oldSF->getTopLevelDecls(),
+                                   tmpSF->getTopLevelDecls(),
+                                   changedMemberLists))
+      return false;
+    if (!changedMemberLists.empty() &&
+        !isCompletionUnaffectedByChangedMembers(changedMemberLists, *tmpCtx,
+                                                tmpSM, tmpBufferID,
+                                                newInfo.ParentContext))
+      return false;
+
     DeclContext *DC =
         getEquivalentDeclContextFromSourceFile(newInfo.ParentContext, oldSF);
     if (!DC)
@@ -434,9 +571,10 @@ bool swift::ide::CompletionInstance::performOperation(
   // source text. That breaks an invariant of syntax tree building.
   Invocation.getLangOptions().BuildSyntaxTree = false;
 
-  // Since caching uses the interface hash, and since per type fingerprints
-  // weaken that hash, disable them here:
-  Invocation.getLangOptions().EnableTypeFingerprints = false;
+  // Caching uses the interface hash together with per type fingerprints:
+  // the fingerprints let member-level edits in types the completion does not
+  // depend on keep the cached AST, so make sure they are computed.
+  Invocation.getLangOptions().EnableTypeFingerprints = true;
 
   // We don't need token list.
   Invocation.getLangOptions().CollectParsedToken = false;
@@ -282,7 +282,7 @@ private:
   }
 
   static RegionType getSyntacticRenameRegionType(const ResolvedLoc &Resolved) {
-    if (Resolved.Node.isNull())
+    if (Resolved.IsInComment)
       return RegionType::Comment;
 
     if (Expr *E = Resolved.Node.getAsExpr()) {
@@ -3835,14 +3835,41 @@ case RefactoringKind::KIND: {                                                  \
   llvm_unreachable("unhandled kind");
 }
 
+/// Returns the range of the identifier token starting exactly at \p Loc if it
+/// spells \p name, and an invalid range otherwise.
+///
+/// Rename locations that came out of the index state their usage, so a plain
+/// (non-function-like, non-operator) reference or definition is fully
+/// described by the identifier token at its location; there are no argument
+/// labels to find. Occurrences inside comments, string literals, or argument
+/// label positions do not lex as a matching identifier token starting at the
+/// given location, so they miss this check and take the AST-based path.
+static CharSourceRange
+getMatchingIdentifierTokenRange(SourceLoc Loc, StringRef name,
+                                ArrayRef<Token> Tokens, SourceManager &SM) {
+  auto Tok = std::lower_bound(
+      Tokens.begin(), Tokens.end(), Loc, [&](const Token &Tok, SourceLoc Loc) {
+        return SM.isBeforeInBuffer(Tok.getLoc(), Loc);
+      });
+  if (Tok == Tokens.end() || Tok->getLoc() != Loc)
+    return CharSourceRange();
+  if (Tok->isNot(tok::identifier) || Tok->getText() != name)
+    return CharSourceRange();
+  return CharSourceRange(Tok->getLoc(), name.size());
+}
+
 static std::vector<ResolvedLoc>
 resolveRenameLocations(ArrayRef<RenameLoc> RenameLocs, SourceFile &SF,
                        DiagnosticEngine &Diags) {
   SourceManager &SM = SF.getASTContext().SourceMgr;
   unsigned BufferID = SF.getBufferID().getValue();
+  ArrayRef<Token> Tokens = SF.getAllTokens();
 
+  std::vector<Optional<ResolvedLoc>> TokenResolved(RenameLocs.size());
   std::vector<UnresolvedLoc> UnresolvedLocs;
+  size_t Index = 0;
   for (const RenameLoc &RenameLoc : RenameLocs) {
+    size_t CurrIndex = Index++;
     DeclNameViewer OldName(RenameLoc.OldName);
     SourceLoc Location = SM.getLocForLineCol(BufferID, RenameLoc.Line,
                                              RenameLoc.Column);
@@ -3880,6 +3907,27 @@ resolveRenameLocations(ArrayRef<RenameLoc> RenameLocs, SourceFile &SF,
     }
 
     bool isOperator = Lexer::isOperator(OldName.base());
+
+    // Plain references and definitions of non-function-like names can be
+    // confirmed against the token stream directly; only call sites, whose
+    // argument labels need locating, and occurrences of unknown usage need
+    // the AST walk below. The index only reports occurrences in active,
+    // compiled code, so an exact identifier match cannot be a comment, a
+    // string literal, or an inactive '#if' region.
+    if ((RenameLoc.Usage == NameUsage::Reference ||
+         RenameLoc.Usage == NameUsage::Definition) &&
+        !RenameLoc.IsFunctionLike && !isOperator && OldName.args().empty()) {
+      auto TokenRange =
+          getMatchingIdentifierTokenRange(Location, OldName.base(), Tokens, SM);
+      if (TokenRange.isValid()) {
+        TokenResolved[CurrIndex] =
+            ResolvedLoc{ASTWalker::ParentTy(), TokenRange, {},
+                        LabelRangeType::None, /*IsActive=*/true,
+                        /*IsInSelector=*/false};
+        continue;
+      }
+    }
+
     UnresolvedLocs.push_back({
       Location,
       (RenameLoc.Usage == NameUsage::Unknown ||
@@ -3887,8 +3935,23 @@ resolveRenameLocations(ArrayRef<RenameLoc> RenameLocs, SourceFile &SF,
     });
   }
 
-  NameMatcher Resolver(SF);
-  return Resolver.resolve(UnresolvedLocs, SF.getAllTokens());
+  std::vector<ResolvedLoc> AstResolved;
+  if (!UnresolvedLocs.empty()) {
+    NameMatcher Resolver(SF);
+    AstResolved = Resolver.resolve(UnresolvedLocs, Tokens);
+  }
+
+  // Merge the results back into the original order.
+  std::vector<ResolvedLoc> ResolvedLocs;
+  ResolvedLocs.reserve(RenameLocs.size());
+  size_t AstIndex = 0;
+  for (auto &Resolved : TokenResolved) {
+    if (Resolved)
+      ResolvedLocs.push_back(std::move(*Resolved));
+    else
+      ResolvedLocs.push_back(std::move(AstResolved[AstIndex++]));
+  }
+  return ResolvedLocs;
 }
 
 int swift::ide::syntacticRename(SourceFile *SF, ArrayRef<RenameLoc> RenameLocs,
@@ -632,8 +632,9 @@ bool NameMatcher::tryResolve(ASTWalker::ParentTy Node, SourceLoc NameLoc,
   if (Range.isValid()) {
     if (NameLoc == Next.Loc) {
       LocsToResolve.pop_back();
+      // A null node means the resolution came from checkComments().
       ResolvedLocs.push_back({Node, Range, LabelRanges, RangeType,
-        isActive(), isInSelector()});
+        isActive(), isInSelector(), /*IsInComment=*/Node.isNull()});
       if (isDone())
         return true;
       WasResolved = true;
@@ -648,7 +649,7 @@ bool NameMatcher::tryResolve(ASTWalker::ParentTy Node, SourceLoc NameLoc,
       if (NewRange.getStart() == Next.Loc) {
         LocsToResolve.pop_back();
         ResolvedLocs.push_back({Node, NewRange, {}, LabelRangeType::None,
-          isActive(), isInSelector()});
+          isActive(), isInSelector(), /*IsInComment=*/Node.isNull()});
         WasResolved = true;
       }
     }
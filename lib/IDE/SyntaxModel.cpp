@@ -360,16 +360,30 @@ class ModelASTWalker : public ASTWalker {
   friend class InactiveClauseRAII;
   bool inInactiveClause = false;
 
+  /// When valid, AST subtrees entirely outside this range are not visited.
+  CharSourceRange RestrictedRange;
+
+  /// Whether the subtree covering \p Range cannot emit any node intersecting
+  /// \c RestrictedRange and can be skipped entirely.
+  bool isOutsideRestrictedRange(SourceRange Range) const {
+    if (!RestrictedRange.isValid() || Range.isInvalid())
+      return false;
+    return !RestrictedRange.overlaps(
+        Lexer::getCharSourceRangeFromSourceRange(SM, Range));
+  }
+
 public:
   SyntaxModelWalker &Walker;
   ArrayRef<SyntaxNode> TokenNodes;
 
-  ModelASTWalker(const SourceFile &File, SyntaxModelWalker &Walker)
+  ModelASTWalker(const SourceFile &File, SyntaxModelWalker &Walker,
+                 CharSourceRange RestrictedRange = CharSourceRange())
       : AllTokensInFile(File.getAllTokens()),
         LangOpts(File.getASTContext().LangOpts),
         SM(File.getASTContext().SourceMgr),
         BufferID(File.getBufferID().getValue()),
         Ctx(File.getASTContext()),
+        RestrictedRange(RestrictedRange),
         Walker(Walker) { }
 
   // FIXME: Remove this
@@ -523,6 +537,13 @@ bool SyntaxModelContext::walk(SyntaxModelWalker &Walker) {
   return true;
 }
 
+bool SyntaxModelContext::walk(SyntaxModelWalker &Walker,
+                              CharSourceRange Range) {
+  ModelASTWalker ASTWalk(Impl.SrcFile, Walker, Range);
+  ASTWalk.visitSourceFile(Impl.SrcFile, Impl.TokenNodes);
+  return true;
+}
+
 void ModelASTWalker::visitSourceFile(SourceFile &SrcFile,
                                      ArrayRef<SyntaxNode> Tokens) {
   TokenNodes = Tokens;
@@ -545,6 +566,8 @@ static bool shouldTreatAsSingleToken(const SyntaxStructureNode &Node,
 std::pair<bool, Expr *> ModelASTWalker::walkToExprPre(Expr *E) {
   if (isVisitedBefore(E))
     return {false, E};
+  if (isOutsideRestrictedRange(E->getSourceRange()))
+    return {false, E};
 
   auto addCallArgExpr = [&](Expr *Elem, TupleExpr *ParentTupleExpr) {
     if (isCurrentCallArgExpr(ParentTupleExpr)) {
@@ -723,6 +746,8 @@ std::pair<bool, Stmt *> ModelASTWalker::walkToStmtPre(Stmt *S) {
   if (isVisitedBefore(S)) {
     return {false, S};
   }
+  if (isOutsideRestrictedRange(S->getSourceRange()))
+    return {false, S};
   auto addExprElem = [&](SyntaxStructureElementKind K, const Expr *Elem,
                          SyntaxStructureNode &SN) {
     if (isa<ErrorExpr>(Elem))
@@ -866,6 +891,8 @@ bool ModelASTWalker::walkToDeclPre(Decl *D) {
     return false;
   if (D->isImplicit())
     return false;
+  if (isOutsideRestrictedRange(D->getSourceRangeIncludingAttrs()))
+    return false;
 
   // The attributes of EnumElementDecls and VarDecls are handled when visiting
   // their parent EnumCaseDecl/PatternBindingDecl (which the attributes are
@@ -1776,6 +1776,15 @@ getIRLinkage(const UniversalLinkageInfo &info, SILLinkage linkage,
     return isDefinition ? RESULT(WeakODR, Hidden, Default)
                         : RESULT(External, Hidden, Default);
 
+  // Shared definitions cover all the lazily emitted entities which several
+  // modules may emit independently: specialized functions, witness thunks,
+  // generic metadata instantiations and their support structures. The mangled
+  // name of such an entity fully determines its contents, so it effectively
+  // serves as a content address: every module emits the definition under the
+  // same linkonce_odr symbol and the linker keeps a single copy per image.
+  // Duplicates that survive across image boundaries are uniqued by the
+  // runtime's metadata and conformance caches, which is also why metadata
+  // cannot be folded purely by content: its address is its identity.
   case SILLinkage::Shared:
   case SILLinkage::SharedExternal:
     return isDefinition ? RESULT(LinkOnceODR, Hidden, Default)
@@ -1855,17 +1864,29 @@ void irgen::updateLinkageForDefinition(IRGenModule &IGM,
     IGM.addUsedGlobal(global);
 }
 
+StringRef IRGenModule::getMangledName(const LinkEntity &entity) {
+  auto cached = MangledEntityNames.find(entity);
+  if (cached != MangledEntityNames.end())
+    return cached->second;
+  StringRef name =
+      MangledEntityNameStorage.insert(entity.mangleAsString()).first->getKey();
+  MangledEntityNames.insert({entity, name});
+  return name;
+}
+
 LinkInfo LinkInfo::get(IRGenModule &IGM, const LinkEntity &entity,
                        ForDefinition_t isDefinition) {
   return LinkInfo::get(UniversalLinkageInfo(IGM),
                        IGM.getSwiftModule(),
-                       entity, isDefinition);
+                       entity, isDefinition,
+                       IGM.getMangledName(entity));
 }
 
 LinkInfo LinkInfo::get(const UniversalLinkageInfo &linkInfo,
                        ModuleDecl *swiftModule,
                        const LinkEntity &entity,
-                       ForDefinition_t isDefinition) {
+                       ForDefinition_t isDefinition,
+                       StringRef mangledName) {
   LinkInfo result;
 
   bool isKnownLocal = entity.isAlwaysSharedLinkage();
@@ -1873,7 +1894,10 @@ LinkInfo LinkInfo::get(const UniversalLinkageInfo &linkInfo,
     if (const auto *MD = DC->getParentModule())
       isKnownLocal = MD == swiftModule;
 
-  entity.mangle(result.Name);
+  if (mangledName.empty())
+    entity.mangle(result.Name);
+  else
+    result.Name += mangledName;
   bool weakImported = entity.isWeakImported(swiftModule);
   result.IRL = getIRLinkage(linkInfo, entity.getLinkage(isDefinition),
                             isDefinition, weakImported, isKnownLocal);
@@ -2636,7 +2660,7 @@ llvm::Function *IRGenModule::getAddrOfSILFunction(
 
   // Check whether we've created the function already.
   // FIXME: We should integrate this into the LinkEntity cache more cleanly.
-  llvm::Function *fn = Module.getFunction(entity.mangleAsString());
+  llvm::Function *fn = Module.getFunction(getMangledName(entity));
   if (fn) {
     if (forDefinition) {
       updateLinkageForDefinition(*this, fn, entity);
@@ -2722,8 +2746,7 @@ static llvm::GlobalVariable *createGOTEquivalent(IRGenModule &IGM,
                                                  LinkEntity entity)
 {
   // Determine the name of this entity.
-  llvm::SmallString<64> globalName;
-  entity.mangle(globalName);
+  StringRef globalName = IGM.getMangledName(entity);
 
   if (IGM.Triple.getObjectFormat() == llvm::Triple::COFF) {
     if (cast<llvm::GlobalValue>(global)->hasDLLImportStorageClass()) {
@@ -4667,7 +4690,7 @@ IRGenModule::getAddrOfContinuationPrototype(CanSILFunctionType fnType) {
   llvm::Function *&entry = GlobalFuncs[entity];
   if (entry) return entry;
 
-  auto signature = Signature::forCoroutineContinuation(*this, fnType);
+  auto signature = getCoroutineContinuationSignature(fnType);
   LinkInfo link = LinkInfo::get(*this, entity, NotForDefinition);
   entry = createFunction(*this, link, signature);
   return entry;
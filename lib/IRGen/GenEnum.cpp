@@ -99,6 +99,7 @@
 //===----------------------------------------------------------------------===//
 
 #define DEBUG_TYPE "enum-layout"
+#include "llvm/ADT/Statistic.h"
 #include "llvm/Support/Debug.h"
 
 #include "GenEnum.h"
@@ -136,6 +137,8 @@
 using namespace swift;
 using namespace irgen;
 
+STATISTIC(NumEnumStrategiesComputed, "# of enum implementation strategies computed");
+
 static llvm::Constant *emitEnumLayoutFlags(IRGenModule &IGM, bool isVWTMutable){
   // For now, we always use the Swift 5 algorithm.
   auto flags = EnumLayoutFlags::Swift5Algorithm;
@@ -5979,8 +5982,21 @@ namespace {
   };
 } // end anonymous namespace
 
+/// Select and build the implementation strategy for an enum type.
+///
+/// This runs once per lowered enum type and IGM: the caller is
+/// convertEnumType, whose result is memoized in the TypeConverter's type
+/// cache, and the strategy becomes part of that one type's TypeInfo. The
+/// strategies cannot be shared between structurally identical enums beyond
+/// that — a strategy captures the element decls and per-IGM TypeInfos of
+/// its payloads and is completed in place against its own EnumTypeInfo, so
+/// its identity is the type's, not its layout's. What *is* shared across
+/// instantiations of one generic enum is the shape of the analysis: the
+/// strategy choice is made on the unsubstituted payload types, precisely so
+/// that all instances agree with each other and with the runtime.
 std::unique_ptr<EnumImplStrategy>
 EnumImplStrategy::get(TypeConverter &TC, SILType type, EnumDecl *theEnum) {
+  ++NumEnumStrategiesComputed;
   unsigned numElements = 0;
   TypeInfoKind tik = Loadable;
   IsFixedSize_t alwaysFixedSize = IsFixedSize;
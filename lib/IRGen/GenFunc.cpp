@@ -124,12 +124,14 @@ namespace {
     const CanSILFunctionType FormalType;
     
     mutable Signature TheSignature;
-    
+    mutable Signature TheCoroutineContinuationSignature;
+
   public:
     FuncSignatureInfo(CanSILFunctionType formalType)
       : FormalType(formalType) {}
-    
+
     Signature getSignature(IRGenModule &IGM) const;
+    Signature getCoroutineContinuationSignature(IRGenModule &IGM) const;
   };
 
   /// The @thin function type-info class.
@@ -563,6 +565,19 @@ Signature FuncSignatureInfo::getSignature(IRGenModule &IGM) const {
   return TheSignature;
 }
 
+Signature
+FuncSignatureInfo::getCoroutineContinuationSignature(IRGenModule &IGM) const {
+  // If it's already been filled in, we're done.
+  if (TheCoroutineContinuationSignature.isValid())
+    return TheCoroutineContinuationSignature;
+
+  // Update the cache and return.
+  TheCoroutineContinuationSignature =
+      Signature::forCoroutineContinuation(IGM, FormalType);
+  assert(TheCoroutineContinuationSignature.isValid());
+  return TheCoroutineContinuationSignature;
+}
+
 static const FuncSignatureInfo &
 getFuncSignatureInfoForLowered(IRGenModule &IGM, CanSILFunctionType type) {
   auto &ti = IGM.getTypeInfoForLowered(type);
@@ -588,6 +603,13 @@ IRGenModule::getSignature(CanSILFunctionType type) {
   return sigInfo.getSignature(*this);
 }
 
+Signature
+IRGenModule::getCoroutineContinuationSignature(CanSILFunctionType type) {
+  assert(type->isCoroutine());
+  auto &sigInfo = getFuncSignatureInfoForLowered(*this, type);
+  return sigInfo.getCoroutineContinuationSignature(*this);
+}
+
 llvm::FunctionType *
 IRGenModule::getFunctionType(CanSILFunctionType type,
                              llvm::AttributeList &attrs,
@@ -1935,7 +1935,7 @@ IRGenModule::getAddrOfSharedContextDescriptor(LinkEntity entity,
       // with the same context mangling (a clang module and its overlay,
       // equivalent extensions, etc.). These can share a context descriptor
       // at runtime.
-      auto mangledName = entity.mangleAsString();
+      auto mangledName = getMangledName(entity);
       if (auto otherDefinition = Module.getGlobalVariable(mangledName)) {
         GlobalVars.insert({entity, otherDefinition});
         return otherDefinition;
@@ -4650,6 +4650,41 @@ SpecialProtocol irgen::getSpecialProtocolID(ProtocolDecl *P) {
 /// Emit global structures associated with the given protocol. This comprises
 /// the protocol descriptor, and for ObjC interop, references to the descriptor
 /// that the ObjC runtime uses for uniquing.
+/// Whether the protocol_t record for an @objc protocol can be left to
+/// reference-driven emission. Every reference point - conformance lists in
+/// class and category data, protocol refs in code, type refs - forces the
+/// record through getObjCProtocolGlobalVars, so an unreferenced record only
+/// serves dynamic lookups by name. Mirrors the policy in
+/// IRGenerator::hasLazyMetadata: externally visible protocols must stay,
+/// since other images and objc_getProtocol can rely on this image
+/// registering them, as must protocols with an explicit ObjC name, which
+/// signals intent to look them up from ObjC.
+static bool canEmitObjCProtocolRecordLazily(IRGenModule &IGM,
+                                            ProtocolDecl *protocol) {
+  if (!IGM.IRGen.Opts.shouldOptimize())
+    return false;
+
+  if (auto objc = protocol->getAttrs().getAttribute<ObjCAttr>())
+    if (objc->getName())
+      return false;
+  if (protocol->getAttrs().hasAttribute<ObjCRuntimeNameAttr>())
+    return false;
+
+  switch (protocol->getEffectiveAccess()) {
+  case AccessLevel::Open:
+  case AccessLevel::Public:
+    return false;
+  case AccessLevel::Internal:
+    // In non-whole-module mode, internal protocols are also visible
+    // externally.
+    return IGM.getSILModule().isWholeModule();
+  case AccessLevel::FilePrivate:
+  case AccessLevel::Private:
+    return true;
+  }
+  llvm_unreachable("bad access level");
+}
+
 void IRGenModule::emitProtocolDecl(ProtocolDecl *protocol) {
   PrettyStackTraceDecl stackTraceRAII("emitting metadata for", protocol);
 
@@ -4663,12 +4698,17 @@ void IRGenModule::emitProtocolDecl(ProtocolDecl *protocol) {
     // runtime in JITted code.
     if (IRGen.Opts.UseJIT)
       return;
-    
+
     // Native ObjC protocols are emitted on-demand in ObjC and uniqued by the
     // runtime; we don't need to try to emit a unique descriptor symbol for them.
     if (protocol->hasClangNode())
       return;
-    
+
+    // If every use of the record will force it anyway, don't emit one for
+    // the bare declaration.
+    if (canEmitObjCProtocolRecordLazily(*this, protocol))
+      return;
+
     getObjCProtocolGlobalVars(protocol);
     return;
   }
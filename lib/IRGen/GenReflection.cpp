@@ -1243,6 +1243,16 @@ const char *IRGenModule::getReflectionTypeRefSectionName() {
   return ReflectionTypeRefSection.c_str();
 }
 
+/// Returns the address of a null-terminated field name string in the
+/// reflection strings section, uniqued per module.
+///
+/// The strings cannot be pooled more aggressively than this: they are
+/// referenced by relative address, which requires the definition to be in
+/// the same object file as the reference, and they must keep their named,
+/// non-unnamed_addr form because ld64 crashes resolving relative references
+/// to coalesceable symbols (see createStringConstant). Whole-image
+/// deduplication and suffix merging are therefore left to the linker for
+/// formats where that ever becomes expressible.
 llvm::Constant *IRGenModule::getAddrOfFieldName(StringRef Name) {
   auto &entry = FieldNames[Name];
   if (entry.second)
@@ -1350,6 +1360,14 @@ void IRGenerator::emitBuiltinReflectionMetadata() {
 }
 
 void IRGenModule::emitFieldDescriptor(const NominalTypeDecl *D) {
+  // Field descriptors are emitted for every nominal type rather than on
+  // demand. Restricting emission to types the compiler can prove to be
+  // reflected would not be sound: descriptors are looked up by mangled name
+  // at runtime, so a type can be reflected by clients the module never
+  // sees — Mirror over a value that escaped as Any into another image,
+  // dynamic casts, the debugger and remote mirrors. Clients who accept
+  // losing those are expected to opt out explicitly with
+  // -disable-reflection-metadata or -disable-reflection-names.
   if (!IRGen.Opts.EnableReflectionMetadata)
     return;
 
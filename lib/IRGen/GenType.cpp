@@ -1291,6 +1291,14 @@ static bool doesPlatformUseLegacyLayouts(StringRef platformName,
 TypeConverter::TypeConverter(IRGenModule &IGM)
   : IGM(IGM),
     FirstType(invalidTypeInfo()) {
+  // The legacy type info is the same for all modules of one compilation.
+  // In multi-threaded compilation copy the table from the first IGM instead
+  // of parsing the file again for every IGM.
+  if (auto *primaryIGM = IGM.IRGen.getPrimaryIGMOrNull()) {
+    LegacyTypeInfos = primaryIGM->Types.LegacyTypeInfos;
+    return;
+  }
+
   // Whether the Objective-C runtime is guaranteed to invoke the class
   // metadata update callback when realizing a Swift class referenced from
   // Objective-C.
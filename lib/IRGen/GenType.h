@@ -229,6 +229,15 @@ private:
   ArchetypeType *getExemplarArchetype(ArchetypeType *t);
   CanType getExemplarType(CanType t);
   
+  /// The per-converter caches of lowered types.
+  ///
+  /// In multi-threaded compilation every IRGenModule has its own converter
+  /// and therefore its own caches. This looks like duplicated work, but it
+  /// is a hard constraint: a TypeInfo refers to llvm::Types which belong to
+  /// the IGM's own LLVMContext, and the contexts are what allow the LLVM
+  /// pipelines to run concurrently. Only the single-threaded IRGen phase
+  /// calls into the converters, so sharing a cache would at best trade the
+  /// repeated lowering for cross-context type translation of every hit.
   class Types_t {
     llvm::DenseMap<TypeBase *, const TypeInfo *> IndependentCache[NumLoweringModes];
     llvm::DenseMap<TypeBase *, const TypeInfo *> DependentCache[NumLoweringModes];
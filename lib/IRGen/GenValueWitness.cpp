@@ -27,6 +27,7 @@
 #include "swift/IRGen/Linking.h"
 #include "swift/SIL/TypeLowering.h"
 #include "llvm/ADT/SmallString.h"
+#include "llvm/ADT/Statistic.h"
 #include "llvm/Support/raw_ostream.h"
 #include "llvm/IR/DerivedTypes.h"
 #include "llvm/IR/Function.h"
@@ -49,6 +50,10 @@
 using namespace swift;
 using namespace irgen;
 
+#define DEBUG_TYPE "IRGen value witnesses"
+STATISTIC(NumSharedValueWitnesses,
+          "# of value witness functions shared between layout-equivalent types");
+
 const char *irgen::getValueWitnessName(ValueWitness witness) {
   switch (witness) {
 #define CASE(NAME) case ValueWitness::NAME: return #NAME;
@@ -943,6 +948,48 @@ static void addValueWitness(IRGenModule &IGM,
   llvm_unreachable("bad value witness kind");
 
  standard:
+  // When a copy/destroy witness is built from a type layout entry, its body
+  // is fully determined by the layout. Layout entries are uniqued per
+  // module, so layout-equivalent types can all point their tables at the
+  // first such function instead of getting an identical copy each. These
+  // functions are only ever referenced from value witness tables in this
+  // module, never by name from elsewhere, so the extra types simply don't
+  // emit their own witness symbol.
+  const TypeLayoutEntry *sharedLayout = nullptr;
+  switch (index) {
+  case ValueWitness::Destroy:
+  case ValueWitness::InitializeBufferWithCopyOfBuffer:
+  case ValueWitness::InitializeWithCopy:
+  case ValueWitness::InitializeWithTake:
+  case ValueWitness::AssignWithCopy:
+  case ValueWitness::AssignWithTake:
+    if (auto *entry = conditionallyGetTypeLayoutEntry(IGM, concreteType)) {
+      // Entries with archetype or resilient fields bind and use the type
+      // metadata passed to the witness, so their bodies are type-specific.
+      if (!entry->containsArchetypeField() && !entry->containsResilientField())
+        sharedLayout = entry;
+    }
+    break;
+  default:
+    break;
+  }
+
+  if (sharedLayout) {
+    auto &cachedFn = IGM.LayoutEquivalentValueWitnesses[
+        std::make_pair(sharedLayout, unsigned(index))];
+    if (cachedFn) {
+      ++NumSharedValueWitnesses;
+      return addFunction(cachedFn);
+    }
+    llvm::Function *fn =
+      IGM.getAddrOfValueWitness(abstractType, index, ForDefinition);
+    if (fn->empty())
+      buildValueWitnessFunction(IGM, fn, index, packing, abstractType,
+                                concreteType, concreteTI);
+    cachedFn = fn;
+    return addFunction(fn);
+  }
+
   llvm::Function *fn =
     IGM.getAddrOfValueWitness(abstractType, index, ForDefinition);
   if (fn->empty())
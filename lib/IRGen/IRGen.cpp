@@ -201,6 +201,10 @@ void swift::performLLVMOptimizations(const IRGenOptions &Opts,
     PMBuilder.SLPVectorize = true;
     PMBuilder.LoopVectorize = true;
     PMBuilder.MergeFunctions = true;
+    // When emitting for LTO, restrain the per-job pipeline so the heavy
+    // cross-module work happens once, at link time, with full visibility.
+    PMBuilder.PrepareForThinLTO = Opts.LLVMLTOKind == IRGenLLVMLTOKind::Thin;
+    PMBuilder.PrepareForLTO = Opts.LLVMLTOKind == IRGenLLVMLTOKind::Full;
   } else {
     PMBuilder.OptLevel = 0;
     if (!Opts.DisableLLVMOptzns)
@@ -585,6 +589,18 @@ bool swift::performLLVM(const IRGenOptions &Opts,
     break;
   case IRGenOutputKind::NativeAssembly:
   case IRGenOutputKind::ObjectFile: {
+    // In LTO modes, this job's "object file" is really bitcode for the
+    // linker's (thin-)link stage; the thin variant additionally carries a
+    // ThinLTO summary so the linker can import across modules in parallel.
+    if (Opts.OutputKind == IRGenOutputKind::ObjectFile &&
+        Opts.LLVMLTOKind != IRGenLLVMLTOKind::None) {
+      if (Opts.LLVMLTOKind == IRGenLLVMLTOKind::Thin)
+        EmitPasses.add(createWriteThinLTOBitcodePass(*RawOS));
+      else
+        EmitPasses.add(createBitcodeWriterPass(*RawOS));
+      break;
+    }
+
     CodeGenFileType FileType;
     FileType = (Opts.OutputKind == IRGenOutputKind::NativeAssembly
                   ? CGFT_AssemblyFile
@@ -1351,6 +1367,10 @@ static void performParallelIRGeneration(
 
   llvm::sys::Mutex DiagMutex;
 
+  // Hand out the biggest modules first so that no thread ends up alone with
+  // a huge module after the queue has drained.
+  irgen.sortQueueByModuleSize();
+
   // Start all the threads and do the LLVM compilation.
   LLVMCodeGenThreads codeGenThreads(&irgen, &DiagMutex, numThreads - 1);
   codeGenThreads.startThreads();
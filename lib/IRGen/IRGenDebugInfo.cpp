@@ -1564,6 +1564,13 @@ private:
     return DBuilder.createNameSpace(Parent, PD.str(), ExportSymbols);
   }
 
+  /// Get or create the debug type for \p DbgTy.
+  ///
+  /// Types are cached on two levels: by TypeBase pointer, which is cheap
+  /// but not unique, and by mangled name via DIRefMap, which catches
+  /// equivalent types with distinct pointers. Composite types are created
+  /// as replaceable forward declarations first and resolved in one batch in
+  /// finalize(), so recursive types never re-enter type creation.
   llvm::DIType *getOrCreateType(DebugTypeInfo DbgTy) {
     // Is this an empty type?
     if (DbgTy.isNull())
@@ -1584,6 +1591,9 @@ private:
       UID = llvm::MDString::get(IGM.getLLVMContext(), MangledName);
       if (llvm::Metadata *CachedTy = DIRefMap.lookup(UID)) {
         auto DITy = cast<llvm::DIType>(CachedTy);
+        // Fill the first-level cache so further queries for this exact
+        // TypeBase* don't have to mangle the name again.
+        DITypeCache[DbgTy.getType()] = llvm::TrackingMDNodeRef(DITy);
         return DITy;
       }
     }
@@ -1416,6 +1416,29 @@ void IRGenerator::addGenModule(SourceFile *SF, IRGenModule *IGM) {
   Queue.push_back(IGM);
 }
 
+void IRGenerator::sortQueueByModuleSize() {
+  // Use the number of function definitions as a cheap estimate for the
+  // codegen cost of a module.
+  auto numFunctionDefs = [](IRGenModule *IGM) -> unsigned {
+    unsigned numDefs = 0;
+    for (llvm::Function &F : IGM->getModule()->getFunctionList()) {
+      if (!F.isDeclaration())
+        ++numDefs;
+    }
+    return numDefs;
+  };
+  llvm::SmallDenseMap<IRGenModule *, unsigned, 8> moduleSizes;
+  for (IRGenModule *IGM : Queue)
+    moduleSizes[IGM] = numFunctionDefs(IGM);
+
+  // A stable sort keeps equally sized modules in their original order, which
+  // keeps the compilation deterministic.
+  std::stable_sort(Queue.begin(), Queue.end(),
+                   [&](IRGenModule *LHS, IRGenModule *RHS) {
+                     return moduleSizes[LHS] > moduleSizes[RHS];
+                   });
+}
+
 IRGenModule *IRGenerator::getGenModule(DeclContext *ctxt) {
   if (GenModules.size() == 1 || !ctxt) {
     return getPrimaryIGM();
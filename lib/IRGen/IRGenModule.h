@@ -40,6 +40,7 @@
 #include "llvm/ADT/SmallPtrSet.h"
 #include "llvm/ADT/SmallVector.h"
 #include "llvm/ADT/StringMap.h"
+#include "llvm/ADT/StringSet.h"
 #include "llvm/IR/Attributes.h"
 #include "llvm/IR/CallingConv.h"
 #include "llvm/IR/Constant.h"
@@ -354,6 +355,10 @@ public:
     assert(PrimaryIGM);
     return PrimaryIGM;
   }
+
+  /// Like getPrimaryIGM, but returns null while the primary IRGenModule
+  /// itself is still being constructed.
+  IRGenModule *getPrimaryIGMOrNull() const { return PrimaryIGM; }
   
   bool hasMultipleIGMs() const { return GenModules.size() >= 2; }
   
@@ -472,6 +477,13 @@ public:
     return it->second;
   }
   
+  /// In multi-threaded compilation sort the queue so that the biggest
+  /// modules are handed out first. The queue is consumed dynamically by
+  /// the codegen threads, so compiling the most expensive modules first
+  /// avoids a long tail where a single thread is still working on a huge
+  /// module after all other threads have run out of work.
+  void sortQueueByModuleSize();
+
   /// In multi-threaded compilation fetch the next IRGenModule from the queue.
   IRGenModule *fetchFromQueue() {
     int idx = QueueIndex++;
@@ -1026,10 +1038,20 @@ private:
 
   llvm::Constant *getOrCreateGOTEquivalent(llvm::Constant *global,
                                            LinkEntity entity);
-                                           
+
+  /// Returns the mangled name of \p entity, cached across requests.
+  llvm::StringRef getMangledName(const LinkEntity &entity);
+
+
   llvm::DenseMap<LinkEntity, llvm::Constant*> GlobalVars;
   llvm::DenseMap<LinkEntity, llvm::Constant*> GlobalGOTEquivalents;
   llvm::DenseMap<LinkEntity, llvm::Function*> GlobalFuncs;
+  /// Mangled names of link entities, cached because IRGen requests the same
+  /// mangling repeatedly, e.g. once per use of a function. The names are
+  /// interned in MangledEntityNameStorage so the cached StringRefs stay valid
+  /// across rehashing.
+  llvm::DenseMap<LinkEntity, llvm::StringRef> MangledEntityNames;
+  llvm::StringSet<> MangledEntityNameStorage;
   llvm::DenseSet<const clang::Decl *> GlobalClangDecls;
   llvm::StringMap<std::pair<llvm::GlobalVariable*, llvm::Constant*>>
     GlobalStrings;
@@ -1147,6 +1169,11 @@ public:
   /// reflection metadata.
   llvm::SetVector<CanType> BuiltinTypes;
 
+  /// Value witness functions shared by all types whose layout reduces to the
+  /// same type layout entry, keyed by the uniqued entry and the witness kind.
+  llvm::DenseMap<std::pair<const TypeLayoutEntry *, unsigned>, llvm::Function *>
+      LayoutEquivalentValueWitnesses;
+
   std::pair<llvm::Constant *, unsigned>
   getTypeRef(Type type, GenericSignature genericSig, MangledTypeRefRole role);
   
@@ -1327,6 +1354,7 @@ public:
   void finishEmitAfterTopLevel();
 
   Signature getSignature(CanSILFunctionType fnType);
+  Signature getCoroutineContinuationSignature(CanSILFunctionType fnType);
   llvm::FunctionType *getFunctionType(CanSILFunctionType type,
                                       llvm::AttributeList &attrs,
                                       ForeignFunctionInfo *foreignInfo=nullptr);
@@ -2823,7 +2823,7 @@ void IRGenSILFunction::visitAbortApplyInst(AbortApplyInst *i) {
 void IRGenSILFunction::visitEndApply(BeginApplyInst *i, bool isAbort) {
   const auto &coroutine = getLoweredCoroutine(i->getTokenResult());
 
-  auto sig = Signature::forCoroutineContinuation(IGM, i->getOrigCalleeType());
+  auto sig = IGM.getCoroutineContinuationSignature(i->getOrigCalleeType());
 
   // Cast the continuation pointer to the right function pointer type.
   auto continuation = coroutine.Continuation;
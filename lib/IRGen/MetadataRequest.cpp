@@ -1789,6 +1789,66 @@ IRGenFunction::emitGenericTypeMetadataAccessFunctionCall(
                                               ArrayRef<llvm::Value *> args,
                                               DynamicMetadataRequest request) {
 
+  // Monomorphic call sites dominate generic metadata access, so when the
+  // request is statically known to produce complete metadata, guard the
+  // call with a one-entry per-call-site cache of the argument/result
+  // pairing.
+  //
+  // The cache stores one word per generic argument followed by the result
+  // word, and is written at most once: the thread that instantiates first
+  // claims the entry by compare-exchanging the first argument word, fills
+  // in the rest, and publishes the result word last with a release store.
+  // A reader that observes a non-null result word is therefore guaranteed
+  // to see the arguments the result was installed for.  Polymorphic sites
+  // keep whichever entry won and always take the slow path thereafter.
+  bool useCallSiteCache =
+      IGM.getOptions().shouldOptimize() &&
+      request.isStaticallyBlockingComplete() && !args.empty() &&
+      args.size() <= NumDirectGenericTypeMetadataAccessFunctionArgs;
+
+  llvm::BasicBlock *loadBB = nullptr;
+  llvm::BasicBlock *contBB = nullptr;
+  llvm::Value *cachedResultWord = nullptr;
+  llvm::GlobalVariable *cache = nullptr;
+  if (useCallSiteCache) {
+    auto cacheTy = llvm::ArrayType::get(IGM.SizeTy, args.size() + 1);
+    cache = new llvm::GlobalVariable(*IGM.getModule(), cacheTy,
+                                     /*constant*/ false,
+                                     llvm::GlobalValue::PrivateLinkage,
+                                     llvm::Constant::getNullValue(cacheTy),
+                                     "metadata.callsite.cache");
+    cache->setAlignment(llvm::MaybeAlign(IGM.getPointerAlignment().getValue()));
+
+    Address cacheAddr(cache, IGM.getPointerAlignment());
+    Address resultSlot = Builder.CreateStructGEP(
+        cacheAddr, args.size(), IGM.getPointerSize() * args.size());
+
+    // The acquire pairs with the release store of the result word below so
+    // that the argument loads that follow cannot observe a stale entry.
+    auto load = Builder.CreateLoad(resultSlot);
+    load->setOrdering(llvm::AtomicOrdering::Acquire);
+    cachedResultWord = load;
+
+    llvm::Value *match = Builder.CreateICmpNE(
+        cachedResultWord, llvm::ConstantInt::get(IGM.SizeTy, 0));
+    for (unsigned i : indices(args)) {
+      Address argSlot =
+          Builder.CreateStructGEP(cacheAddr, i, IGM.getPointerSize() * i);
+      auto cachedArg = Builder.CreateLoad(argSlot);
+      auto argWord = Builder.CreatePtrToInt(args[i], IGM.SizeTy);
+      match =
+          Builder.CreateAnd(match, Builder.CreateICmpEQ(cachedArg, argWord));
+    }
+    match = Builder.CreateExpect(match,
+                                 llvm::ConstantInt::get(IGM.Int1Ty, 1));
+
+    auto missBB = createBasicBlock("metadata-callsite.miss");
+    contBB = createBasicBlock("metadata-callsite.cont");
+    loadBB = Builder.GetInsertBlock();
+    Builder.CreateCondBr(match, contBB, missBB);
+    Builder.emitBlock(missBB);
+  }
+
   SmallVector<llvm::Value *, 8> callArgs;
 
   // Add the metadata request argument.
@@ -1834,7 +1894,48 @@ IRGenFunction::emitGenericTypeMetadataAccessFunctionCall(
   if (allocatedArgsBuffer)
     Builder.CreateLifetimeEnd(argsBuffer, IGM.getPointerSize() * args.size());
 
-  return MetadataResponse::handle(*this, request, call);
+  auto response = MetadataResponse::handle(*this, request, call);
+  if (!useCallSiteCache)
+    return response;
+
+  // Try to install the entry.  Claiming the first argument word with a
+  // compare-exchange ensures only one thread ever writes the entry, so the
+  // cached arguments and result can never mix values from racing threads.
+  // Losing the race just means this thread returns its own result.
+  auto metadataWord =
+      Builder.CreatePtrToInt(response.getMetadata(), IGM.SizeTy);
+  Address cacheAddr(cache, IGM.getPointerAlignment());
+  Address arg0Slot = Builder.CreateStructGEP(cacheAddr, 0, Size(0));
+  auto arg0Word = Builder.CreatePtrToInt(args[0], IGM.SizeTy);
+  auto claim = Builder.CreateAtomicCmpXchg(
+      arg0Slot.getAddress(), llvm::ConstantInt::get(IGM.SizeTy, 0), arg0Word,
+      llvm::AtomicOrdering::Monotonic, llvm::AtomicOrdering::Monotonic);
+  auto claimed = Builder.CreateExtractValue(claim, 1);
+
+  auto installBB = createBasicBlock("metadata-callsite.install");
+  auto missEndBB = Builder.GetInsertBlock();
+  Builder.CreateCondBr(claimed, installBB, contBB);
+
+  Builder.emitBlock(installBB);
+  for (unsigned i = 1, e = args.size(); i != e; ++i) {
+    Address argSlot =
+        Builder.CreateStructGEP(cacheAddr, i, IGM.getPointerSize() * i);
+    Builder.CreateStore(Builder.CreatePtrToInt(args[i], IGM.SizeTy), argSlot);
+  }
+  Address resultSlot = Builder.CreateStructGEP(
+      cacheAddr, args.size(), IGM.getPointerSize() * args.size());
+  auto store = Builder.CreateStore(metadataWord, resultSlot);
+  store->setOrdering(llvm::AtomicOrdering::Release);
+  Builder.CreateBr(contBB);
+
+  Builder.emitBlock(contBB);
+  auto phi = Builder.CreatePHI(IGM.SizeTy, 3);
+  phi->addIncoming(cachedResultWord, loadBB);
+  phi->addIncoming(metadataWord, missEndBB);
+  phi->addIncoming(metadataWord, installBB);
+
+  auto metadata = Builder.CreateIntToPtr(phi, IGM.TypeMetadataPtrTy);
+  return MetadataResponse::forComplete(metadata);
 }
 
 static void emitCanonicalSpecializationsForGenericTypeMetadataAccessFunction(
@@ -305,11 +305,16 @@ int swift::RunImmediately(CompilerInstance &CI,
   std::tie(TargetOpt, CPU, Features, Triple)
     = getIRTargetOptions(IRGenOpts, swiftModule->getASTContext());
 
-  std::unique_ptr<llvm::orc::LLJIT> JIT;
+  // Use the lazy JIT so that functions are only compiled when execution
+  // first reaches them. Immediate mode compiles a whole module for what is
+  // often a script with one hot path, so materializing per function on call
+  // moves most of the codegen cost off of startup; code that is never
+  // reached is never compiled at all.
+  std::unique_ptr<llvm::orc::LLLazyJIT> JIT;
 
   {
     auto JITOrErr =
-      llvm::orc::LLJITBuilder()
+      llvm::orc::LLLazyJITBuilder()
         .setJITTargetMachineBuilder(
             llvm::orc::JITTargetMachineBuilder(llvm::Triple(Triple))
               .setRelocationModel(llvm::Reloc::PIC_)
@@ -342,7 +347,7 @@ int swift::RunImmediately(CompilerInstance &CI,
 
   {
     auto TSM = llvm::orc::ThreadSafeModule(std::move(Module), std::move(ModuleCtx));
-    if (auto Err = JIT->addIRModule(std::move(TSM))) {
+    if (auto Err = JIT->addLazyIRModule(std::move(TSM))) {
       llvm::logAllUnhandledErrors(std::move(Err), llvm::errs(), "");
       return -1;
     }
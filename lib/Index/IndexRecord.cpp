@@ -28,10 +28,17 @@
 #include "clang/Frontend/CompilerInstance.h"
 #include "clang/Index/IndexingAction.h"
 #include "clang/Index/IndexRecordWriter.h"
+#include "clang/Index/IndexUnitReader.h"
 #include "clang/Index/IndexUnitWriter.h"
 #include "clang/Lex/Preprocessor.h"
+#include "llvm/ADT/StringSet.h"
+#include "llvm/Support/Allocator.h"
+#include "llvm/Support/FileSystem.h"
 #include "llvm/Support/Path.h"
 
+#include <mutex>
+#include <thread>
+
 using namespace swift;
 using namespace swift::index;
 using clang::index::IndexUnitWriter;
@@ -108,9 +115,12 @@ public:
     auto pair = USRToSymbol.insert(std::make_pair(indexSym.USR.data(),
                                                   symbols.size()));
     if (pair.second) {
-      Symbol symbol{indexSym.name,
-                    indexSym.USR,
-                    indexSym.group,
+      // Copy the strings into storage the tracker owns; the symbols have to
+      // stay valid after the AST walk that produced them so that the record
+      // can be written on a background thread.
+      Symbol symbol{copyString(indexSym.name),
+                    copyString(indexSym.USR),
+                    copyString(indexSym.group),
                     indexSym.symInfo,
                     0};
       recordHash = llvm::hash_combine(recordHash, symbol.hash());
@@ -140,9 +150,18 @@ public:
   llvm::hash_code hashRecord() const { return recordHash; }
 
 private:
+  StringRef copyString(StringRef str) {
+    if (str.empty())
+      return str;
+    char *buf = stringStorage.Allocate<char>(str.size());
+    std::copy(str.begin(), str.end(), buf);
+    return StringRef(buf, str.size());
+  }
+
   llvm::DenseMap<const char *, size_t> USRToSymbol;
   std::vector<Symbol> symbols;
   std::vector<SymbolOccurrence> occurrences;
+  llvm::BumpPtrAllocator stringStorage;
   bool sorted = false;
   llvm::hash_code recordHash = 0;
 };
@@ -155,10 +174,10 @@ class IndexRecordingConsumer : public IndexDataConsumer {
   // we actually need it (once per Decl instead of once per occurrence).
   std::vector<IndexSymbol> symbolStack;
 
-  std::function<void(SymbolTracker &)> onFinish;
+  std::function<void(SymbolTracker &&)> onFinish;
 
 public:
-  IndexRecordingConsumer(std::function<void(SymbolTracker &)> onFinish)
+  IndexRecordingConsumer(std::function<void(SymbolTracker &&)> onFinish)
       : onFinish(std::move(onFinish)) {}
 
   void failed(StringRef error) override {
@@ -181,7 +200,7 @@ public:
     return true;
   }
 
-  void finish() override { onFinish(record); }
+  void finish() override { onFinish(std::move(record)); }
 };
 
 class StdlibGroupsIndexRecordingConsumer : public IndexDataConsumer {
@@ -192,10 +211,10 @@ class StdlibGroupsIndexRecordingConsumer : public IndexDataConsumer {
   // we actually need it (once per Decl instead of once per occurrence).
   std::vector<IndexSymbol> symbolStack;
 
-  std::function<bool(StringRef groupName, SymbolTracker &)> onFinish;
+  std::function<bool(StringRef groupName, SymbolTracker &&)> onFinish;
 
 public:
-  StdlibGroupsIndexRecordingConsumer(std::function<bool(StringRef groupName, SymbolTracker &)> onFinish)
+  StdlibGroupsIndexRecordingConsumer(std::function<bool(StringRef groupName, SymbolTracker &&)> onFinish)
       : onFinish(std::move(onFinish)) {}
 
   void failed(StringRef error) override {
@@ -226,8 +245,7 @@ public:
   void finish() override {
     for (auto &pair : TrackerByGroup) {
       StringRef groupName = pair.first();
-      SymbolTracker &tracker = *pair.second;
-      bool cont = onFinish(groupName, tracker);
+      bool cont = onFinish(groupName, std::move(*pair.second));
       if (!cont)
         break;
     }
@@ -267,79 +285,133 @@ StringRef StdlibGroupsIndexRecordingConsumer::findGroupForSymbol(const IndexSymb
   llvm_unreachable("did not find group name for reference");
 }
 
-static bool writeRecord(SymbolTracker &record, std::string Filename,
-                        std::string indexStorePath, DiagnosticEngine *diags,
-                        std::string &outRecordFile) {
-  if (record.getOccurrences().empty()) {
-    outRecordFile = std::string();
-    return false;
+namespace {
+/// Hashes and writes index record files on background threads, so that record
+/// I/O overlaps the remaining work of the frontend job. Record file names are
+/// derived from the record's content hash, so records whose contents are
+/// already present in the store are skipped without spawning a thread. The
+/// unit file referencing the records must not be written until \c wait() has
+/// returned.
+class BackgroundRecordWriter {
+  std::vector<std::thread> Writers;
+  std::mutex ErrorsMtx;
+  std::vector<std::string> Errors;
+
+public:
+  ~BackgroundRecordWriter() {
+    for (auto &writer : Writers)
+      writer.join();
   }
 
-  IndexRecordWriter recordWriter(indexStorePath);
-  std::string error;
-  auto result = recordWriter.beginRecord(
-      Filename, record.hashRecord(), error, &outRecordFile);
-  switch (result) {
-  case IndexRecordWriter::Result::Failure:
-    diags->diagnose(SourceLoc(), diag::error_write_index_record, error);
-    return true;
-  case IndexRecordWriter::Result::AlreadyExists:
+  /// Begins the record for \p Filename and, unless its contents are already
+  /// present in the store, queues a background write of it. \p outRecordFile
+  /// is filled with the record file name before this returns, so the unit
+  /// writer can reference the record right away.
+  /// \returns true if beginning the record failed.
+  bool enqueue(SymbolTracker &&record, std::string Filename,
+               std::string indexStorePath, DiagnosticEngine *diags,
+               std::string &outRecordFile) {
+    if (record.getOccurrences().empty()) {
+      outRecordFile = std::string();
+      return false;
+    }
+
+    IndexRecordWriter recordWriter(indexStorePath);
+    std::string error;
+    auto result = recordWriter.beginRecord(
+        Filename, record.hashRecord(), error, &outRecordFile);
+    switch (result) {
+    case IndexRecordWriter::Result::Failure:
+      diags->diagnose(SourceLoc(), diag::error_write_index_record, error);
+      return true;
+    case IndexRecordWriter::Result::AlreadyExists:
+      return false;
+    case IndexRecordWriter::Result::Success:
+      break;
+    }
+
+    Writers.emplace_back(
+        [this, recordWriter, record = std::move(record)]() mutable {
+          writeOccurrences(record, recordWriter);
+        });
     return false;
-  case IndexRecordWriter::Result::Success:
-    break;
   }
 
-  for (auto &occurrence : record.getOccurrences()) {
-    SmallVector<clang::index::writer::SymbolRelation, 3> relations;
-    for(SymbolTracker::SymbolRelation symbolRelation: occurrence.related) {
-      relations.push_back({record.getSymbol(symbolRelation.symbolIndex), symbolRelation.roles});
+  /// Waits for all queued record writes to finish and reports any failures
+  /// to \p diags. \returns true if any write failed.
+  bool wait(DiagnosticEngine &diags) {
+    for (auto &writer : Writers)
+      writer.join();
+    Writers.clear();
+
+    std::lock_guard<std::mutex> guard(ErrorsMtx);
+    bool failed = !Errors.empty();
+    for (auto &error : Errors)
+      diags.diagnose(SourceLoc(), diag::error_write_index_record, error);
+    Errors.clear();
+    return failed;
+  }
+
+private:
+  /// Runs on a background thread; errors are saved for \c wait() since the
+  /// DiagnosticEngine is not thread-safe.
+  void writeOccurrences(SymbolTracker &record,
+                        IndexRecordWriter &recordWriter) {
+    for (auto &occurrence : record.getOccurrences()) {
+      SmallVector<clang::index::writer::SymbolRelation, 3> relations;
+      for (SymbolTracker::SymbolRelation symbolRelation : occurrence.related) {
+        relations.push_back({record.getSymbol(symbolRelation.symbolIndex),
+                             symbolRelation.roles});
+      }
+
+      recordWriter.addOccurrence(
+          record.getSymbol(occurrence.symbolIndex), occurrence.roles,
+          occurrence.line, occurrence.column, relations);
     }
 
-    recordWriter.addOccurrence(
-        record.getSymbol(occurrence.symbolIndex), occurrence.roles,
-        occurrence.line, occurrence.column, relations);
-  }
-
-  result = recordWriter.endRecord(error,
-      [&](clang::index::writer::OpaqueDecl opaqueSymbol,
-          SmallVectorImpl<char> &scratch) {
-    auto *symbol = static_cast<const SymbolTracker::Symbol *>(opaqueSymbol);
-    clang::index::writer::Symbol result;
-    result.SymInfo = symbol->symInfo;
-    result.Name = symbol->name;
-    result.USR = symbol->USR;
-    result.CodeGenName = ""; // FIXME
-    return result;
-  });
+    std::string error;
+    auto result = recordWriter.endRecord(error,
+        [&](clang::index::writer::OpaqueDecl opaqueSymbol,
+            SmallVectorImpl<char> &scratch) {
+      auto *symbol = static_cast<const SymbolTracker::Symbol *>(opaqueSymbol);
+      clang::index::writer::Symbol result;
+      result.SymInfo = symbol->symInfo;
+      result.Name = symbol->name;
+      result.USR = symbol->USR;
+      result.CodeGenName = ""; // FIXME
+      return result;
+    });
 
-  if (result == IndexRecordWriter::Result::Failure) {
-    diags->diagnose(SourceLoc(), diag::error_write_index_record, error);
-    return true;
+    if (result == IndexRecordWriter::Result::Failure) {
+      std::lock_guard<std::mutex> guard(ErrorsMtx);
+      Errors.push_back(std::move(error));
+    }
   }
-
-  return false;
-}
+};
+} // end anonymous namespace
 
 static std::unique_ptr<IndexRecordingConsumer>
 makeRecordingConsumer(std::string Filename, std::string indexStorePath,
+                      BackgroundRecordWriter &recordWriter,
                       DiagnosticEngine *diags,
                       std::string *outRecordFile,
                       bool *outFailed) {
-  return std::make_unique<IndexRecordingConsumer>([=](SymbolTracker &record) {
-    *outFailed = writeRecord(record, Filename, indexStorePath, diags,
-                             *outRecordFile);
+  return std::make_unique<IndexRecordingConsumer>(
+      [=, &recordWriter](SymbolTracker &&record) {
+    *outFailed = recordWriter.enqueue(std::move(record), Filename,
+                                      indexStorePath, diags, *outRecordFile);
   });
 }
 
 static bool
 recordSourceFile(SourceFile *SF, StringRef indexStorePath,
-                 DiagnosticEngine &diags,
+                 BackgroundRecordWriter &recordWriter, DiagnosticEngine &diags,
                  llvm::function_ref<void(StringRef, StringRef)> callback) {
   std::string recordFile;
   bool failed = false;
   auto consumer =
       makeRecordingConsumer(SF->getFilename().str(), indexStorePath.str(),
-                            &diags, &recordFile, &failed);
+                            recordWriter, &diags, &recordFile, &failed);
   indexSourceFile(SF, *consumer);
 
   if (!failed && !recordFile.empty())
@@ -379,6 +451,7 @@ emitDataForSwiftSerializedModule(ModuleDecl *module,
                                  bool skipStdlib,
                                  StringRef targetTriple,
                                  const clang::CompilerInstance &clangCI,
+                                 BackgroundRecordWriter &recordWriter,
                                  DiagnosticEngine &diags,
                                  IndexUnitWriter &parentUnitWriter,
                                  SourceFile *initialFile);
@@ -389,6 +462,7 @@ static void addModuleDependencies(ArrayRef<ModuleDecl::ImportedModule> imports,
                                   bool skipStdlib,
                                   StringRef targetTriple,
                                   const clang::CompilerInstance &clangCI,
+                                  BackgroundRecordWriter &recordWriter,
                                   DiagnosticEngine &diags,
                                   IndexUnitWriter &unitWriter,
                                   StringScratchSpace &moduleNameScratch,
@@ -435,7 +509,8 @@ static void addModuleDependencies(ArrayRef<ModuleDecl::ImportedModule> imports,
                 (!skipStdlib || !mod->isStdlibModule())) {
               emitDataForSwiftSerializedModule(mod, indexStorePath,
                                                indexSystemModules, skipStdlib,
-                                               targetTriple, clangCI, diags,
+                                               targetTriple, clangCI,
+                                               recordWriter, diags,
                                                unitWriter, initialFile);
               withoutUnitName = false;
             }
@@ -465,6 +540,7 @@ emitDataForSwiftSerializedModule(ModuleDecl *module,
                                  bool skipStdlib,
                                  StringRef targetTriple,
                                  const clang::CompilerInstance &clangCI,
+                                 BackgroundRecordWriter &recordWriter,
                                  DiagnosticEngine &diags,
                                  IndexUnitWriter &parentUnitWriter,
                                  SourceFile *initialFile) {
@@ -497,7 +573,8 @@ emitDataForSwiftSerializedModule(ModuleDecl *module,
     std::string recordFile;
     bool failed = false;
     auto consumer = makeRecordingConsumer(filename.str(), indexStorePath.str(),
-                                          &diags, &recordFile, &failed);
+                                          recordWriter, &diags, &recordFile,
+                                          &failed);
     indexModule(module, *consumer);
 
     if (failed)
@@ -532,16 +609,18 @@ emitDataForSwiftSerializedModule(ModuleDecl *module,
     };
 
     bool failed = false;
-    StdlibGroupsIndexRecordingConsumer groupIndexConsumer([&](StringRef groupName, SymbolTracker &tracker) -> bool {
+    StdlibGroupsIndexRecordingConsumer groupIndexConsumer([&](StringRef groupName, SymbolTracker &&tracker) -> bool {
       SmallString<128> moduleName;
       makeSubmoduleNameFromGroupName(groupName, moduleName);
       SmallString<256> fileNameWithGroup = filename;
       appendGroupNameForFilename(groupName, fileNameWithGroup);
 
       std::string outRecordFile;
-      failed =
-          failed || writeRecord(tracker, std::string(fileNameWithGroup.str()),
-                                indexStorePath.str(), &diags, outRecordFile);
+      failed = failed ||
+               recordWriter.enqueue(std::move(tracker),
+                                    std::string(fileNameWithGroup.str()),
+                                    indexStorePath.str(), &diags,
+                                    outRecordFile);
       if (failed)
         return false;
       records.emplace_back(outRecordFile, moduleName.str().str());
@@ -585,9 +664,14 @@ emitDataForSwiftSerializedModule(ModuleDecl *module,
   module->getImportedModules(imports, importFilter);
   StringScratchSpace moduleNameScratch;
   addModuleDependencies(imports, indexStorePath, indexSystemModules, skipStdlib,
-                        targetTriple, clangCI, diags, unitWriter,
+                        targetTriple, clangCI, recordWriter, diags, unitWriter,
                         moduleNameScratch, initialFile);
 
+  // The unit references the queued records, so they have to be on disk before
+  // it is written.
+  if (recordWriter.wait(diags))
+    return true;
+
   if (unitWriter.write(error)) {
     diags.diagnose(SourceLoc(), diag::error_write_index_unit, error);
     return true;
@@ -603,6 +687,7 @@ recordSourceFileUnit(SourceFile *primarySourceFile, StringRef indexUnitToken,
                      StringRef targetTriple,
                      ArrayRef<const clang::FileEntry *> fileDependencies,
                      const clang::CompilerInstance &clangCI,
+                     BackgroundRecordWriter &recordWriter,
                      DiagnosticEngine &diags) {
   auto &fileMgr = clangCI.getFileManager();
   auto *module = primarySourceFile->getParentModule();
@@ -618,6 +703,17 @@ recordSourceFileUnit(SourceFile *primarySourceFile, StringRef indexUnitToken,
       /*isModuleUnit=*/false, isDebugCompilation, targetTriple, sysrootPath,
       getModuleInfoFromOpaqueModule);
 
+  // Index the primary file first so its record write proceeds in the
+  // background while the dependencies below are collected (which may involve
+  // emitting index data for clang and serialized swift modules).
+  recordSourceFile(primarySourceFile, indexStorePath, recordWriter, diags,
+                   [&](StringRef recordFile, StringRef filename) {
+                     auto file = fileMgr.getFile(filename);
+                     unitWriter.addRecordFile(
+                         recordFile, file ? *file : nullptr,
+                         module->isSystemModule(), /*Module=*/nullptr);
+                   });
+
   // Module dependencies.
   ModuleDecl::ImportFilter importFilter;
   importFilter |= ModuleDecl::ImportFilterKind::Public;
@@ -628,20 +724,17 @@ recordSourceFileUnit(SourceFile *primarySourceFile, StringRef indexUnitToken,
   primarySourceFile->getImportedModules(imports, importFilter);
   StringScratchSpace moduleNameScratch;
   addModuleDependencies(imports, indexStorePath, indexSystemModules, skipStdlib,
-                        targetTriple, clangCI, diags, unitWriter,
+                        targetTriple, clangCI, recordWriter, diags, unitWriter,
                         moduleNameScratch, primarySourceFile);
 
   // File dependencies.
   for (auto *F : fileDependencies)
     unitWriter.addFileDependency(F, /*FIXME:isSystem=*/false, /*Module=*/nullptr);
 
-  recordSourceFile(primarySourceFile, indexStorePath, diags,
-                   [&](StringRef recordFile, StringRef filename) {
-                     auto file = fileMgr.getFile(filename);
-                     unitWriter.addRecordFile(
-                         recordFile, file ? *file : nullptr,
-                         module->isSystemModule(), /*Module=*/nullptr);
-                   });
+  // The unit references the queued records, so they have to be on disk before
+  // it is written.
+  if (recordWriter.wait(diags))
+    return true;
 
   std::string error;
   if (unitWriter.write(error)) {
@@ -707,11 +800,15 @@ bool index::indexAndRecord(SourceFile *primarySourceFile,
   collectFileDependencies(fileDependencies, dependencyTracker, module, fileMgr);
 #endif
 
-  return recordSourceFileUnit(primarySourceFile, indexUnitToken,
-                              indexStorePath, indexSystemModules, skipStdlib,
-                              isDebugCompilation, targetTriple,
-                              fileDependencies.getArrayRef(),
-                              clangCI, diags);
+  BackgroundRecordWriter recordWriter;
+  bool failed = recordSourceFileUnit(primarySourceFile, indexUnitToken,
+                                     indexStorePath, indexSystemModules,
+                                     skipStdlib, isDebugCompilation,
+                                     targetTriple,
+                                     fileDependencies.getArrayRef(),
+                                     clangCI, recordWriter, diags);
+  failed |= recordWriter.wait(diags);
+  return failed;
 }
 
 bool index::indexAndRecord(ModuleDecl *module,
@@ -747,6 +844,7 @@ bool index::indexAndRecord(ModuleDecl *module,
 #endif
 
   // Write a unit for each source file.
+  BackgroundRecordWriter recordWriter;
   unsigned unitIndex = 0;
   for (auto *F : module->getFiles()) {
     if (auto *SF = dyn_cast<SourceFile>(F)) {
@@ -758,7 +856,7 @@ bool index::indexAndRecord(ModuleDecl *module,
                                indexStorePath, indexSystemModules, skipStdlib,
                                isDebugCompilation, targetTriple,
                                fileDependencies.getArrayRef(),
-                               clangCI, diags))
+                               clangCI, recordWriter, diags))
         return true;
       unitIndex += 1;
     }
@@ -768,5 +866,89 @@ bool index::indexAndRecord(ModuleDecl *module,
   // ignore the inputs; associated unit files for the modules' source inputs
   // should have been generated at swift module creation time.
 
+  return recordWriter.wait(diags);
+}
+
+//===----------------------------------------------------------------------===//
+// Index store compaction
+//===----------------------------------------------------------------------===//
+
+bool index::compactIndexStore(StringRef indexStorePath,
+                              DiagnosticEngine &diags) {
+  // The subdirectory layout below matches the store format version used by
+  // clang's IndexUnitWriter and IndexRecordWriter.
+  SmallString<128> unitsPath(indexStorePath);
+  llvm::sys::path::append(unitsPath, "v5", "units");
+  SmallString<128> recordsPath(indexStorePath);
+  llvm::sys::path::append(recordsPath, "v5", "records");
+
+  // First pass: visit every unit, drop the ones whose main source file has
+  // been deleted, and collect the record names the surviving units reference.
+  llvm::StringSet<> liveRecords;
+  std::vector<std::string> staleUnits;
+
+  std::error_code ec;
+  for (llvm::sys::fs::directory_iterator it(unitsPath, ec), end;
+       !ec && it != end; it.increment(ec)) {
+    StringRef unitName = llvm::sys::path::filename(it->path());
+
+    std::string error;
+    auto reader = clang::index::IndexUnitReader::createWithUnitFilename(
+        unitName, indexStorePath, error);
+    if (!reader) {
+      // An unreadable unit cannot be queried, so queries never see it; treat
+      // it as garbage rather than keeping it around forever.
+      staleUnits.push_back(it->path());
+      continue;
+    }
+
+    if (reader->hasMainFile() &&
+        !llvm::sys::fs::exists(reader->getMainFilePath())) {
+      staleUnits.push_back(it->path());
+      continue;
+    }
+
+    reader->foreachDependency(
+        [&](const clang::index::IndexUnitReader::DependencyInfo &info) {
+          if (info.Kind ==
+              clang::index::IndexUnitReader::DependencyKind::Record)
+            liveRecords.insert(info.UnitOrRecordName);
+          return true;
+        });
+  }
+  if (ec) {
+    diags.diagnose(SourceLoc(), diag::error_compact_index_store, ec.message());
+    return true;
+  }
+
+  for (const std::string &unitPath : staleUnits) {
+    if (auto removeEC = llvm::sys::fs::remove(unitPath)) {
+      diags.diagnose(SourceLoc(), diag::error_compact_index_store,
+                     removeEC.message());
+      return true;
+    }
+  }
+
+  // Second pass: remove record files no longer referenced by any unit.
+  // Records are content-addressed, so a record shared by several units stays
+  // as long as any of them survives.
+  for (llvm::sys::fs::recursive_directory_iterator it(recordsPath, ec), end;
+       !ec && it != end; it.increment(ec)) {
+    llvm::sys::fs::file_status status;
+    if (it->status(status) || !llvm::sys::fs::is_regular_file(status))
+      continue;
+    if (liveRecords.count(llvm::sys::path::filename(it->path())))
+      continue;
+    if (auto removeEC = llvm::sys::fs::remove(it->path())) {
+      diags.diagnose(SourceLoc(), diag::error_compact_index_store,
+                     removeEC.message());
+      return true;
+    }
+  }
+  if (ec) {
+    diags.diagnose(SourceLoc(), diag::error_compact_index_store, ec.message());
+    return true;
+  }
+
   return false;
 }
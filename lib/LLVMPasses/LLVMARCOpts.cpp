@@ -59,6 +59,10 @@ STATISTIC(NumStoreOnlyObjectsEliminated,
           "Number of swift stored-only objects eliminated");
 STATISTIC(NumUnknownObjectRetainReleaseSRed,
           "Number of unknownretain/release strength reduced to retain/release");
+STATISTIC(NumRetainsSunkAcrossBlocks,
+          "Number of retains sunk into a successor block");
+STATISTIC(NumReleasesHoistedAcrossBlocks,
+          "Number of releases hoisted into a predecessor block");
 
 llvm::cl::opt<bool>
 DisableARCOpts("disable-llvm-arc-opts", llvm::cl::init(false));
@@ -251,8 +255,15 @@ static bool canonicalizeInputFunction(Function &F, ARCEntryPointBuilder &B,
 /// moving it earlier in the function if possible, over instructions that do not
 /// access the released object.  If we get to a retain or allocation of the
 /// object, zap both.
+///
+/// If the release reaches the top of its block, motion continues across the
+/// incoming edge when the block has a unique predecessor that branches here
+/// unconditionally; such an edge is straight-line code for our purposes.
+/// \p MaxCrossBlockHops bounds that walk so unreachable single-predecessor
+/// cycles can't recurse forever.
 static bool performLocalReleaseMotion(CallInst &Release, BasicBlock &BB,
-                                      SwiftRCIdentity *RC) {
+                                      SwiftRCIdentity *RC,
+                                      unsigned MaxCrossBlockHops = 16) {
   // FIXME: Call classifier should identify the object for us.  Too bad C++
   // doesn't have nice Swift-style enums.
   Value *ReleasedObject = RC->getSwiftRCIdentityRoot(Release.getArgOperand(0));
@@ -381,6 +392,23 @@ static bool performLocalReleaseMotion(CallInst &Release, BasicBlock &BB,
   }
 OutOfLoop:
 
+  // If the release made it all the way to the top of the block, try to
+  // continue into a unique predecessor that unconditionally branches here.
+  // Everything that reaches that predecessor's terminator continues into
+  // this block, so any value dominating the release's old position also
+  // dominates its new one. Note that a scan which stopped at a phi or at the
+  // definition of the released object never gets here.
+  if (BBI == BB.begin() && MaxCrossBlockHops != 0) {
+    if (BasicBlock *Pred = BB.getSinglePredecessor()) {
+      auto *PredBr = dyn_cast<BranchInst>(Pred->getTerminator());
+      if (Pred != &BB && PredBr && PredBr->isUnconditional()) {
+        Release.moveBefore(PredBr);
+        ++NumReleasesHoistedAcrossBlocks;
+        performLocalReleaseMotion(Release, *Pred, RC, MaxCrossBlockHops - 1);
+        return true;
+      }
+    }
+  }
 
   // If we got to the top of the block, (and if the instruction didn't start
   // there) move the release to the top of the block.
@@ -404,8 +432,14 @@ OutOfLoop:
 ///
 /// NOTE: this handles both objc_retain and swift_retain.
 ///
+/// If the retain reaches the terminator, motion continues across the
+/// outgoing edge when it is an unconditional branch to a block with a unique
+/// predecessor; such an edge is straight-line code for our purposes.
+/// \p MaxCrossBlockHops bounds that walk so unreachable single-predecessor
+/// cycles can't recurse forever.
 static bool performLocalRetainMotion(CallInst &Retain, BasicBlock &BB,
-                                     SwiftRCIdentity *RC) {
+                                     SwiftRCIdentity *RC,
+                                     unsigned MaxCrossBlockHops = 16) {
   // FIXME: Call classifier should identify the object for us.  Too bad C++
   // doesn't have nice Swift-style enums.
   Value *RetainedObject = RC->getSwiftRCIdentityRoot(Retain.getArgOperand(0));
@@ -506,6 +540,23 @@ static bool performLocalRetainMotion(CallInst &Retain, BasicBlock &BB,
   }
 OutOfLoop:
 
+  // If the retain made it all the way to the terminator, try to continue
+  // into the successor when the terminator is an unconditional branch to a
+  // block we are the unique predecessor of. Sinking the retain further down
+  // can never break dominance of its operand.
+  if (BBI == BBE && MaxCrossBlockHops != 0) {
+    auto *Br = dyn_cast<BranchInst>(BB.getTerminator());
+    if (Br && Br->isUnconditional()) {
+      BasicBlock *Succ = Br->getSuccessor(0);
+      if (Succ != &BB && Succ->getSinglePredecessor() == &BB) {
+        Retain.moveBefore(Succ->getFirstNonPHI());
+        ++NumRetainsSunkAcrossBlocks;
+        performLocalRetainMotion(Retain, *Succ, RC, MaxCrossBlockHops - 1);
+        return true;
+      }
+    }
+  }
+
   // If we were able to move the retain down, move it now.
   // TODO: This is where we'd plug in some global algorithms someday.
   if (MadeProgress) {
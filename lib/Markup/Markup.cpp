@@ -332,3 +332,31 @@ Document *swift::markup::parseDocument(MarkupContext &MC, LineList &LL) {
 Document *swift::markup::parseDocument(MarkupContext &MC, StringRef String) {
   return parseDocumentImpl(MC, MC.allocateCopy(String));
 }
+
+Paragraph *swift::markup::parseDocumentBrief(MarkupContext &MC, LineList &LL) {
+  auto String = LL.str();
+  auto CMarkDoc =
+      cmark_parse_document(String.data(), String.size(), CMARK_OPT_SMART);
+
+  if (CMarkDoc == nullptr)
+    return nullptr;
+
+  ParseState State(cmark_iter_new(CMarkDoc));
+  auto Iter = State.Iter;
+  // Prime the parser.
+  State = State.next();
+  assert(cmark_node_get_type(State.Node) == CMARK_NODE_DOCUMENT
+      && State.Event == CMARK_EVENT_ENTER);
+
+  // Only materialize the leading paragraph; the rest of the comment is
+  // left unparsed.
+  Paragraph *Brief = nullptr;
+  State = State.next();
+  if (State.Event == CMARK_EVENT_ENTER
+      && State.getType() == CMARK_NODE_PARAGRAPH)
+    Brief = parseParagraph(MC, State).Node;
+
+  cmark_node_free(CMarkDoc);
+  cmark_iter_free(Iter);
+  return Brief;
+}
@@ -26,17 +26,67 @@
 using namespace swift;
 using namespace swift::migrator;
 
+namespace {
+/// Compute the output path for one primary of a batch-mode migration job.
+/// The configured path names a single file, suitable for the unique-primary
+/// case, so siblings are disambiguated by the primary's filename while
+/// keeping the configured directory and extension.
+std::string derivePerPrimaryPath(StringRef ConfiguredPath,
+                                 StringRef PrimaryFile) {
+  llvm::SmallString<128> Path(ConfiguredPath);
+  llvm::sys::path::remove_filename(Path);
+  llvm::sys::path::append(Path, llvm::sys::path::filename(PrimaryFile));
+  llvm::sys::path::replace_extension(
+      Path, llvm::sys::path::extension(ConfiguredPath));
+  return Path.str().str();
+}
+} // end anonymous namespace
+
+static bool updateCodeForPrimary(CompilerInstance *Instance,
+                                 const CompilerInvocation &Invocation,
+                                 StringRef PrimaryFile,
+                                 const MigratorOptions &Opts);
+
 bool migrator::updateCodeAndEmitRemapIfNeeded(
     CompilerInstance *Instance, const CompilerInvocation &Invocation) {
-  if (!Invocation.getMigratorOptions().shouldRunMigrator())
+  const auto &MigratorOpts = Invocation.getMigratorOptions();
+  if (!MigratorOpts.shouldRunMigrator())
     return false;
 
+  const auto &IO = Invocation.getFrontendOptions().InputsAndOutputs;
+  bool Failed = false;
+  IO.forEachPrimaryInput([&](const InputFile &Primary) -> bool {
+    auto PrimaryOpts = MigratorOpts;
+    if (IO.hasMultiplePrimaryInputs()) {
+      // The configured output paths name a single file; give each primary of
+      // a batch job its own sibling path.
+      if (!PrimaryOpts.EmitRemapFilePath.empty())
+        PrimaryOpts.EmitRemapFilePath =
+            derivePerPrimaryPath(PrimaryOpts.EmitRemapFilePath,
+                                 Primary.file());
+      if (!PrimaryOpts.EmitMigratedFilePath.empty())
+        PrimaryOpts.EmitMigratedFilePath =
+            derivePerPrimaryPath(PrimaryOpts.EmitMigratedFilePath,
+                                 Primary.file());
+    }
+    Failed |= updateCodeForPrimary(Instance, Invocation, Primary.file(),
+                                   PrimaryOpts);
+    return false;
+  });
+  return Failed;
+}
+
+static bool updateCodeForPrimary(CompilerInstance *Instance,
+                                 const CompilerInvocation &Invocation,
+                                 StringRef PrimaryFile,
+                                 const MigratorOptions &Opts) {
   // Delete the remap file, in case someone is re-running the Migrator. If the
   // file fails to compile and we don't get a chance to overwrite it, the old
   // changes may get picked up.
-  llvm::sys::fs::remove(Invocation.getMigratorOptions().EmitRemapFilePath);
+  llvm::sys::fs::remove(Opts.EmitRemapFilePath);
 
-  Migrator M { Instance, Invocation }; // Provide inputs and configuration
+  Migrator M { Instance, Invocation,
+               PrimaryFile, Opts }; // Provide inputs and configuration
   auto EffectiveVersion = Invocation.getLangOptions().EffectiveLanguageVersion;
   auto CurrentVersion = version::Version::getCurrentLanguageVersion();
 
@@ -94,8 +144,10 @@ bool migrator::updateCodeAndEmitRemapIfNeeded(
 }
 
 Migrator::Migrator(CompilerInstance *StartInstance,
-                   const CompilerInvocation &StartInvocation)
-  : StartInstance(StartInstance), StartInvocation(StartInvocation) {
+                   const CompilerInvocation &StartInvocation,
+                   StringRef InputFilename, const MigratorOptions &Opts)
+  : StartInstance(StartInstance), StartInvocation(StartInvocation),
+    InputFilename(InputFilename), Opts(Opts) {
 
     auto ErrorOrStartBuffer = llvm::MemoryBuffer::getFile(getInputFilename());
     auto &StartBuffer = ErrorOrStartBuffer.get();
@@ -141,9 +193,12 @@ Migrator::performAFixItMigration(version::Version SwiftLanguageVersion) {
   assert(OrigFrontendOpts.InputsAndOutputs.hasPrimaryInputs() &&
          "Migration must have a primary");
   for (const auto &input : OrigFrontendOpts.InputsAndOutputs.getAllInputs()) {
+    // Only the file this migrator is responsible for stays primary; in a
+    // batch job the other primaries are migrated by their own Migrators.
+    bool IsPrimary = input.isPrimary() && input.file() == getInputFilename();
     Invocation.getFrontendOptions().InputsAndOutputs.addInput(
-        InputFile(input.file(), input.isPrimary(),
-                  input.isPrimary() ? InputBuffer.get() : input.buffer()));
+        InputFile(input.file(), IsPrimary,
+                  IsPrimary ? InputBuffer.get() : input.buffer()));
   }
 
   auto Instance = std::make_unique<swift::CompilerInstance>();
@@ -199,11 +254,10 @@ bool Migrator::performSyntacticPasses(SyntacticPassOptions Opts) {
 
   EditorAdapter Editor { StartInstance->getSourceMgr(), ClangSourceManager };
 
-  runAPIDiffMigratorPass(Editor, StartInstance->getPrimarySourceFile(),
-                         getMigratorOptions());
+  auto *PrimarySF = getPrimarySourceFile();
+  runAPIDiffMigratorPass(Editor, PrimarySF, getMigratorOptions());
   if (Opts.RunOptionalTryMigration) {
-    runOptionalTryMigratorPass(Editor, StartInstance->getPrimarySourceFile(),
-                               getMigratorOptions());
+    runOptionalTryMigratorPass(Editor, PrimarySF, getMigratorOptions());
   }
 
   Edits.commit(Editor.getEdits());
@@ -211,7 +265,7 @@ bool Migrator::performSyntacticPasses(SyntacticPassOptions Opts) {
   RewriteBufferEditsReceiver Rewriter {
     ClangSourceManager,
     Editor.getClangFileIDForSwiftBufferID(
-      StartInstance->getPrimarySourceFile()->getBufferID().getValue()),
+      PrimarySF->getBufferID().getValue()),
     InputState->getOutputText()
   };
 
@@ -428,11 +482,17 @@ bool Migrator::dumpStates() const {
 }
 
 const MigratorOptions &Migrator::getMigratorOptions() const {
-  return StartInvocation.getMigratorOptions();
+  return Opts;
 }
 
 const StringRef Migrator::getInputFilename() const {
-  auto &PrimaryInput = StartInvocation.getFrontendOptions()
-                           .InputsAndOutputs.getRequiredUniquePrimaryInput();
-  return PrimaryInput.file();
+  return InputFilename;
+}
+
+SourceFile *Migrator::getPrimarySourceFile() const {
+  for (auto *SF : StartInstance->getPrimarySourceFiles()) {
+    if (SF->getFilename() == getInputFilename())
+      return SF;
+  }
+  llvm_unreachable("no primary source file for the migrator's input");
 }
@@ -41,6 +41,15 @@ public:
 
 } // end anonymous namespace
 
+/// Create the option table for a driver or frontend invocation.
+///
+/// The table itself is the static, TableGen-generated InfoTable above --
+/// nothing is parsed from Options.td at runtime. Constructing a
+/// SwiftOptTable only verifies the table's ordering (in asserts builds) and
+/// sets up a few index bounds; argument parsing is then a binary search over
+/// the name-sorted entries per argument actually passed, so per-invocation
+/// cost scales with the command line, not with the number of options
+/// defined.
 std::unique_ptr<OptTable> swift::createSwiftOptTable() {
   return std::unique_ptr<OptTable>(new SwiftOptTable());
 }
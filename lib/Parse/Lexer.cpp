@@ -32,6 +32,12 @@
 
 #include <limits>
 
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#elif defined(__ARM_NEON) && defined(__aarch64__)
+#include <arm_neon.h>
+#endif
+
 using namespace swift;
 using namespace swift::syntax;
 
@@ -374,12 +380,142 @@ static void diagnoseEmbeddedNul(DiagnosticEngine *Diags, const char *Ptr) {
       .fixItRemoveChars(NulLoc, NulEndLoc);
 }
 
+//===----------------------------------------------------------------------===//
+// Vectorized scanning kernels
+//===----------------------------------------------------------------------===//
+//
+// The hot loops in the lexer (identifier continuation, '//' comment skipping,
+// and whitespace trivia) spend nearly all of their time advancing over plain
+// ASCII bytes one at a time. The helpers below bulk-advance over 16-byte
+// chunks using SSE2 or NEON where those are baseline for the target, and
+// degrade to the portable byte loop otherwise. Each helper stops conservatively
+// at the first byte it cannot classify (including any non-ASCII byte) and
+// leaves the caller's scalar loop to handle it, so diagnostics and UTF-8
+// validation behavior are unchanged.
+
+/// Advance \p p over any run of ASCII identifier continuation characters
+/// [a-zA-Z0-9_$], returning a pointer to the first byte not in that set (or
+/// \p end).
+static const char *skipASCIIIdentifierChars(const char *p, const char *end) {
+#if defined(__SSE2__)
+  while (p + 16 <= end) {
+    __m128i chunk = _mm_loadu_si128(reinterpret_cast<const __m128i *>(p));
+    // Letters, case-folded via the 0x20 bit. Bytes with the high bit set are
+    // negative under the signed comparisons and never classify as valid, so
+    // non-ASCII bytes always stop the scan.
+    __m128i folded = _mm_or_si128(chunk, _mm_set1_epi8(0x20));
+    __m128i isAlpha =
+        _mm_and_si128(_mm_cmpgt_epi8(folded, _mm_set1_epi8('a' - 1)),
+                      _mm_cmplt_epi8(folded, _mm_set1_epi8('z' + 1)));
+    __m128i isDigit =
+        _mm_and_si128(_mm_cmpgt_epi8(chunk, _mm_set1_epi8('0' - 1)),
+                      _mm_cmplt_epi8(chunk, _mm_set1_epi8('9' + 1)));
+    __m128i isMisc =
+        _mm_or_si128(_mm_cmpeq_epi8(chunk, _mm_set1_epi8('_')),
+                     _mm_cmpeq_epi8(chunk, _mm_set1_epi8('$')));
+    int mask = _mm_movemask_epi8(
+        _mm_or_si128(_mm_or_si128(isAlpha, isDigit), isMisc));
+    if (mask != 0xFFFF)
+      return p + llvm::countTrailingOnes(static_cast<uint32_t>(mask));
+    p += 16;
+  }
+#elif defined(__ARM_NEON) && defined(__aarch64__)
+  while (p + 16 <= end) {
+    uint8x16_t chunk = vld1q_u8(reinterpret_cast<const uint8_t *>(p));
+    uint8x16_t folded = vorrq_u8(chunk, vdupq_n_u8(0x20));
+    uint8x16_t isAlpha = vandq_u8(vcgeq_u8(folded, vdupq_n_u8('a')),
+                                  vcleq_u8(folded, vdupq_n_u8('z')));
+    uint8x16_t isDigit = vandq_u8(vcgeq_u8(chunk, vdupq_n_u8('0')),
+                                  vcleq_u8(chunk, vdupq_n_u8('9')));
+    uint8x16_t isMisc = vorrq_u8(vceqq_u8(chunk, vdupq_n_u8('_')),
+                                 vceqq_u8(chunk, vdupq_n_u8('$')));
+    uint8x16_t ok = vorrq_u8(vorrq_u8(isAlpha, isDigit), isMisc);
+    if (vminvq_u8(ok) != 0xFF)
+      break;
+    p += 16;
+  }
+#endif
+  while (p < end) {
+    char c = *p;
+    if (!clang::isIdentifierBody(c, /*AllowDollar=*/true))
+      break;
+    ++p;
+  }
+  return p;
+}
+
+/// Advance \p p over bytes that cannot terminate a '//' comment scan: anything
+/// other than '\n', '\r', NUL, or a byte with the high bit set. Returns a
+/// pointer to the first byte the caller must inspect itself.
+static const char *skipToPossibleLineEnd(const char *p, const char *end) {
+#if defined(__SSE2__)
+  while (p + 16 <= end) {
+    __m128i chunk = _mm_loadu_si128(reinterpret_cast<const __m128i *>(p));
+    __m128i stop = _mm_or_si128(
+        _mm_or_si128(_mm_cmpeq_epi8(chunk, _mm_set1_epi8('\n')),
+                     _mm_cmpeq_epi8(chunk, _mm_set1_epi8('\r'))),
+        _mm_cmpeq_epi8(chunk, _mm_setzero_si128()));
+    // movemask of the raw chunk flags high-bit (non-ASCII) bytes.
+    int mask = _mm_movemask_epi8(stop) | _mm_movemask_epi8(chunk);
+    if (mask != 0)
+      return p + llvm::countTrailingZeros(static_cast<uint32_t>(mask));
+    p += 16;
+  }
+#elif defined(__ARM_NEON) && defined(__aarch64__)
+  while (p + 16 <= end) {
+    uint8x16_t chunk = vld1q_u8(reinterpret_cast<const uint8_t *>(p));
+    uint8x16_t stop = vorrq_u8(
+        vorrq_u8(vceqq_u8(chunk, vdupq_n_u8('\n')),
+                 vceqq_u8(chunk, vdupq_n_u8('\r'))),
+        vorrq_u8(vceqq_u8(chunk, vdupq_n_u8(0)),
+                 vcgeq_u8(chunk, vdupq_n_u8(0x80))));
+    if (vmaxvq_u8(stop) != 0)
+      break;
+    p += 16;
+  }
+#endif
+  while (p < end) {
+    char c = *p;
+    if (c == '\n' || c == '\r' || c == 0 || (signed char)c < 0)
+      break;
+    ++p;
+  }
+  return p;
+}
+
+/// Advance \p p over a run of the byte \p b, returning a pointer to the first
+/// differing byte (or \p end).
+static const char *skipByteRun(const char *p, const char *end, char b) {
+#if defined(__SSE2__)
+  while (p + 16 <= end) {
+    __m128i chunk = _mm_loadu_si128(reinterpret_cast<const __m128i *>(p));
+    int mask = _mm_movemask_epi8(_mm_cmpeq_epi8(chunk, _mm_set1_epi8(b)));
+    if (mask != 0xFFFF)
+      return p + llvm::countTrailingOnes(static_cast<uint32_t>(mask));
+    p += 16;
+  }
+#elif defined(__ARM_NEON) && defined(__aarch64__)
+  while (p + 16 <= end) {
+    uint8x16_t chunk = vld1q_u8(reinterpret_cast<const uint8_t *>(p));
+    if (vminvq_u8(vceqq_u8(chunk, vdupq_n_u8(b))) != 0xFF)
+      break;
+    p += 16;
+  }
+#endif
+  while (p < end && *p == b)
+    ++p;
+  return p;
+}
+
 /// Advance \p CurPtr to the end of line or the end of file. Returns \c true
 /// if it stopped at the end of line, \c false if it stopped at the end of file.
 static bool advanceToEndOfLine(const char *&CurPtr, const char *BufferEnd,
                                const char *CodeCompletionPtr = nullptr,
                                DiagnosticEngine *Diags = nullptr) {
   while (1) {
+    // Bulk-advance over uninteresting ASCII bytes; the switch below only ever
+    // sees line terminators, NUL, or the start of a non-ASCII sequence.
+    CurPtr = skipToPossibleLineEnd(CurPtr, BufferEnd);
     switch (*CurPtr++) {
     case '\n':
     case '\r':
@@ -662,8 +798,12 @@ void Lexer::lexIdentifier() {
   assert(didStart && "Unexpected start");
   (void) didStart;
 
-  // Lex [a-zA-Z_$0-9[[:XID_Continue:]]]*
-  while (advanceIfValidContinuationOfIdentifier(CurPtr, BufferEnd));
+  // Lex [a-zA-Z_$0-9[[:XID_Continue:]]]*. The vectorized kernel handles the
+  // (overwhelmingly common) ASCII run; the scalar loop picks up any Unicode
+  // continuation characters and then retries the fast path.
+  CurPtr = skipASCIIIdentifierChars(CurPtr, BufferEnd);
+  while (advanceIfValidContinuationOfIdentifier(CurPtr, BufferEnd))
+    CurPtr = skipASCIIIdentifierChars(CurPtr, BufferEnd);
 
   tok Kind = kindOfIdentifier(StringRef(TokStart, CurPtr-TokStart),
                               LexMode == LexerMode::SIL);
@@ -2531,10 +2671,12 @@ Restart:
     }
     goto Restart;
   case ' ':
-    Pieces.appendOrSquash(TriviaKind::Space, 1);
+    CurPtr = skipByteRun(CurPtr, BufferEnd, ' ');
+    Pieces.appendOrSquash(TriviaKind::Space, CurPtr - TriviaStart);
     goto Restart;
   case '\t':
-    Pieces.appendOrSquash(TriviaKind::Tab, 1);
+    CurPtr = skipByteRun(CurPtr, BufferEnd, '\t');
+    Pieces.appendOrSquash(TriviaKind::Tab, CurPtr - TriviaStart);
     goto Restart;
   case '\v':
     Pieces.appendOrSquash(TriviaKind::VerticalTab, 1);
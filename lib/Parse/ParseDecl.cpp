@@ -37,6 +37,7 @@
 #include "llvm/Support/MemoryBuffer.h"
 #include "llvm/Support/Path.h"
 #include "llvm/Support/SaveAndRestore.h"
+#include "llvm/Support/xxhash.h"
 #include "llvm/ADT/PointerUnion.h"
 #include "llvm/ADT/StringSwitch.h"
 #include "llvm/ADT/Twine.h"
@@ -6141,6 +6142,12 @@ void Parser::consumeAbstractFunctionBody(AbstractFunctionDecl *AFD,
 
   AFD->setBodyDelayed(BodyRange);
 
+  // Record a fingerprint of the skipped body text so that later phases can
+  // prove the body unchanged without lexing it again.
+  auto BodyText = SourceMgr.extractText(
+      Lexer::getCharSourceRangeFromSourceRange(SourceMgr, BodyRange));
+  AFD->setBodyFingerprint(llvm::xxHash64(BodyText));
+
   if (isCodeCompletionFirstPass()) {
     if (SourceMgr.rangeContainsCodeCompletionLoc(BodyRange)) {
       State->setCodeCompletionDelayedDeclState(
@@ -11,6 +11,7 @@
 //===----------------------------------------------------------------------===//
 
 #include "swift/Parse/ParsedTrivia.h"
+#include "swift/Syntax/SyntaxArena.h"
 #include "swift/Syntax/Trivia.h"
 #include "swift/Basic/SourceManager.h"
 
@@ -33,6 +34,23 @@ ParsedTriviaPiece::convertToSyntaxTrivia(ArrayRef<ParsedTriviaPiece> pieces,
   return trivia;
 }
 
+Trivia
+ParsedTriviaPiece::convertToSyntaxTrivia(ArrayRef<ParsedTriviaPiece> pieces,
+                                         SourceLoc loc,
+                                         const SourceManager &SM,
+                                         unsigned bufferID,
+                                         SyntaxArena &Arena) {
+  Trivia trivia;
+  SourceLoc curLoc = loc;
+  for (const auto &piece : pieces) {
+    CharSourceRange range{curLoc, piece.getLength()};
+    StringRef text = SM.extractText(range, bufferID);
+    trivia.push_back(TriviaPiece::fromText(piece.getKind(), text, Arena));
+    curLoc = curLoc.getAdvancedLoc(piece.getLength());
+  }
+  return trivia;
+}
+
 Trivia
 ParsedTrivia::convertToSyntaxTrivia(SourceLoc loc, const SourceManager &SM,
                                     unsigned bufferID) const {
@@ -18,9 +18,45 @@ using namespace swift::syntax;
 
 void SyntaxParsingCache::addEdit(size_t Start, size_t End,
                                  size_t ReplacementLength) {
-  assert((Edits.empty() || Edits.back().End <= Start) &&
-         "'Start' must be greater than or equal to 'End' of the previous edit");
-  Edits.emplace_back(Start, End, ReplacementLength);
+  assert(Start <= End && "Invalid edit range");
+  SourceEdit NewEdit(Start, End, ReplacementLength);
+
+  // Keep the edits sorted by their start position so that
+  // translateToPreEditPosition can replay them front to back.
+  auto InsertPos = std::lower_bound(
+      Edits.begin(), Edits.end(), NewEdit,
+      [](const SourceEdit &Lhs, const SourceEdit &Rhs) {
+        return Lhs.Start < Rhs.Start;
+      });
+  InsertPos = Edits.insert(InsertPos, NewEdit);
+
+  // Merge the new edit with any neighbours it overlaps or touches. The merged
+  // edit covers the union of the original ranges and preserves the combined
+  // length delta, which is all position translation needs.
+  auto MergeAdjacent = [this](size_t Index) -> bool {
+    if (Index + 1 >= Edits.size())
+      return false;
+    SourceEdit &Lhs = Edits[Index];
+    SourceEdit &Rhs = Edits[Index + 1];
+    if (Lhs.End < Rhs.Start)
+      return false;
+    size_t MergedEnd = std::max(Lhs.End, Rhs.End);
+    ptrdiff_t Delta =
+        (ptrdiff_t(Lhs.ReplacementLength) - ptrdiff_t(Lhs.originalLength())) +
+        (ptrdiff_t(Rhs.ReplacementLength) - ptrdiff_t(Rhs.originalLength()));
+    Lhs.End = MergedEnd;
+    Lhs.ReplacementLength = size_t(ptrdiff_t(Lhs.originalLength()) + Delta);
+    Edits.erase(Edits.begin() + Index + 1);
+    return true;
+  };
+
+  size_t Index = InsertPos - Edits.begin();
+  // Merge with the predecessor first so that the new edit's range is folded
+  // into it, then keep folding successors into the merged edit.
+  if (Index > 0 && MergeAdjacent(Index - 1))
+    --Index;
+  while (MergeAdjacent(Index)) {
+  }
 }
 
 bool SyntaxParsingCache::nodeCanBeReused(const Syntax &Node, size_t NodeStart,
@@ -107,12 +143,15 @@ SyntaxParsingCache::translateToPreEditPosition(size_t PostEditPosition,
 
 llvm::Optional<Syntax> SyntaxParsingCache::lookUp(size_t NewPosition,
                                                   SyntaxKind Kind) {
+  ++LookupCount;
   Optional<size_t> OldPosition = translateToPreEditPosition(NewPosition, Edits);
   if (!OldPosition.hasValue())
     return None;
 
   auto Node = lookUpFrom(OldSyntaxTree, /*NodeStart=*/0, *OldPosition, Kind);
   if (Node.hasValue()) {
+    ++HitCount;
+    ReusedBytes += Node->getTextLength();
     ReusedNodeIds.insert(Node->getId());
   }
   return Node;
@@ -19,6 +19,7 @@
 #include "swift/AST/ProtocolConformance.h"
 #include "swift/AST/SwiftNameTranslation.h"
 #include "swift/AST/TypeDeclFinder.h"
+#include "swift/Basic/SourceManager.h"
 #include "swift/ClangImporter/ClangImporter.h"
 
 #include "clang/AST/Decl.h"
@@ -529,10 +530,39 @@ public:
                           const ProtocolDecl *nextRHSProto) {
         return nextLHSProto->getName() != nextRHSProto->getName();
       });
-      if (mismatch.first == lhsProtos.end())
-        return Equivalent;
-      StringRef lhsProtoName = (*mismatch.first)->getName().str();
-      return lhsProtoName.compare((*mismatch.second)->getName().str());
+      if (mismatch.first != lhsProtos.end()) {
+        StringRef lhsProtoName = (*mismatch.first)->getName().str();
+        return lhsProtoName.compare((*mismatch.second)->getName().str());
+      }
+
+      // Still nothing? Tie-break by source order. array_pod_sort is not a
+      // stable sort, so letting two distinct extensions compare equivalent
+      // would leave their relative order up to the pointer values of the
+      // decls, which vary from run to run. Keeping the order deterministic
+      // keeps the emitted header's bytes stable when the API is unchanged,
+      // so incremental builds that compare the new header against the old
+      // one can leave it untouched.
+      auto lhsLoc = (*lhs)->getLoc();
+      auto rhsLoc = (*rhs)->getLoc();
+      if (lhsLoc.isValid() && rhsLoc.isValid()) {
+        const auto &srcMgr = (*lhs)->getASTContext().SourceMgr;
+        unsigned lhsBuf = srcMgr.findBufferContainingLoc(lhsLoc);
+        unsigned rhsBuf = srcMgr.findBufferContainingLoc(rhsLoc);
+        if (lhsBuf == rhsBuf) {
+          unsigned lhsOff = srcMgr.getLocOffsetInBuffer(lhsLoc, lhsBuf);
+          unsigned rhsOff = srcMgr.getLocOffsetInBuffer(rhsLoc, rhsBuf);
+          assert(lhsOff != rhsOff && "distinct decls at the same location");
+          // Earlier decls precede later ones, so sort them after (reversed).
+          return lhsOff < rhsOff ? Descending : Ascending;
+        }
+        // Different files: order by the files' names.
+        int result = srcMgr.getIdentifierForBuffer(lhsBuf).compare(
+            srcMgr.getIdentifierForBuffer(rhsBuf));
+        if (result != 0)
+          return result < 0 ? Descending : Ascending;
+      }
+
+      return Equivalent;
     });
 
     assert(declsToWrite.empty());
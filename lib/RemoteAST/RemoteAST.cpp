@@ -33,6 +33,8 @@
 #include "swift/Demangling/Demangler.h"
 #include "llvm/ADT/StringSwitch.h"
 
+#include <unordered_map>
+
 // TODO: Develop a proper interface for this.
 #include "swift/AST/IRGenOptions.h"
 #include "swift/AST/SILOptions.h"
@@ -98,8 +100,34 @@ public:
   RemoteASTContextImpl() = default;
   virtual ~RemoteASTContextImpl() = default;
 
+  Result<Type>
+  getTypeForRemoteTypeMetadata(RemoteAddress metadata, bool skipArtificial) {
+    // Debuggers resolve the same metadata on every stop, so cache successful
+    // resolutions for the lifetime of the context.  Failures are not cached:
+    // they can be transient, e.g. metadata that was only partway initialized
+    // when the process was stopped.
+    auto &cache = MetadataTypeCache[skipArtificial];
+    auto cached = cache.find(metadata.getAddressData());
+    if (cached != cache.end())
+      return cached->second;
+
+    auto result = getTypeForRemoteTypeMetadataImpl(metadata, skipArtificial);
+    if (result)
+      cache.insert({metadata.getAddressData(), result.getValue()});
+    return result;
+  }
+
+  /// Discard all cached resolution results.  Must be called whenever the
+  /// remote process is resumed, since metadata addresses may be reused.
+  void invalidateCaches() {
+    MetadataTypeCache[0].clear();
+    MetadataTypeCache[1].clear();
+    clearReaderCaches();
+  }
+
   virtual Result<Type>
-  getTypeForRemoteTypeMetadata(RemoteAddress metadata, bool skipArtificial) = 0;
+  getTypeForRemoteTypeMetadataImpl(RemoteAddress metadata,
+                                   bool skipArtificial) = 0;
   virtual Result<MetadataKind>
   getKindForRemoteTypeMetadata(RemoteAddress metadata) = 0;
   virtual Result<NominalTypeDecl*>
@@ -164,8 +192,13 @@ protected:
   }
 
 private:
+  /// Successfully resolved types, keyed by metadata address and indexed by
+  /// whether artificial subclasses were skipped during resolution.
+  std::unordered_map<uint64_t, Type> MetadataTypeCache[2];
+
   virtual ASTBuilder &getBuilder() = 0;
   virtual MemoryReader &getReader() = 0;
+  virtual void clearReaderCaches() = 0;
   virtual bool readWordOffset(RemoteAddress address, int64_t *offset) = 0;
   virtual std::unique_ptr<IRGenContext> createIRGenContext() = 0;
   virtual Result<uint64_t>
@@ -419,6 +452,10 @@ class RemoteASTContextConcreteImpl final : public RemoteASTContextImpl {
     return *Reader.Reader;
   }
 
+  void clearReaderCaches() override {
+    Reader.clear();
+  }
+
   bool readWordOffset(RemoteAddress address, int64_t *extendedOffset) override {
     using unsigned_size_t = typename Runtime::StoredSize;
     using signed_size_t = typename std::make_signed<unsigned_size_t>::type;
@@ -435,8 +472,8 @@ public:
                                ASTContext &ctx)
     : Reader(std::move(reader), ctx) {}
 
-  Result<Type> getTypeForRemoteTypeMetadata(RemoteAddress metadata,
-                                            bool skipArtificial) override {
+  Result<Type> getTypeForRemoteTypeMetadataImpl(RemoteAddress metadata,
+                                                bool skipArtificial) override {
     if (auto result = Reader.readTypeFromMetadata(metadata.getAddressData(),
                                                   skipArtificial))
       return result;
@@ -678,6 +715,10 @@ RemoteASTContext::getTypeForRemoteTypeMetadata(RemoteAddress address,
   return asImpl(Impl)->getTypeForRemoteTypeMetadata(address, skipArtificial);
 }
 
+void RemoteASTContext::invalidateCaches() {
+  asImpl(Impl)->invalidateCaches();
+}
+
 Result<MetadataKind>
 RemoteASTContext::getKindForRemoteTypeMetadata(remote::RemoteAddress address) {
   return asImpl(Impl)->getKindForRemoteTypeMetadata(address);
@@ -121,6 +121,19 @@ SILModule::~SILModule() {
   }
 }
 
+SILModule::InstFreeListSet::~InstFreeListSet() {
+  // Return the recycled instruction memory to malloc. This member is
+  // destroyed after the function list, so the instructions of the remaining
+  // functions have all been pushed here by then.
+  for (void *head : Heads) {
+    while (head) {
+      void *next = *reinterpret_cast<void **>(head);
+      AlignedFree(head);
+      head = next;
+    }
+  }
+}
+
 std::unique_ptr<SILModule>
 SILModule::createEmptyModule(ModuleDecl *M, TypeConverter &TC, const SILOptions &Options,
                              bool WholeModule) {
@@ -140,11 +153,41 @@ void *SILModule::allocate(unsigned Size, unsigned Align) const {
 }
 
 void *SILModule::allocateInst(unsigned Size, unsigned Align) const {
-  return AlignedAlloc(Size, Align);
+  assert(Align <= InstMemoryHeaderBytes &&
+         "instruction alignment exceeds the recycling header");
+
+  // Round the allocation (including the header) up to its size class. The
+  // header makes the dynamic size of the instruction recoverable in
+  // deallocateInst(), which only sees the instruction pointer.
+  uint64_t totalSize = llvm::alignTo<InstMemoryGranularity>(
+      uint64_t(Size) + InstMemoryHeaderBytes);
+  uint64_t bucket = totalSize / InstMemoryGranularity - 1;
+
+  // Reuse a previously deallocated block of the same class if we have one.
+  void *base = nullptr;
+  if (bucket < NumInstFreeLists && InstFreeLists.Heads[bucket]) {
+    base = InstFreeLists.Heads[bucket];
+    InstFreeLists.Heads[bucket] = *reinterpret_cast<void *const *>(base);
+  }
+  if (!base)
+    base = AlignedAlloc(totalSize, InstMemoryHeaderBytes);
+
+  // A bucket index past the free lists marks the block as unbucketed, so
+  // deallocateInst() hands it straight back to malloc.
+  *reinterpret_cast<uint32_t *>(base) = uint32_t(bucket);
+  return reinterpret_cast<char *>(base) + InstMemoryHeaderBytes;
 }
 
 void SILModule::deallocateInst(SILInstruction *I) {
-  AlignedFree(I);
+  void *base = reinterpret_cast<char *>(I) - InstMemoryHeaderBytes;
+  uint32_t bucket = *reinterpret_cast<uint32_t *>(base);
+  if (bucket >= NumInstFreeLists) {
+    AlignedFree(base);
+    return;
+  }
+
+  *reinterpret_cast<void **>(base) = InstFreeLists.Heads[bucket];
+  InstFreeLists.Heads[bucket] = base;
 }
 
 SILWitnessTable *
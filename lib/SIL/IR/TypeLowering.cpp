@@ -1711,7 +1711,7 @@ TypeConverter::getTypeLowering(AbstractionPattern origType,
                                TypeExpansionContext forExpansion) {
   CanType substType = origSubstType->getCanonicalType();
   auto origHadOpaqueTypeArchetype =
-      hasOpaqueArchetypeOrPropertiesOrCases(origSubstType->getCanonicalType());
+      hasOpaqueArchetypeOrPropertiesOrCases(substType);
   auto key = getTypeKey(origType, substType, forExpansion);
   assert(!substType->is<InOutType>());
 
@@ -1963,34 +1963,33 @@ TypeConverter::getTypeLoweringForLoweredType(AbstractionPattern origType,
   return *lowering;
 }
 
-/// When we've found a type lowering for one resilience expansion,
-/// check if its the one we want; if not, walk the list until we
-/// find the right one, returning nullptr if the caller needs to
+/// When we've found a type lowering for the minimal resilience expansion,
+/// check if its the one we want; if not, check for a lowering cached for
+/// the exact expansion context, returning nullptr if the caller needs to
 /// go ahead and lower the type with the correct expansion.
 const TypeLowering *TypeConverter::
 getTypeLoweringForExpansion(TypeKey key,
                             TypeExpansionContext forExpansion,
-                            const TypeLowering *lowering,
+                            const TypeLowering *minimalLowering,
                             bool origHadOpaqueTypeArchetype) {
-  if (lowering == nullptr)
-    return nullptr;
+  if (forExpansion.isMinimal())
+    return minimalLowering;
 
-  if (!lowering->isResilient() && !origHadOpaqueTypeArchetype) {
+  if (minimalLowering != nullptr &&
+      !minimalLowering->isResilient() && !origHadOpaqueTypeArchetype) {
     // Don't try to refine the lowering for other resilience expansions if
     // we don't expect to get a different lowering anyway. Similar if the
     // original type did not have opaque type archetypes.
     //
     // See LowerType::handleResilience() for the gory details; we only
     // set this flag if the type is resilient *and* inside our module.
-    return lowering;
+    return minimalLowering;
   }
 
-  auto *exactLowering = find(key);
-  if (exactLowering)
-    return exactLowering;
-
-  // We have to create a new one.
-  return nullptr;
+  // Resilient and opaque-archetype-involved types are cached per expansion
+  // context, so probe for the exact key even if there was no entry for the
+  // minimal expansion. Returns nullptr if we have to create a new one.
+  return find(key);
 }
 
 static GenericSignature 
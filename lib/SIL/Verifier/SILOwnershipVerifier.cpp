@@ -914,7 +914,9 @@ void SILInstruction::verifyOperandOwnership() const {
   }
 }
 
-void SILValue::verifyOwnership(DeadEndBlocks *deadEndBlocks) const {
+void SILValue::verifyOwnership(
+    DeadEndBlocks *deadEndBlocks,
+    SmallPtrSetImpl<SILBasicBlock *> *visitedBlocks) const {
   if (DisableOwnershipVerification)
     return;
 
@@ -960,7 +962,12 @@ void SILValue::verifyOwnership(DeadEndBlocks *deadEndBlocks) const {
     errorBehavior = decltype(errorBehavior)::PrintMessageAndAssert;
   }
 
-  SmallPtrSet<SILBasicBlock *, 32> liveBlocks;
+  // Use caller-provided scratch space for the dataflow's visited set if we
+  // got some, so that verifying all the values of a function reuses one
+  // allocation instead of growing a fresh set per value.
+  SmallPtrSet<SILBasicBlock *, 32> localLiveBlocks;
+  auto &liveBlocks = visitedBlocks ? *visitedBlocks : localLiveBlocks;
+  assert(liveBlocks.empty() && "expected empty scratch space");
   if (deadEndBlocks) {
     SILValueOwnershipChecker(*deadEndBlocks, *this, errorBehavior,
                              liveBlocks)
@@ -655,6 +655,11 @@ class SILVerifier : public SILVerifierBase<SILVerifier> {
   llvm::DenseMap<const SILInstruction *, unsigned> InstNumbers;
 
   DeadEndBlocks DEBlocks;
+
+  // Scratch space handed to the per-value ownership dataflows so they share
+  // one visited-set allocation across all the values of the function.
+  llvm::SmallPtrSet<SILBasicBlock *, 32> OwnershipScratchBlocks;
+
   bool SingleFunction = true;
 
   SILVerifier(const SILVerifier&) = delete;
@@ -993,7 +998,10 @@ public:
     // ownership.
     if (!F->hasOwnership())
       return;
-    SILValue(V).verifyOwnership(&DEBlocks);
+    // Scratch space shared by the per-value lifetime dataflows; cleared
+    // before each use.
+    OwnershipScratchBlocks.clear();
+    SILValue(V).verifyOwnership(&DEBlocks, &OwnershipScratchBlocks);
   }
 
   void checkSILInstruction(SILInstruction *I) {
@@ -519,9 +519,16 @@ SILFunction *SILGenModule::getEmittedFunction(SILDeclRef constant,
 static SILFunction *getFunctionToInsertAfter(SILGenModule &SGM,
                                              SILDeclRef insertAfter) {
   // If the decl ref was emitted, emit after its function.
+  SmallVector<SILDeclRef, 4> visitedDelayed;
   while (insertAfter) {
     auto found = SGM.emittedFunctions.find(insertAfter);
     if (found != SGM.emittedFunctions.end()) {
+      // Forcing one function often forces a batch of others, which builds up
+      // long transitive chains of delayed references. Point the references we
+      // just walked directly at the emitted function so the next walk
+      // resolves immediately.
+      for (auto ref : visitedDelayed)
+        SGM.delayedFunctions.find(ref)->second.insertAfter = insertAfter;
       return found->second;
     }
 
@@ -529,6 +536,7 @@ static SILFunction *getFunctionToInsertAfter(SILGenModule &SGM,
     // be inserted after.
     auto foundDelayed = SGM.delayedFunctions.find(insertAfter);
     if (foundDelayed != SGM.delayedFunctions.end()) {
+      visitedDelayed.push_back(insertAfter);
       insertAfter = foundDelayed->second.insertAfter;
     } else {
       break;
@@ -644,7 +652,8 @@ SILFunction *SILGenModule::getFunction(SILDeclRef constant,
       M.functions.insertAfter(insertAfter->getIterator(), F);
     }
 
-    forcedFunctions.push_back(*foundDelayed);
+    forcedFunctions.emplace_back(foundDelayed->first,
+                                 std::move(foundDelayed->second));
     delayedFunctions.erase(foundDelayed);
   } else {
     // We would have registered a delayed function as "last emitted" when we
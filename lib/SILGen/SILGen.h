@@ -82,6 +82,14 @@ public:
   llvm::DenseSet<TypeBase *> usedConformancesFromTypes;
   llvm::DenseSet<TypeBase *> usedConformancesFromObjectiveCTypes;
 
+  /// Mapping from the types that determine a reabstraction thunk's mangled
+  /// name to the thunk, so that repeated requests for the same thunk skip
+  /// re-mangling. The key is ((thunkType, fromType), (toType,
+  /// dynamicSelfType)).
+  llvm::DenseMap<std::pair<std::pair<CanType, CanType>,
+                           std::pair<CanType, CanType>>,
+                 SILFunction *> reabstractionThunks;
+
   /// Queue of delayed conformances that need to be emitted.
   std::deque<NormalProtocolConformance *> pendingConformances;
 
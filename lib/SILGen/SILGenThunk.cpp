@@ -28,6 +28,7 @@
 #include "swift/AST/DiagnosticsSIL.h"
 #include "swift/AST/FileUnit.h"
 #include "swift/AST/GenericEnvironment.h"
+#include "swift/Basic/Statistic.h"
 #include "swift/SIL/PrettyStackTrace.h"
 #include "swift/SIL/SILArgument.h"
 #include "swift/SIL/TypeLowering.h"
@@ -157,6 +158,20 @@ getOrCreateReabstractionThunk(CanSILFunctionType thunkType,
                               CanSILFunctionType fromType,
                               CanSILFunctionType toType,
                               CanType dynamicSelfType) {
+  // These four types fully determine the thunk's mangled name, so repeated
+  // requests for the same thunk can bypass the mangling below.
+  auto cacheKey = std::make_pair(std::make_pair(CanType(thunkType),
+                                                CanType(fromType)),
+                                 std::make_pair(CanType(toType),
+                                                dynamicSelfType));
+  auto cached = reabstractionThunks.find(cacheKey);
+  if (cached != reabstractionThunks.end()) {
+    if (getASTContext().Stats)
+      getASTContext().Stats->getFrontendCounters()
+          .NumReabstractionThunksReused++;
+    return cached->second;
+  }
+
   // The reference to the thunk is likely @noescape, but declarations are always
   // escaping.
   auto thunkDeclType =
@@ -182,9 +197,11 @@ getOrCreateReabstractionThunk(CanSILFunctionType thunkType,
   auto loc = RegularLocation::getAutoGeneratedLocation();
 
   SILGenFunctionBuilder builder(*this);
-  return builder.getOrCreateSharedFunction(
+  auto *thunk = builder.getOrCreateSharedFunction(
       loc, name, thunkDeclType, IsBare, IsTransparent, IsSerializable,
       ProfileCounter(), IsReabstractionThunk, IsNotDynamic);
+  reabstractionThunks[cacheKey] = thunk;
+  return thunk;
 }
 
 SILFunction *SILGenModule::getOrCreateAutoDiffClassMethodThunk(
@@ -28,6 +28,23 @@
 
 using namespace swift;
 
+// One recompute counter per analysis kind, so that over-broad invalidation in
+// a pass shows up as a hot counter under -stats.
+#define ANALYSIS(NAME)                                                         \
+  STATISTIC(NumRecompute##NAME,                                                \
+            "Number of times the " #NAME " analysis recomputed a function");
+#include "swift/SILOptimizer/Analysis/Analysis.def"
+
+void swift::countAnalysisRecomputation(SILAnalysisKind kind) {
+  switch (kind) {
+#define ANALYSIS(NAME)                                                         \
+  case SILAnalysisKind::NAME:                                                  \
+    ++NumRecompute##NAME;                                                      \
+    break;
+#include "swift/SILOptimizer/Analysis/Analysis.def"
+  }
+}
+
 void SILAnalysis::verifyFunction(SILFunction *F) {
   // Only functions with bodies can be analyzed by the analysis.
   assert(F->isDefinition() && "Can't analyze external functions");
@@ -372,7 +372,11 @@ bool FunctionSideEffects::summarizeFunction(SILFunction *F) {
   }
 
   if (!F->isDefinition()) {
-    // We can't assume anything about external functions.
+    // We can't assume anything about external functions. The only effect
+    // information that crosses a module boundary today is what got here via
+    // the swiftmodule: @_effects attributes (handled above) and serialized
+    // bodies of @inlinable functions, which the SIL linker deserializes into
+    // real definitions before we are asked about them.
     LLVM_DEBUG(llvm::dbgs() << "  -- is external " << F->getName() << '\n');
     setWorstEffects();
     return true;
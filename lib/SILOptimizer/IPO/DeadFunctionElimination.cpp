@@ -406,6 +406,16 @@ public:
     keepExternalWitnessTablesAlive(keepExternalWitnessTablesAlive) {}
 
   /// The main entry point of the optimization.
+  ///
+  /// The liveness closure is recomputed from the anchors on every scheduled
+  /// run, even though that looks wasteful when the pass runs several times in
+  /// a pipeline. It cannot be made incremental: aliveness is not monotone
+  /// between runs - passes remove references (inlining, devirtualization, dead
+  /// code elimination), which can make a function dead that was alive the last
+  /// time - and nothing in the pass manager records which references changed.
+  /// The closure itself is worklist-driven and each function is scanned at
+  /// most once, so a run is linear in the size of the alive part of the
+  /// module.
   bool findAliveFunctions() {
 
     LLVM_DEBUG(llvm::dbgs() << "running function elimination\n");
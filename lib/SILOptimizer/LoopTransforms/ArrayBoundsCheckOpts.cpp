@@ -38,6 +38,7 @@
 #include "llvm/ADT/DepthFirstIterator.h"
 #include "llvm/ADT/PointerIntPair.h"
 #include "llvm/ADT/SmallPtrSet.h"
+#include "llvm/ADT/Statistic.h"
 #include "llvm/ADT/StringExtras.h"
 #include "llvm/ADT/StringSwitch.h"
 #include "llvm/Support/Allocator.h"
@@ -50,6 +51,15 @@
 using namespace swift;
 using namespace PatternMatch;
 
+STATISTIC(NumRedundantChecksRemoved,
+          "Number of redundant bounds checks removed");
+STATISTIC(NumLoopChecksRemoved,
+          "Number of bounds checks removed from loops");
+STATISTIC(NumLoopChecksHoisted,
+          "Number of bounds checks hoisted to a loop preheader");
+STATISTIC(NumLoopsClearedOfChecks,
+          "Number of changed loops left without any bounds check");
+
 static llvm::cl::opt<bool> ShouldReportBoundsChecks("sil-abcopts-report",
                                               llvm::cl::init(false));
 
@@ -369,6 +379,7 @@ static bool removeRedundantChecksInBlock(SILBasicBlock &BB, ArraySet &Arrays,
 
     // Remove the bounds check.
     ArrayCall.removeCall();
+    ++NumRedundantChecksRemoved;
     Changed = true;
   }
   return Changed;
@@ -430,6 +441,7 @@ static bool removeRedundantChecks(DominanceInfoNode *CurBB,
 
     // Remove the bounds check.
     ArrayCall.removeCall();
+    ++NumRedundantChecksRemoved;
     Changed = true;
   }
 
@@ -982,6 +994,7 @@ static bool hoistChecksInLoop(DominanceInfo *DT, DominanceInfoNode *DTNode,
              "Must be able to hoist the instruction.");
       Changed = true;
       ArrayCall.hoist(Preheader->getTerminator(), DT);
+      ++NumLoopChecksHoisted;
       LLVM_DEBUG(llvm::dbgs() << " could hoist invariant bounds check: "
                               << *Inst);
       continue;
@@ -1003,6 +1016,7 @@ static bool hoistChecksInLoop(DominanceInfo *DT, DominanceInfoNode *DTNode,
       // dominate the loop exit block.
       Changed = true;
       ArrayCall.removeCall();
+      ++NumLoopChecksRemoved;
       LLVM_DEBUG(llvm::dbgs() << "  Bounds check removed\n");
       continue;
     }
@@ -1020,7 +1034,8 @@ static bool hoistChecksInLoop(DominanceInfo *DT, DominanceInfoNode *DTNode,
 
     // Remove the old check in the loop and the match the retain with a release.
     ArrayCall.removeCall();
-  
+    ++NumLoopChecksHoisted;
+
     LLVM_DEBUG(llvm::dbgs() << "  Bounds check hoisted\n");
     Changed = true;
   }
@@ -1235,6 +1250,27 @@ static bool hoistBoundsChecks(SILLoop *Loop, DominanceInfo *DT, SILLoopInfo *LI,
   Changed |= hoistChecksInLoop(DT, DT->getNode(Header), ABC, IndVars,
                                Preheader, Header, SingleExitingBlk);
   if (Changed) {
+    // Record whether the loop body is now completely free of bounds checks.
+    // Only such loops have a chance to be vectorized after lowering, so this
+    // is the per-loop outcome to watch under -stats.
+    bool HasRemainingChecks = false;
+    for (auto *BB : Loop->getBlocks()) {
+      for (auto &Inst : *BB) {
+        ArraySemanticsCall Check(&Inst);
+        auto CheckKind = Check.getKind();
+        if (CheckKind == ArrayCallKind::kCheckSubscript ||
+            CheckKind == ArrayCallKind::kCheckIndex) {
+          HasRemainingChecks = true;
+          break;
+        }
+      }
+      if (HasRemainingChecks)
+        break;
+    }
+    if (!HasRemainingChecks) {
+      ++NumLoopsClearedOfChecks;
+      LLVM_DEBUG(llvm::dbgs() << "Loop is now free of bounds checks\n");
+    }
     Preheader->getParent()->verify();
   }
   return Changed;
@@ -12,6 +12,17 @@
 ///
 /// Optimize CoW array access by hoisting uniqueness checks.
 ///
+/// This pass is deliberately specific to Array: its safety analysis
+/// enumerates the exact set of @_semantics("array.*") operations and knows
+/// which of them may bridge to Cocoa, retain the buffer, or invalidate a
+/// hoisted make_mutable. Extending the same hoisting to Dictionary and Set
+/// is not a matter of annotating their ensureUnique entry points - their
+/// mutations funnel through the _Variant representation, whose native/cocoa
+/// dichotomy cannot be summarized by the semantics model used here. A
+/// container-agnostic version of this optimization needs uniqueness to be
+/// expressed directly in SIL (as dedicated CoW mutation instructions) rather
+/// than recovered from per-container call patterns.
+///
 //===----------------------------------------------------------------------===//
 
 #define DEBUG_TYPE "cowarray-opts"
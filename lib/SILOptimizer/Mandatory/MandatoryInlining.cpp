@@ -589,7 +589,8 @@ static SILFunction *
 getCalleeFunction(SILFunction *F, FullApplySite AI, bool &IsThick,
                   SmallVectorImpl<ParameterConvention> &CapturedArgConventions,
                   SmallVectorImpl<SILValue> &FullArgs,
-                  PartialApplyInst *&PartialApply) {
+                  PartialApplyInst *&PartialApply,
+                  DenseFunctionSet &UnloadableCallees) {
   IsThick = false;
   PartialApply = nullptr;
   CapturedArgConventions.clear();
@@ -729,13 +730,20 @@ getCalleeFunction(SILFunction *F, FullApplySite AI, bool &IsThick,
   if (CalleeFunction->isTransparent() == IsNotTransparent)
     return nullptr;
 
-  // If CalleeFunction is a declaration, see if we can load it.
-  if (CalleeFunction->empty())
+  // If CalleeFunction is a declaration, see if we can load it. Remember
+  // callees that fail to load so that other apply sites of the same function
+  // don't retry the deserialization.
+  if (CalleeFunction->empty()) {
+    if (UnloadableCallees.count(CalleeFunction))
+      return nullptr;
     AI.getModule().loadFunction(CalleeFunction);
 
-  // If we fail to load it, bail.
-  if (CalleeFunction->empty())
-    return nullptr;
+    // If we fail to load it, bail.
+    if (CalleeFunction->empty()) {
+      UnloadableCallees.insert(CalleeFunction);
+      return nullptr;
+    }
+  }
 
   if (F->isSerialized() &&
       !CalleeFunction->hasValidLinkageForFragileInline()) {
@@ -753,6 +761,14 @@ getCalleeFunction(SILFunction *F, FullApplySite AI, bool &IsThick,
 
 static SILInstruction *tryDevirtualizeApplyHelper(FullApplySite InnerAI,
                                                   ClassHierarchyAnalysis *CHA) {
+  // Only applies of witness_method, class_method and super_method callees can
+  // be devirtualized; skip the attempt for anything else - in particular the
+  // direct applies that dominate -Onone code - before doing any real work.
+  SILValue Callee = InnerAI.getCallee();
+  if (!isa<WitnessMethodInst>(Callee) && !isa<ClassMethodInst>(Callee) &&
+      !isa<SuperMethodInst>(Callee))
+    return InnerAI.getInstruction();
+
   auto NewInst = tryDevirtualizeApply(InnerAI, CHA).first;
   if (!NewInst)
     return InnerAI.getInstruction();
@@ -788,7 +804,8 @@ runOnFunctionRecursively(SILOptFunctionBuilder &FuncBuilder,
                          DenseFunctionSet &FullyInlinedSet,
                          ImmutableFunctionSet::Factory &SetFactory,
                          ImmutableFunctionSet CurrentInliningSet,
-                         ClassHierarchyAnalysis *CHA) {
+                         ClassHierarchyAnalysis *CHA,
+                         DenseFunctionSet &UnloadableCallees) {
   // Avoid reprocessing functions needlessly.
   if (FullyInlinedSet.count(F))
     return true;
@@ -846,8 +863,9 @@ runOnFunctionRecursively(SILOptFunctionBuilder &FuncBuilder,
       SILValue CalleeValue = InnerAI.getCallee();
       bool IsThick;
       PartialApplyInst *PAI;
-      SILFunction *CalleeFunction = getCalleeFunction(
-          F, InnerAI, IsThick, CapturedArgConventions, FullArgs, PAI);
+      SILFunction *CalleeFunction =
+          getCalleeFunction(F, InnerAI, IsThick, CapturedArgConventions,
+                            FullArgs, PAI, UnloadableCallees);
 
       if (!CalleeFunction)
         continue;
@@ -855,7 +873,8 @@ runOnFunctionRecursively(SILOptFunctionBuilder &FuncBuilder,
       // Then recursively process it first before trying to inline it.
       if (!runOnFunctionRecursively(FuncBuilder, CalleeFunction, InnerAI,
                                     FullyInlinedSet, SetFactory,
-                                    CurrentInliningSet, CHA)) {
+                                    CurrentInliningSet, CHA,
+                                    UnloadableCallees)) {
         // If we failed due to circular inlining, then emit some notes to
         // trace back the failure if we have more information.
         // FIXME: possibly it could be worth recovering and attempting other
@@ -976,6 +995,9 @@ class MandatoryInlining : public SILModuleTransform {
     bool SILVerifyAll = getOptions().VerifyAll;
     DenseFunctionSet FullyInlinedSet;
     ImmutableFunctionSet::Factory SetFactory;
+    // Transparent callee declarations that could not be deserialized, cached
+    // at module scope so each one is attempted at most once.
+    DenseFunctionSet UnloadableCallees;
 
     SILOptFunctionBuilder FuncBuilder(*this);
     for (auto &F : *M) {
@@ -989,7 +1011,8 @@ class MandatoryInlining : public SILModuleTransform {
 
       runOnFunctionRecursively(FuncBuilder, &F,
                                FullApplySite(), FullyInlinedSet, SetFactory,
-                               SetFactory.getEmptySet(), CHA);
+                               SetFactory.getEmptySet(), CHA,
+                               UnloadableCallees);
 
       // The inliner splits blocks at call sites. Re-merge trivial branches
       // to reestablish a canonical CFG.
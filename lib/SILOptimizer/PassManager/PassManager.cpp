@@ -13,7 +13,9 @@
 #define DEBUG_TYPE "sil-passmanager"
 
 #include "swift/SILOptimizer/PassManager/PassManager.h"
+#include "swift/AST/ASTContext.h"
 #include "swift/AST/SILOptimizerRequests.h"
+#include "swift/Basic/Statistic.h"
 #include "swift/Demangling/Demangle.h"
 #include "swift/SIL/ApplySite.h"
 #include "swift/SIL/SILFunction.h"
@@ -421,7 +423,14 @@ void SILPassManager::runPassOnFunction(unsigned TransIdx, SILFunction *F) {
   Mod->registerDeleteNotificationHandler(SFT);
   if (breakBeforeRunning(F->getName(), SFT))
     LLVM_BUILTIN_DEBUGTRAP;
-  SFT->run();
+  {
+    // Scope a stats tracer around the transform so that per-pass wall time
+    // and counter deltas show up in the -stats-output-dir and
+    // -trace-stats-events output, keyed by the pass tag and the function.
+    FrontendStatsTracer StatsTracer(Mod->getASTContext().Stats,
+                                    SFT->getTag(), F);
+    SFT->run();
+  }
   assert(analysesUnlocked() && "Expected all analyses to be unlocked!");
   Mod->removeDeleteNotificationHandler(SFT);
 
@@ -448,6 +457,9 @@ void SILPassManager::runPassOnFunction(unsigned TransIdx, SILFunction *F) {
       (CurrentPassHasInvalidated || SILVerifyWithoutInvalidation)) {
     F->verify();
     verifyAnalyses(F);
+    // The function was just verified; don't verify it again after the next
+    // module pass unless it changes again.
+    FunctionsChangedSinceLastVerify.erase(F);
   } else {
     if ((SILVerifyAfterPass.end() != std::find_if(SILVerifyAfterPass.begin(),
                                                   SILVerifyAfterPass.end(),
@@ -463,6 +475,13 @@ void SILPassManager::runPassOnFunction(unsigned TransIdx, SILFunction *F) {
   ++NumPassesRun;
 }
 
+// Note on parallelism: the bottom-up order admits running the pipeline
+// concurrently on functions in independent call-graph subtrees, but nearly
+// everything the passes touch is shared mutable state today: the analyses
+// (which have no locking), the SILModule's single instruction allocator and
+// free lists, type lowering's caches, and the ASTContext that gets hit
+// whenever a pass creates a type. Until those are made thread-safe, this
+// loop must stay sequential.
 void SILPassManager::
 runFunctionPasses(unsigned FromTransIdx, unsigned ToTransIdx) {
   if (ToTransIdx <= FromTransIdx)
@@ -568,7 +587,11 @@ void SILPassManager::runModulePass(unsigned TransIdx) {
   llvm::sys::TimePoint<> StartTime = std::chrono::system_clock::now();
   assert(analysesUnlocked() && "Expected all analyses to be unlocked!");
   Mod->registerDeleteNotificationHandler(SMT);
-  SMT->run();
+  {
+    // Trace module passes like function passes, just without an entity.
+    FrontendStatsTracer StatsTracer(Mod->getASTContext().Stats, SMT->getTag());
+    SMT->run();
+  }
   Mod->removeDeleteNotificationHandler(SMT);
   assert(analysesUnlocked() && "Expected all analyses to be unlocked!");
 
@@ -588,7 +611,7 @@ void SILPassManager::runModulePass(unsigned TransIdx) {
 
   if (Options.VerifyAll &&
       (CurrentPassHasInvalidated || !SILVerifyWithoutInvalidation)) {
-    Mod->verify();
+    verifyModuleChanges();
     verifyAnalyses();
   } else {
     if ((SILVerifyAfterPass.end() != std::find_if(SILVerifyAfterPass.begin(),
@@ -679,12 +702,29 @@ SILPassManager::~SILPassManager() {
 }
 
 void SILPassManager::notifyOfNewFunction(SILFunction *F, SILTransform *T) {
+  FunctionsChangedSinceLastVerify.insert(F);
   if (doPrintAfter(T, F, SILPrintAll)) {
     dumpPassInfo("*** New SIL function in ", T, F);
     F->dump(getOptions().EmitVerboseSIL);
   }
 }
 
+void SILPassManager::verifyModuleChanges() {
+  // Changes to witness- or vtables, function deletions and wholesale
+  // invalidations cannot be pinned to individual functions; fall back to
+  // verifying the whole module for those. Otherwise it suffices to verify
+  // the functions which actually changed since the last verification, which
+  // makes -sil-verify-all affordable on large modules.
+  if (WholeModuleChangedSinceLastVerify || SILVerifyWithoutInvalidation) {
+    Mod->verify();
+  } else {
+    for (SILFunction *F : FunctionsChangedSinceLastVerify)
+      F->verify();
+  }
+  WholeModuleChangedSinceLastVerify = false;
+  FunctionsChangedSinceLastVerify.clear();
+}
+
 void SILPassManager::addFunctionToWorklist(SILFunction *F,
                                            SILFunction *DerivedFrom) {
   assert(F && F->isDefinition() && (isMandatory || F->shouldOptimize()) &&
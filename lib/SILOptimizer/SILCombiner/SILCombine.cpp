@@ -40,6 +40,7 @@ using namespace swift;
 
 STATISTIC(NumCombined, "Number of instructions combined");
 STATISTIC(NumDeadInst, "Number of dead insts eliminated");
+STATISTIC(NumCombineIterations, "Number of iterations to reach the fixpoint");
 
 //===----------------------------------------------------------------------===//
 //                              Utility Methods
@@ -146,11 +147,20 @@ public:
 
 bool SILCombiner::doOneIteration(SILFunction &F, unsigned Iteration) {
   MadeChange = false;
+  ++NumCombineIterations;
 
   LLVM_DEBUG(llvm::dbgs() << "\n\nSILCOMBINE ITERATION #" << Iteration << " on "
                           << F.getName() << "\n");
 
   // Add reachable instructions to our worklist.
+  //
+  // Within one iteration the worklist already propagates changes precisely:
+  // the builder's tracking list, the canonicalizer callbacks and
+  // replaceInstructionWithInstruction re-enqueue exactly the def-use
+  // neighborhood of every rewrite. The full re-seed here is the safety net
+  // for visitors which mutate the function without notifying the worklist;
+  // every re-seed beyond the second iteration means some visitor did so and
+  // shows up in the iteration count statistic.
   addReachableCodeToWorklist(&*F.begin());
 
   SILCombineCanonicalize scCanonicalize(Worklist);
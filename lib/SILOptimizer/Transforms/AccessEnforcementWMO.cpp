@@ -60,12 +60,16 @@
 #include "swift/SIL/SILFunction.h"
 #include "swift/SILOptimizer/PassManager/Transforms.h"
 #include "swift/SILOptimizer/Utils/InstOptUtils.h"
+#include "llvm/ADT/Statistic.h"
 
 using namespace swift;
 
 using llvm::DenseMap;
 using llvm::SmallDenseSet;
 
+STATISTIC(NumAccessesDemotedToStatic,
+          "Number of dynamic accesses demoted to static enforcement");
+
 // Get the VarDecl that represents the DisjointAccessLocation for the given
 // AccessedStorage. Returns nullptr for any storage that can't be partitioned
 // into a disjoint location.
@@ -264,6 +268,7 @@ void GlobalAccessRemoval::removeNonreentrantAccess() {
     for (BeginAccessInst *beginAccess : info.beginAccessSet) {
       LLVM_DEBUG(llvm::dbgs() << "  Disabling access marker " << *beginAccess);
       beginAccess->setEnforcement(SILAccessEnforcement::Static);
+      ++NumAccessesDemotedToStatic;
     }
   }
 }
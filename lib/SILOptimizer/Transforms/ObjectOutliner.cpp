@@ -26,13 +26,15 @@ namespace {
 class ObjectOutliner {
   SILOptFunctionBuilder &FunctionBuilder;
   NominalTypeDecl *ArrayDecl = nullptr;
+  NominalTypeDecl *ContiguousArrayDecl = nullptr;
   int GlobIdx = 0;
 
   // Instructions to be deleted.
   llvm::SmallVector<SILInstruction *, 4> ToRemove;
 
   bool isCOWType(SILType type) {
-    return type.getNominalOrBoundGenericNominal() == ArrayDecl;
+    auto *nominal = type.getNominalOrBoundGenericNominal();
+    return nominal == ArrayDecl || nominal == ContiguousArrayDecl;
   }
 
   bool isValidUseOfObject(SILInstruction *Val,
@@ -52,8 +54,10 @@ class ObjectOutliner {
 
 public:
   ObjectOutliner(SILOptFunctionBuilder &FunctionBuilder,
-                 NominalTypeDecl *ArrayDecl)
-      : FunctionBuilder(FunctionBuilder), ArrayDecl(ArrayDecl) { }
+                 NominalTypeDecl *ArrayDecl,
+                 NominalTypeDecl *ContiguousArrayDecl)
+      : FunctionBuilder(FunctionBuilder), ArrayDecl(ArrayDecl),
+        ContiguousArrayDecl(ContiguousArrayDecl) { }
 
   bool run(SILFunction *F);
 };
@@ -118,7 +122,7 @@ static bool isValidInitVal(SILValue V) {
 /// Check if a use of an object may prevent outlining the object.
 ///
 /// If \p isCOWObject is true, then the object reference is wrapped into a
-/// COW container. Currently this is just Array<T>.
+/// COW container. Currently this is Array<T> or ContiguousArray<T>.
 /// If a use is a call to the findStringSwitchCase semantic call, the apply
 /// is returned in \p FindStringCall.
 bool ObjectOutliner::isValidUseOfObject(SILInstruction *I, bool isCOWObject,
@@ -560,8 +564,9 @@ class ObjectOutlinerPass : public SILFunctionTransform {
   void run() override {
     SILFunction *F = getFunction();
     SILOptFunctionBuilder FuncBuilder(*this);
-    ObjectOutliner Outliner(FuncBuilder,
-                            F->getModule().getASTContext().getArrayDecl());
+    auto &ctx = F->getModule().getASTContext();
+    ObjectOutliner Outliner(FuncBuilder, ctx.getArrayDecl(),
+                            ctx.getContiguousArrayDecl());
     if (Outliner.run(F)) {
       invalidateAnalysis(SILAnalysis::InvalidationKind::Instructions);
     }
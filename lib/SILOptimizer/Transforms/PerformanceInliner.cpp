@@ -162,14 +162,9 @@ class SILPerformanceInliner {
     return SPA;
   }
 
-  bool profileBasedDecision(
-      const FullApplySite &AI, int Benefit, SILFunction *Callee, int CalleeCost,
-      int &NumCallerBlocks,
-      const llvm::DenseMapIterator<
-          swift::SILBasicBlock *, uint64_t,
-          llvm::DenseMapInfo<swift::SILBasicBlock *>,
-          llvm::detail::DenseMapPair<swift::SILBasicBlock *, uint64_t>, true>
-          &bbIt);
+  bool profileBasedDecision(FullApplySite AI, int Benefit, SILFunction *Callee,
+                            int CalleeCost, uint64_t callerCount,
+                            int &NumCallerBlocks);
 
   bool isProfitableToInline(
       FullApplySite AI, Weight CallerWeight, ConstantTracker &callerTracker,
@@ -209,19 +204,15 @@ static bool canSpecializeGeneric(ApplySite AI, SILFunction *F,
   return ReabstractionInfo::canBeSpecialized(AI, F, Subs);
 }
 
-bool SILPerformanceInliner::profileBasedDecision(
-    const FullApplySite &AI, int Benefit, SILFunction *Callee, int CalleeCost,
-    int &NumCallerBlocks,
-    const llvm::DenseMapIterator<
-        swift::SILBasicBlock *, uint64_t,
-        llvm::DenseMapInfo<swift::SILBasicBlock *>,
-        llvm::detail::DenseMapPair<swift::SILBasicBlock *, uint64_t>, true>
-        &bbIt) {
+bool SILPerformanceInliner::profileBasedDecision(FullApplySite AI, int Benefit,
+                                                 SILFunction *Callee,
+                                                 int CalleeCost,
+                                                 uint64_t callerCount,
+                                                 int &NumCallerBlocks) {
   if (CalleeCost < TrivialFunctionThreshold) {
     // We do not increase code size below this threshold
     return true;
   }
-  auto callerCount = bbIt->getSecond();
   if (callerCount < 1) {
     // Never called - do not inline
     LLVM_DEBUG(dumpCaller(AI.getFunction());
@@ -491,7 +482,7 @@ bool SILPerformanceInliner::isProfitableToInline(
   auto bbIt = BBToWeightMap.find(bb);
   if (bbIt != BBToWeightMap.end()) {
     return profileBasedDecision(AI, Benefit, Callee, CalleeCost,
-                                NumCallerBlocks, bbIt);
+                                bbIt->getSecond(), NumCallerBlocks);
   }
   if (isClassMethodAtOsize && Benefit > OSizeClassMethodBenefit) {
     Benefit = OSizeClassMethodBenefit;
@@ -32,6 +32,7 @@
 #include "swift/SILOptimizer/Utils/SILInliner.h"
 #include "swift/SILOptimizer/Utils/SILOptFunctionBuilder.h"
 #include "swift/SILOptimizer/Utils/SILSSAUpdater.h"
+#include "llvm/ADT/SetVector.h"
 #include "llvm/ADT/SmallPtrSet.h"
 #include "llvm/ADT/SmallVector.h"
 #include "llvm/ADT/Statistic.h"
@@ -44,6 +45,8 @@ STATISTIC(NumBlocksMerged, "Number of blocks merged together");
 STATISTIC(NumJumpThreads, "Number of jumps threaded");
 STATISTIC(NumTermBlockSimplified, "Number of programterm block simplified");
 STATISTIC(NumConstantFolded, "Number of terminators constant folded");
+STATISTIC(NumDomSimplifyIterations,
+          "Number of iterations of dominator-based simplification");
 STATISTIC(NumDeadArguments, "Number of unused arguments removed");
 STATISTIC(NumSROAArguments, "Number of aggregate argument levels split by "
                             "SROA");
@@ -168,9 +171,11 @@ namespace {
 
     bool simplifyBlocks();
     bool canonicalizeSwitchEnums();
-    bool simplifyThreadedTerminators();
-    bool dominatorBasedSimplifications(SILFunction &Fn,
-                                       DominanceInfo *DT);
+    bool simplifyThreadedTerminators(
+        const llvm::SmallSetVector<SILBasicBlock *, 16> &FoldableTermBlocks);
+    bool dominatorBasedSimplifications(
+        SILFunction &Fn, DominanceInfo *DT,
+        llvm::SmallSetVector<SILBasicBlock *, 16> &FoldableTermBlocks);
     bool dominatorBasedSimplify(DominanceAnalysis *DA);
 
     /// Remove the basic block if it has no predecessors. Returns true
@@ -399,7 +404,8 @@ static bool tryDominatorBasedSimplifications(
     llvm::DenseSet<std::pair<SILBasicBlock *, SILBasicBlock *>>
         &ThreadedEdgeSet,
     bool TryJumpThreading,
-    llvm::DenseMap<SILBasicBlock *, bool> &CachedThreadable) {
+    llvm::DenseMap<SILBasicBlock *, bool> &CachedThreadable,
+    llvm::SmallSetVector<SILBasicBlock *, 16> &FoldableTermBlocks) {
   auto *DominatingTerminator = DominatingBB->getTerminator();
 
   // We handle value propagation from cond_br and switch_enum terminators.
@@ -527,6 +533,10 @@ static bool tryDominatorBasedSimplifications(
             EdgeValue = createValueForEdge(UserInst, DominatingTerminator, Idx);
           Op.set(EdgeValue);
           Changed = true;
+          // If we rewrote a terminator condition to a constant, remember its
+          // block so that only those terminators get re-simplified afterwards.
+          if (UserInst == UserInst->getParent()->getTerminator())
+            FoldableTermBlocks.insert(UserInst->getParent());
         }
       }
     }
@@ -536,8 +546,9 @@ static bool tryDominatorBasedSimplifications(
 
 /// Propagate values of branched upon values along the outgoing edges down the
 /// dominator tree.
-bool SimplifyCFG::dominatorBasedSimplifications(SILFunction &Fn,
-                                                DominanceInfo *DT) {
+bool SimplifyCFG::dominatorBasedSimplifications(
+    SILFunction &Fn, DominanceInfo *DT,
+    llvm::SmallSetVector<SILBasicBlock *, 16> &FoldableTermBlocks) {
   bool Changed = false;
   // Collect jump threadable edges and propagate outgoing edge values of
   // conditional branches/switches.
@@ -548,7 +559,7 @@ bool SimplifyCFG::dominatorBasedSimplifications(SILFunction &Fn,
     if (DT->getNode(&BB)) // Only handle reachable blocks.
       Changed |= tryDominatorBasedSimplifications(
           &BB, DT, LoopHeaders, JumpThreadableEdges, ThreadedEdgeSet,
-          EnableJumpThread, CachedThreadable);
+          EnableJumpThread, CachedThreadable, FoldableTermBlocks);
 
   // Nothing to jump thread?
   if (JumpThreadableEdges.empty())
@@ -563,9 +574,15 @@ bool SimplifyCFG::dominatorBasedSimplifications(SILFunction &Fn,
 }
 
 /// Simplify terminators that could have been simplified by threading.
-bool SimplifyCFG::simplifyThreadedTerminators() {
+///
+/// Only the blocks whose terminator condition was rewritten to a constant are
+/// visited; anything this misses is picked up by the worklist-driven
+/// simplifyBlocks afterwards.
+bool SimplifyCFG::simplifyThreadedTerminators(
+    const llvm::SmallSetVector<SILBasicBlock *, 16> &FoldableTermBlocks) {
   bool HaveChangedCFG = false;
-  for (auto &BB : Fn) {
+  for (SILBasicBlock *BlockWithFoldableTerm : FoldableTermBlocks) {
+    auto &BB = *BlockWithFoldableTerm;
     auto *Term = BB.getTerminator();
     // Simplify a switch_enum.
     if (auto *SEI = dyn_cast<SwitchEnumInst>(Term)) {
@@ -625,6 +642,7 @@ bool SimplifyCFG::dominatorBasedSimplify(DominanceAnalysis *DA) {
   bool HasChangedInCurrentIter;
   do {
     HasChangedInCurrentIter = false;
+    NumDomSimplifyIterations++;
 
     // Do dominator based simplification of terminator condition. This does not
     // and MUST NOT change the CFG without updating the dominator tree to
@@ -653,12 +671,13 @@ bool SimplifyCFG::dominatorBasedSimplify(DominanceAnalysis *DA) {
       DT->verify();
 
     // Jump thread.
-    if (dominatorBasedSimplifications(Fn, DT)) {
+    llvm::SmallSetVector<SILBasicBlock *, 16> FoldableTermBlocks;
+    if (dominatorBasedSimplifications(Fn, DT, FoldableTermBlocks)) {
       DominanceInfo *InvalidDT = DT;
       DT = nullptr;
       HasChangedInCurrentIter = true;
-      // Simplify terminators.
-      simplifyThreadedTerminators();
+      // Simplify the terminators whose conditions became constant.
+      simplifyThreadedTerminators(FoldableTermBlocks);
       DT = InvalidDT;
       DT->recalculate(Fn);
     }
@@ -39,6 +39,9 @@ STATISTIC(NumPreventedTooComplexGenericSpecializations,
           "# of prevented generic specializations with too complex "
           "generic type parameters");
 
+STATISTIC(NumReusedGenericSpecializations,
+          "# of apply sites which reused an existing generic specialization");
+
 /// Set to true to enable the support for partial specialization.
 llvm::cl::opt<bool> EnablePartialSpecialization(
     "sil-partial-specialization", llvm::cl::init(false),
@@ -1812,6 +1815,12 @@ GenericFuncSpecializer::GenericFuncSpecializer(
 }
 
 /// Return an existing specialization if one exists.
+///
+/// The module's function table, keyed by the mangled specialization name,
+/// serves as the module-wide index of specializations: the mangled name
+/// encodes the generic function and the (canonicalized) substitutions, so an
+/// identical specialization requested from any caller - including one
+/// deserialized from another module - is found here and never re-cloned.
 SILFunction *GenericFuncSpecializer::lookupSpecialization() {
   if (SILFunction *SpecializedF = M.lookUpFunction(ClonedName)) {
     if (ReInfo.getSpecializedType() != SpecializedF->getLoweredFunctionType()) {
@@ -1825,6 +1834,7 @@ SILFunction *GenericFuncSpecializer::lookupSpecialization() {
            "Previously specialized function does not match expected type.");
     LLVM_DEBUG(llvm::dbgs() << "Found an existing specialization for: "
                             << ClonedName << "\n");
+    NumReusedGenericSpecializations++;
     return SpecializedF;
   }
   LLVM_DEBUG(llvm::dbgs() << "Could not find an existing specialization for: "
@@ -2359,6 +2369,12 @@ void swift::trySpecializeApplyOfGeneric(
     Serialized = IsNotSerialized;
   }
 
+  // Note that the ReabstractionInfo is computed per apply site even if an
+  // identical specialization already exists in the module: its legality checks
+  // are caller-sensitive (infinite specialization loop detection walks the
+  // apply's specialization history) and its parameter conversions are needed
+  // below to rewrite this particular call site. Only the expensive part - the
+  // cloning of the callee - is shared, via lookupSpecialization.
   ReabstractionInfo ReInfo(FuncBuilder.getModule().getSwiftModule(),
                            FuncBuilder.getModule().isWholeModule(), Apply, RefF,
                            Apply.getSubstitutionMap(), Serialized,
@@ -50,7 +50,6 @@ class BuilderClosureVisitor
   Type builderType;
   NominalTypeDecl *builder = nullptr;
   Identifier buildOptionalId;
-  llvm::SmallDenseMap<Identifier, bool> supportedOps;
 
   SkipUnhandledConstructInFunctionBuilder::UnhandledNode unhandledNode;
 
@@ -109,9 +108,16 @@ class BuilderClosureVisitor
   /// Check whether the builder supports the given operation.
   bool builderSupports(Identifier fnName,
                        ArrayRef<Identifier> argLabels = {}) {
-    auto known = supportedOps.find(fnName);
-    if (known != supportedOps.end()) {
-      return known->second;
+    // Consult the ASTContext-wide cache first; the same few builder types
+    // tend to be applied throughout a module, so most applications can
+    // skip the lookup entirely. The answer can only change when a newly
+    // loaded module extends the builder, so entries from an older module
+    // load generation are recomputed.
+    auto key = std::make_pair(builder, fnName);
+    auto known = ctx.FunctionBuilderSupportedOps.find(key);
+    if (known != ctx.FunctionBuilderSupportedOps.end() &&
+        known->second.second == ctx.getCurrentGeneration()) {
+      return known->second.first;
     }
 
     bool found = false;
@@ -135,7 +141,8 @@ class BuilderClosureVisitor
       }
     }
 
-    return supportedOps[fnName] = found;
+    ctx.FunctionBuilderSupportedOps[key] = {found, ctx.getCurrentGeneration()};
+    return found;
   }
 
   /// Build an implicit variable in this context.
@@ -4074,6 +4074,27 @@ ConstraintSystem::matchTypes(Type type1, Type type2, ConstraintKind kind,
     }
   }
 
+  // For equality matches between types that contain no type variables, the
+  // result depends only on the types themselves, so consult the cache of
+  // matches this solver invocation has already proven impossible. Conversion
+  // kinds are not cached because the legality of some conversions depends on
+  // the locator, and matches involving type variables are not cached because
+  // their results change as variables are bound.
+  Optional<SolverState::TypeMatchFailureKey> failureCacheKey;
+  if (solverState && !shouldAttemptFixes() &&
+      (kind == ConstraintKind::Bind || kind == ConstraintKind::Equal) &&
+      !desugar1->hasTypeVariable() && !desugar2->hasTypeVariable() &&
+      !desugar1->hasUnresolvedType() && !desugar2->hasUnresolvedType()) {
+    failureCacheKey = std::make_pair(
+        std::make_pair(desugar1->getCanonicalType(),
+                       desugar2->getCanonicalType()),
+        std::make_pair(unsigned(kind), flags.toRaw()));
+    if (solverState->FailedTypeMatches.count(*failureCacheKey)) {
+      ++solverState->NumTypeMatchFailureCacheHits;
+      return getTypeMatchFailure(locator);
+    }
+  }
+
   // Local function that should be used to produce the return value whenever
   // this function was unable to resolve the constraint. It should be used
   // within \c matchTypes() as
@@ -4880,8 +4901,13 @@ ConstraintSystem::matchTypes(Type type1, Type type2, ConstraintKind kind,
     }
   }
 
-  if (conversionsOrFixes.empty())
+  if (conversionsOrFixes.empty()) {
+    // Remember that this pair of types can never match, so that repeated
+    // attempts during the solve are answered without re-walking them.
+    if (failureCacheKey)
+      solverState->FailedTypeMatches.insert(*failureCacheKey);
     return getTypeMatchFailure(locator);
+  }
 
   // Where there is more than one potential conversion, create a disjunction
   // so that we'll explore all of the options.
@@ -4933,6 +4959,10 @@ ConstraintSystem::matchTypes(Type type1, Type type2, ConstraintKind kind,
   auto formTypeMatchResult = [&](SolutionKind kind) {
     switch (kind) {
       case SolutionKind::Error:
+        // This covers the deep-equality case, where the failure was found
+        // by recursing into the component types.
+        if (failureCacheKey)
+          solverState->FailedTypeMatches.insert(*failureCacheKey);
         return getTypeMatchFailure(locator);
 
       case SolutionKind::Solved:
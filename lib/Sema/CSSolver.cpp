@@ -22,6 +22,7 @@
 #include "swift/AST/TypeWalker.h"
 #include "llvm/ADT/STLExtras.h"
 #include "llvm/ADT/SetVector.h"
+#include "llvm/ADT/SmallString.h"
 #include "llvm/ADT/Statistic.h"
 #include "llvm/Support/Compiler.h"
 #include "llvm/Support/SaveAndRestore.h"
@@ -479,6 +480,7 @@ ConstraintSystem::SolverScope::SolverScope(ConstraintSystem &cs)
   numCaseLabelItems = cs.caseLabelItems.size();
 
   PreviousScore = cs.CurrentScore;
+  arenaWatermark = cs.ConstraintArena.getWatermark();
 
   cs.solverState->registerScope(this);
   assert(!cs.failedConstraint && "Unexpected failed constraint!");
@@ -565,6 +567,10 @@ ConstraintSystem::SolverScope::~SolverScope() {
 
   // Clear out other "failed" state.
   cs.failedConstraint = nullptr;
+
+  // All constraints created within this scope have been unlinked above, so
+  // their memory can be handed back to the solver arena in bulk.
+  cs.ConstraintArena.resetToWatermark(arenaWatermark);
 }
 
 /// Solve the system of constraints.
@@ -1165,13 +1171,20 @@ Optional<std::vector<Solution>> ConstraintSystem::solve(
     }
   };
 
+  // If the primary attempt fails with an ambiguity we cannot accept, hold
+  // on to its solutions so that salvaging can diagnose directly from them
+  // instead of solving the system a second time.
+  Optional<SolutionResult> ambiguousPrimary;
+
   // Take up to two attempts at solving the system. The first attempts to
   // solve a system that is expected to be well-formed, the second kicks in
   // when there is an error and attempts to salvage an ill-formed program.
   for (unsigned stage = 0; stage != 2; ++stage) {
     auto solution = (stage == 0)
         ? solveImpl(target, allowFreeTypeVariables)
-        : salvage();
+        : salvage(ambiguousPrimary
+                      ? std::move(*ambiguousPrimary).takeAmbiguousSolutions()
+                      : MutableArrayRef<Solution>());
 
     switch (solution.getKind()) {
     case SolutionResult::Success: {
@@ -1211,6 +1224,15 @@ Optional<std::vector<Solution>> ConstraintSystem::solve(
         return std::move(result);
       }
 
+      // These solutions are exactly what the salvage attempt would
+      // rediscover, since it also disallows free type variables; keep them
+      // around so it can diagnose the ambiguity without re-solving.
+      if (!shouldSuppressDiagnostics() &&
+          allowFreeTypeVariables == FreeTypeVariableBinding::Disallow) {
+        ambiguousPrimary.emplace(std::move(solution));
+        continue;
+      }
+
       LLVM_FALLTHROUGH;
 
     case SolutionResult::UndiagnosedError:
@@ -1893,6 +1915,150 @@ Constraint *ConstraintSystem::selectApplyDisjunction() {
   return nullptr;
 }
 
+namespace {
+/// A binary operator application whose operand types have already been
+/// resolved, which makes it eligible for lookups in the solver's operator
+/// memo and overload profile.
+struct ResolvedBinaryOperator {
+  BinaryExpr *apply;
+  Identifier opName;
+  CanType lhsTy;
+  CanType rhsTy;
+};
+} // end anonymous namespace
+
+/// If the given operator disjunction applies a binary operator whose operand
+/// types are fully resolved already, describe that application. Both the memo
+/// and the overload profile are keyed on exact types, so unresolved operands
+/// mean there is nothing to look up.
+static Optional<ResolvedBinaryOperator>
+resolveBinaryOperatorShape(ConstraintSystem &cs,
+                           ArrayRef<Constraint *> choices) {
+  auto *anchor = choices.front()->getLocator()->getAnchor();
+  if (!anchor)
+    return None;
+
+  auto *apply = dyn_cast_or_null<BinaryExpr>(cs.getParentExpr(anchor));
+  if (!apply)
+    return None;
+
+  auto *argTuple = dyn_cast<TupleExpr>(apply->getArg());
+  if (!argTuple || argTuple->getNumElements() != 2)
+    return None;
+
+  auto getResolvedType = [&](Expr *arg) -> CanType {
+    auto ty = cs.simplifyType(cs.getType(arg));
+    if (ty->hasTypeVariable() || ty->hasError())
+      return CanType();
+    return ty->getCanonicalType();
+  };
+
+  auto lhsTy = getResolvedType(argTuple->getElement(0));
+  auto rhsTy = getResolvedType(argTuple->getElement(1));
+  if (!lhsTy || !rhsTy)
+    return None;
+
+  auto opName = choices.front()->getOverloadChoice().getDecl()->getBaseName();
+  if (opName.isSpecial())
+    return None;
+
+  return ResolvedBinaryOperator{apply, opName.getIdentifier(), lhsTy, rhsTy};
+}
+
+std::string constraints::getOperatorOverloadProfileKey(Identifier opName,
+                                                       CanType lhsTy,
+                                                       CanType rhsTy,
+                                                       ValueDecl *choice) {
+  llvm::SmallString<128> key;
+  llvm::raw_svector_ostream os(key);
+  os << opName.str() << '|' << lhsTy.getString() << '|' << rhsTy.getString()
+     << '|' << choice->getModuleContext()->getName().str() << '.'
+     << choice->getInterfaceType().getString();
+  return os.str().str();
+}
+
+/// Find the choice in an operator disjunction that a previously solved
+/// expression with the same operator, operand types and contextual type
+/// ended up using, consulting the per-frontend memo on the ASTContext.
+///
+/// Returns null if the operand types are not fully resolved yet or no
+/// expression with this shape has been solved before.
+static Constraint *
+findPreviouslySolvedOperatorChoice(ConstraintSystem &cs,
+                                   ArrayRef<Constraint *> choices) {
+  auto resolved = resolveBinaryOperatorShape(cs, choices);
+  if (!resolved)
+    return nullptr;
+
+  CanType contextualTy;
+  if (auto ty = cs.getContextualType(resolved->apply)) {
+    if (ty->hasTypeVariable())
+      return nullptr;
+    contextualTy = ty->getCanonicalType();
+  }
+
+  auto &ctx = cs.getASTContext();
+  if (auto *stats = ctx.Stats)
+    stats->getFrontendCounters().NumOperatorOverloadMemoLookups++;
+
+  auto *known = ctx.getSolvedBinaryOperatorOverload(
+      resolved->opName, resolved->lhsTy, resolved->rhsTy, contextualTy);
+  if (!known)
+    return nullptr;
+
+  for (auto *choice : choices) {
+    if (choice->isDisabled() ||
+        choice->getKind() != ConstraintKind::BindOverload)
+      continue;
+
+    if (choice->getOverloadChoice().getDeclOrNull() == known) {
+      if (auto *stats = ctx.Stats)
+        stats->getFrontendCounters().NumOperatorOverloadMemoHits++;
+      return choice;
+    }
+  }
+  return nullptr;
+}
+
+/// Reorder the remaining choices of an operator disjunction so that the
+/// overloads that succeeded most often for the same operator and operand
+/// types in previous builds come first, consulting the profile persisted
+/// via -solver-overload-profile-path.
+static void sortByRecordedOverloadSuccesses(ConstraintSystem &cs,
+                                            ArrayRef<Constraint *> choices,
+                                            SmallVectorImpl<unsigned> &indices) {
+  auto resolved = resolveBinaryOperatorShape(cs, choices);
+  if (!resolved)
+    return;
+
+  auto &ctx = cs.getASTContext();
+
+  llvm::SmallDenseMap<unsigned, unsigned, 8> successCounts;
+  for (auto index : indices) {
+    auto *constraint = choices[index];
+    if (constraint->getKind() != ConstraintKind::BindOverload)
+      continue;
+
+    auto *decl = constraint->getOverloadChoice().getDeclOrNull();
+    if (!decl)
+      continue;
+
+    auto key = getOperatorOverloadProfileKey(resolved->opName, resolved->lhsTy,
+                                             resolved->rhsTy, decl);
+    if (auto count = ctx.getOperatorOverloadSuccessCount(key))
+      successCounts[index] = count;
+  }
+
+  if (successCounts.empty())
+    return;
+
+  std::stable_sort(indices.begin(), indices.end(),
+                   [&](unsigned lhsIndex, unsigned rhsIndex) {
+                     return successCounts.lookup(lhsIndex) >
+                            successCounts.lookup(rhsIndex);
+                   });
+}
+
 static bool isOperatorBindOverload(Constraint *bindOverload) {
   if (bindOverload->getKind() != ConstraintKind::BindOverload)
     return false;
@@ -2146,6 +2312,14 @@ void ConstraintSystem::partitionDisjunction(
     favorConstraint(favored);
   }
 
+  // If a previously solved expression already picked an overload for the
+  // same operator, operand types and contextual type, try that choice first.
+  if (isOperatorBindOverload(Choices[0])) {
+    if (auto *memoized = findPreviouslySolvedOperatorChoice(*this, Choices)) {
+      favorConstraint(memoized);
+    }
+  }
+
   SmallSet<Constraint *, 16> taken;
 
   // Local function used to iterate over the untaken choices from the
@@ -2243,6 +2417,13 @@ void ConstraintSystem::partitionDisjunction(
     everythingElse.push_back(index);
     return true;
   });
+  // If a recorded overload profile is available, try the historically
+  // successful choices for this operator and operand types first.
+  if (!getASTContext().TypeCheckerOpts.SolverOverloadProfilePath.empty() &&
+      isOperatorBindOverload(Choices[0])) {
+    sortByRecordedOverloadSuccesses(*this, Choices, everythingElse);
+  }
+
   appendPartition(favored);
   appendPartition(everythingElse);
   appendPartition(simdOperators);
@@ -854,5 +854,8 @@ Constraint *Constraint::createDisjunction(ConstraintSystem &cs,
 
 void *Constraint::operator new(size_t bytes, ConstraintSystem& cs,
                                size_t alignment) {
-  return ::operator new (bytes, cs, alignment);
+  // Constraints created while the solver is active never outlive the solver
+  // scope they were created in, so they are carved out of the scope-reclaimed
+  // solver arena rather than the constraint system's main allocator.
+  return cs.allocateConstraintMemory(bytes, alignment);
 }
@@ -70,7 +70,8 @@ ExpressionTimer::~ExpressionTimer() {
 ConstraintSystem::ConstraintSystem(DeclContext *dc,
                                    ConstraintSystemOptions options)
   : Context(dc->getASTContext()), DC(dc), Options(options),
-    Arena(dc->getASTContext(), Allocator),
+    Allocator(dc->getASTContext()),
+    Arena(dc->getASTContext(), Allocator.get()),
     CG(*new ConstraintGraph(*this))
 {
   assert(DC && "context required");
@@ -997,7 +998,7 @@ void ConstraintSystem::recordOpenedTypes(
 #endif
 
   OpenedType* openedTypes
-    = Allocator.Allocate<OpenedType>(replacements.size());
+    = getAllocator().Allocate<OpenedType>(replacements.size());
   std::copy(replacements.begin(), replacements.end(), openedTypes);
   OpenedTypes.push_back({ locatorPtr,
     llvm::makeArrayRef(openedTypes,
@@ -2562,7 +2563,8 @@ bool OverloadChoice::isImplicitlyUnwrappedValueOrReturnValue() const {
   llvm_unreachable("unhandled kind");
 }
 
-SolutionResult ConstraintSystem::salvage() {
+SolutionResult ConstraintSystem::salvage(
+    MutableArrayRef<Solution> primarySolutions) {
   auto &ctx = getASTContext();
   if (ctx.TypeCheckerOpts.DebugConstraintSolver) {
     auto &log = ctx.TypeCheckerDebug->getStream();
@@ -2584,8 +2586,26 @@ SolutionResult ConstraintSystem::salvage() {
     SolverState state(*this, FreeTypeVariableBinding::Disallow);
     state.recordFixes = true;
 
-    // Solve the system.
-    solveImpl(viable);
+    // If the primary attempt already produced a set of competing solutions
+    // none of which involve fixes, a second solve could only rediscover
+    // them: any solution that requires a fix scores strictly worse than a
+    // fix-free one. Diagnose the ambiguity from the solutions we have
+    // instead of paying for the re-solve.
+    if (!primarySolutions.empty() &&
+        llvm::all_of(primarySolutions, [](const Solution &solution) {
+          return solution.Fixes.empty();
+        })) {
+      for (auto &solution : primarySolutions) {
+        auto score = solution.getFixedScore();
+        if (!state.BestScore || score < *state.BestScore)
+          state.BestScore = score;
+
+        viable.push_back(std::move(solution));
+      }
+    } else {
+      // Solve the system.
+      solveImpl(viable);
+    }
 
     // Check whether we have a best solution; this can happen if we found
     // a series of fixes that worked.
@@ -34,6 +34,7 @@
 #include "swift/Basic/Debug.h"
 #include "swift/Basic/LLVM.h"
 #include "swift/Basic/OptionSet.h"
+#include "llvm/ADT/DenseSet.h"
 #include "llvm/ADT/PointerUnion.h"
 #include "llvm/ADT/STLExtras.h"
 #include "llvm/ADT/SetOperations.h"
@@ -1579,6 +1580,78 @@ enum class ConstraintSystemPhase {
   Finalization
 };
 
+/// A bump allocator for objects whose lifetime is bounded by a solver scope.
+///
+/// Allocations are made in exploration order and reclaimed in bulk by
+/// resetting the arena to the watermark taken when the enclosing solver
+/// scope was created, so backtracking out of a failed branch reuses its
+/// memory instead of permanently growing the constraint system's allocator.
+/// Slabs are retained across resets for reuse.
+class SolverArena {
+  /// The slabs of memory that have been allocated so far.
+  SmallVector<char *, 8> Slabs;
+
+  /// The slab currently being allocated from.
+  unsigned CurSlab = 0;
+
+  /// The offset of the next free byte in the current slab.
+  size_t CurOffset = 0;
+
+  /// Fallback for allocations too large for a slab; these are rare and are
+  /// not reclaimed until the arena is destroyed.
+  llvm::BumpPtrAllocator LargeAllocations;
+
+  static const size_t SlabSize = 64 * 1024;
+
+public:
+  /// An allocation point that the arena can later be reset to.
+  struct Watermark {
+    unsigned Slab = 0;
+    size_t Offset = 0;
+  };
+
+  SolverArena() = default;
+  SolverArena(const SolverArena &) = delete;
+  SolverArena &operator=(const SolverArena &) = delete;
+
+  ~SolverArena() {
+    for (char *slab : Slabs)
+      delete[] slab;
+  }
+
+  Watermark getWatermark() const { return {CurSlab, CurOffset}; }
+
+  /// Reclaim all memory allocated since \p mark was taken. The caller must
+  /// guarantee that none of the objects allocated since then are referenced
+  /// again.
+  void resetToWatermark(Watermark mark) {
+    assert(mark.Slab < CurSlab ||
+           (mark.Slab == CurSlab && mark.Offset <= CurOffset));
+    CurSlab = mark.Slab;
+    CurOffset = mark.Offset;
+  }
+
+  void *allocate(size_t bytes, size_t alignment) {
+    if (bytes + alignment > SlabSize)
+      return LargeAllocations.Allocate(bytes, alignment);
+
+    while (true) {
+      if (CurSlab == Slabs.size())
+        Slabs.push_back(new char[SlabSize]);
+
+      size_t alignedOffset = llvm::alignTo(CurOffset, alignment);
+      if (alignedOffset + bytes <= SlabSize) {
+        CurOffset = alignedOffset + bytes;
+        return Slabs[CurSlab] + alignedOffset;
+      }
+
+      // The current slab is full; move on to the next one.
+      ++CurSlab;
+      CurOffset = 0;
+    }
+  }
+};
+
 /// Describes a system of constraints on type variables, the
 /// solution of which assigns concrete types to each of the type variables.
 /// Constraint systems are typically generated given an (untyped) expression.
@@ -1631,8 +1704,14 @@ private:
 
   llvm::DenseMap<Expr *, std::pair<unsigned, Expr *>> ExprWeights;
 
-  /// Allocator used for all of the related constraint systems.
-  llvm::BumpPtrAllocator Allocator;
+  /// Allocator used for all of the related constraint systems, leased
+  /// from the ASTContext's pool so that its slabs are reused from one
+  /// expression to the next.
+  SolverAllocatorRAII Allocator;
+
+  /// Arena for constraints created while the solver is active; it is reset
+  /// to the enclosing scope's watermark whenever the solver backtracks.
+  SolverArena ConstraintArena;
 
   /// Arena used for memory management of constraint-checker-related
   /// allocations.
@@ -1799,7 +1878,7 @@ private:
   public:
     Candidate(ConstraintSystem &cs, Expr *expr, Type ct = Type(),
               ContextualTypePurpose ctp = ContextualTypePurpose::CTP_Unused)
-        : E(expr), DC(cs.DC), Allocator(cs.Allocator), CT(ct), CTP(ctp) {}
+        : E(expr), DC(cs.DC), Allocator(cs.getAllocator()), CT(ct), CTP(ctp) {}
 
     /// Return underlying expression.
     Expr *getExpr() const { return E; }
@@ -1888,6 +1967,16 @@ private:
      /// The best solution computed so far.
     Optional<Score> BestScore;
 
+    /// A key identifying a type pair that \c matchTypes() has proven cannot
+    /// match under a particular constraint kind and set of matching flags.
+    using TypeMatchFailureKey =
+        std::pair<std::pair<CanType, CanType>, std::pair<unsigned, unsigned>>;
+
+    /// Type pairs this solver invocation has already proven cannot match.
+    /// Only pairs free of type variables are recorded, so entries never
+    /// become stale when a type variable is bound.
+    llvm::DenseSet<TypeMatchFailureKey> FailedTypeMatches;
+
     /// The number of the solution attempt we're looking at.
     unsigned SolutionAttempt;
 
@@ -2276,6 +2365,11 @@ public:
     /// The previous score.
     Score PreviousScore;
 
+    /// The solver arena watermark at the time this scope was created; the
+    /// arena is reset to it when the scope is rolled back, reclaiming all
+    /// constraints created within the scope in bulk.
+    SolverArena::Watermark arenaWatermark;
+
     /// The scope number of this scope. Set when the scope is registered.
     unsigned scopeNumber = 0;
 
@@ -2761,7 +2855,12 @@ public:
 
   /// Try to salvage the constraint system by applying (speculative)
   /// fixes.
-  SolutionResult salvage();
+  ///
+  /// \param primarySolutions The competing solutions produced by a primary
+  /// attempt that ended in an ambiguity, if any. When all of them are free
+  /// of fixes, the ambiguity is diagnosed directly from them rather than by
+  /// solving the system a second time.
+  SolutionResult salvage(MutableArrayRef<Solution> primarySolutions = {});
   
   /// Mine the active and inactive constraints in the constraint
   /// system to generate a plausible diagnosis of why the system could not be
@@ -3508,7 +3607,17 @@ public:
                       ConstraintLocator *locator);
 
   /// Retrieve the allocator used by this constraint system.
-  llvm::BumpPtrAllocator &getAllocator() { return Allocator; }
+  llvm::BumpPtrAllocator &getAllocator() { return Allocator.get(); }
+
+  /// Allocate memory for a constraint. While the solver is active the
+  /// memory comes from the solver arena, which is reclaimed in bulk when
+  /// the enclosing solver scope is rolled back; otherwise it comes from the
+  /// main allocator and lives as long as the constraint system.
+  void *allocateConstraintMemory(size_t bytes, size_t alignment) {
+    if (solverState)
+      return ConstraintArena.allocate(bytes, alignment);
+    return getAllocator().Allocate(bytes, alignment);
+  }
 
   template <typename It>
   ArrayRef<typename std::iterator_traits<It>::value_type>
@@ -4978,6 +5087,12 @@ bool isPatternMatchingOperator(Expr *expr);
 /// extract and produce name of the operator.
 Optional<Identifier> getOperatorName(Expr *expr);
 
+/// Produce the key under which the success of the given overload choice for
+/// a binary operator application with the given operand types is recorded
+/// in the overload profile (see -solver-overload-profile-path).
+std::string getOperatorOverloadProfileKey(Identifier opName, CanType lhsTy,
+                                          CanType rhsTy, ValueDecl *choice);
+
 // Check whether argument of the call at given position refers to
 // parameter marked as `@autoclosure`. This function is used to
 // maintain source compatibility with Swift versions < 5,
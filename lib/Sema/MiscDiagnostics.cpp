@@ -44,6 +44,100 @@ static Expr *isImplicitPromotionToOptional(Expr *E) {
   return nullptr;
 }
 
+namespace {
+/// Runs several per-node syntactic checks during a single pre-order
+/// traversal of an expression, instead of walking the tree once per check.
+///
+/// Each registered check observes exactly the nodes it would have seen when
+/// walking on its own: a check may ask to skip the subtree under the current
+/// node, which deactivates just that check until the traversal leaves the
+/// subtree, and checks that would not descend into non-single-expression
+/// closure bodies or TapExprs are deactivated for those subtrees while the
+/// shared walk continues for the checks that would.
+class FusedExprDiagnosticWalker : public ASTWalker {
+public:
+  /// The action a check requests for the subtree under the visited node.
+  enum class CheckAction : bool { Continue, SkipSubtree };
+
+  /// A per-node check, invoked with the visited expression and its parent.
+  using NodeCheck = std::function<CheckAction(Expr *, const ParentTy &)>;
+
+private:
+  struct RegisteredCheck {
+    NodeCheck check;
+
+    /// Whether this check visits the bodies of non-single-expression
+    /// closures that have no function builder applied.
+    bool walksIntoClosureBodies;
+
+    /// Whether this check visits the bodies of TapExprs.
+    bool walksIntoTapExpressions;
+
+    /// When non-null, the root of a subtree this check asked to skip; the
+    /// check stays inactive until the traversal leaves that subtree.
+    Expr *skipRoot = nullptr;
+  };
+
+  SmallVector<RegisteredCheck, 4> Checks;
+
+public:
+  void addCheck(NodeCheck check, bool walksIntoClosureBodies = false,
+                bool walksIntoTapExpressions = false) {
+    Checks.push_back(
+        {std::move(check), walksIntoClosureBodies, walksIntoTapExpressions});
+  }
+
+  bool hasChecks() const { return !Checks.empty(); }
+
+  bool shouldWalkIntoNonSingleExpressionClosure(ClosureExpr *expr) override {
+    if (expr->hasAppliedFunctionBuilder())
+      return true;
+    return llvm::any_of(Checks, [](const RegisteredCheck &registered) {
+      return registered.walksIntoClosureBodies;
+    });
+  }
+
+  bool shouldWalkIntoTapExpression() override {
+    return llvm::any_of(Checks, [](const RegisteredCheck &registered) {
+      return registered.walksIntoTapExpressions;
+    });
+  }
+
+  std::pair<bool, Expr *> walkToExprPre(Expr *E) override {
+    for (auto &registered : Checks) {
+      if (registered.skipRoot)
+        continue;
+      if (registered.check(E, Parent) == CheckAction::SkipSubtree)
+        registered.skipRoot = E;
+    }
+
+    // Deactivate the checks that would not have descended into this node's
+    // subtree when walking on their own.
+    if (auto *closure = dyn_cast<ClosureExpr>(E)) {
+      if (!closure->hasSingleExpressionBody() &&
+          !closure->hasAppliedFunctionBuilder()) {
+        for (auto &registered : Checks)
+          if (!registered.skipRoot && !registered.walksIntoClosureBodies)
+            registered.skipRoot = E;
+      }
+    } else if (isa<TapExpr>(E)) {
+      for (auto &registered : Checks)
+        if (!registered.skipRoot && !registered.walksIntoTapExpressions)
+          registered.skipRoot = E;
+    }
+
+    return {true, E};
+  }
+
+  Expr *walkToExprPost(Expr *E) override {
+    for (auto &registered : Checks)
+      if (registered.skipRoot == E)
+        registered.skipRoot = nullptr;
+    return E;
+  }
+};
+} // end anonymous namespace
+
 /// Diagnose syntactic restrictions of expressions.
 ///
 ///   - Module values may only occur as part of qualification.
@@ -1263,7 +1357,8 @@ static void diagSyntacticUseRestrictions(const Expr *E, const DeclContext *DC,
 
 
 /// Diagnose recursive use of properties within their own accessors
-static void diagRecursivePropertyAccess(const Expr *E, const DeclContext *DC) {
+static void addRecursivePropertyAccessCheck(FusedExprDiagnosticWalker &fused,
+                                            const DeclContext *DC) {
   auto fn = dyn_cast<AccessorDecl>(DC);
   if (!fn)
     return;
@@ -1272,29 +1367,20 @@ static void diagRecursivePropertyAccess(const Expr *E, const DeclContext *DC) {
   if (!var)  // Ignore subscripts
     return;
 
-  class DiagnoseWalker : public ASTWalker {
-    ASTContext &Ctx;
-    VarDecl *Var;
-    const AccessorDecl *Accessor;
-
-  public:
-    explicit DiagnoseWalker(VarDecl *var, const AccessorDecl *Accessor)
-      : Ctx(var->getASTContext()), Var(var), Accessor(Accessor) {}
-
-    /// Return true if this is an implicit reference to self.
-    static bool isImplicitSelfUse(Expr *E) {
-      auto *DRE = dyn_cast<DeclRefExpr>(E);
-      return DRE && DRE->isImplicit() && isa<VarDecl>(DRE->getDecl()) &&
-             cast<VarDecl>(DRE->getDecl())->isSelfParameter();
-    }
-
-    bool shouldWalkIntoNonSingleExpressionClosure(ClosureExpr *expr) override {
-      return expr->hasAppliedFunctionBuilder();
-    }
-
-    bool shouldWalkIntoTapExpression() override { return false; }
+  /// Return true if this is an implicit reference to self.
+  auto isImplicitSelfUse = [](Expr *E) -> bool {
+    auto *DRE = dyn_cast<DeclRefExpr>(E);
+    return DRE && DRE->isImplicit() && isa<VarDecl>(DRE->getDecl()) &&
+           cast<VarDecl>(DRE->getDecl())->isSelfParameter();
+  };
 
-    std::pair<bool, Expr *> walkToExprPre(Expr *E) override {
+  VarDecl *Var = var;
+  const AccessorDecl *Accessor = fn;
+  fused.addCheck(
+      [Var, Accessor, isImplicitSelfUse](Expr *E,
+                                         const ASTWalker::ParentTy &Parent)
+          -> FusedExprDiagnosticWalker::CheckAction {
+      auto &Ctx = Var->getASTContext();
       Expr *subExpr;
       bool isStore = false;
 
@@ -1303,7 +1389,7 @@ static void diagRecursivePropertyAccess(const Expr *E, const DeclContext *DC) {
         
         // If we couldn't flatten this expression, don't explode.
         if (!subExpr)
-          return { true, E };
+          return FusedExprDiagnosticWalker::CheckAction::Continue;
 
         isStore = true;
       } else if (auto *IOE = dyn_cast<InOutExpr>(E)) {
@@ -1389,12 +1475,8 @@ static void diagRecursivePropertyAccess(const Expr *E, const DeclContext *DC) {
 
       }
 
-      return { true, E };
-    }
-  };
-
-  DiagnoseWalker walker(var, fn);
-  const_cast<Expr *>(E)->walk(walker);
+      return FusedExprDiagnosticWalker::CheckAction::Continue;
+    });
 }
 
 /// Look for any property references in closures that lack a 'self.' qualifier.
@@ -4188,127 +4270,104 @@ static void diagnoseUnintendedOptionalBehavior(const Expr *E,
   const_cast<Expr *>(E)->walk(Walker);
 }
 
-static void diagnoseDeprecatedWritableKeyPath(const Expr *E,
-                                              const DeclContext *DC) {
-  if (!E || isa<ErrorExpr>(E) || !E->getType())
-    return;
+static void addDeprecatedWritableKeyPathCheck(
+    FusedExprDiagnosticWalker &fused, const DeclContext *DC) {
+  auto visitKeyPathApplicationExpr = [DC](KeyPathApplicationExpr *E,
+                                          const ASTWalker::ParentTy &Parent) {
+    auto &Ctx = DC->getASTContext();
 
-  class DeprecatedWritableKeyPathWalker : public ASTWalker {
-    ASTContext &Ctx;
-    const DeclContext *DC;
+    bool isWrite = false;
+    if (auto *P = Parent.getAsExpr())
+      if (auto *AE = dyn_cast<AssignExpr>(P))
+        if (AE->getDest() == E)
+          isWrite = true;
 
-    void visitKeyPathApplicationExpr(KeyPathApplicationExpr *E) {
-      bool isWrite = false;
-      if (auto *P = Parent.getAsExpr())
-        if (auto *AE = dyn_cast<AssignExpr>(P))
-          if (AE->getDest() == E)
-            isWrite = true;
+    if (!isWrite)
+      return;
 
-      if (!isWrite)
+    if (auto *keyPathExpr = dyn_cast<KeyPathExpr>(E->getKeyPath())) {
+      auto *decl = keyPathExpr->getType()->getNominalOrBoundGenericNominal();
+      if (decl != Ctx.getWritableKeyPathDecl() &&
+          decl != Ctx.getReferenceWritableKeyPathDecl())
         return;
 
-      if (auto *keyPathExpr = dyn_cast<KeyPathExpr>(E->getKeyPath())) {
-        auto *decl = keyPathExpr->getType()->getNominalOrBoundGenericNominal();
-        if (decl != Ctx.getWritableKeyPathDecl() &&
-            decl != Ctx.getReferenceWritableKeyPathDecl())
-          return;
-
-        assert(keyPathExpr->getComponents().size() > 0);
-        auto &component = keyPathExpr->getComponents().back();
-        if (component.getKind() == KeyPathExpr::Component::Kind::Property) {
-          auto *storage =
-            cast<AbstractStorageDecl>(component.getDeclRef().getDecl());
-          if (!storage->isSettable(nullptr) ||
-              !storage->isSetterAccessibleFrom(DC)) {
-            Ctx.Diags.diagnose(keyPathExpr->getLoc(),
-                               swift::diag::expr_deprecated_writable_keypath,
-                               storage->getFullName());
-          }
+      assert(keyPathExpr->getComponents().size() > 0);
+      auto &component = keyPathExpr->getComponents().back();
+      if (component.getKind() == KeyPathExpr::Component::Kind::Property) {
+        auto *storage =
+          cast<AbstractStorageDecl>(component.getDeclRef().getDecl());
+        if (!storage->isSettable(nullptr) ||
+            !storage->isSetterAccessibleFrom(DC)) {
+          Ctx.Diags.diagnose(keyPathExpr->getLoc(),
+                             swift::diag::expr_deprecated_writable_keypath,
+                             storage->getFullName());
         }
       }
     }
-
-    bool shouldWalkIntoNonSingleExpressionClosure(ClosureExpr *expr) override {
-      return expr->hasAppliedFunctionBuilder();
-    }
-
-    bool shouldWalkIntoTapExpression() override { return false; }
-
-    std::pair<bool, Expr *> walkToExprPre(Expr *E) override {
-      if (!E || isa<ErrorExpr>(E) || !E->getType())
-        return {false, E};
-
-      if (auto *KPAE = dyn_cast<KeyPathApplicationExpr>(E)) {
-        visitKeyPathApplicationExpr(KPAE);
-        return {true, E};
-      }
-
-      return {true, E};
-    }
-
-  public:
-    DeprecatedWritableKeyPathWalker(const DeclContext *DC)
-        : Ctx(DC->getASTContext()), DC(DC) {}
   };
 
-  DeprecatedWritableKeyPathWalker Walker(DC);
-  const_cast<Expr *>(E)->walk(Walker);
-}
+  fused.addCheck(
+      [visitKeyPathApplicationExpr](Expr *E,
+                                    const ASTWalker::ParentTy &Parent)
+          -> FusedExprDiagnosticWalker::CheckAction {
+        if (!E || isa<ErrorExpr>(E) || !E->getType())
+          return FusedExprDiagnosticWalker::CheckAction::SkipSubtree;
 
-static void maybeDiagnoseCallToKeyValueObserveMethod(const Expr *E,
-                                                     const DeclContext *DC) {
-  class KVOObserveCallWalker : public ASTWalker {
-    const ASTContext &C;
-
-  public:
-    KVOObserveCallWalker(ASTContext &ctx) : C(ctx) {}
+        if (auto *KPAE = dyn_cast<KeyPathApplicationExpr>(E))
+          visitKeyPathApplicationExpr(KPAE, Parent);
 
-    void maybeDiagnoseCallExpr(CallExpr *expr) {
-      auto fn = expr->getCalledValue();
-      if (!fn)
-        return;
-      if (fn->getModuleContext()->getName() != C.Id_Foundation)
-        return;
-      if (!fn->getFullName().isCompoundName("observe",
-                                            {"", "options", "changeHandler"}))
-        return;
-      auto args = cast<TupleExpr>(expr->getArg());
-      auto firstArg = dyn_cast<KeyPathExpr>(args->getElement(0));
-      if (!firstArg)
-        return;
-      auto lastComponent = firstArg->getComponents().back();
-      if (lastComponent.getKind() != KeyPathExpr::Component::Kind::Property)
-        return;
-      auto property = lastComponent.getDeclRef().getDecl();
-      if (!property)
-        return;
-      auto propertyVar = cast<VarDecl>(property);
-      if (propertyVar->isObjCDynamic() ||
-          (propertyVar->isObjC() &&
-           propertyVar->getParsedAccessor(AccessorKind::Set)))
-        return;
-      C.Diags
-          .diagnose(expr->getLoc(),
-                    diag::observe_keypath_property_not_objc_dynamic,
-                    property->getFullName(), fn->getFullName())
-          .highlight(lastComponent.getLoc());
-    }
+        return FusedExprDiagnosticWalker::CheckAction::Continue;
+      });
+}
 
-    std::pair<bool, Expr *> walkToExprPre(Expr *E) override {
-      if (!E || isa<ErrorExpr>(E) || !E->getType())
-        return {false, E};
+static void addCallToKeyValueObserveMethodCheck(
+    FusedExprDiagnosticWalker &fused, const DeclContext *DC) {
+  auto maybeDiagnoseCallExpr = [DC](CallExpr *expr) {
+    const ASTContext &C = DC->getASTContext();
+    auto fn = expr->getCalledValue();
+    if (!fn)
+      return;
+    if (fn->getModuleContext()->getName() != C.Id_Foundation)
+      return;
+    if (!fn->getFullName().isCompoundName("observe",
+                                          {"", "options", "changeHandler"}))
+      return;
+    auto args = cast<TupleExpr>(expr->getArg());
+    auto firstArg = dyn_cast<KeyPathExpr>(args->getElement(0));
+    if (!firstArg)
+      return;
+    auto lastComponent = firstArg->getComponents().back();
+    if (lastComponent.getKind() != KeyPathExpr::Component::Kind::Property)
+      return;
+    auto property = lastComponent.getDeclRef().getDecl();
+    if (!property)
+      return;
+    auto propertyVar = cast<VarDecl>(property);
+    if (propertyVar->isObjCDynamic() ||
+        (propertyVar->isObjC() &&
+         propertyVar->getParsedAccessor(AccessorKind::Set)))
+      return;
+    C.Diags
+        .diagnose(expr->getLoc(),
+                  diag::observe_keypath_property_not_objc_dynamic,
+                  property->getFullName(), fn->getFullName())
+        .highlight(lastComponent.getLoc());
+  };
 
-      if (auto *CE = dyn_cast<CallExpr>(E)) {
-        maybeDiagnoseCallExpr(CE);
-        return {false, E};
-      }
+  fused.addCheck(
+      [maybeDiagnoseCallExpr](Expr *E, const ASTWalker::ParentTy &Parent)
+          -> FusedExprDiagnosticWalker::CheckAction {
+        if (!E || isa<ErrorExpr>(E) || !E->getType())
+          return FusedExprDiagnosticWalker::CheckAction::SkipSubtree;
 
-      return {true, E};
-    }
-  };
+        if (auto *CE = dyn_cast<CallExpr>(E)) {
+          maybeDiagnoseCallExpr(CE);
+          return FusedExprDiagnosticWalker::CheckAction::SkipSubtree;
+        }
 
-  KVOObserveCallWalker Walker(DC->getASTContext());
-  const_cast<Expr *>(E)->walk(Walker);
+        return FusedExprDiagnosticWalker::CheckAction::Continue;
+      },
+      /*walksIntoClosureBodies=*/true, /*walksIntoTapExpressions=*/true);
 }
 
 //===----------------------------------------------------------------------===//
@@ -4322,17 +4381,22 @@ void swift::performSyntacticExprDiagnostics(const Expr *E,
   auto &ctx = DC->getASTContext();
   TypeChecker::diagnoseSelfAssignment(E);
   diagSyntacticUseRestrictions(E, DC, isExprStmt);
-  diagRecursivePropertyAccess(E, DC);
   diagnoseImplicitSelfUseInClosure(E, DC);
   diagnoseUnintendedOptionalBehavior(E, DC);
-  maybeDiagnoseCallToKeyValueObserveMethod(E, DC);
-  if (!ctx.isSwiftVersionAtLeast(5))
-    diagnoseDeprecatedWritableKeyPath(E, DC);
   if (!ctx.LangOpts.DisableAvailabilityChecking)
     diagAvailability(E, const_cast<DeclContext*>(DC));
   if (ctx.LangOpts.EnableObjCInterop)
     diagDeprecatedObjCSelectors(DC, E);
   diagnoseConstantArgumentRequirement(E, DC);
+
+  // The per-node checks below share a single traversal of the expression.
+  FusedExprDiagnosticWalker fused;
+  addRecursivePropertyAccessCheck(fused, DC);
+  addCallToKeyValueObserveMethodCheck(fused, DC);
+  if (!ctx.isSwiftVersionAtLeast(5))
+    addDeprecatedWritableKeyPathCheck(fused, DC);
+  if (fused.hasChecks())
+    const_cast<Expr *>(E)->walk(fused);
 }
 
 void swift::performStmtDiagnostics(ASTContext &ctx, const Stmt *S) {
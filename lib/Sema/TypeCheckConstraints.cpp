@@ -2027,6 +2027,65 @@ Type TypeChecker::typeCheckExpression(Expr *&expr, DeclContext *dc,
   return expr->getType();
 }
 
+namespace {
+/// Record the binary operator overloads a fully type-checked expression
+/// ended up using, so that the solver can favor them when it sees another
+/// expression with the same operator, operand types and contextual type.
+class SolvedOperatorRecorder : public ASTWalker {
+  ConstraintSystem &CS;
+
+public:
+  explicit SolvedOperatorRecorder(ConstraintSystem &cs) : CS(cs) {}
+
+  std::pair<bool, Expr *> walkToExprPre(Expr *expr) override {
+    auto *apply = dyn_cast<BinaryExpr>(expr);
+    if (!apply)
+      return {true, expr};
+
+    auto *choice = apply->getCalledValue();
+    if (!choice || choice->getBaseName().isSpecial())
+      return {true, expr};
+
+    auto *argTuple = dyn_cast<TupleExpr>(apply->getArg());
+    if (!argTuple || argTuple->getNumElements() != 2)
+      return {true, expr};
+
+    auto getOperandType = [](Expr *arg) -> CanType {
+      Type ty = arg->getType();
+      if (!ty || ty->hasError() || ty->hasTypeVariable() ||
+          ty->hasUnresolvedType())
+        return CanType();
+      return ty->getCanonicalType();
+    };
+
+    auto lhsTy = getOperandType(argTuple->getElement(0));
+    auto rhsTy = getOperandType(argTuple->getElement(1));
+    if (!lhsTy || !rhsTy)
+      return {true, expr};
+
+    CanType contextualTy;
+    if (auto ty = CS.getContextualType(apply)) {
+      if (ty->hasTypeVariable())
+        return {true, expr};
+      contextualTy = ty->getCanonicalType();
+    }
+
+    auto &ctx = CS.getASTContext();
+    auto opName = choice->getBaseName().getIdentifier();
+    ctx.setSolvedBinaryOperatorOverload(opName, lhsTy, rhsTy, contextualTy,
+                                        choice);
+
+    // If an overload profile is being collected, count this success so
+    // future builds can try the popular choices first.
+    if (!ctx.TypeCheckerOpts.SolverOverloadProfilePath.empty()) {
+      ctx.recordOperatorOverloadSuccess(
+          getOperatorOverloadProfileKey(opName, lhsTy, rhsTy, choice));
+    }
+    return {true, expr};
+  }
+};
+} // end anonymous namespace
+
 Optional<SolutionApplicationTarget>
 TypeChecker::typeCheckExpression(
     SolutionApplicationTarget &target,
@@ -2110,6 +2169,11 @@ TypeChecker::typeCheckExpression(
   }
   Expr *result = resultTarget->getAsExpr();
 
+  // Remember which operator overloads this expression used so that later
+  // expressions with the same shape can try them first.
+  SolvedOperatorRecorder recorder(cs);
+  result->walk(recorder);
+
   // Unless the client has disabled them, perform syntactic checks on the
   // expression now.
   if (!cs.shouldSuppressDiagnostics()) {
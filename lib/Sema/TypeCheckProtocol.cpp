@@ -824,9 +824,24 @@ static Optional<RequirementMatch> findMissingGenericRequirementForSolutionFix(
 RequirementMatch
 swift::matchWitness(WitnessChecker::RequirementEnvironmentCache &reqEnvCache,
                     ProtocolDecl *proto, ProtocolConformance *conformance,
-                    DeclContext *dc, ValueDecl *req, ValueDecl *witness) {
+                    DeclContext *dc, ValueDecl *req, ValueDecl *witness,
+                    WitnessChecker::WitnessMatchCache *matchCache) {
   using namespace constraints;
 
+  auto &ctx = dc->getASTContext();
+  if (auto *stats = ctx.Stats)
+    stats->getFrontendCounters().NumRequirementMatchAttempts++;
+
+  WitnessChecker::WitnessMatchCacheKey cacheKey({req, witness}, conformance);
+  if (matchCache) {
+    auto known = matchCache->find(cacheKey);
+    if (known != matchCache->end()) {
+      if (auto *stats = ctx.Stats)
+        stats->getFrontendCounters().NumRequirementMatchCacheHits++;
+      return known->second;
+    }
+  }
+
   // Initialized by the setup operation.
   Optional<ConstraintSystem> cs;
   ConstraintLocator *locator = nullptr;
@@ -1013,7 +1028,15 @@ swift::matchWitness(WitnessChecker::RequirementEnvironmentCache &reqEnvCache,
     return result;
   };
 
-  return matchWitness(dc, req, witness, setup, matchTypes, finalize);
+  auto match = matchWitness(dc, req, witness, setup, matchTypes, finalize);
+
+  // Remember the result for subsequent attempts. A circularity verdict is
+  // transient—it reflects a witness that was still being validated—so it
+  // has to be recomputed once validation has finished.
+  if (matchCache && match.Kind != MatchKind::Circularity)
+    matchCache->insert({cacheKey, match});
+
+  return match;
 }
 
 static bool
@@ -1219,7 +1242,7 @@ bool WitnessChecker::findBestWitness(
       }
 
       auto match = matchWitness(ReqEnvironmentCache, Proto, conformance,
-                                DC, requirement, witness);
+                                DC, requirement, witness, &MatchCache);
       if (match.isViable()) {
         ++numViable;
         bestIdx = matches.size();
@@ -1244,7 +1267,8 @@ bool WitnessChecker::findBestWitness(
       if (auto *SF = DC->getParentSourceFile()) {
         if (SF->Kind == SourceFileKind::Interface) {
           auto match = matchWitness(ReqEnvironmentCache, Proto,
-                                    conformance, DC, requirement, requirement);
+                                    conformance, DC, requirement, requirement,
+                                    &MatchCache);
           assert(match.isViable());
           numViable = 1;
           bestIdx = matches.size();
@@ -3646,7 +3670,7 @@ ResolveWitnessResult ConformanceChecker::resolveWitnessViaDerivation(
 
   // Try to match the derived requirement.
   auto match = matchWitness(ReqEnvironmentCache, Proto, Conformance, DC,
-                            requirement, derived);
+                            requirement, derived, &MatchCache);
   if (match.isViable()) {
     recordWitness(requirement, match);
     return ResolveWitnessResult::Success;
@@ -499,6 +499,16 @@ public:
   using RequirementEnvironmentCache =
       llvm::DenseMap<RequirementEnvironmentCacheKey, RequirementEnvironment>;
 
+  /// Key for a memoized requirement-to-witness match: the requirement and
+  /// candidate witness pair, plus the conformance whose substitutions the
+  /// match was performed under. The conformance uniquely determines the
+  /// adoptee and conforming context, so it acts as the substitution
+  /// fingerprint for the match.
+  using WitnessMatchCacheKey =
+      std::pair<std::pair<ValueDecl *, ValueDecl *>, ProtocolConformance *>;
+  using WitnessMatchCache =
+      llvm::DenseMap<WitnessMatchCacheKey, RequirementMatch>;
+
 protected:
   ASTContext &Context;
   ProtocolDecl *Proto;
@@ -514,6 +524,11 @@ protected:
 
   RequirementEnvironmentCache ReqEnvironmentCache;
 
+  /// Memoized results of matching requirements against candidate witnesses,
+  /// so repeated resolution attempts for the same conformance do not re-solve
+  /// the same matches.
+  WitnessMatchCache MatchCache;
+
   Optional<std::pair<AccessScope, bool>> RequiredAccessScopeAndUsableFromInline;
 
   WitnessChecker(ASTContext &ctx, ProtocolDecl *proto, Type adoptee,
@@ -816,6 +831,11 @@ private:
   /// concrete type.
   Type computeFixedTypeWitness(AssociatedTypeDecl *assocType);
 
+  /// Compute a type witness by reusing the already-resolved witness of a
+  /// same-named associated type from the adoptee's conformance to an
+  /// inherited protocol, if there is one.
+  Type computeInheritedTypeWitness(AssociatedTypeDecl *assocType);
+
   /// Compute the default type witness from an associated type default,
   /// if there is one.
   Type computeDefaultTypeWitness(AssociatedTypeDecl *assocType);
@@ -926,10 +946,18 @@ RequirementMatch matchWitness(
                      RequirementMatch(bool, ArrayRef<OptionalAdjustment>)
                    > finalize);
 
+/// Match the given witness to the given requirement by building and solving
+/// a constraint system over the two interface types.
+///
+/// \param matchCache If non-null, a cache of prior match results to consult
+/// and populate, keyed by the requirement, witness, and conformance.
+///
+/// \returns the result of performing the match.
 RequirementMatch
 matchWitness(WitnessChecker::RequirementEnvironmentCache &reqEnvCache,
              ProtocolDecl *proto, ProtocolConformance *conformance,
-             DeclContext *dc, ValueDecl *req, ValueDecl *witness);
+             DeclContext *dc, ValueDecl *req, ValueDecl *witness,
+             WitnessChecker::WitnessMatchCache *matchCache = nullptr);
 
 /// If the given type is a direct reference to an associated type of
 /// the given protocol, return the referenced associated type.
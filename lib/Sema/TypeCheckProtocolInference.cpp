@@ -24,6 +24,7 @@
 #include "swift/AST/TypeMatcher.h"
 #include "swift/AST/Types.h"
 #include "swift/Basic/Defer.h"
+#include "swift/Basic/Statistic.h"
 #include "swift/ClangImporter/ClangModule.h"
 #include "llvm/ADT/Statistic.h"
 #include "llvm/ADT/TinyPtrVector.h"
@@ -810,6 +811,44 @@ Type AssociatedTypeInference::computeFixedTypeWitness(
   return resultType;
 }
 
+Type AssociatedTypeInference::computeInheritedTypeWitness(
+                                            AssociatedTypeDecl *assocType) {
+  auto *module = dc->getParentModule();
+  for (auto *inheritedProto : proto->getInheritedProtocols()) {
+    auto *inheritedAssocType =
+        inheritedProto->getAssociatedType(assocType->getName());
+    if (!inheritedAssocType)
+      continue;
+
+    auto inheritedConf = module->lookupConformance(adoptee, inheritedProto);
+    if (inheritedConf.isInvalid() || !inheritedConf.isConcrete())
+      continue;
+
+    // Only reuse witnesses that have already been resolved;
+    // hasTypeWitness() does not force resolution, so conformances that are
+    // themselves mid-check are skipped rather than recursed into.
+    auto *normal =
+        inheritedConf.getConcrete()->getRootNormalConformance();
+    if (!normal->hasTypeWitness(inheritedAssocType))
+      continue;
+
+    Type witness = normal->getTypeWitness(inheritedAssocType);
+    if (!witness || witness->hasError())
+      continue;
+
+    // The refined protocol can impose additional requirements on the
+    // associated type, so the reused witness still has to be checked
+    // against them.
+    if (checkTypeWitness(dc, proto, assocType,
+                         dc->mapTypeIntoContext(witness)))
+      continue;
+
+    return witness;
+  }
+
+  return Type();
+}
+
 Type AssociatedTypeInference::computeDefaultTypeWitness(
                                               AssociatedTypeDecl *assocType) {
   // Go find a default definition.
@@ -1870,6 +1909,7 @@ auto AssociatedTypeInference::solve(ConformanceChecker &checker)
 
   // Try to resolve type witnesses via name lookup.
   llvm::SetVector<AssociatedTypeDecl *> unresolvedAssocTypes;
+  SmallVector<std::pair<AssociatedTypeDecl *, Type>, 4> reusedWitnesses;
   for (auto assocType : proto->getAssociatedTypeMembers()) {
     // If we already have a type witness, do nothing.
     if (conformance->hasTypeWitness(assocType))
@@ -1886,6 +1926,16 @@ auto AssociatedTypeInference::solve(ConformanceChecker &checker)
       continue;
 
     case ResolveWitnessResult::Missing:
+      // If the adoptee's conformance to an inherited protocol has already
+      // resolved a same-named associated type, reuse its witness: the two
+      // associated types are equivalent in the refined protocol's
+      // signature, so running inference could not arrive at a different
+      // answer.
+      if (Type inheritedWitness = computeInheritedTypeWitness(assocType)) {
+        reusedWitnesses.push_back({assocType, inheritedWitness});
+        continue;
+      }
+
       // Note that we haven't resolved this associated type yet.
       unresolvedAssocTypes.insert(assocType);
       break;
@@ -1894,10 +1944,17 @@ auto AssociatedTypeInference::solve(ConformanceChecker &checker)
 
   // Result variable to use for returns so that we get NRVO.
   Optional<InferredTypeWitnesses> result = InferredTypeWitnesses();
+  result->insert(result->end(), reusedWitnesses.begin(),
+                 reusedWitnesses.end());
 
   // If we resolved everything, we're done.
-  if (unresolvedAssocTypes.empty())
+  if (unresolvedAssocTypes.empty()) {
+    if (!reusedWitnesses.empty()) {
+      if (auto *stats = getASTContext().Stats)
+        stats->getFrontendCounters().NumAssociatedTypeInferencesAvoided++;
+    }
     return result;
+  }
 
   // Infer potential type witnesses from value witnesses.
   inferred = inferTypeWitnessesViaValueWitnesses(checker,
@@ -47,6 +47,7 @@
 #include "llvm/ADT/StringSwitch.h"
 #include "llvm/ADT/Twine.h"
 #include "llvm/Support/SaveAndRestore.h"
+#include "llvm/Support/raw_ostream.h"
 
 using namespace swift;
 
@@ -1873,6 +1874,67 @@ namespace {
   };
 } // end anonymous namespace
 
+/// Whether a resolution of \p repr is eligible for memoization. Opaque
+/// result types resolve against the enclosing declaration rather than the
+/// declaration context alone, so they are excluded.
+static bool isCacheableTypeRepr(TypeRepr *repr) {
+  class Walker : public ASTWalker {
+  public:
+    bool IsCacheable = true;
+
+    bool walkToTypeReprPre(TypeRepr *T) override {
+      if (isa<OpaqueReturnTypeRepr>(T)) {
+        IsCacheable = false;
+        return false;
+      }
+      return true;
+    }
+  } walker;
+  repr->walk(walker);
+  return walker.IsCacheable;
+}
+
+/// Collect the identifier components of \p repr in source order.
+static void collectIdentComponents(
+    TypeRepr *repr, SmallVectorImpl<ComponentIdentTypeRepr *> &components) {
+  class Walker : public ASTWalker {
+    SmallVectorImpl<ComponentIdentTypeRepr *> &Components;
+
+  public:
+    explicit Walker(SmallVectorImpl<ComponentIdentTypeRepr *> &components)
+        : Components(components) {}
+
+    bool walkToTypeReprPre(TypeRepr *T) override {
+      if (auto *comp = dyn_cast<ComponentIdentTypeRepr>(T))
+        Components.push_back(comp);
+      return true;
+    }
+  } walker(components);
+  repr->walk(walker);
+}
+
+/// Replay the identifier bindings made while resolving \p from onto the
+/// structurally identical representation \p to, so that later passes that
+/// inspect bound components - availability checking, for one - see the same
+/// information they would after a full resolution.
+static void replayIdentBindings(TypeRepr *from, TypeRepr *to) {
+  SmallVector<ComponentIdentTypeRepr *, 8> fromComponents;
+  SmallVector<ComponentIdentTypeRepr *, 8> toComponents;
+  collectIdentComponents(from, fromComponents);
+  collectIdentComponents(to, toComponents);
+  assert(fromComponents.size() == toComponents.size() &&
+         "structurally identical types must have matching components");
+  if (fromComponents.size() != toComponents.size())
+    return;
+
+  for (unsigned i = 0, e = fromComponents.size(); i != e; ++i) {
+    auto *boundComp = fromComponents[i];
+    if (boundComp->isBound())
+      toComponents[i]->setValue(boundComp->getBoundDecl(),
+                                boundComp->getDeclContext());
+  }
+}
+
 Type TypeResolution::resolveType(TypeRepr *TyR,
                               TypeResolutionOptions options) {
   auto &ctx = getASTContext();
@@ -1880,10 +1942,58 @@ Type TypeResolution::resolveType(TypeRepr *TyR,
                                   "resolve-type", TyR);
   PrettyStackTraceTypeRepr stackTrace(ctx, "resolving", TyR);
 
+  // Memoize resolutions of structurally identical type representations,
+  // which occur thousands of times per module for common annotations.
+  // Only resolutions whose outcome is fully determined by the printed form
+  // of the representation, the declaration context, the stage, and the
+  // options are eligible:
+  //   - local contexts are excluded because unqualified lookup there
+  //     depends on the source location;
+  //   - contextual-stage resolutions are excluded because they may map
+  //     into a generic environment other than the context's own;
+  //   - interface-stage resolutions against a signature other than the
+  //     context's are likewise excluded;
+  //   - SIL resolutions are excluded because they can introduce their own
+  //     generic parameters.
+  // Entries are only added when resolution produced no diagnostics, so
+  // warnings are still emitted once per occurrence, and the module load
+  // generation is part of the key.
+  llvm::SmallString<128> cacheKeyBuffer;
+  StringRef cacheKey;
+  if (!dc->isLocalContext() && stage != TypeResolutionStage::Contextual &&
+      (stage == TypeResolutionStage::Structural ||
+       getGenericSignature().getPointer() ==
+           dc->getGenericSignatureOfContext().getPointer()) &&
+      !options.contains(TypeResolutionFlags::SILType) &&
+      !options.contains(TypeResolutionFlags::SILMode) &&
+      isCacheableTypeRepr(TyR)) {
+    llvm::raw_svector_ostream os(cacheKeyBuffer);
+    TyR->print(os);
+    os << '\0' << (const void *)dc << '\0' << unsigned(stage) << '\0'
+       << options.toRaw() << '\0' << ctx.getCurrentGeneration();
+    cacheKey = os.str();
+
+    auto known = ctx.ResolvedTypeReprCache.find(cacheKey);
+    if (known != ctx.ResolvedTypeReprCache.end()) {
+      replayIdentBindings(known->second.second, TyR);
+      return known->second.first;
+    }
+  }
+
   TypeResolver typeResolver(*this);
 
+  // Defer diagnostics so we can tell whether resolution produced any;
+  // the transaction commits them unchanged when it goes out of scope.
+  DiagnosticTransaction transaction(ctx.Diags);
+  unsigned priorDiagnostics = ctx.Diags.getTentativeDiagnosticCount();
+
   auto result = typeResolver.resolveType(TyR, options);
 
+  if (!cacheKey.empty() && result && !result->hasError() &&
+      ctx.Diags.getTentativeDiagnosticCount() == priorDiagnostics) {
+    ctx.ResolvedTypeReprCache[cacheKey] = {result, TyR};
+  }
+
   if (result) {
     // If we resolved down to an error, make sure to mark the typeRepr as invalid
     // so we don't produce a redundant diagnostic.
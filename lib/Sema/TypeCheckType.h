@@ -196,6 +196,12 @@ public:
   /// Get the current flags.
   TypeResolutionFlags getFlags() const { return TypeResolutionFlags(flags); }
 
+  /// Get an opaque value encoding the full option state, for use as a
+  /// cache key.
+  uint32_t toRaw() const {
+    return uint32_t(flags) | (uint32_t(base) << 16) | (uint32_t(context) << 24);
+  }
+
   /// Is this type resolution context an expression.
   bool isAnyExpr() const {
     switch (base) {
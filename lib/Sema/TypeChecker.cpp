@@ -284,14 +284,25 @@ static void typeCheckDelayedFunctions(SourceFile &SF) {
   unsigned currentFunctionIdx = 0;
   unsigned currentSynthesizedDecl = SF.LastCheckedSynthesizedDecl;
   do {
-    // Type check the body of each of the function in turn.  Note that outside
-    // functions must be visited before nested functions for type-checking to
-    // work correctly.
+    // Phase 1: force out the signatures of the delayed functions before
+    // touching any bodies. This keeps signature requests from being
+    // interleaved with body checking, so the body phase below only depends
+    // on already-computed signatures — the shape a parallel body-checking
+    // phase would need once the evaluator and ASTContext can tolerate
+    // concurrent requests.
+    for (unsigned i = currentFunctionIdx, n = SF.DelayedFunctions.size();
+         i != n; ++i) {
+      auto *AFD = SF.DelayedFunctions[i];
+      assert(!AFD->getDeclContext()->isLocalContext());
+      (void)AFD->getInterfaceType();
+    }
+
+    // Phase 2: type check the body of each of the functions in turn.  Note
+    // that outside functions must be visited before nested functions for
+    // type-checking to work correctly.
     for (unsigned n = SF.DelayedFunctions.size(); currentFunctionIdx != n;
          ++currentFunctionIdx) {
       auto *AFD = SF.DelayedFunctions[currentFunctionIdx];
-      assert(!AFD->getDeclContext()->isLocalContext());
-
       TypeChecker::typeCheckAbstractFunctionBody(AFD);
     }
 
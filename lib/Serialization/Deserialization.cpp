@@ -1855,6 +1855,15 @@ Identifier ModuleFile::getIdentifier(IdentifierID IID) {
   return name.getIdentifier();
 }
 
+/// Retrieve the text of a serialized identifier without interning it.
+///
+/// The identifier data block is the module's single shared string table:
+/// every identifier is uniqued to one ID at serialization time and every
+/// other block refers to it by that ID, so the text here is a StringRef
+/// directly into the memory-mapped blob with no decoding or copying. The
+/// one unavoidable copy happens in getDeclBaseName, which must intern the
+/// text into the ASTContext to produce a pointer-uniqued Identifier, and
+/// that result is memoized per ID.
 StringRef ModuleFile::getIdentifierText(IdentifierID IID) {
   if (IID == 0)
     return StringRef();
@@ -1863,7 +1872,7 @@ StringRef ModuleFile::getIdentifierText(IdentifierID IID) {
 
   size_t rawID = IID - NUM_SPECIAL_IDS;
   assert(rawID < Identifiers.size() && "invalid identifier ID");
-  auto identRecord = Identifiers[rawID];
+  const auto &identRecord = Identifiers[rawID];
 
   if (!identRecord.Ident.empty())
     return identRecord.Ident.str();
@@ -2324,6 +2333,16 @@ static void setOriginalDeclarationAndParameterIndicesInDifferentiableAttributes(
   }
 }
 
+/// Resolve a decl ID to a deserialized decl, loading it on first request.
+///
+/// Loading is strictly demand-driven and must stay on the requesting thread:
+/// deserialization allocates into the shared ASTContext, mutates the
+/// ModuleFile's side tables through a single DeclTypeCursor, and freely
+/// re-enters other lazy loaders (member lists, conformances, cross-module
+/// references), none of which are synchronized. Speculatively decoding a
+/// decl's dependency closure on background threads would race on all of
+/// these, so the way to shorten a long chain of dependent loads is to not
+/// request its head, not to decode it earlier.
 Decl *ModuleFile::getDecl(DeclID DID) {
   Expected<Decl *> deserialized = getDeclChecked(DID);
   if (!deserialized) {
@@ -454,6 +454,17 @@ SILFunction *SILDeserializer::readSILFunction(DeclID FID,
   return deserialized.get();
 }
 
+/// Deserialize a SIL function, either fully or as a declaration.
+///
+/// This is the two-stage loading point for serialized SIL: with
+/// \p declarationOnly the decode stops after the function record -- type,
+/// linkage, effects, and attributes -- without ever entering the body
+/// blocks, and the cache entry records that only the first stage has run.
+/// A later non-declaration request for the same ID resumes from the saved
+/// offset and materializes the body. There is deliberately no separate
+/// summary record in the module format; the function record already is the
+/// summary, and a client that wants a body (such as the inliner's cost
+/// model, which walks instructions) needs the real thing anyway.
 llvm::Expected<SILFunction *>
 SILDeserializer::readSILFunctionChecked(DeclID FID, SILFunction *existingFn,
                                         StringRef name, bool declarationOnly,
@@ -975,6 +975,20 @@ ModuleFile::readDerivativeFunctionConfigTable(ArrayRef<uint64_t> fields,
       base + tableOffset, base + sizeof(uint32_t), base));
 }
 
+/// Read the index block, which maps the module's decls, types, and
+/// identifiers to their offsets within the bitstream.
+///
+/// This is the only part of the file that is decoded eagerly; everything it
+/// points at is left in place in the memory-mapped buffer. The name lookup
+/// tables (TOP_LEVEL_DECLS, OPERATORS, and friends) are llvm on-disk hash
+/// tables whose readers resolve queries by pointer arithmetic directly into
+/// the blob, and the offset arrays only tell us where to drop a cursor when a
+/// particular entity is first requested; the entity's records are not decoded
+/// until then. The offset arrays themselves do have to be copied out: they
+/// are bit-packed in the bitstream rather than stored at a fixed width, and
+/// for decls and types the array doubles as the side table that caches the
+/// deserialized pointer, so it must be mutable and sized for in-memory use
+/// regardless of how the file lays it out.
 bool ModuleFile::readIndexBlock(llvm::BitstreamCursor &cursor) {
   if (llvm::Error Err = cursor.EnterSubBlock(INDEX_BLOCK_ID)) {
     // FIXME this drops the error on the floor.
@@ -1473,7 +1487,8 @@ public:
 };
 
 std::unique_ptr<ModuleFile::SerializedDeclUSRTable>
-ModuleFile::readDeclUSRsTable(ArrayRef<uint64_t> fields, StringRef blobData) {
+ModuleFile::readDeclUSRsTable(ArrayRef<uint64_t> fields,
+                              StringRef blobData) const {
   if (fields.empty() || blobData.empty())
     return nullptr;
   uint32_t tableOffset = static_cast<uint32_t>(fields.front());
@@ -1483,7 +1498,7 @@ ModuleFile::readDeclUSRsTable(ArrayRef<uint64_t> fields, StringRef blobData) {
                                    base));
 }
 
-bool ModuleFile::readDeclLocsBlock(llvm::BitstreamCursor &cursor) {
+bool ModuleFile::readDeclLocsBlock(llvm::BitstreamCursor &cursor) const {
   if (llvm::Error Err = cursor.EnterSubBlock(CONTROL_BLOCK_ID)) {
     consumeError(std::move(Err));
     return false;
@@ -1543,10 +1558,16 @@ bool ModuleFile::readDeclLocsBlock(llvm::BitstreamCursor &cursor) {
   return false;
 }
 
-bool ModuleFile::readModuleSourceInfoIfPresent() {
+bool ModuleFile::readModuleSourceInfoIfPresent() const {
   if (!this->ModuleSourceInfoInputBuffer)
     return true;
 
+  // Only decode the buffer once; malformed data should not be reprocessed on
+  // every query.
+  if (TriedReadingSourceInfo)
+    return true;
+  TriedReadingSourceInfo = true;
+
   llvm::BitstreamCursor infoCursor{ModuleSourceInfoInputBuffer->getMemBufferRef()};
   if (!checkModuleSignature(infoCursor, SWIFTSOURCEINFO_SIGNATURE) ||
       !enterTopLevelModuleBlock(infoCursor, MODULE_SOURCEINFO_BLOCK_ID)) {
@@ -1965,8 +1986,8 @@ ModuleFile::ModuleFile(
     info.status = error(Status::Malformed);
     return;
   }
-  // Read source info file.
-  readModuleSourceInfoIfPresent();
+  // The source info file, if present, is decoded lazily on the first
+  // location query; see getBasicDeclLocsForDecl().
   if (!readModuleDocIfPresent()) {
     info.status = error(Status::MalformedDocumentation);
     return;
@@ -2789,6 +2810,8 @@ ModuleFile::getBasicDeclLocsForDecl(const Decl *D) const {
          "cannot find comments for Clang decls in Swift modules");
   assert(D->getDeclContext()->getModuleScopeContext() == FileContext &&
          "Decl is from a different serialized file");
+  // Decode the source info file on the first query.
+  readModuleSourceInfoIfPresent();
   if (!DeclUSRsTable)
     return None;
   // Future compilers may not provide BasicDeclLocsData anymore.
@@ -419,7 +419,7 @@ private:
   class DeclUSRTableInfo;
   using SerializedDeclUSRTable =
       llvm::OnDiskIterableChainedHashTable<DeclUSRTableInfo>;
-  std::unique_ptr<SerializedDeclUSRTable> DeclUSRsTable;
+  mutable std::unique_ptr<SerializedDeclUSRTable> DeclUSRsTable;
 
   class DerivativeFunctionConfigTableInfo;
   using SerializedDerivativeFunctionConfigTable =
@@ -428,15 +428,19 @@ private:
       DerivativeFunctionConfigurations;
 
   /// A blob of 0 terminated string segments referenced in \c SourceLocsTextData
-  StringRef SourceLocsTextData;
+  mutable StringRef SourceLocsTextData;
 
   /// An array of fixed size source location data for each USR appearing in
   /// \c DeclUSRsTable.
-  StringRef BasicDeclLocsData;
+  mutable StringRef BasicDeclLocsData;
 
   /// An array of fixed-size location data for each `SingleRawComment` piece
   /// of declaration's documentation `RawComment`s.
-  StringRef DocRangesData;
+  mutable StringRef DocRangesData;
+
+  /// Whether an attempt was already made to decode the source info file.
+  /// The blobs above are decoded lazily, on the first location query.
+  mutable bool TriedReadingSourceInfo = false;
 
   struct ModuleBits {
     /// The decl ID of the main class in this module file, if it has one.
@@ -592,17 +596,21 @@ private:
   /// Reads the source loc block, which contains USR to decl location mapping.
   ///
   /// Returns false if there was an error.
-  bool readDeclLocsBlock(llvm::BitstreamCursor &cursor);
+  bool readDeclLocsBlock(llvm::BitstreamCursor &cursor) const;
 
   /// Loads data from #ModuleSourceInfoInputBuffer.
   ///
+  /// The buffer is opened when the module is loaded, but it is only decoded
+  /// here, on the first source location query, so modules whose locations
+  /// are never asked for do not pay for it.
+  ///
   /// Returns false if there was an error.
-  bool readModuleSourceInfoIfPresent();
+  bool readModuleSourceInfoIfPresent() const;
 
   /// Read an on-disk decl hash table stored in
   /// \c sourceinfo_block::DeclUSRSLayout format.
   std::unique_ptr<SerializedDeclUSRTable>
-  readDeclUSRsTable(ArrayRef<uint64_t> fields, StringRef blobData);
+  readDeclUSRsTable(ArrayRef<uint64_t> fields, StringRef blobData) const;
 
   /// Recursively reads a pattern from \c DeclTypeCursor.
   llvm::Expected<Pattern *> readPattern(DeclContext *owningDC);
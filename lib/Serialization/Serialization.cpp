@@ -4402,6 +4402,15 @@ bool Serializer::writeASTBlockEntitiesIfNeeded(
   return true;
 }
 
+/// Write out all decls and types in the serialization queues, in order.
+///
+/// Note that this always re-encodes every record from scratch. Splicing
+/// unchanged records forward from a previous .swiftmodule is not possible
+/// with this encoding: decl, type, and identifier IDs are allocated in
+/// encounter order during a particular serialization run, so the bytes of a
+/// record depend on the history of the whole run, and a single edited decl
+/// renumbers everything serialized after it. Record reuse would first
+/// require IDs that are stable across rebuilds.
 void Serializer::writeAllDeclsAndTypes() {
   BCBlockRAII restoreBlock(Out, DECLS_AND_TYPES_BLOCK_ID, 8);
   using namespace decls_block;
@@ -5167,6 +5176,10 @@ void SerializerBase::writeToStream(raw_ostream &os) {
 
 SerializerBase::SerializerBase(ArrayRef<unsigned char> signature,
                                ModuleOrSourceFile DC) {
+  // Modules are commonly at least this large; reserving up front avoids
+  // repeatedly reallocating and copying the buffer as the bitstream grows.
+  Buffer.reserve(256 * 1024);
+
   for (unsigned char byte : signature)
     Out.Emit(byte, 8);
 
@@ -5174,6 +5187,16 @@ SerializerBase::SerializerBase(ArrayRef<unsigned char> signature,
   this->SF = DC.dyn_cast<SourceFile *>();
 }
 
+/// Serialize a module to a stream.
+///
+/// Encoding happens in one pass on the calling thread, and that is load
+/// bearing: the serializer assigns decl/type/identifier IDs in the order it
+/// encounters them and writes them into a single BitstreamWriter, and
+/// serializing a decl can trigger lazy loading and other mutation of the
+/// shared AST. Handing blocks to a background encoder thread would race on
+/// both, so the way this work overlaps the rest of the pipeline is placement
+/// rather than threading: the SerializeSILAction hook runs serialization at
+/// the right point in the SIL pipeline instead of as a tail after it.
 void Serializer::writeToStream(raw_ostream &os, ModuleOrSourceFile DC,
                                const SILModule *SILMod,
                                const SerializationOptions &options) {
@@ -443,6 +443,25 @@ std::string SerializedModuleBaseName::getName(file_types::ID fileTy) const {
   return std::string(result.str());
 }
 
+Optional<bool>
+SerializedModuleLoaderBase::searchPathContains(llvm::vfs::FileSystem &fs,
+                                               StringRef directoryPath,
+                                               StringRef entryName) {
+  auto &cachedContents = SearchPathContentsCache[directoryPath];
+  if (!cachedContents.hasValue()) {
+    llvm::StringSet<> contents;
+    std::error_code errorCode;
+    llvm::vfs::directory_iterator DI = fs.dir_begin(directoryPath, errorCode);
+    llvm::vfs::directory_iterator End;
+    for (; !errorCode && DI != End; DI.increment(errorCode))
+      contents.insert(llvm::sys::path::filename(DI->path()));
+    if (errorCode)
+      return None;
+    cachedContents.emplace(std::move(contents));
+  }
+  return cachedContents->count(entryName) != 0;
+}
+
 bool
 SerializedModuleLoaderBase::findModule(AccessPathElem moduleID,
            SmallVectorImpl<char> *moduleInterfacePath,
@@ -526,13 +545,23 @@ SerializedModuleLoaderBase::findModule(AccessPathElem moduleID,
             // always use single-architecture swiftmodules.
             checkTargetSpecificModule = Ctx.LangOpts.Target.isOSDarwin();
           } else {
-            auto modulePath = currPath;
-            llvm::sys::path::append(modulePath, genericModuleFileName);
-
-            llvm::ErrorOr<llvm::vfs::Status> statResult = fs.status(modulePath);
-            // Even if stat fails, we can't just return the error; the path
-            // we're looking for might not be "Foo.swiftmodule".
-            checkTargetSpecificModule = statResult && statResult->isDirectory();
+            // Check the cached directory listing first; if the search path
+            // doesn't contain "Foo.swiftmodule" at all there is no need to
+            // stat it to find out whether it's a directory.
+            auto contains = searchPathContains(fs, path, genericModuleFileName);
+            if (contains && !*contains) {
+              checkTargetSpecificModule = false;
+            } else {
+              auto modulePath = currPath;
+              llvm::sys::path::append(modulePath, genericModuleFileName);
+
+              llvm::ErrorOr<llvm::vfs::Status> statResult =
+                  fs.status(modulePath);
+              // Even if stat fails, we can't just return the error; the path
+              // we're looking for might not be "Foo.swiftmodule".
+              checkTargetSpecificModule =
+                  statResult && statResult->isDirectory();
+            }
           }
 
           if (checkTargetSpecificModule)
@@ -553,10 +582,14 @@ SerializedModuleLoaderBase::findModule(AccessPathElem moduleID,
         }
         case SearchPathKind::Framework: {
           isFramework = true;
-          llvm::sys::path::append(currPath, moduleName + ".framework");
-
-          // Check if the framework directory exists.
-          if (!fs.exists(currPath))
+          llvm::SmallString<64> frameworkName(moduleName);
+          frameworkName += ".framework";
+          llvm::sys::path::append(currPath, frameworkName);
+
+          // Check if the framework directory exists, consulting the cached
+          // directory listing before falling back to the filesystem.
+          auto contains = searchPathContains(fs, path, frameworkName);
+          if (contains ? !*contains : !fs.exists(currPath))
             return None;
 
           // Frameworks always use architecture-specific files within a
@@ -58,6 +58,47 @@ size_t swift_demangle_getSimplifiedDemangledName(const char *MangledName,
                                                  Length, Opts);
 }
 
+size_t swift_demangle_getDemangledNames(const char *const *MangledNames,
+                                        size_t NumNames,
+                                        char *OutputBuffer, size_t Length,
+                                        size_t *OutputUsed) {
+  assert((MangledNames != nullptr || NumNames == 0) && "null input");
+  assert(OutputBuffer != nullptr || Length == 0);
+
+  swift::Demangle::DemangleOptions DemangleOptions;
+  DemangleOptions.SynthesizeSugarOnTypes = true;
+
+  // One context, and with it one demangler arena, is reused for all symbols.
+  // Clearing the context recycles its largest slab, so after the first few
+  // symbols demangling stops hitting the allocator altogether.
+  swift::Demangle::Context DCtx;
+
+  size_t Used = 0;
+  size_t NumProcessed = 0;
+  for (; NumProcessed != NumNames; ++NumProcessed) {
+    const char *MangledName = MangledNames[NumProcessed];
+    assert(MangledName != nullptr && "null input");
+
+    std::string Result;
+    if (swift::Demangle::isSwiftSymbol(MangledName)) {
+      Result = DCtx.demangleSymbolAsString(llvm::StringRef(MangledName),
+                                           DemangleOptions);
+      if (Result == MangledName)
+        Result.clear(); // Not a mangled name
+      DCtx.clear();
+    }
+
+    // Stop before writing a partial result.
+    if (Result.size() + 1 > Length - Used)
+      break;
+    memcpy(OutputBuffer + Used, Result.c_str(), Result.size() + 1);
+    Used += Result.size() + 1;
+  }
+  if (OutputUsed)
+    *OutputUsed = Used;
+  return NumProcessed;
+}
+
 size_t swift_demangle_getModuleName(const char *MangledName,
                                     char *OutputBuffer,
                                     size_t Length) {
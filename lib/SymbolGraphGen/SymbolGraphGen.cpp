@@ -51,6 +51,15 @@ int serializeSymbolGraph(SymbolGraph &SG,
 // MARK: - Main Entry Point
 
 /// Emit a symbol graph JSON file for a `ModuleDecl`.
+///
+/// Both phases here are serial by necessity, not oversight. The walk
+/// obviously mutates shared AST state, but so does serialization: rendering
+/// a symbol's declaration fragments, USR, and doc comment pulls lazily
+/// computed information out of the decls, so handing each per-extended-
+/// module graph to its own thread would race inside the ASTContext. The
+/// useful unit of parallelism is the one that already exists -- each module
+/// is an independent emission with independent output files -- so fan out
+/// across modules at the job level.
 int
 symbolgraphgen::emitSymbolGraphForModule(ModuleDecl *M,
                                          const SymbolGraphOptions &Options) {
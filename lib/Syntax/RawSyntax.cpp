@@ -88,7 +88,7 @@ RawSyntax::RawSyntax(SyntaxKind Kind, ArrayRef<RC<RawSyntax>> Layout,
   Bits.Layout.NumChildren = Layout.size();
   Bits.Layout.TextLength = UINT32_MAX;
 
-  this->Arena = Arena;
+  this->Arena = Arena.get();
 
   // Initialize layout data.
   std::uninitialized_copy(Layout.begin(), Layout.end(),
@@ -114,7 +114,7 @@ RawSyntax::RawSyntax(tok TokKind, OwnedString Text,
   Bits.Token.NumLeadingTrivia = LeadingTrivia.size();
   Bits.Token.NumTrailingTrivia = TrailingTrivia.size();
 
-  this->Arena = Arena;
+  this->Arena = Arena.get();
 
   // Initialize token text.
   ::new (static_cast<void *>(getTrailingObjects<OwnedString>()))
@@ -174,7 +174,14 @@ RC<RawSyntax> RawSyntax::append(RC<RawSyntax> NewLayoutElement) const {
   NewLayout.reserve(Layout.size() + 1);
   std::copy(Layout.begin(), Layout.end(), std::back_inserter(NewLayout));
   NewLayout.push_back(NewLayoutElement);
-  return RawSyntax::make(getKind(), NewLayout, SourcePresence::Present);
+  // Allocate the new node in this node's arena. The reused children are not
+  // individually reference counted if they are arena-allocated, so the new
+  // root must keep their arena alive. If the new element lives in a different
+  // arena, keep that one alive as well.
+  RC<SyntaxArena> Arena = getArena();
+  if (Arena && NewLayoutElement)
+    Arena->addChildArena(NewLayoutElement->getArena());
+  return RawSyntax::make(getKind(), NewLayout, SourcePresence::Present, Arena);
 }
 
 RC<RawSyntax> RawSyntax::replaceChild(CursorIndex Index,
@@ -191,7 +198,13 @@ RC<RawSyntax> RawSyntax::replaceChild(CursorIndex Index,
   std::copy(Layout.begin() + Index + 1, Layout.end(),
             std::back_inserter(NewLayout));
 
-  return RawSyntax::make(getKind(), NewLayout, getPresence());
+  // As in append(), the new node must be allocated in this node's arena so
+  // that the arena owning the reused children outlives any tree rooted at the
+  // new node.
+  RC<SyntaxArena> Arena = getArena();
+  if (Arena && NewLayoutElement)
+    Arena->addChildArena(NewLayoutElement->getArena());
+  return RawSyntax::make(getKind(), NewLayout, getPresence(), Arena);
 }
 
 llvm::Optional<AbsolutePosition>
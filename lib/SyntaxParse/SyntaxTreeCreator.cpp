@@ -122,14 +122,19 @@ SyntaxTreeCreator::recordToken(tok tokenKind,
   CharSourceRange tokRange = CharSourceRange{tokLoc, tokLength};
   SourceLoc leadingTriviaLoc = range.getStart();
   SourceLoc trailingTriviaLoc = tokLoc.getAdvancedLoc(tokLength);
+  // Copy token and trivia text into the arena. The resulting nodes then own
+  // no memory individually and the whole tree is torn down by dropping the
+  // arena.
   Trivia syntaxLeadingTrivia =
     ParsedTriviaPiece::convertToSyntaxTrivia(leadingTriviaPieces,
-                                             leadingTriviaLoc, SM, BufferID);
+                                             leadingTriviaLoc, SM, BufferID,
+                                             *Arena);
   Trivia syntaxTrailingTrivia =
     ParsedTriviaPiece::convertToSyntaxTrivia(trailingTriviaPieces,
-                                             trailingTriviaLoc, SM, BufferID);
+                                             trailingTriviaLoc, SM, BufferID,
+                                             *Arena);
   StringRef tokenText = SM.extractText(tokRange, BufferID);
-  auto ownedText = OwnedString::makeRefCounted(tokenText);
+  auto ownedText = OwnedString::makeUnowned(Arena->copyString(tokenText));
   auto raw = TokenCache->getToken(Arena, tokenKind, ownedText,
                     syntaxLeadingTrivia.Pieces, syntaxTrailingTrivia.Pieces);
   OpaqueSyntaxNode opaqueN = raw.get();
@@ -139,7 +144,8 @@ SyntaxTreeCreator::recordToken(tok tokenKind,
 
 OpaqueSyntaxNode
 SyntaxTreeCreator::recordMissingToken(tok kind, SourceLoc loc) {
-  auto ownedText = OwnedString::makeRefCounted(getTokenText(kind));
+  // Token spellings are static strings; no need to copy them anywhere.
+  auto ownedText = OwnedString::makeUnowned(getTokenText(kind));
   auto raw = RawSyntax::missing(kind, ownedText, Arena);
   OpaqueSyntaxNode opaqueN = raw.get();
   raw.resetWithoutRelease();
@@ -169,6 +175,10 @@ SyntaxTreeCreator::lookupNode(size_t lexerOffset, syntax::SyntaxKind kind) {
   if (!cacheLookup)
     return {0, nullptr};
   RC<RawSyntax> raw = cacheLookup->getRaw();
+  // The reused subtree lives in the previous parse's arena. Keep that arena
+  // alive for as long as the tree we are currently building.
+  if (auto *nodeArena = raw->getArena())
+    Arena->addChildArena(nodeArena);
   OpaqueSyntaxNode opaqueN = raw.get();
   size_t length = raw->getTextLength();
   raw.resetWithoutRelease();
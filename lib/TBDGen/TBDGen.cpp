@@ -12,6 +12,14 @@
 //
 //  This file implements the entrypoints into TBD file generation.
 //
+//  TBD generation is deliberately independent of IRGen: it enumerates the
+//  exported symbols from the type-checked AST alone, using LinkEntity and
+//  SILDeclRef manglings and UniversalLinkageInfo, without constructing an
+//  IRGenModule or lowering any SIL. This keeps it cheap enough to run as a
+//  supplementary output of a plain -typecheck invocation, which is the
+//  fastest way to produce a TBD for a module (no SILGen, SIL passes, or
+//  IR generation runs in that mode).
+//
 //===----------------------------------------------------------------------===//
 
 #include "swift/TBDGen/TBDGen.h"
@@ -180,25 +180,55 @@ TypeRefBuilder::getFieldTypeInfo(const TypeRef *TR) {
   if (Found != FieldTypeInfoCache.end())
     return Found->second;
 
-  // On failure, fill out the cache with everything we know about.
-  std::vector<std::pair<std::string, const TypeRef *>> Fields;
-  for (auto &Info : ReflectionInfos) {
+  // On failure, index any images we haven't seen yet and try again.
+  populateDescriptorCaches();
+
+  Found = FieldTypeInfoCache.find(MangledName);
+  if (Found != FieldTypeInfoCache.end())
+    return Found->second;
+
+  return nullptr;
+}
+
+void TypeRefBuilder::populateDescriptorCaches() {
+  for (size_t i = ProcessedReflectionInfos, e = ReflectionInfos.size();
+       i != e; ++i) {
+    auto &Info = ReflectionInfos[i];
+
     for (auto FD : Info.Field) {
       if (!FD->hasMangledTypeName())
         continue;
       auto CandidateMangledName = readTypeRef(FD, FD->MangledTypeName);
       auto NormalizedName = normalizeReflectionName(CandidateMangledName);
-      FieldTypeInfoCache[NormalizedName] = FD;
+      FieldTypeInfoCache.insert({std::move(NormalizedName), FD});
       Dem.clear();
     }
-  }
 
-  // We've filled the cache with everything we know about now. Try the cache again.
-  Found = FieldTypeInfoCache.find(MangledName);
-  if (Found != FieldTypeInfoCache.end())
-    return Found->second;
+    for (auto BuiltinTypeDescriptor : Info.Builtin) {
+      if (BuiltinTypeDescriptor->Stride <= 0)
+        continue;
+      if (!BuiltinTypeDescriptor->hasMangledTypeName())
+        continue;
 
-  return nullptr;
+      auto Alignment = BuiltinTypeDescriptor->getAlignment();
+      if (Alignment <= 0)
+        continue;
+      // Reject any alignment that's not a power of two.
+      if (Alignment & (Alignment - 1))
+        continue;
+
+      auto CandidateMangledName =
+        readTypeRef(BuiltinTypeDescriptor, BuiltinTypeDescriptor->TypeName);
+      auto NormalizedName = normalizeReflectionName(CandidateMangledName);
+      BuiltinTypeInfoCache.insert({std::move(NormalizedName),
+                                   BuiltinTypeDescriptor});
+      Dem.clear();
+    }
+
+    for (auto CD : Info.Capture)
+      CaptureDescriptorCache.insert({CD.getAddressData(), CD});
+  }
+  ProcessedReflectionInfos = ReflectionInfos.size();
 }
 
 bool TypeRefBuilder::getFieldTypeRefs(
@@ -254,40 +284,30 @@ TypeRefBuilder::getBuiltinTypeInfo(const TypeRef *TR) {
   else
     return nullptr;
 
-  for (auto Info : ReflectionInfos) {
-    for (auto BuiltinTypeDescriptor : Info.Builtin) {
-      if (BuiltinTypeDescriptor->Stride <= 0)
-        continue;
-      if (!BuiltinTypeDescriptor->hasMangledTypeName())
-        continue;
+  auto Found = BuiltinTypeInfoCache.find(MangledName);
+  if (Found != BuiltinTypeInfoCache.end())
+    return Found->second;
 
-      auto Alignment = BuiltinTypeDescriptor->getAlignment();
-      if (Alignment <= 0)
-        continue;
-      // Reject any alignment that's not a power of two.
-      if (Alignment & (Alignment - 1))
-        continue;
+  populateDescriptorCaches();
 
-      auto CandidateMangledName =
-        readTypeRef(BuiltinTypeDescriptor, BuiltinTypeDescriptor->TypeName);
-      if (!reflectionNameMatches(CandidateMangledName, MangledName))
-        continue;
-      return BuiltinTypeDescriptor;
-    }
-  }
+  Found = BuiltinTypeInfoCache.find(MangledName);
+  if (Found != BuiltinTypeInfoCache.end())
+    return Found->second;
 
   return nullptr;
 }
 
 RemoteRef<CaptureDescriptor>
 TypeRefBuilder::getCaptureDescriptor(uint64_t RemoteAddress) {
-  for (auto Info : ReflectionInfos) {
-    for (auto CD : Info.Capture) {
-      if (RemoteAddress == CD.getAddressData()) {
-        return CD;
-      }
-    }
-  }
+  auto Found = CaptureDescriptorCache.find(RemoteAddress);
+  if (Found != CaptureDescriptorCache.end())
+    return Found->second;
+
+  populateDescriptorCaches();
+
+  Found = CaptureDescriptorCache.find(RemoteAddress);
+  if (Found != CaptureDescriptorCache.end())
+    return Found->second;
 
   return nullptr;
 }
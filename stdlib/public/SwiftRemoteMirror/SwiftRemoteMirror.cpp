@@ -23,6 +23,7 @@ unsigned long long swift_reflection_classIsSwiftMask = 2;
 #include "swift/Reflection/ReflectionContext.h"
 #include "swift/Reflection/TypeLowering.h"
 #include "swift/Remote/CMemoryReader.h"
+#include "swift/Remote/CachingMemoryReader.h"
 #include "swift/Runtime/Unreachable.h"
 
 #if defined(__APPLE__) && defined(__MACH__)
@@ -38,12 +39,14 @@ using NativeReflectionContext = swift::reflection::ReflectionContext<
 
 struct SwiftReflectionContext {
   NativeReflectionContext *nativeContext;
+  std::shared_ptr<CachingMemoryReader> reader;
   std::vector<std::function<void()>> freeFuncs;
   std::vector<std::tuple<swift_addr_t, swift_addr_t>> dataSegments;
-  
+
   SwiftReflectionContext(MemoryReaderImpl impl) {
-    auto Reader = std::make_shared<CMemoryReader>(impl);
-    nativeContext = new NativeReflectionContext(Reader);
+    reader = std::make_shared<CachingMemoryReader>(
+        std::make_shared<CMemoryReader>(impl));
+    nativeContext = new NativeReflectionContext(reader);
   }
   
   ~SwiftReflectionContext() {
@@ -160,6 +163,10 @@ void swift_reflection_destroyReflectionContext(SwiftReflectionContextRef Context
   delete ContextRef;
 }
 
+void swift_reflection_invalidateMemoryCache(SwiftReflectionContextRef ContextRef) {
+  ContextRef->reader->invalidateCache();
+}
+
 template<typename Iterator>
 ReflectionSection<Iterator> sectionFromInfo(const swift_reflection_info_t &Info,
                               const swift_reflection_section_pair_t &Section) {
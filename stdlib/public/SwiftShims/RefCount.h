@@ -1238,6 +1238,12 @@ class RefCounts {
   // Use this when creating a new weak reference to an object.
   HeapObjectSideTableEntry* formWeakReference();
 
+  // Like formWeakReference, but the weak count update is non-atomic.
+  // The side table installation itself is still atomic so that a
+  // thread-local weak reference does not conflict with unowned or
+  // strong overflow from other threads.
+  HeapObjectSideTableEntry* formWeakReferenceNonAtomic();
+
   // Increment the weak reference count.
   void incrementWeak() {
     auto oldbits = refCounts.load(SWIFT_MEMORY_ORDER_CONSUME);
@@ -1252,7 +1258,19 @@ class RefCounts {
     } while (!refCounts.compare_exchange_weak(oldbits, newbits,
                                               std::memory_order_relaxed));
   }
-  
+
+  void incrementWeakNonAtomic() {
+    auto oldbits = refCounts.load(SWIFT_MEMORY_ORDER_CONSUME);
+    auto newbits = oldbits;
+    assert(newbits.getWeakRefCount() != 0);
+    newbits.incrementWeakRefCount();
+
+    if (newbits.getWeakRefCount() < oldbits.getWeakRefCount())
+      swift_abortWeakRetainOverflow();
+
+    refCounts.store(newbits, std::memory_order_relaxed);
+  }
+
   bool decrementWeakShouldCleanUp() {
     auto oldbits = refCounts.load(SWIFT_MEMORY_ORDER_CONSUME);
     RefCountBits newbits;
@@ -1330,6 +1348,13 @@ class HeapObjectSideTableEntry {
       return nullptr;
   }
 
+  HeapObject* tryRetainNonAtomic() {
+    if (refCounts.tryIncrementNonAtomic())
+      return object.load(std::memory_order_relaxed);
+    else
+      return nullptr;
+  }
+
   void initRefCounts(InlineRefCountBits newbits) {
     refCounts.init(newbits);
   }
@@ -1432,6 +1457,15 @@ class HeapObjectSideTableEntry {
     return this;
   }
 
+  LLVM_NODISCARD
+  HeapObjectSideTableEntry* incrementWeakNonAtomic() {
+    // See incrementWeak for why the deiniting check need not be atomic.
+    if (refCounts.isDeiniting())
+      return nullptr;
+    refCounts.incrementWeakNonAtomic();
+    return this;
+  }
+
   void decrementWeak() {
     // FIXME: assertions
     // FIXME: optimize barriers
@@ -122,11 +122,40 @@ public class AnyKeyPath: Hashable, _AppendKeyPath {
   // SPI for the Foundation overlay to allow interop with KVC keypath-based
   // APIs.
   public var _kvcKeyPathString: String? {
+    guard getOffsetFromStorage() == nil else { return nil }
     guard let ptr = _kvcKeyPathStringPtr else { return nil }
 
     return String(validatingUTF8: ptr)
   }
-  
+
+  // A key path that traverses only stored struct properties reduces to a
+  // single byte offset from its root. We cache that offset at instantiation
+  // time in the storage for the KVC string pointer, which such key paths
+  // never have, so that projection becomes a load at a precomputed offset
+  // instead of an interpretation of the component buffer. The offset is
+  // encoded as the bit pattern -(offset + 1), which is negative and
+  // therefore never a valid userspace pointer on 64-bit targets; 32-bit
+  // targets have no such reserved range, so they skip the cache.
+  internal final func assignOffsetToStorage(offset: Int) {
+    guard MemoryLayout<Int>.size == 8,
+          offset >= 0,
+          _kvcKeyPathStringPtr == nil else {
+      return
+    }
+    _kvcKeyPathStringPtr = UnsafePointer<CChar>(bitPattern: -offset - 1)
+  }
+
+  internal final func getOffsetFromStorage() -> Int? {
+    guard MemoryLayout<Int>.size == 8,
+          let stored = _kvcKeyPathStringPtr else {
+      return nil
+    }
+    let value = Int(bitPattern: stored)
+    guard value < 0 else { return nil }
+    return -value - 1
+  }
+
+
   // MARK: Implementation details
   
   // Prevent normal initialization. We use tail allocation via
@@ -234,6 +263,15 @@ public class KeyPath<Root, Value>: PartialKeyPath<Root> {
   
   @usableFromInline
   internal final func _projectReadOnly(from root: Root) -> Value {
+    // A pure-offset key path projects with a single load; see
+    // assignOffsetToStorage(offset:).
+    if let offset = getOffsetFromStorage() {
+      return withUnsafeBytes(of: root) {
+        $0.baseAddress.unsafelyUnwrapped.load(fromByteOffset: offset,
+                                              as: Value.self)
+      }
+    }
+
     // TODO: For perf, we could use a local growable buffer instead of Any
     var curBase: Any = root
     return withBuffer {
@@ -290,10 +328,20 @@ public class WritableKeyPath<Root, Value>: KeyPath<Root, Value> {
   @usableFromInline
   internal func _projectMutableAddress(from base: UnsafePointer<Root>)
       -> (pointer: UnsafeMutablePointer<Value>, owner: AnyObject?) {
+    // A pure-offset key path projects by offsetting the base address; there
+    // is no reference prefix, so there is nothing to keep alive. See
+    // assignOffsetToStorage(offset:).
+    if let offset = getOffsetFromStorage() {
+      let typedPointer = (UnsafeRawPointer(base) + offset)
+        .assumingMemoryBound(to: Value.self)
+      return (pointer: UnsafeMutablePointer(mutating: typedPointer),
+              owner: nil)
+    }
+
     var p = UnsafeRawPointer(base)
     var type: Any.Type = Root.self
     var keepAlive: AnyObject?
-    
+
     return withBuffer {
       var buffer = $0
       
@@ -2248,7 +2296,11 @@ internal func _appendingKeyPaths<
       // KVC-compatible.
       let appendedKVCLength: Int, rootKVCLength: Int, leafKVCLength: Int
 
-      if let rootPtr = root._kvcKeyPathStringPtr,
+      // The KVC string pointer storage may hold a cached offset instead of
+      // a string; such key paths are not KVC-compatible.
+      if root.getOffsetFromStorage() == nil,
+         leaf.getOffsetFromStorage() == nil,
+         let rootPtr = root._kvcKeyPathStringPtr,
          let leafPtr = leaf._kvcKeyPathStringPtr {
         rootKVCLength = Int(_swift_stdlib_strlen(rootPtr))
         leafKVCLength = Int(_swift_stdlib_strlen(leafPtr))
@@ -2385,6 +2437,13 @@ internal func _appendingKeyPaths<
         kvcStringBuffer.advanced(by: rootKVCLength + leafKVCLength + 1)
           .storeBytes(of: 0 /* '\0' */, as: CChar.self)
       }
+
+      // If the combined path is all stored struct offsets, cache the
+      // flattened offset so projections skip the component buffer.
+      if result._kvcKeyPathStringPtr == nil,
+         let offset = result._storedInlineOffset {
+        result.assignOffsetToStorage(offset: offset)
+      }
       return unsafeDowncast(result, to: Result.self)
     }
   }
@@ -2489,6 +2548,15 @@ public func _swift_getKeyPath(pattern: UnsafeMutableRawPointer,
       kvcStringPtr.assumingMemoryBound(to: CChar.self)
   }
 
+  // If the key path traverses only stored struct properties, cache the
+  // flattened byte offset in the unused KVC string storage so that repeated
+  // projections become a load at a known offset instead of an
+  // interpretation of the component buffer.
+  if instance._kvcKeyPathStringPtr == nil,
+     let offset = instance._storedInlineOffset {
+    instance.assignOffsetToStorage(offset: offset)
+  }
+
   // If we can cache this instance as a shared instance, do so.
   if let oncePtr = oncePtr {
     // Try to replace a null pointer in the cache variable with the instance
@@ -42,10 +42,19 @@ struct HashableConformanceEntry {
   /// don't have to deal with cache invalidation.
   const Metadata *baseTypeThatConformsToHashable;
 
+  /// The witness table for the `Hashable` conformance of `derivedType`,
+  /// resolved once per metadata pointer so that repeated boxing and
+  /// comparison of the same type doesn't rescan the conformance records.
+  ///
+  /// Always non-NULL.
+  const WitnessTable *hashableWT;
+
   HashableConformanceEntry(HashableConformanceKey key,
-                           const Metadata *baseTypeThatConformsToHashable)
+                           const Metadata *baseTypeThatConformsToHashable,
+                           const WitnessTable *hashableWT)
       : derivedType(key.derivedType),
-        baseTypeThatConformsToHashable(baseTypeThatConformsToHashable) {}
+        baseTypeThatConformsToHashable(baseTypeThatConformsToHashable),
+        hashableWT(hashableWT) {}
 
   int compareWithKey(const HashableConformanceKey &key) const {
     if (key.derivedType != derivedType) {
@@ -57,7 +66,8 @@ struct HashableConformanceEntry {
 
   static size_t
   getExtraAllocationSize(HashableConformanceKey key,
-                         const Metadata *baseTypeThatConformsToHashable) {
+                         const Metadata *baseTypeThatConformsToHashable,
+                         const WitnessTable *hashableWT) {
     return 0;
   }
 
@@ -74,11 +84,12 @@ static ConcurrentMap<HashableConformanceEntry, /*Destructor*/ false>
 
 template<bool KnownToConformToHashable>
 LLVM_ATTRIBUTE_ALWAYS_INLINE
-static const Metadata *findHashableBaseTypeImpl(const Metadata *type) {
+static const HashableConformanceEntry *
+findHashableConformanceEntryImpl(const Metadata *type) {
   // Check the cache first.
   if (HashableConformanceEntry *entry =
           HashableConformances.find(HashableConformanceKey{type})) {
-    return entry->baseTypeThatConformsToHashable;
+    return entry;
   }
 
   auto witnessTable =
@@ -92,9 +103,19 @@ static const Metadata *findHashableBaseTypeImpl(const Metadata *type) {
   const auto *conformance = witnessTable->getDescription();
   const Metadata *baseTypeThatConformsToHashable =
     findConformingSuperclass(type, conformance);
-  HashableConformances.getOrInsert(HashableConformanceKey{type},
-                                   baseTypeThatConformsToHashable);
-  return baseTypeThatConformsToHashable;
+  return HashableConformances.getOrInsert(HashableConformanceKey{type},
+                                          baseTypeThatConformsToHashable,
+                                          witnessTable).first;
+}
+
+template<bool KnownToConformToHashable>
+LLVM_ATTRIBUTE_ALWAYS_INLINE
+static const Metadata *findHashableBaseTypeImpl(const Metadata *type) {
+  if (const HashableConformanceEntry *entry =
+          findHashableConformanceEntryImpl<KnownToConformToHashable>(type)) {
+    return entry->baseTypeThatConformsToHashable;
+  }
+  return nullptr;
 }
 
 /// Find the base type that introduces the `Hashable` conformance.
@@ -117,6 +138,19 @@ const Metadata *swift::hashable_support::findHashableBaseType(
   return findHashableBaseTypeImpl</*KnownToConformToHashable=*/ false>(type);
 }
 
+/// Find the witness table for `type`'s `Hashable` conformance, resolving
+/// it at most once per metadata pointer.
+/// If `type` does not conform to `Hashable`, `nullptr` is returned.
+const HashableWitnessTable *swift::hashable_support::findHashableConformance(
+    const Metadata *type) {
+  if (const HashableConformanceEntry *entry =
+          findHashableConformanceEntryImpl</*KnownToConformToHashable=*/ false>(
+              type)) {
+    return reinterpret_cast<const HashableWitnessTable *>(entry->hashableWT);
+  }
+  return nullptr;
+}
+
 // internal func _makeAnyHashableUsingDefaultRepresentation<H : Hashable>(
 //   of value: H,
 //   storingResultInto result: UnsafeMutablePointer<AnyHashable>)
@@ -153,11 +187,11 @@ void _swift_makeAnyHashableUpcastingToHashableBaseType(
       std::tie(unboxedType, unboxedValue) =
           getValueFromSwiftValue(srcSwiftValue);
 
-      if (auto unboxedHashableWT =
-              swift_conformsToProtocol(unboxedType, &HashableProtocolDescriptor)) {
+      if (auto unboxedHashableWT = findHashableConformance(unboxedType)) {
         _swift_makeAnyHashableUpcastingToHashableBaseType(
             const_cast<OpaqueValue *>(unboxedValue), anyHashableResultPointer,
-            unboxedType, unboxedHashableWT);
+            unboxedType,
+            reinterpret_cast<const WitnessTable *>(unboxedHashableWT));
         return;
       }
     }
@@ -58,6 +58,67 @@ static void array_pod_copy(ArrayCopy copyKind, OpaqueValue *dest,
   memmove(dest, src, stride * count);
 }
 
+/// Returns true if the array elements are single native-refcounted
+/// pointers, i.e. they use the shared Builtin.NativeObject value
+/// witnesses. Most arrays of Swift class references have this layout.
+static bool array_is_native_object(const ValueWitnessTable *wtable) {
+  return wtable == &VALUE_WITNESS_SYM(Bo);
+}
+
+/// Perform a copy operation on an array of single native-refcounted
+/// pointers by updating the reference counts directly, instead of making
+/// an indirect witness call per element.
+template <ArrayDest destOp, ArraySource srcOp, ArrayCopy copyKind>
+static void array_native_object_copy(OpaqueValue *dest, OpaqueValue *src,
+                                     size_t count) {
+  auto *to = reinterpret_cast<HeapObject **>(dest);
+  auto *from = reinterpret_cast<HeapObject **>(src);
+
+  if (destOp == ArrayDest::Init) {
+    // Initialization from a copy: blit the pointers, then retain them in
+    // one batch. Init entry points never overlap, and native takes are
+    // bitwise and were already handled above.
+    assert(srcOp == ArraySource::Copy && "takes of native objects are POD");
+    memcpy(to, from, count * sizeof(HeapObject *));
+    for (size_t i = 0; i < count; ++i)
+      swift_retain(to[i]);
+    return;
+  }
+
+  if (srcOp == ArraySource::Take) {
+    // Assignment from a take: drop the old references in one batch, then
+    // blit the new pointers over; the take transfers their retain counts.
+    for (size_t i = 0; i < count; ++i)
+      swift_release(to[i]);
+    memcpy(to, from, count * sizeof(HeapObject *));
+    return;
+  }
+
+  // Assignment from a copy; the ranges may overlap, so exchange the
+  // references element by element in the requested direction.
+  if (copyKind == ArrayCopy::BackToFront) {
+    assert(count != 0);
+    size_t i = count;
+    do {
+      --i;
+      auto *newValue = from[i];
+      auto *oldValue = to[i];
+      swift_retain(newValue);
+      to[i] = newValue;
+      swift_release(oldValue);
+    } while (i != 0);
+    return;
+  }
+
+  for (size_t i = 0; i < count; ++i) {
+    auto *newValue = from[i];
+    auto *oldValue = to[i];
+    swift_retain(newValue);
+    to[i] = newValue;
+    swift_release(oldValue);
+  }
+}
+
 namespace {
 typedef OpaqueValue *(*const WitnessFunction)(OpaqueValue *, OpaqueValue *,
                                               const Metadata *);
@@ -108,6 +169,13 @@ static void array_copy_operation(OpaqueValue *dest, OpaqueValue *src,
     }
   }
 
+  // Update reference counts directly if the elements are single
+  // native-refcounted pointers.
+  if (array_is_native_object(wtable)) {
+    array_native_object_copy<destOp, srcOp, copyKind>(dest, src, count);
+    return;
+  }
+
   // Call the witness to do the copy.
   if (copyKind == ArrayCopy::NoAlias || copyKind == ArrayCopy::FrontToBack) {
     auto copy = get_witness_function<destOp, srcOp>(wtable);
@@ -201,6 +269,15 @@ void swift_arrayDestroy(OpaqueValue *begin, size_t count, const Metadata *self)
   if (wtable->isPOD())
     return;
 
+  // Arrays of single native-refcounted pointers can drop their references
+  // directly.
+  if (array_is_native_object(wtable)) {
+    auto *objects = reinterpret_cast<HeapObject **>(begin);
+    for (size_t i = 0; i < count; ++i)
+      swift_release(objects[i]);
+    return;
+  }
+
   auto stride = wtable->getStride();
   for (size_t i = 0; i < count; ++i) {
     auto offset = i * stride;
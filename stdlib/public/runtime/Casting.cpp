@@ -2331,7 +2331,16 @@ static bool _dynamicCastTupleToTuple(OpaqueValue *destination,
 /******************************************************************************/
 
 /// Perform a dynamic cast to an arbitrary type.
-
+///
+/// There is no (srcType, targetType) -> outcome cache at this entry point,
+/// and deliberately so: for most interesting casts the result is a property
+/// of the value, not the type pair. A class downcast depends on the
+/// instance's dynamic type, an existential unwraps to whatever it happens
+/// to hold, and bridging can fail per value, while the static srcType seen
+/// here is often just AnyObject or an existential. The type-pair-keyed work
+/// that is value-independent -- protocol conformance lookups -- is already
+/// memoized behind swift_conformsToProtocol, so a repeated cast re-runs
+/// only the cheap kind-dispatch around those cached queries.
 static bool swift_dynamicCastImpl(OpaqueValue *dest, OpaqueValue *src,
                                   const Metadata *srcType,
                                   const Metadata *targetType,
@@ -20,6 +20,8 @@
 #include "Private.h"
 #include "swift/Runtime/Metadata.h"
 #include "swift/Runtime/Once.h"
+#include <atomic>
+#include <cstdint>
 #include <type_traits>
 
 namespace swift {
@@ -40,20 +42,38 @@ namespace swift {
 #include "CompatibilityOverride.def"
 
 
+/// Sentinel values for the per-entry resolved-override caches in
+/// COMPATIBILITY_OVERRIDE.
+enum : uintptr_t {
+  ResolvedOverride_Unresolved = 0,
+  ResolvedOverride_None = 1,
+};
+
 /// Used to define an override point. The override point #defines the appropriate
 /// OVERRIDE macro from CompatibilityOverride.def to this macro, then includes
 /// the file to generate the override points. The original implementation of the
 /// functionality must be available as swift_funcNameHereImpl.
+///
+/// The override is resolved on first call and cached in a single word, so
+/// the steady-state cost of an entry point without an override is one
+/// relaxed load and a predicted branch rather than a swift_once check per
+/// call. Resolution is idempotent, so concurrent first calls can race to
+/// store the same value. Relaxed ordering suffices because the hooks live
+/// in the main executable and are fully mapped before any Swift code runs.
 #define COMPATIBILITY_OVERRIDE(name, ret, attrs, ccAttrs, namespace, typedArgs, namedArgs) \
   attrs ccAttrs ret namespace swift_ ## name typedArgs {                          \
-    static Override_ ## name Override;                                            \
-    static swift_once_t Predicate;                                                \
-    swift_once(&Predicate, [](void *) {                                           \
-      Override = getOverride_ ## name();                                          \
-    }, nullptr);                                                                  \
-    if (Override != nullptr)                                                      \
-      return Override(COMPATIBILITY_UNPAREN namedArgs, swift_ ## name ## Impl);   \
-    return swift_ ## name ## Impl namedArgs; \
+    static std::atomic<uintptr_t> Resolved(ResolvedOverride_Unresolved);          \
+    uintptr_t Fn = Resolved.load(std::memory_order_relaxed);                      \
+    if (SWIFT_UNLIKELY(Fn == ResolvedOverride_Unresolved)) {                      \
+      Fn = reinterpret_cast<uintptr_t>(getOverride_ ## name());                   \
+      if (Fn == ResolvedOverride_Unresolved)                                      \
+        Fn = ResolvedOverride_None;                                               \
+      Resolved.store(Fn, std::memory_order_relaxed);                              \
+    }                                                                             \
+    if (SWIFT_LIKELY(Fn == ResolvedOverride_None))                                \
+      return swift_ ## name ## Impl namedArgs;                                    \
+    return reinterpret_cast<Override_ ## name>(Fn)                                \
+        (COMPATIBILITY_UNPAREN namedArgs, swift_ ## name ## Impl);                \
   }
 
 } /* end namespace swift */
@@ -157,6 +157,17 @@ static void storeMultiPayloadEnumTagSinglePayload(OpaqueValue *value,
                                                   uint32_t index,
                                                   uint32_t numExtraCases,
                                                   const Metadata *enumType);
+template <unsigned NumTagBytes>
+static uint32_t
+getMultiPayloadEnumTagSinglePayloadFixed(const OpaqueValue *value,
+                                         uint32_t numExtraCases,
+                                         const Metadata *enumType);
+template <unsigned NumTagBytes>
+static void
+storeMultiPayloadEnumTagSinglePayloadFixed(OpaqueValue *value,
+                                           uint32_t index,
+                                           uint32_t numExtraCases,
+                                           const Metadata *enumType);
 
 void
 swift::swift_initEnumMetadataMultiPayload(EnumMetadata *enumType,
@@ -211,8 +222,33 @@ swift::swift_initEnumMetadataMultiPayload(EnumMetadata *enumType,
   // Unconditionally overwrite the enum-tag witnesses.
   // The compiler does not generate meaningful enum-tag witnesses for
   // enums in this state.
-  vwtable->getEnumTagSinglePayload = getMultiPayloadEnumTagSinglePayload;
-  vwtable->storeEnumTagSinglePayload = storeMultiPayloadEnumTagSinglePayload;
+  // The tag width is fixed by the layout we just computed, so install a
+  // witness specialized to it when we have one; the specialized witnesses
+  // compile their tag access down to a single fixed-width load or store.
+  switch (tagCounts.numTagBytes) {
+  case 1:
+    vwtable->getEnumTagSinglePayload =
+      getMultiPayloadEnumTagSinglePayloadFixed<1>;
+    vwtable->storeEnumTagSinglePayload =
+      storeMultiPayloadEnumTagSinglePayloadFixed<1>;
+    break;
+  case 2:
+    vwtable->getEnumTagSinglePayload =
+      getMultiPayloadEnumTagSinglePayloadFixed<2>;
+    vwtable->storeEnumTagSinglePayload =
+      storeMultiPayloadEnumTagSinglePayloadFixed<2>;
+    break;
+  case 4:
+    vwtable->getEnumTagSinglePayload =
+      getMultiPayloadEnumTagSinglePayloadFixed<4>;
+    vwtable->storeEnumTagSinglePayload =
+      storeMultiPayloadEnumTagSinglePayloadFixed<4>;
+    break;
+  default:
+    vwtable->getEnumTagSinglePayload = getMultiPayloadEnumTagSinglePayload;
+    vwtable->storeEnumTagSinglePayload = storeMultiPayloadEnumTagSinglePayload;
+    break;
+  }
 
   vwtable->publishLayout(layout);
 }
@@ -308,6 +344,64 @@ static void storeMultiPayloadEnumTagSinglePayload(OpaqueValue *value,
                                 storeMultiPayloadExtraInhabitantTag);
 }
 
+// Variants of the above with the tag width baked in as a template
+// parameter, so that the element loads and stores reduce to a single
+// fixed-width memory access. swift_initEnumMetadataMultiPayload selects
+// among these by the tag byte count of the layout it computes.
+
+template <unsigned NumTagBytes>
+SWIFT_CC(swift)
+static unsigned
+getMultiPayloadExtraInhabitantTagFixed(const OpaqueValue *value,
+                                       unsigned enumNumXI,
+                                       const Metadata *enumType) {
+  size_t payloadSize = cast<EnumMetadata>(enumType)->getPayloadSize();
+  auto tagBytes = reinterpret_cast<const uint8_t *>(value) + payloadSize;
+  // Out-of-range bytes read as all-ones; shifting in a wider type keeps
+  // the NumTagBytes == 4 instantiation well-defined.
+  constexpr uint32_t outOfRangeBits = uint32_t(~0ull << (NumTagBytes * 8));
+  unsigned index = ~(loadEnumElement(tagBytes, NumTagBytes) | outOfRangeBits);
+
+  if (index >= enumType->getValueWitnesses()->getNumExtraInhabitants())
+    return 0;
+  return index + 1;
+}
+
+template <unsigned NumTagBytes>
+SWIFT_CC(swift)
+static void
+storeMultiPayloadExtraInhabitantTagFixed(OpaqueValue *value,
+                                         unsigned tag,
+                                         unsigned enumNumXI,
+                                         const Metadata *enumType) {
+  size_t payloadSize = cast<EnumMetadata>(enumType)->getPayloadSize();
+  auto tagBytes = reinterpret_cast<uint8_t *>(value) + payloadSize;
+  storeEnumElement(tagBytes, ~(tag - 1), NumTagBytes);
+}
+
+template <unsigned NumTagBytes>
+static uint32_t
+getMultiPayloadEnumTagSinglePayloadFixed(const OpaqueValue *value,
+                                         uint32_t numExtraCases,
+                                         const Metadata *enumType) {
+  return getEnumTagSinglePayloadImpl(
+      value, numExtraCases, enumType, enumType->vw_size(),
+      enumType->vw_getNumExtraInhabitants(),
+      getMultiPayloadExtraInhabitantTagFixed<NumTagBytes>);
+}
+
+template <unsigned NumTagBytes>
+static void
+storeMultiPayloadEnumTagSinglePayloadFixed(OpaqueValue *value,
+                                           uint32_t index,
+                                           uint32_t numExtraCases,
+                                           const Metadata *enumType) {
+  storeEnumTagSinglePayloadImpl(
+      value, index, numExtraCases, enumType, enumType->vw_size(),
+      enumType->vw_getNumExtraInhabitants(),
+      storeMultiPayloadExtraInhabitantTagFixed<NumTagBytes>);
+}
+
 void
 swift::swift_storeEnumTagMultiPayload(OpaqueValue *value,
                                       const EnumMetadata *enumType,
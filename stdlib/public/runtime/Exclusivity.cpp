@@ -20,6 +20,7 @@
 #include "swift/Runtime/Exclusivity.h"
 #include "swift/Runtime/Metadata.h"
 #include "ThreadLocalStorage.h"
+#include <cstring>
 #include <memory>
 #include <stdio.h>
 
@@ -124,31 +125,31 @@ namespace {
 struct Access {
   void *Pointer;
   void *PC;
-  uintptr_t NextAndAction;
+  uintptr_t SlotAndAction;
 
   enum : uintptr_t {
     ActionMask = (uintptr_t)ExclusivityFlags::ActionMask,
-    NextMask = ~ActionMask
+    SlotShift = 1
   };
 
-  Access *getNext() const {
-    return reinterpret_cast<Access*>(NextAndAction & NextMask);
+  size_t getSlotIndex() const {
+    return size_t(SlotAndAction >> SlotShift);
   }
 
-  void setNext(Access *next) {
-    NextAndAction =
-      reinterpret_cast<uintptr_t>(next) | (NextAndAction & ActionMask);
+  void setSlotIndex(size_t index) {
+    SlotAndAction =
+      (uintptr_t(index) << SlotShift) | (SlotAndAction & ActionMask);
   }
 
   ExclusivityFlags getAccessAction() const {
-    return ExclusivityFlags(NextAndAction & ActionMask);
+    return ExclusivityFlags(SlotAndAction & ActionMask);
   }
 
-  void initialize(void *pc, void *pointer, Access *next,
+  void initialize(void *pc, void *pointer, size_t slotIndex,
                   ExclusivityFlags action) {
     Pointer = pointer;
     PC = pc;
-    NextAndAction = reinterpret_cast<uintptr_t>(next) | uintptr_t(action);
+    SlotAndAction = (uintptr_t(slotIndex) << SlotShift) | uintptr_t(action);
   }
 };
 
@@ -156,68 +157,181 @@ static_assert(sizeof(Access) <= sizeof(ValueBuffer) &&
               alignof(Access) <= alignof(ValueBuffer),
               "Access doesn't fit in a value buffer!");
 
-/// A set of accesses that we're tracking.  Just a singly-linked list.
+static_assert(uintptr_t(ExclusivityFlags::ActionMask) <
+                (uintptr_t(1) << Access::SlotShift),
+              "slot index would overlap the action bits");
+
+/// A set of accesses that we're tracking, as a flat open-addressed hash
+/// table keyed by the accessed address.
+///
+/// Slots hold pointers to the Access scratch buffers of live accesses, and
+/// each access records its slot index so that ending it never probes.
+/// Ending an access leaves a tombstone to keep probe chains intact; the
+/// table is wiped once the last access ends and rehashed when live entries
+/// plus tombstones get too dense. Storage starts inline, which covers the
+/// common case of a handful of simultaneous accesses, and moves to the
+/// heap for threads that exceed it.
 class AccessSet {
-  Access *Head = nullptr;
-public:
-  constexpr AccessSet() {}
+  enum : size_t { InlineCapacity = 8 };
 
-  bool insert(Access *access, void *pc, void *pointer, ExclusivityFlags flags) {
-    auto action = getAccessAction(flags);
+  /// Marks a slot vacated by an ended access that may still lie in the
+  /// middle of a probe chain.
+  static Access *tombstone() {
+    return reinterpret_cast<Access *>(uintptr_t(1));
+  }
 
-    for (Access *cur = Head; cur != nullptr; cur = cur->getNext()) {
-      // Ignore accesses to different values.
-      if (cur->Pointer != pointer)
-        continue;
+  /// The slot array; null until the first insertion, then InlineSlots
+  /// until the table grows.
+  Access **Slots = nullptr;
+  /// The size of the slot array. Always a power of two.
+  size_t Capacity = InlineCapacity;
+  /// The number of live accesses in the table.
+  size_t LiveCount = 0;
+  /// The number of slots holding either a live access or a tombstone.
+  size_t OccupiedCount = 0;
+  /// The total number of accesses this thread has ever tracked.
+  uint64_t TotalTracked = 0;
+  Access *InlineSlots[InlineCapacity] = {};
+
+  static size_t hash(void *pointer, size_t mask) {
+    // Accessed addresses are at least word-aligned; fold the high bits of
+    // a Fibonacci hash down so that the mask sees them.
+    auto h = (reinterpret_cast<uintptr_t>(pointer) >> 3)
+           * uintptr_t(0x9E3779B97F4A7C15ull);
+    h ^= h >> (sizeof(uintptr_t) * 4);
+    return size_t(h) & mask;
+  }
 
-      // If both accesses are reads, it's not a conflict.
-      if (action == ExclusivityFlags::Read &&
-          action == cur->getAccessAction())
+  /// Move every live access into a table of the given capacity, dropping
+  /// tombstones and updating each access's slot index.
+  void rehash(size_t newCapacity) {
+    Access **oldSlots = Slots;
+    size_t oldCapacity = Capacity;
+
+    auto newSlots = new Access *[newCapacity]();
+    size_t mask = newCapacity - 1;
+    for (size_t i = 0; i != oldCapacity; ++i) {
+      Access *access = oldSlots[i];
+      if (!access || access == tombstone())
         continue;
+      size_t index = hash(access->Pointer, mask);
+      while (newSlots[index])
+        index = (index + 1) & mask;
+      newSlots[index] = access;
+      access->setSlotIndex(index);
+    }
+
+    Slots = newSlots;
+    Capacity = newCapacity;
+    OccupiedCount = LiveCount;
+    if (oldSlots != InlineSlots)
+      delete[] oldSlots;
+  }
 
-      // Otherwise, it's a conflict.
-      reportExclusivityConflict(cur->getAccessAction(), cur->PC,
-                                flags, pc, pointer);
+public:
+  constexpr AccessSet() {}
 
-      // 0 means no backtrace will be printed.
-      fatalError(0, "Fatal access conflict detected.\n");
+#if !SWIFT_TLS_HAS_RESERVED_PTHREAD_SPECIFIC && SWIFT_TLS_HAS_THREADLOCAL
+  // No destructor: LLVM_THREAD_LOCAL storage may require a trivially
+  // destructible type, and this configuration performs no thread-exit
+  // cleanup anyway.
+#else
+  ~AccessSet() {
+    if (Slots && Slots != InlineSlots)
+      delete[] Slots;
+  }
+#endif
+
+  bool insert(Access *access, void *pc, void *pointer, ExclusivityFlags flags) {
+    auto action = getAccessAction(flags);
+
+    if (!Slots)
+      Slots = InlineSlots;
+
+    // Every live access to this pointer lies on its probe chain, which
+    // tombstones keep unbroken, so scanning to the first empty slot
+    // checks them all.
+    size_t mask = Capacity - 1;
+    size_t index = hash(pointer, mask);
+    size_t insertionIndex = size_t(-1);
+    while (Access *cur = Slots[index]) {
+      if (cur == tombstone()) {
+        if (insertionIndex == size_t(-1))
+          insertionIndex = index;
+      } else if (cur->Pointer == pointer) {
+        // If both accesses are reads, it's not a conflict.
+        if (action != ExclusivityFlags::Read ||
+            cur->getAccessAction() != ExclusivityFlags::Read) {
+          reportExclusivityConflict(cur->getAccessAction(), cur->PC,
+                                    flags, pc, pointer);
+
+          // 0 means no backtrace will be printed.
+          fatalError(0, "Fatal access conflict detected.\n");
+        }
+      }
+      index = (index + 1) & mask;
     }
     if (!isTracking(flags))
       return false;
 
-    // Insert to the front of the array so that remove tends to find it faster.
-    access->initialize(pc, pointer, Head, action);
-    Head = access;
+    if (insertionIndex == size_t(-1))
+      insertionIndex = index;
+
+    // Keep the table at most three-quarters occupied, counting tombstones.
+    if ((OccupiedCount + 1) * 4 > Capacity * 3) {
+      rehash(LiveCount * 2 >= Capacity ? Capacity * 2 : Capacity);
+      mask = Capacity - 1;
+      insertionIndex = hash(pointer, mask);
+      while (Slots[insertionIndex])
+        insertionIndex = (insertionIndex + 1) & mask;
+    }
+
+    if (!Slots[insertionIndex])
+      ++OccupiedCount;
+    Slots[insertionIndex] = access;
+    ++LiveCount;
+    ++TotalTracked;
+    access->initialize(pc, pointer, insertionIndex, action);
     return true;
   }
 
   void remove(Access *access) {
-    auto cur = Head;
-    // Fast path: stack discipline.
-    if (cur == access) {
-      Head = cur->getNext();
-      return;
-    }
-
-    Access *last = cur;
-    for (cur = cur->getNext(); cur != nullptr;
-         last = cur, cur = cur->getNext()) {
-      assert(last->getNext() == cur);
-      if (cur == access) {
-        last->setNext(cur->getNext());
-        return;
-      }
+    size_t index = access->getSlotIndex();
+    assert(Slots && index < Capacity && Slots[index] == access &&
+           "access not found in set");
+    // Leave a tombstone so that probe chains through this slot survive.
+    Slots[index] = tombstone();
+    --LiveCount;
+
+    // Once the last access ends nothing can legitimately probe, so wipe
+    // the tombstones out rather than letting insertions rehash them away.
+    if (LiveCount == 0 && OccupiedCount != 0) {
+      memset(Slots, 0, Capacity * sizeof(Access *));
+      OccupiedCount = 0;
     }
+  }
 
-    swift_runtime_unreachable("access not found in set");
+  /// Report this thread's tracking counters, skipping null out-parameters.
+  void getCounters(size_t *liveCount, size_t *tableCapacity,
+                   uint64_t *totalTracked) const {
+    if (liveCount)
+      *liveCount = LiveCount;
+    if (tableCapacity)
+      *tableCapacity = Capacity;
+    if (totalTracked)
+      *totalTracked = TotalTracked;
   }
 
 #ifndef NDEBUG
   /// Only available with asserts. Intended to be used with
   /// swift_dumpTrackedAccess().
   void forEach(std::function<void (Access *)> action) {
-    for (auto *iter = Head; iter != nullptr; iter = iter->getNext()) {
-      action(iter);
+    if (!Slots)
+      return;
+    for (size_t i = 0; i != Capacity; ++i) {
+      Access *cur = Slots[i];
+      if (cur && cur != tombstone())
+        action(cur);
     }
   }
 #endif
@@ -357,6 +471,14 @@ char *swift::swift_getFunctionReplacement(char **ReplFnPtr, char *CurrFn) {
   return ReplFn;
 }
 
+/// Report the calling thread's access-tracking counters.
+void swift::swift_getAccessTrackingCounters(size_t *liveCount,
+                                            size_t *tableCapacity,
+                                            uint64_t *totalTracked) {
+  getTLSContext().accessSet.getCounters(liveCount, tableCapacity,
+                                        totalTracked);
+}
+
 char *swift::swift_getOrigOfReplaceable(char **OrigFnPtr) {
   char *OrigFn = *OrigFnPtr;
   getTLSContext().CallOriginalOfReplacedFunction = true;
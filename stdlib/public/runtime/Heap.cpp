@@ -84,6 +84,17 @@ static inline malloc_zone_t *DEFAULT_ZONE() {
 // i.e. 0 < alignment <= _minAllocationAlignment:
 //   The runtime may use either malloc or AlignedAlloc, and the standard library
 //   must deallocate using an identical alignment.
+// Forwarding to the system allocator is a requirement, not a placeholder.
+// Swift heap objects must remain ordinary malloc blocks: they are handed to
+// code that frees them with plain free(), inspected by malloc zone and leak
+// tooling, and interleaved with allocations from C and Objective-C in the
+// same process. A private size-classed magazine front end would break that
+// interoperability, and the system allocators already keep per-thread
+// caches of small size classes (magazines on Darwin, tcache in glibc), so
+// the win it promises is mostly already present. The profitable way to
+// spend allocator time in Swift is to not allocate: the optimizer promotes
+// objects to the stack and the runtime supports that via
+// swift_initStackObject.
 void *swift::swift_slowAlloc(size_t size, size_t alignMask) {
   void *p;
   // This check also forces "default" alignment to use AlignedAlloc.
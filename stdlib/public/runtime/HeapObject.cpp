@@ -547,6 +547,78 @@ SWIFT_RUNTIME_EXPORT
 HeapObject *(*SWIFT_RT_DECLARE_ENTRY _swift_tryRetain)(HeapObject *object) =
     _swift_tryRetain_;
 
+// Single-threaded process mode.
+//
+// When SWIFT_SINGLE_THREADED_MODE is set in the environment at process start,
+// the retain/release entry points are rerouted through their non-atomic
+// implementations using the same function-pointer overrides that the
+// performance tooling uses.  This avoids atomic reference-counting RMW
+// operations in processes known to be single-threaded, such as CLI tools and
+// per-process-sharded daemons.
+//
+// The runtime cannot intercept thread creation, so the mode trusts the
+// process; in assertions builds, every rerouted operation checks that it is
+// still running on the thread that enabled the mode and traps otherwise.
+
+#ifndef NDEBUG
+static std::thread::id theSingleThread;
+
+static void checkSingleThreadedMode() {
+  if (std::this_thread::get_id() != theSingleThread)
+    swift::fatalError(0, "Fatal error: reference-counting operation on a "
+                         "secondary thread in single-threaded mode\n");
+}
+#else
+static void checkSingleThreadedMode() {}
+#endif
+
+static HeapObject *_swift_retain_singleThreaded(HeapObject *object) {
+  checkSingleThreadedMode();
+  return swift_nonatomic_retain(object);
+}
+
+static HeapObject *_swift_retain_n_singleThreaded(HeapObject *object,
+                                                  uint32_t n) {
+  checkSingleThreadedMode();
+  return swift_nonatomic_retain_n(object, n);
+}
+
+static void _swift_release_singleThreaded(HeapObject *object) {
+  checkSingleThreadedMode();
+  swift_nonatomic_release(object);
+}
+
+static void _swift_release_n_singleThreaded(HeapObject *object, uint32_t n) {
+  checkSingleThreadedMode();
+  swift_nonatomic_release_n(object, n);
+}
+
+static HeapObject *_swift_tryRetain_singleThreaded(HeapObject *object) {
+  checkSingleThreadedMode();
+  SWIFT_RT_TRACK_INVOCATION(object, swift_tryRetain);
+  if (!isValidPointerForNativeRetain(object))
+    return nullptr;
+
+  if (object->refCounts.tryIncrementNonAtomic()) return object;
+  else return nullptr;
+}
+
+__attribute__((__constructor__))
+static void initializeSingleThreadedMode() {
+  const char *env = getenv("SWIFT_SINGLE_THREADED_MODE");
+  if (!env || env[0] == '\0' || env[0] == '0')
+    return;
+
+#ifndef NDEBUG
+  theSingleThread = std::this_thread::get_id();
+#endif
+  _swift_retain = _swift_retain_singleThreaded;
+  _swift_retain_n = _swift_retain_n_singleThreaded;
+  _swift_release = _swift_release_singleThreaded;
+  _swift_release_n = _swift_release_n_singleThreaded;
+  _swift_tryRetain = _swift_tryRetain_singleThreaded;
+}
+
 bool swift::swift_isDeallocating(HeapObject *object) {
   if (!isValidPointerForNativeRetain(object))
     return false;
@@ -887,6 +959,56 @@ WeakReference *swift::swift_weakTakeAssign(WeakReference *dest,
   return dest;
 }
 
+WeakReference *swift::swift_nonatomic_weakInit(WeakReference *ref,
+                                               HeapObject *value) {
+  ref->nativeInitNonAtomic(value);
+  return ref;
+}
+
+WeakReference *swift::swift_nonatomic_weakAssign(WeakReference *ref,
+                                                 HeapObject *value) {
+  ref->nativeAssignNonAtomic(value);
+  return ref;
+}
+
+HeapObject *swift::swift_nonatomic_weakLoadStrong(WeakReference *ref) {
+  return ref->nativeLoadStrongNonAtomic();
+}
+
+HeapObject *swift::swift_nonatomic_weakTakeStrong(WeakReference *ref) {
+  return ref->nativeTakeStrongNonAtomic();
+}
+
+void swift::swift_nonatomic_weakDestroy(WeakReference *ref) {
+  ref->nativeDestroyNonAtomic();
+}
+
+WeakReference *swift::swift_nonatomic_weakCopyInit(WeakReference *dest,
+                                                   WeakReference *src) {
+  dest->nativeCopyInitNonAtomic(src);
+  return dest;
+}
+
+WeakReference *swift::swift_nonatomic_weakTakeInit(WeakReference *dest,
+                                                   WeakReference *src) {
+  // Taking moves the side table reference without touching its counts,
+  // so there is nothing non-atomic to do here.
+  dest->nativeTakeInit(src);
+  return dest;
+}
+
+WeakReference *swift::swift_nonatomic_weakCopyAssign(WeakReference *dest,
+                                                     WeakReference *src) {
+  dest->nativeCopyAssignNonAtomic(src);
+  return dest;
+}
+
+WeakReference *swift::swift_nonatomic_weakTakeAssign(WeakReference *dest,
+                                                     WeakReference *src) {
+  dest->nativeTakeAssignNonAtomic(src);
+  return dest;
+}
+
 #ifndef NDEBUG
 
 void HeapObject::dump() const {
@@ -297,6 +297,15 @@ namespace {
       return { metadata, state };
     }
 
+    /// Allocate by adopting a statically-emitted specialization as the
+    /// canonical metadata record for its key arguments.
+    AllocationResult allocate(const Metadata *candidate) {
+      // The candidate was fully instantiated at compile time, including its
+      // value witnesses, so there is nothing left to allocate or complete.
+      return { const_cast<Metadata *>(candidate),
+               PrivateMetadataState::Complete };
+    }
+
     TryInitializeResult tryInitialize(Metadata *metadata,
                                       PrivateMetadataState state,
                                PrivateMetadataCompletionContext *context) {
@@ -672,6 +681,35 @@ swift::swift_getGenericMetadata(MetadataRequest request,
                               arguments);
   auto result = cache.getOrInsert(key, request, description, arguments);
 
+  if (SWIFT_UNLIKELY(_swift_metadataSnapshotRecordingEnabled))
+    _swift_recordMetadataSnapshotEntry(result.second.Value);
+
+  return result.second;
+}
+
+MetadataResponse
+swift::swift_getCanonicalSpecializedMetadata(MetadataRequest request,
+                                             const Metadata *candidate) {
+  auto *description = candidate->getTypeContextDescriptor();
+  assert(description && description->isGeneric() &&
+         "candidate is not a specialization of a generic type");
+
+  // The candidate's generic argument vector was laid out by the compiler
+  // exactly as swift_getGenericMetadata would have installed it, so its
+  // leading key arguments form the cache key directly.
+  auto &cache = getCache(*description);
+  auto *arguments =
+    reinterpret_cast<const void * const *>(candidate->getGenericArgs());
+  assert(description->getFullGenericContextHeader().Base.NumKeyArguments ==
+         cache.NumKeyParameters + cache.NumWitnessTables);
+  auto key = MetadataCacheKey(cache.NumKeyParameters, cache.NumWitnessTables,
+                              arguments);
+
+  // If another thread raced us to instantiate this specialization
+  // dynamically, keep the dynamic instantiation as the canonical record;
+  // the candidate simply goes unused.
+  auto result = cache.getOrInsert(key, request, candidate);
+
   return result.second;
 }
 
@@ -0,0 +1,126 @@
+//===--- MetadataCacheSnapshot.cpp - Replayable metadata working sets -----===//
+//
+// This source file is part of the Swift.org open source project
+//
+// Copyright (c) 2014 - 2020 Apple Inc. and the Swift project authors
+// Licensed under Apache License v2.0 with Runtime Library Exception
+//
+// See https://swift.org/LICENSE.txt for license information
+// See https://swift.org/CONTRIBUTORS.txt for the list of Swift project authors
+//
+//===----------------------------------------------------------------------===//
+//
+// Opt-in support for capturing the set of generic type metadata a process
+// instantiates and replaying those instantiations at the start of the next
+// launch:
+//
+//   SWIFT_METADATA_SNAPSHOT_OUT=<path>  record the working set and write it
+//                                       to <path> at process exit
+//   SWIFT_METADATA_SNAPSHOT_IN=<path>   instantiate every type listed in
+//                                       <path> when the runtime is loaded
+//
+// A snapshot is a text file with one mangled type name per line.
+// Instantiated metadata records are full of absolute pointers, so the
+// records themselves cannot usefully be persisted across launches; replaying
+// the instantiations from their mangled names achieves the same effect of
+// front-loading the instantiation storm before main() runs.
+//
+//===----------------------------------------------------------------------===//
+
+#include "Private.h"
+#include "swift/Basic/Lazy.h"
+#include "swift/Demangling/Demangler.h"
+#include "swift/Runtime/Metadata.h"
+#include "swift/Runtime/Mutex.h"
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <unordered_set>
+
+using namespace swift;
+
+bool swift::_swift_metadataSnapshotRecordingEnabled = false;
+
+namespace {
+struct MetadataSnapshotRecorder {
+  Mutex Lock;
+  std::unordered_set<const Metadata *> WorkingSet;
+};
+} // end anonymous namespace
+
+static Lazy<MetadataSnapshotRecorder> SnapshotRecorder;
+
+void swift::_swift_recordMetadataSnapshotEntry(const Metadata *metadata) {
+  auto &recorder = SnapshotRecorder.get();
+  ScopedLock guard(recorder.Lock);
+  recorder.WorkingSet.insert(metadata);
+}
+
+/// Write the mangled names of the recorded working set to the file named by
+/// SWIFT_METADATA_SNAPSHOT_OUT. Runs at process exit.
+static void writeMetadataSnapshot() {
+  const char *path = getenv("SWIFT_METADATA_SNAPSHOT_OUT");
+  if (!path)
+    return;
+
+  FILE *file = fopen(path, "w");
+  if (!file)
+    return;
+
+  auto &recorder = SnapshotRecorder.get();
+  ScopedLock guard(recorder.Lock);
+  for (auto *metadata : recorder.WorkingSet) {
+    Demangle::StackAllocatedDemangler<4096> Dem;
+    auto node = _swift_buildDemanglingForMetadata(metadata, Dem);
+    if (!node)
+      continue;
+    auto mangledName = Demangle::mangleNode(node);
+    if (mangledName.empty())
+      continue;
+    fprintf(file, "%s\n", mangledName.c_str());
+  }
+  fclose(file);
+}
+
+/// Instantiate every type named in the snapshot file at \p path.
+static void replayMetadataSnapshot(const char *path) {
+  FILE *file = fopen(path, "r");
+  if (!file)
+    return;
+
+  char line[4096];
+  while (fgets(line, sizeof(line), file)) {
+    size_t length = strlen(line);
+    while (length > 0 &&
+           (line[length - 1] == '\n' || line[length - 1] == '\r'))
+      line[--length] = '\0';
+    if (length == 0)
+      continue;
+
+    // Snapshot entries are fully concrete, so no generic substitutions are
+    // required to resolve them. Names that no longer resolve - say, because
+    // the binary changed since the snapshot was taken - are skipped; a
+    // stale snapshot degrades back to lazy instantiation.
+    swift_getTypeByMangledName(MetadataState::Complete,
+                               StringRef(line, length),
+                               nullptr,
+                               [](unsigned, unsigned) { return nullptr; },
+                               [](const Metadata *, unsigned) {
+                                 return nullptr;
+                               });
+  }
+  fclose(file);
+}
+
+/// Check the snapshot environment variables when the runtime is loaded.
+/// Replay runs here so the warmed caches are in place before main().
+__attribute__((constructor))
+static void setupMetadataSnapshots() {
+  if (const char *path = getenv("SWIFT_METADATA_SNAPSHOT_IN"))
+    replayMetadataSnapshot(path);
+
+  if (getenv("SWIFT_METADATA_SNAPSHOT_OUT")) {
+    _swift_metadataSnapshotRecordingEnabled = true;
+    atexit(writeMetadataSnapshot);
+  }
+}
@@ -238,9 +238,25 @@ namespace {
 struct TypeMetadataPrivateState {
   ConcurrentMap<NominalTypeDescriptorCacheEntry> NominalCache;
   ConcurrentReadableArray<TypeMetadataSection> SectionsToScan;
-  
+
+  /// Guards BatchedSections.
+  Mutex BatchedSectionsLock;
+
+  /// While non-null, sections are collected here and added to SectionsToScan
+  /// with a single bulk append, rather than one append per image. This is
+  /// only set during construction, when the loader reports every image
+  /// already loaded at startup.
+  std::vector<TypeMetadataSection> *BatchedSections = nullptr;
+
   TypeMetadataPrivateState() {
+    std::vector<TypeMetadataSection> initialSections;
+    BatchedSections = &initialSections;
     initializeTypeMetadataRecordLookup();
+    {
+      ScopedLock guard(BatchedSectionsLock);
+      BatchedSections = nullptr;
+    }
+    SectionsToScan.append(initialSections.data(), initialSections.size());
   }
 
 };
@@ -251,6 +267,13 @@ static void
 _registerTypeMetadataRecords(TypeMetadataPrivateState &T,
                              const TypeMetadataRecord *begin,
                              const TypeMetadataRecord *end) {
+  {
+    ScopedLock guard(T.BatchedSectionsLock);
+    if (T.BatchedSections) {
+      T.BatchedSections->push_back(TypeMetadataSection{begin, end});
+      return;
+    }
+  }
   T.SectionsToScan.push_back(TypeMetadataSection{begin, end});
 }
 
@@ -771,8 +794,24 @@ namespace {
     ConcurrentMap<ProtocolDescriptorCacheEntry> ProtocolCache;
     ConcurrentReadableArray<ProtocolSection> SectionsToScan;
 
+    /// Guards BatchedSections.
+    Mutex BatchedSectionsLock;
+
+    /// While non-null, sections are collected here and added to
+    /// SectionsToScan with a single bulk append, rather than one append per
+    /// image. This is only set during construction, when the loader reports
+    /// every image already loaded at startup.
+    std::vector<ProtocolSection> *BatchedSections = nullptr;
+
     ProtocolMetadataPrivateState() {
+      std::vector<ProtocolSection> initialSections;
+      BatchedSections = &initialSections;
       initializeProtocolLookup();
+      {
+        ScopedLock guard(BatchedSectionsLock);
+        BatchedSections = nullptr;
+      }
+      SectionsToScan.append(initialSections.data(), initialSections.size());
     }
   };
 
@@ -783,6 +822,13 @@ static void
 _registerProtocols(ProtocolMetadataPrivateState &C,
                    const ProtocolRecord *begin,
                    const ProtocolRecord *end) {
+  {
+    ScopedLock guard(C.BatchedSectionsLock);
+    if (C.BatchedSections) {
+      C.BatchedSections->push_back(ProtocolSection{begin, end});
+      return;
+    }
+  }
   C.SectionsToScan.push_back(ProtocolSection{begin, end});
 }
 
@@ -1648,6 +1694,65 @@ swift_getTypeByMangledNameInContextInMetadataState(
     }).getMetadata();
 }
 
+namespace {
+  /// Cached result of resolving a type by mangled name with no generic
+  /// arguments in scope, as done by _typeByName(). Successful lookups are
+  /// cached forever; a failed lookup records the number of type metadata
+  /// sections that were registered when the search ran, so that loading a
+  /// new image causes the search to be retried once.
+  struct TypeByMangledNameCacheEntry {
+  private:
+    std::string Name;
+    std::atomic<const Metadata *> Type;
+    std::atomic<size_t> FailureSectionCount;
+
+  public:
+    TypeByMangledNameCacheEntry(const llvm::StringRef name,
+                                const Metadata *type,
+                                size_t failureSectionCount)
+      : Name(name.str()), Type(type),
+        FailureSectionCount(failureSectionCount) {}
+
+    int compareWithKey(llvm::StringRef aName) const {
+      return aName.compare(Name);
+    }
+
+    template <class... T>
+    static size_t getExtraAllocationSize(T &&... ignored) {
+      return 0;
+    }
+
+    bool isSuccessful() const {
+      return Type.load(std::memory_order_relaxed) != nullptr;
+    }
+
+    void makeSuccessful(const Metadata *type) {
+      Type.store(type, std::memory_order_release);
+    }
+
+    void updateFailureSectionCount(size_t failureSectionCount) {
+      assert(!isSuccessful());
+      FailureSectionCount.store(failureSectionCount,
+                                std::memory_order_relaxed);
+    }
+
+    /// Get the cached metadata, if successful.
+    const Metadata *getType() const {
+      assert(isSuccessful());
+      return Type.load(std::memory_order_acquire);
+    }
+
+    /// Get the section count at which this lookup failed.
+    size_t getFailureSectionCount() const {
+      assert(!isSuccessful());
+      return FailureSectionCount.load(std::memory_order_relaxed);
+    }
+  };
+} // end anonymous namespace
+
+static Lazy<ConcurrentMap<TypeByMangledNameCacheEntry>>
+TypeByMangledNameCache;
+
 /// Demangle a mangled name, but don't allow symbolic references.
 SWIFT_CC(swift) SWIFT_RUNTIME_STDLIB_INTERNAL
 const Metadata *_Nullable
@@ -1658,9 +1763,35 @@ swift_stdlib_getTypeByMangledNameUntrusted(const char *typeNameStart,
     if (c >= '\x01' && c <= '\x1F')
       return nullptr;
   }
-  
-  return swift_getTypeByMangledName(MetadataState::Complete, typeName, nullptr,
-                                    {}, {}).getMetadata();
+
+  // With no generic environment, the result depends only on the name and
+  // the set of loaded images, so it can be memoized. Clients such as
+  // _typeByName() tend to resolve the same few names over and over, and
+  // demangling plus descriptor lookup is far more expensive than a probe
+  // of the concurrent tree.
+  auto &cache = TypeByMangledNameCache.get();
+  size_t sectionCount =
+      TypeMetadataRecords.get().SectionsToScan.snapshot().count();
+
+  if (auto *existing = cache.find(typeName)) {
+    if (existing->isSuccessful())
+      return existing->getType();
+    if (existing->getFailureSectionCount() == sectionCount)
+      return nullptr;
+  }
+
+  auto type = swift_getTypeByMangledName(MetadataState::Complete, typeName,
+                                         nullptr, {}, {}).getMetadata();
+
+  auto result = cache.getOrInsert(typeName, type, sectionCount);
+  if (!result.second) {
+    // Raced with another lookup, or retried a stale failure entry.
+    if (type)
+      result.first->makeSuccessful(type);
+    else if (!result.first->isSuccessful())
+      result.first->updateFailureSectionCount(sectionCount);
+  }
+  return type;
 }
 
 SWIFT_CC(swift) SWIFT_RUNTIME_EXPORT
@@ -256,6 +256,14 @@ public:
   Demangle::NodePointer _swift_buildDemanglingForMetadata(const Metadata *type,
                                                       Demangle::Demangler &Dem);
 
+  /// True if SWIFT_METADATA_SNAPSHOT_OUT is set and generic metadata
+  /// instantiations should be recorded for a metadata cache snapshot.
+  extern bool _swift_metadataSnapshotRecordingEnabled;
+
+  /// Record \p metadata in the snapshot working set.  Only called when
+  /// \c _swift_metadataSnapshotRecordingEnabled is true.
+  void _swift_recordMetadataSnapshotEntry(const Metadata *metadata);
+
   /// Callback used to provide the substitution of a generic parameter
   /// (described by depth/index) to its metadata.
   using SubstGenericParameterFn =
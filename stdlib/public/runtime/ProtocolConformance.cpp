@@ -267,9 +267,27 @@ namespace {
 struct ConformanceState {
   ConcurrentMap<ConformanceCacheEntry> Cache;
   ConcurrentReadableArray<ConformanceSection> SectionsToScan;
-  
+
+  /// Guards BatchedSections.
+  Mutex BatchedSectionsLock;
+
+  /// While non-null, sections are collected here instead of being appended
+  /// to SectionsToScan one at a time. This is only set during construction,
+  /// when the loader reports every image already loaded at startup; the
+  /// collected sections are then added with a single bulk append. With many
+  /// loaded images, growing SectionsToScan once per image is a measurable
+  /// slice of launch time.
+  std::vector<ConformanceSection> *BatchedSections = nullptr;
+
   ConformanceState() {
+    std::vector<ConformanceSection> initialSections;
+    BatchedSections = &initialSections;
     initializeProtocolConformanceLookup();
+    {
+      ScopedLock guard(BatchedSectionsLock);
+      BatchedSections = nullptr;
+    }
+    SectionsToScan.append(initialSections.data(), initialSections.size());
   }
 
   void cacheSuccess(const void *type, const ProtocolDescriptor *proto,
@@ -325,6 +343,13 @@ static void
 _registerProtocolConformances(ConformanceState &C,
                               const ProtocolConformanceRecord *begin,
                               const ProtocolConformanceRecord *end) {
+  {
+    ScopedLock guard(C.BatchedSectionsLock);
+    if (C.BatchedSections) {
+      C.BatchedSections->push_back(ConformanceSection{begin, end});
+      return;
+    }
+  }
   C.SectionsToScan.push_back(ConformanceSection{begin, end});
 }
 
@@ -572,6 +597,17 @@ namespace {
   };
 }
 
+/// Resolve a conformance, consulting the cache before scanning records.
+///
+/// The record sections are unordered by ABI -- every image emitted by every
+/// shipping toolchain lays conformances out as a flat array -- so a cache
+/// miss has no choice but to walk records. What keeps that affordable is
+/// how much each walk amortizes: the scan caches every matching record for
+/// the queried protocol (not just the queried type), and a negative result
+/// is cached with the section count as its generation, so a repeated miss
+/// rescans only sections registered since the last failure. A sorted
+/// per-image index would have to be a new section emitted by the compiler
+/// and understood here, with this walk kept anyway for existing images.
 static const ProtocolConformanceDescriptor *
 swift_conformsToSwiftProtocolImpl(const Metadata * const type,
                                   const ProtocolDescriptor *protocol,
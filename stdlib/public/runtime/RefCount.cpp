@@ -78,6 +78,12 @@ template bool RefCounts<SideTableRefCountBits>::tryIncrementNonAtomicSlow(SideTa
 
 // Return an object's side table, allocating it if necessary.
 // Returns null if the object is deiniting.
+//
+// The transition is per-object and lock-free: the entry is allocated
+// speculatively, then installed into the object's inline refcount word with a
+// CAS loop; a loser deletes its entry and adopts the winner's. There is no
+// global pool or lock to shard, and the allocation itself goes through
+// operator new, so it already lands in malloc's per-thread caches.
 // SideTableRefCountBits specialization intentionally does not exist.
 template <>
 HeapObjectSideTableEntry* RefCounts<InlineRefCountBits>::allocateSideTable(bool failIfDeiniting)
@@ -134,6 +140,17 @@ HeapObjectSideTableEntry* RefCounts<InlineRefCountBits>::formWeakReference()
     return nullptr;
 }
 
+// SideTableRefCountBits specialization intentionally does not exist.
+template <>
+HeapObjectSideTableEntry* RefCounts<InlineRefCountBits>::formWeakReferenceNonAtomic()
+{
+  auto side = allocateSideTable(true);
+  if (side)
+    return side->incrementWeakNonAtomic();
+  else
+    return nullptr;
+}
+
 template <typename RefCountBits>
 void RefCounts<RefCountBits>::incrementUnownedSlow(uint32_t n) {
   auto side = allocateSideTable(false);
@@ -16,10 +16,12 @@
 //===----------------------------------------------------------------------===//
 
 #include "llvm/ADT/DenseMap.h"
+#include "llvm/Support/Compiler.h"
 #include "RuntimeInvocationsTracking.h"
 #include "swift/Basic/Lazy.h"
 #include "swift/Runtime/HeapObject.h"
 #include "swift/Runtime/Mutex.h"
+#include <atomic>
 
 #if defined(SWIFT_ENABLE_RUNTIME_FUNCTION_COUNTERS)
 
@@ -46,12 +48,72 @@ static bool UpdatePerObjectRuntimeFunctionCounters = false;
 static bool UpdateGlobalRuntimeFunctionCounters = false;
 /// TODO: Add support for enabling/disabling counters on a per object basis?
 
-/// Global set of counters tracking the total number of runtime invocations.
+/// Bias added on top of the per-thread counter blocks when the global
+/// counters are read. _swift_setGlobalRuntimeFunctionCounters adjusts this
+/// bias, because the per-thread blocks belong to their owning threads and
+/// cannot be written from outside.
 struct RuntimeFunctionCountersStateSentinel {
   RuntimeFunctionCountersState State;
   StaticReadWriteLock Lock;
 };
-static RuntimeFunctionCountersStateSentinel RuntimeGlobalFunctionCountersState;
+static RuntimeFunctionCountersStateSentinel RuntimeGlobalFunctionCountersBias;
+
+/// Per-thread block of global counters. The owning thread increments the
+/// counters without synchronization and aggregation reads them racily; on
+/// the targets we support, aligned 32-bit loads cannot tear, and telemetry
+/// reads are allowed to be momentarily stale. Blocks are cache-line
+/// aligned so that threads never contend on them, pushed onto a global
+/// list on first use, and kept for the life of the process so that counts
+/// survive thread exit.
+struct alignas(64) ThreadRuntimeFunctionCounters {
+  RuntimeFunctionCountersState State;
+  /// Invocations left until the next one is recorded; see the sample rate.
+  uint32_t SampleCountdown = 0;
+  ThreadRuntimeFunctionCounters *Next = nullptr;
+};
+
+/// The list of all threads' counter blocks.
+static std::atomic<ThreadRuntimeFunctionCounters *>
+    ThreadRuntimeFunctionCountersList{nullptr};
+
+/// The sampling period for the global counters. A period of N records
+/// every Nth invocation on each thread and adds N, so totals remain
+/// unbiased estimates; 1 counts every invocation.
+static std::atomic<uint32_t> GlobalRuntimeFunctionCountersSampleRate{1};
+
+static LLVM_THREAD_LOCAL ThreadRuntimeFunctionCounters
+    *LocalRuntimeFunctionCounters = nullptr;
+
+/// Get this thread's counter block, creating and registering it on first
+/// use.
+static ThreadRuntimeFunctionCounters *getThreadRuntimeFunctionCounters() {
+  auto *counters = LocalRuntimeFunctionCounters;
+  if (LLVM_LIKELY(counters != nullptr))
+    return counters;
+
+  counters = new ThreadRuntimeFunctionCounters();
+  auto head =
+      ThreadRuntimeFunctionCountersList.load(std::memory_order_relaxed);
+  do {
+    counters->Next = head;
+  } while (!ThreadRuntimeFunctionCountersList.compare_exchange_weak(
+      head, counters, std::memory_order_release, std::memory_order_relaxed));
+  LocalRuntimeFunctionCounters = counters;
+  return counters;
+}
+
+/// Add every thread's counters into \p sums.
+static void
+accumulateThreadRuntimeFunctionCounters(RuntimeFunctionCountersState &sums) {
+  for (auto *node = ThreadRuntimeFunctionCountersList.load(
+           std::memory_order_acquire);
+       node != nullptr; node = node->Next) {
+#define FUNCTION_TO_TRACK(RT_FUNCTION)                                         \
+    sums.SWIFT_RT_FUNCTION_INVOCATION_COUNTER_NAME(RT_FUNCTION) +=             \
+        node->State.SWIFT_RT_FUNCTION_INVOCATION_COUNTER_NAME(RT_FUNCTION);
+#include "RuntimeInvocationsTracking.def"
+  }
+}
 
 /// The object state cache mapping objects to the collected state associated with
 /// them.
@@ -99,19 +161,28 @@ static uint16_t RuntimeFunctionCountersOffsets[] = {
 /// TODO: Perform atomic increments?
 #define FUNCTION_TO_TRACK(RT_FUNCTION)                                         \
   void SWIFT_RT_TRACK_INVOCATION_NAME(RT_FUNCTION)(HeapObject * object) {      \
-    /* Update global counters. */                                              \
+    /* Update global counters in this thread's block, without locking. */      \
     if (UpdateGlobalRuntimeFunctionCounters) {                                 \
-      StaticScopedWriteLock lock(RuntimeGlobalFunctionCountersState.Lock);     \
-      RuntimeGlobalFunctionCountersState.State                                 \
-          .SWIFT_RT_FUNCTION_INVOCATION_COUNTER_NAME(RT_FUNCTION)++;           \
-      if (GlobalRuntimeFunctionCountersUpdateHandler) {                        \
-        auto oldGlobalMode = _swift_setGlobalRuntimeFunctionCountersMode(0);   \
-        auto oldPerObjectMode =                                                \
-            _swift_setPerObjectRuntimeFunctionCountersMode(0);                 \
-        GlobalRuntimeFunctionCountersUpdateHandler(                            \
-            object, RT_FUNCTION_ID(RT_FUNCTION));                              \
-        _swift_setGlobalRuntimeFunctionCountersMode(oldGlobalMode);            \
-        _swift_setPerObjectRuntimeFunctionCountersMode(oldPerObjectMode);      \
+      auto *threadCounters = getThreadRuntimeFunctionCounters();               \
+      if (threadCounters->SampleCountdown > 1) {                               \
+        threadCounters->SampleCountdown--;                                     \
+      } else {                                                                 \
+        auto sampleRate = GlobalRuntimeFunctionCountersSampleRate.load(        \
+            std::memory_order_relaxed);                                        \
+        threadCounters->SampleCountdown = sampleRate;                          \
+        /* Each recorded event stands for sampleRate invocations. */           \
+        threadCounters->State                                                  \
+            .SWIFT_RT_FUNCTION_INVOCATION_COUNTER_NAME(RT_FUNCTION) +=        \
+            sampleRate;                                                        \
+        if (GlobalRuntimeFunctionCountersUpdateHandler) {                      \
+          auto oldGlobalMode = _swift_setGlobalRuntimeFunctionCountersMode(0); \
+          auto oldPerObjectMode =                                              \
+              _swift_setPerObjectRuntimeFunctionCountersMode(0);               \
+          GlobalRuntimeFunctionCountersUpdateHandler(                          \
+              object, RT_FUNCTION_ID(RT_FUNCTION));                            \
+          _swift_setGlobalRuntimeFunctionCountersMode(oldGlobalMode);          \
+          _swift_setPerObjectRuntimeFunctionCountersMode(oldPerObjectMode);    \
+        }                                                                      \
       }                                                                        \
     }                                                                          \
     /* Update per object counters. */                                          \
@@ -144,19 +215,42 @@ void _swift_setObjectRuntimeFunctionCounters(
   theSentinel.Cache[object] = *state;
 }
 
-/// Get the global runtime state containing the total numbers of invocations for
-/// each runtime function of interest.
+/// Get the global runtime state containing the total numbers of invocations
+/// for each runtime function of interest, by summing every thread's block
+/// on top of the bias.
 void _swift_getGlobalRuntimeFunctionCounters(
     RuntimeFunctionCountersState *result) {
-  StaticScopedReadLock lock(RuntimeGlobalFunctionCountersState.Lock);
-  *result = RuntimeGlobalFunctionCountersState.State;
+  {
+    StaticScopedReadLock lock(RuntimeGlobalFunctionCountersBias.Lock);
+    *result = RuntimeGlobalFunctionCountersBias.State;
+  }
+  accumulateThreadRuntimeFunctionCounters(*result);
 }
 
 /// Set the global runtime state of function pointers from a provided state.
+/// Only the bias can be written safely, so pick the bias that makes a
+/// subsequent read return the provided state; the subtraction wraps, which
+/// is consistent with how the counters themselves wrap.
 void _swift_setGlobalRuntimeFunctionCounters(
     RuntimeFunctionCountersState *state) {
-  StaticScopedWriteLock lock(RuntimeGlobalFunctionCountersState.Lock);
-  RuntimeGlobalFunctionCountersState.State = *state;
+  RuntimeFunctionCountersState sums;
+  accumulateThreadRuntimeFunctionCounters(sums);
+  StaticScopedWriteLock lock(RuntimeGlobalFunctionCountersBias.Lock);
+#define FUNCTION_TO_TRACK(RT_FUNCTION)                                         \
+  RuntimeGlobalFunctionCountersBias.State                                      \
+      .SWIFT_RT_FUNCTION_INVOCATION_COUNTER_NAME(RT_FUNCTION) =                \
+      state->SWIFT_RT_FUNCTION_INVOCATION_COUNTER_NAME(RT_FUNCTION) -          \
+      sums.SWIFT_RT_FUNCTION_INVOCATION_COUNTER_NAME(RT_FUNCTION);
+#include "RuntimeInvocationsTracking.def"
+}
+
+/// Set the sampling period for the global runtime function counters.
+/// Returns the previous period; a period of 0 is treated as 1.
+uint32_t _swift_setGlobalRuntimeFunctionCountersSampleRate(uint32_t rate) {
+  if (rate == 0)
+    rate = 1;
+  return GlobalRuntimeFunctionCountersSampleRate.exchange(
+      rate, std::memory_order_relaxed);
 }
 
 /// Return the names of the runtime functions being tracked.
@@ -99,6 +99,14 @@ SWIFT_RUNTIME_EXPORT int _swift_setGlobalRuntimeFunctionCountersMode(int mode);
 SWIFT_RUNTIME_EXPORT void _swift_setGlobalRuntimeFunctionCounters(
     swift::RuntimeFunctionCountersState *state);
 
+/// Set the sampling period for the global runtime function counters.
+/// A period of N records every Nth invocation on each thread and adds N to
+/// the counter, so totals remain unbiased estimates. A period of 1 (the
+/// default) counts every invocation; 0 is treated as 1.
+/// Return the old period.
+SWIFT_RUNTIME_EXPORT uint32_t
+_swift_setGlobalRuntimeFunctionCountersSampleRate(uint32_t rate);
+
 /// Set the runtime object state associated with an object from a provided
 /// state.
 SWIFT_RUNTIME_EXPORT void
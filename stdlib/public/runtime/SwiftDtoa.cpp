@@ -1328,6 +1328,27 @@ size_t swift_format_double(double d, char *dest, size_t length)
                  digits, digitCount, decimalExponent);
     }
 }
+
+size_t swift_format_double_batch(const double *values, size_t count,
+    char *dest, size_t length, size_t *used)
+{
+    size_t totalUsed = 0;
+    size_t i = 0;
+    for (; i < count; i++) {
+        size_t written = swift_format_double(values[i], dest + totalUsed,
+                                             length - totalUsed);
+        if (written == 0) {
+            // Out of room; the failed conversion wrote nothing but a
+            // terminator (if it had space even for that).
+            break;
+        }
+        totalUsed += written + 1; // Keep each result's zero byte.
+    }
+    if (used) {
+        *used = totalUsed;
+    }
+    return i;
+}
 #endif
 
 #if SWIFT_DTOA_FLOAT80_SUPPORT
@@ -1392,6 +1413,34 @@ size_t swift_format_float80(long double d, char *dest, size_t length)
  * Routines to format a decomposed value into a standard string form.
  */
 
+// Table of ASCII digit pairs "00" through "99", so runs of digits can be
+// emitted two at a time with a single lookup and a two-byte store.
+static const char asciiDigitPairs[201] =
+    "00010203040506070809"
+    "10111213141516171819"
+    "20212223242526272829"
+    "30313233343536373839"
+    "40414243444546474849"
+    "50515253545556575859"
+    "60616263646566676869"
+    "70717273747576777879"
+    "80818283848586878889"
+    "90919293949596979899";
+
+// Write `count` decimal digits (one per byte, values 0-9) as ASCII,
+// pairwise via the table above. Returns the advanced output pointer.
+static char *emitDigits(char *p, const int8_t *digits, int count) {
+    int i = 0;
+    for (; i + 2 <= count; i += 2) {
+        memcpy(p, asciiDigitPairs + (digits[i] * 10 + digits[i + 1]) * 2, 2);
+        p += 2;
+    }
+    if (i < count) {
+        *p++ = digits[i] + '0';
+    }
+    return p;
+}
+
 // Format into exponential format: "1.234e+56"
 // Returns number of characters actually written to `dest`.
 // Returns zero if buffer is too small.
@@ -1426,9 +1475,7 @@ size_t swift_format_exponential(char *dest, size_t length,
     exponent -= 1;
     if (digit_count > 1) {
         *p++ = '.';
-        for (int i = 1; i < digit_count; i++) {
-            *p++ = digits[i] + '0';
-        }
+        p = emitDigits(p, digits + 1, digit_count - 1);
     }
     *p++ = 'e';
     if (exponent < 0) {
@@ -1444,8 +1491,8 @@ size_t swift_format_exponential(char *dest, size_t length,
         *p++ = (exponent / 100 % 10) + '0';
         exponent %= 100;
     }
-    *p++ = (exponent / 10) + '0';
-    *p++ = (exponent % 10) + '0';
+    memcpy(p, asciiDigitPairs + exponent * 2, 2);
+    p += 2;
     *p = '\0';
     return p - dest;
 }
@@ -1516,22 +1563,14 @@ size_t swift_format_decimal(char *dest, size_t length,
             *p++ = '0';
             exponent += 1;
         }
-        for (int i = 0; i < digit_count; ++i) {
-            *p++ = digits[i] + '0';
-        }
+        p = emitDigits(p, digits, digit_count);
     } else if (exponent < digit_count) {
-        for (int i = 0; i < digit_count; i++) {
-            if (exponent == 0) {
-                *p++ = '.';
-            }
-            *p++ = digits[i] + '0';
-            exponent -= 1;
-        }
+        p = emitDigits(p, digits, exponent);
+        *p++ = '.';
+        p = emitDigits(p, digits + exponent, digit_count - exponent);
     } else {
-        for (int i = 0; i < digit_count; i++) {
-            *p++ = digits[i] + '0';
-            exponent -= 1;
-        }
+        p = emitDigits(p, digits, digit_count);
+        exponent -= digit_count;
         while (exponent > 0) {
             *p++ = '0';
             exponent -= 1;
@@ -57,6 +57,11 @@ const Metadata *findHashableBaseTypeOfHashableType(
 /// If `type` does not conform to `Hashable`, `nullptr` is returned.
 const Metadata *findHashableBaseType(const Metadata *type);
 
+/// Find the witness table for `type`'s `Hashable` conformance, resolving
+/// it at most once per metadata pointer.
+/// If `type` does not conform to `Hashable`, `nullptr` is returned.
+const HashableWitnessTable *findHashableConformance(const Metadata *type);
+
 } // namespace hashable_support
 } // namespace swift
 
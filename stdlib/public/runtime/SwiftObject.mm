@@ -27,6 +27,7 @@
 #include "swift/Basic/LLVM.h"
 #include "swift/Basic/Lazy.h"
 #include "swift/Runtime/Casting.h"
+#include "swift/Runtime/Concurrent.h"
 #include "swift/Runtime/Heap.h"
 #include "swift/Runtime/HeapObject.h"
 #include "swift/Runtime/Metadata.h"
@@ -1266,7 +1267,44 @@ void swift::swift_instantiateObjCClass(const ClassMetadata *_c) {
   (void)registered;
 }
 
+namespace {
+/// An entry in the cache of Objective-C classes that are known to have
+/// been initialized by the Objective-C runtime.
+struct InitializedObjCClassEntry {
+  /// The class that was realized.
+  Class cls;
+
+  InitializedObjCClassEntry(Class cls) : cls(cls) {}
+
+  int compareWithKey(Class key) const {
+    auto a = reinterpret_cast<uintptr_t>(key);
+    auto b = reinterpret_cast<uintptr_t>(cls);
+    return a == b ? 0 : (a < b ? -1 : 1);
+  }
+
+  static size_t getExtraAllocationSize(Class key) {
+    return 0;
+  }
+
+  size_t getExtraAllocationSize() const {
+    return 0;
+  }
+};
+} // end anonymous namespace
+
+/// The set of classes we have already asked the Objective-C runtime to
+/// initialize. We only record a class after the message send returns, and
+/// lookups acquire, so a hit implies the realization is visible.
+static ConcurrentMap<InitializedObjCClassEntry, /*Destructor*/ false>
+  InitializedObjCClasses;
+
 Class swift::swift_getInitializedObjCClass(Class c) {
+  // If we've already initialized this class on a previous call, don't
+  // message it again; repeated calls on hot paths would otherwise pay an
+  // objc_msgSend per call just to re-check realization state.
+  if (InitializedObjCClasses.find(c))
+    return c;
+
   // Used when we have class metadata and we want to ensure a class has been
   // initialized by the Objective-C runtime. We need to do this because the
   // class "c" might be valid metadata, but it hasn't been initialized yet.
@@ -1274,6 +1312,7 @@ Class swift::swift_getInitializedObjCClass(Class c) {
   // side effects. Ignore the return value in case it is overridden to
   // return something different. See SR-10463 for an example.
   [c self];
+  InitializedObjCClasses.getOrInsert(c);
   return c;
 }
 
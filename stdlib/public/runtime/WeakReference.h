@@ -190,6 +190,42 @@ class WeakReference {
     nativeValue.store(WeakReferenceBits(side), std::memory_order_relaxed);
   }
 
+  // Non-atomic variants of the helpers above. The weak variable's own
+  // storage is always accessed with relaxed atomics; what these skip is
+  // the compare-and-swap loops on the side table's reference counts.
+  // They may only be used when the referenced object is known not to be
+  // accessed by any other thread, same as the swift_nonatomic_* entry
+  // points for strong and unowned references.
+
+  void destroyOldNativeBitsNonAtomic(WeakReferenceBits oldBits) {
+    auto oldSide = oldBits.getNativeOrNull();
+    if (oldSide)
+      oldSide->decrementWeakNonAtomic();
+  }
+
+  HeapObject *nativeLoadStrongFromBitsNonAtomic(WeakReferenceBits bits) {
+    auto side = bits.getNativeOrNull();
+    return side ? side->tryRetainNonAtomic() : nullptr;
+  }
+
+  HeapObject *nativeTakeStrongFromBitsNonAtomic(WeakReferenceBits bits) {
+    auto side = bits.getNativeOrNull();
+    if (side) {
+      side->decrementWeakNonAtomic();
+      return side->tryRetainNonAtomic();
+    } else {
+      return nullptr;
+    }
+  }
+
+  void nativeCopyInitFromBitsNonAtomic(WeakReferenceBits srcBits) {
+    auto side = srcBits.getNativeOrNull();
+    if (side)
+      side = side->incrementWeakNonAtomic();
+
+    nativeValue.store(WeakReferenceBits(side), std::memory_order_relaxed);
+  }
+
  public:
   
   WeakReference() : nativeValue() {}
@@ -264,6 +300,68 @@ class WeakReference {
     nativeTakeInit(src);
   }
 
+  // Non-atomic entry points, mirroring the atomic family above.
+  // nativeTakeInit has no non-atomic variant because it performs no
+  // reference count operations to begin with.
+
+  void nativeInitNonAtomic(HeapObject *object) {
+    auto side =
+      object ? object->refCounts.formWeakReferenceNonAtomic() : nullptr;
+    nativeValue.store(WeakReferenceBits(side), std::memory_order_relaxed);
+  }
+
+  void nativeDestroyNonAtomic() {
+    auto oldBits = nativeValue.load(std::memory_order_relaxed);
+    nativeValue.store(nullptr, std::memory_order_relaxed);
+    destroyOldNativeBitsNonAtomic(oldBits);
+  }
+
+  void nativeAssignNonAtomic(HeapObject *newObject) {
+    if (newObject) {
+      assert(objectUsesNativeSwiftReferenceCounting(newObject) &&
+             "weak assign native with non-native new object");
+    }
+
+    auto newSide =
+      newObject ? newObject->refCounts.formWeakReferenceNonAtomic() : nullptr;
+    auto newBits = WeakReferenceBits(newSide);
+
+    auto oldBits = nativeValue.load(std::memory_order_relaxed);
+    nativeValue.store(newBits, std::memory_order_relaxed);
+
+    assert(oldBits.isNativeOrNull() &&
+           "weak assign native with non-native old object");
+    destroyOldNativeBitsNonAtomic(oldBits);
+  }
+
+  HeapObject *nativeLoadStrongNonAtomic() {
+    auto bits = nativeValue.load(std::memory_order_relaxed);
+    return nativeLoadStrongFromBitsNonAtomic(bits);
+  }
+
+  HeapObject *nativeTakeStrongNonAtomic() {
+    auto bits = nativeValue.load(std::memory_order_relaxed);
+    nativeValue.store(nullptr, std::memory_order_relaxed);
+    return nativeTakeStrongFromBitsNonAtomic(bits);
+  }
+
+  void nativeCopyInitNonAtomic(WeakReference *src) {
+    auto srcBits = src->nativeValue.load(std::memory_order_relaxed);
+    return nativeCopyInitFromBitsNonAtomic(srcBits);
+  }
+
+  void nativeCopyAssignNonAtomic(WeakReference *src) {
+    if (this == src) return;
+    nativeDestroyNonAtomic();
+    nativeCopyInitNonAtomic(src);
+  }
+
+  void nativeTakeAssignNonAtomic(WeakReference *src) {
+    if (this == src) return;
+    nativeDestroyNonAtomic();
+    nativeTakeInit(src);
+  }
+
 #if SWIFT_OBJC_INTEROP
  private:
   void nonnativeInit(id object) {
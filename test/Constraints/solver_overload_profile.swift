@@ -0,0 +1,27 @@
+// RUN: %empty-directory(%t)
+
+// Round trip: the first compile records the solved '+' application and
+// persists it; the second compile loads the profile back and bumps the count.
+
+// RUN: %target-swift-frontend -typecheck -solver-overload-profile-path %t/profile.tsv %s
+// RUN: %FileCheck -check-prefix=FIRST %s < %t/profile.tsv
+// FIRST: 1{{.}}+|Int|Int|Swift.
+
+// RUN: %target-swift-frontend -typecheck -solver-overload-profile-path %t/profile.tsv %s
+// RUN: %FileCheck -check-prefix=SECOND %s < %t/profile.tsv
+// SECOND: 2{{.}}+|Int|Int|Swift.
+
+// A profile with garbage contents only loses its unparseable entries: type
+// checking is unaffected and the file is rewritten with valid contents.
+
+// RUN: echo "this is not a profile" > %t/garbage.tsv
+// RUN: printf 'NaN\t+|Int|Int|Swift.bogus\n\t\n12345\n' >> %t/garbage.tsv
+// RUN: %target-swift-frontend -typecheck -solver-overload-profile-path %t/garbage.tsv %s
+// RUN: %FileCheck -check-prefix=GARBAGE %s < %t/garbage.tsv
+// GARBAGE-NOT: this is not a profile
+// GARBAGE: 1{{.}}+|Int|Int|Swift.
+// GARBAGE-NOT: this is not a profile
+
+func add(a: Int, b: Int) -> Int {
+  return a + b
+}
@@ -0,0 +1,25 @@
+// RUN: %target-swiftc_driver -lto=llvm-thin %s -### 2>&1 | %FileCheck %s -check-prefix=CHECK-THIN
+// CHECK-THIN: -frontend
+// CHECK-THIN-SAME: -lto=llvm-thin
+
+// RUN: %target-swiftc_driver -lto=llvm-full %s -### 2>&1 | %FileCheck %s -check-prefix=CHECK-FULL
+// CHECK-FULL: -frontend
+// CHECK-FULL-SAME: -lto=llvm-full
+
+// On ELF targets the clang link invocation engages the linker's LTO plugin
+// with the matching -flto= mode; the Darwin link is unchanged because ld64
+// detects bitcode members on its own.
+
+// RUN: %swiftc_driver -driver-print-jobs -target x86_64-unknown-linux-gnu -lto=llvm-thin %s 2>&1 | %FileCheck %s -check-prefix=CHECK-LINK-THIN-LINUX
+// CHECK-LINK-THIN-LINUX: clang{{(\.exe)?"? }}
+// CHECK-LINK-THIN-LINUX-SAME: -flto=thin
+
+// RUN: %swiftc_driver -driver-print-jobs -target x86_64-unknown-linux-gnu -lto=llvm-full %s 2>&1 | %FileCheck %s -check-prefix=CHECK-LINK-FULL-LINUX
+// CHECK-LINK-FULL-LINUX: clang{{(\.exe)?"? }}
+// CHECK-LINK-FULL-LINUX-SAME: -flto=full
+
+// RUN: %swiftc_driver -driver-print-jobs -target x86_64-apple-macosx10.9 -lto=llvm-full %s 2>&1 | %FileCheck %s -check-prefix=CHECK-LINK-MACHO
+// CHECK-LINK-MACHO-NOT: -flto
+
+// RUN: not %target-swiftc_driver -lto=unknown %s 2>&1 | %FileCheck %s -check-prefix=CHECK-INVALID
+// CHECK-INVALID: invalid value 'unknown' in '-lto=unknown'
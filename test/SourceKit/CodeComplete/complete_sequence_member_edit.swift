@@ -0,0 +1,197 @@
+// BEGIN State1.swift
+struct Unrelated {
+  var a: Int
+  // unrelated-placeholder
+}
+class Mentioned {
+  var x: Int
+  // mentioned-placeholder
+}
+class Enclosing {
+  // enclosing-placeholder
+  func method() {
+    _ = self.
+  }
+}
+class Extended {
+  var e: Int
+  // extended-placeholder
+}
+extension Extended {
+  func extMethod() {
+    _ = self.
+  }
+}
+func test(arg: Mentioned) {
+  _ = arg.
+}
+
+// BEGIN State2.swift
+struct Unrelated {
+  var a: Int
+  var b: Int
+}
+class Mentioned {
+  var x: Int
+  // mentioned-placeholder
+}
+class Enclosing {
+  // enclosing-placeholder
+  func method() {
+    _ = self.
+  }
+}
+class Extended {
+  var e: Int
+  // extended-placeholder
+}
+extension Extended {
+  func extMethod() {
+    _ = self.
+  }
+}
+func test(arg: Mentioned) {
+  _ = arg.
+}
+
+// BEGIN State3.swift
+struct Unrelated {
+  var a: Int
+  var b: Int
+}
+class Mentioned {
+  var x: Int
+  var y: Int
+}
+class Enclosing {
+  // enclosing-placeholder
+  func method() {
+    _ = self.
+  }
+}
+class Extended {
+  var e: Int
+  // extended-placeholder
+}
+extension Extended {
+  func extMethod() {
+    _ = self.
+  }
+}
+func test(arg: Mentioned) {
+  _ = arg.
+}
+
+// BEGIN State4.swift
+struct Unrelated {
+  var a: Int
+  var b: Int
+}
+class Mentioned {
+  var x: Int
+  var y: Int
+}
+class Enclosing {
+  func added() {}
+  func method() {
+    _ = self.
+  }
+}
+class Extended {
+  var e: Int
+  // extended-placeholder
+}
+extension Extended {
+  func extMethod() {
+    _ = self.
+  }
+}
+func test(arg: Mentioned) {
+  _ = arg.
+}
+
+// BEGIN State5.swift
+struct Unrelated {
+  var a: Int
+  var b: Int
+}
+class Mentioned {
+  var x: Int
+  var y: Int
+}
+class Enclosing {
+  func added() {}
+  func method() {
+    _ = self.
+  }
+}
+class Extended {
+  var e: Int
+  var f: Int
+}
+extension Extended {
+  func extMethod() {
+    _ = self.
+  }
+}
+func test(arg: Mentioned) {
+  _ = arg.
+}
+
+// BEGIN DUMMY.swift
+
+// Checks the decisions the cached completion AST makes for member-level
+// edits. Each state replaces one placeholder comment with a new member, so
+// all states have identical line numbers:
+// - State2 adds a member to 'Unrelated', which the completion at 'arg.'
+//   cannot observe: the AST is reused.
+// - State3 adds a member to 'Mentioned', which is named in 'test's
+//   signature: rebuilt.
+// - State4 adds a member to 'Enclosing', the type enclosing the completion
+//   point: rebuilt.
+// - State5 adds a member to 'Extended'; the completion is in an extension
+//   of it: rebuilt.
+
+// RUN: %empty-directory(%t)
+// RUN: %{python} %utils/split_file.py -o %t %s
+
+// RUN: %sourcekitd-test \
+// RUN:   -req=complete -pos=25:11 -name file.swift -text-input %t/State1.swift -- file.swift == \
+// RUN:   -req=complete -pos=25:11 -name file.swift -text-input %t/State2.swift -- file.swift == \
+// RUN:   -req=complete -pos=25:11 -name file.swift -text-input %t/State3.swift -- file.swift == \
+// RUN:   -req=complete -pos=12:14 -name file.swift -text-input %t/State4.swift -- file.swift == \
+// RUN:   -req=complete -pos=21:14 -name file.swift -text-input %t/State5.swift -- file.swift > %t.response
+// RUN: %FileCheck --check-prefix=RESULT %s < %t.response
+
+// Initial build.
+// RESULT-LABEL: key.results: [
+// RESULT-DAG: key.name: "x"
+// RESULT: ]
+// RESULT-NOT: key.reusingastcontext: 1
+
+// Member added to 'Unrelated': reused.
+// RESULT-LABEL: key.results: [
+// RESULT-DAG: key.name: "x"
+// RESULT: ]
+// RESULT: key.reusingastcontext: 1
+
+// Member added to 'Mentioned': rebuilt, and the new member is visible.
+// RESULT-LABEL: key.results: [
+// RESULT-DAG: key.name: "x"
+// RESULT-DAG: key.name: "y"
+// RESULT: ]
+// RESULT-NOT: key.reusingastcontext: 1
+
+// Member added to 'Enclosing': rebuilt, and the new member is visible.
+// RESULT-LABEL: key.results: [
+// RESULT-DAG: key.name: "method()"
+// RESULT-DAG: key.name: "added()"
+// RESULT: ]
+// RESULT-NOT: key.reusingastcontext: 1
+
+// Member added to 'Extended': rebuilt, and the new member is visible.
+// RESULT-LABEL: key.results: [
+// RESULT-DAG: key.name: "e"
+// RESULT-DAG: key.name: "f"
+// RESULT: ]
+// RESULT-NOT: key.reusingastcontext: 1
@@ -0,0 +1,4 @@
+let foo = 1
+let bar = 2
+let str = "a" + "b"
+let baz = 3
@@ -0,0 +1,191 @@
+// Checks the edits that may and may not rebuild the syntax map
+// incrementally. Each RUN line opens the document and performs a single edit;
+// the reported map must be the same whether the incremental splice or the
+// full rebuild path handled it.
+
+// Replacing an identifier with another identifier is lexically local and is
+// spliced into the existing map.
+
+// RUN: %sourcekitd-test -req=open -print-raw-response %S/Inputs/syntaxmap-local-rebuild.swift == -req=edit -print-raw-response %S/Inputs/syntaxmap-local-rebuild.swift -pos=2:5 -length=3 -replace="renamed" | %sed_clean > %t.local.response
+// RUN: %FileCheck -check-prefix=CHECK -check-prefix=LOCAL -input-file=%t.local.response %s
+
+// Inserting directly in front of an identifier joins with it; the rebuilt
+// region has to extend over the adjacent token.
+
+// RUN: %sourcekitd-test -req=open -print-raw-response %S/Inputs/syntaxmap-local-rebuild.swift == -req=edit -print-raw-response %S/Inputs/syntaxmap-local-rebuild.swift -pos=2:5 -length=0 -replace="re" | %sed_clean > %t.join.response
+// RUN: %FileCheck -check-prefix=CHECK -check-prefix=JOIN -input-file=%t.join.response %s
+
+// Removing a string delimiter re-lexes everything to the right of the edit:
+// 'a' and 'b' leave their string and the trailing quote is left unterminated.
+
+// RUN: %sourcekitd-test -req=open -print-raw-response %S/Inputs/syntaxmap-local-rebuild.swift == -req=edit -print-raw-response %S/Inputs/syntaxmap-local-rebuild.swift -pos=3:11 -length=1 -replace=" " | %sed_clean > %t.string.response
+// RUN: %FileCheck -check-prefix=CHECK -check-prefix=STRING -input-file=%t.string.response %s
+
+// Inserting a comment marker swallows the rest of the line.
+
+// RUN: %sourcekitd-test -req=open -print-raw-response %S/Inputs/syntaxmap-local-rebuild.swift == -req=edit -print-raw-response %S/Inputs/syntaxmap-local-rebuild.swift -pos=4:1 -length=0 -replace="// " | %sed_clean > %t.comment.response
+// RUN: %FileCheck -check-prefix=CHECK -check-prefix=COMMENT -input-file=%t.comment.response %s
+
+// Inserting a '#' directive.
+
+// RUN: %sourcekitd-test -req=open -print-raw-response %S/Inputs/syntaxmap-local-rebuild.swift == -req=edit -print-raw-response %S/Inputs/syntaxmap-local-rebuild.swift -pos=1:11 -length=1 -replace="#line" | %sed_clean > %t.directive.response
+// RUN: %FileCheck -check-prefix=CHECK -check-prefix=DIRECTIVE -input-file=%t.directive.response %s
+
+// Initial state
+
+// CHECK: {{^}}{
+// CHECK-NEXT: key.offset: 0,
+// CHECK-NEXT: key.length: 56,
+// CHECK-NEXT: key.diagnostic_stage: source.diagnostic.stage.swift.parse,
+// CHECK-NEXT: key.syntaxmap: [
+// CHECK-NEXT:   {
+// CHECK-NEXT:     key.kind: source.lang.swift.syntaxtype.keyword,
+// CHECK-NEXT:     key.offset: 0,
+// CHECK-NEXT:     key.length: 3
+// CHECK-NEXT:   },
+// CHECK-NEXT:   {
+// CHECK-NEXT:     key.kind: source.lang.swift.syntaxtype.identifier,
+// CHECK-NEXT:     key.offset: 4,
+// CHECK-NEXT:     key.length: 3
+// CHECK-NEXT:   },
+// CHECK-NEXT:   {
+// CHECK-NEXT:     key.kind: source.lang.swift.syntaxtype.number,
+// CHECK-NEXT:     key.offset: 10,
+// CHECK-NEXT:     key.length: 1
+// CHECK-NEXT:   },
+// CHECK-NEXT:   {
+// CHECK-NEXT:     key.kind: source.lang.swift.syntaxtype.keyword,
+// CHECK-NEXT:     key.offset: 12,
+// CHECK-NEXT:     key.length: 3
+// CHECK-NEXT:   },
+// CHECK-NEXT:   {
+// CHECK-NEXT:     key.kind: source.lang.swift.syntaxtype.identifier,
+// CHECK-NEXT:     key.offset: 16,
+// CHECK-NEXT:     key.length: 3
+// CHECK-NEXT:   },
+// CHECK-NEXT:   {
+// CHECK-NEXT:     key.kind: source.lang.swift.syntaxtype.number,
+// CHECK-NEXT:     key.offset: 22,
+// CHECK-NEXT:     key.length: 1
+// CHECK-NEXT:   },
+// CHECK-NEXT:   {
+// CHECK-NEXT:     key.kind: source.lang.swift.syntaxtype.keyword,
+// CHECK-NEXT:     key.offset: 24,
+// CHECK-NEXT:     key.length: 3
+// CHECK-NEXT:   },
+// CHECK-NEXT:   {
+// CHECK-NEXT:     key.kind: source.lang.swift.syntaxtype.identifier,
+// CHECK-NEXT:     key.offset: 28,
+// CHECK-NEXT:     key.length: 3
+// CHECK-NEXT:   },
+// CHECK-NEXT:   {
+// CHECK-NEXT:     key.kind: source.lang.swift.syntaxtype.string,
+// CHECK-NEXT:     key.offset: 34,
+// CHECK-NEXT:     key.length: 3
+// CHECK-NEXT:   },
+// CHECK-NEXT:   {
+// CHECK-NEXT:     key.kind: source.lang.swift.syntaxtype.string,
+// CHECK-NEXT:     key.offset: 40,
+// CHECK-NEXT:     key.length: 3
+// CHECK-NEXT:   },
+// CHECK-NEXT:   {
+// CHECK-NEXT:     key.kind: source.lang.swift.syntaxtype.keyword,
+// CHECK-NEXT:     key.offset: 44,
+// CHECK-NEXT:     key.length: 3
+// CHECK-NEXT:   },
+// CHECK-NEXT:   {
+// CHECK-NEXT:     key.kind: source.lang.swift.syntaxtype.identifier,
+// CHECK-NEXT:     key.offset: 48,
+// CHECK-NEXT:     key.length: 3
+// CHECK-NEXT:   },
+// CHECK-NEXT:   {
+// CHECK-NEXT:     key.kind: source.lang.swift.syntaxtype.number,
+// CHECK-NEXT:     key.offset: 54,
+// CHECK-NEXT:     key.length: 1
+// CHECK-NEXT:   }
+// CHECK-NEXT: ],
+
+// After replacing 'bar' with 'renamed'
+
+// LOCAL: {{^}}{
+// LOCAL-NEXT: key.offset: 16,
+// LOCAL-NEXT: key.length: 7,
+// LOCAL-NEXT: key.diagnostic_stage: source.diagnostic.stage.swift.parse,
+// LOCAL-NEXT: key.syntaxmap: [
+// LOCAL-NEXT:   {
+// LOCAL-NEXT:     key.kind: source.lang.swift.syntaxtype.identifier,
+// LOCAL-NEXT:     key.offset: 16,
+// LOCAL-NEXT:     key.length: 7
+// LOCAL-NEXT:   }
+// LOCAL-NEXT: ],
+
+// After inserting 're' in front of 'bar', forming 'rebar'
+
+// JOIN: {{^}}{
+// JOIN-NEXT: key.offset: 16,
+// JOIN-NEXT: key.length: 5,
+// JOIN-NEXT: key.diagnostic_stage: source.diagnostic.stage.swift.parse,
+// JOIN-NEXT: key.syntaxmap: [
+// JOIN-NEXT:   {
+// JOIN-NEXT:     key.kind: source.lang.swift.syntaxtype.identifier,
+// JOIN-NEXT:     key.offset: 16,
+// JOIN-NEXT:     key.length: 5
+// JOIN-NEXT:   }
+// JOIN-NEXT: ],
+
+// After replacing the opening quote of "a" with a space
+
+// STRING: {{^}}{
+// STRING-NEXT: key.offset: 34,
+// STRING-NEXT: key.length: 9,
+// STRING-NEXT: key.diagnostic_stage: source.diagnostic.stage.swift.parse,
+// STRING-NEXT: key.syntaxmap: [
+// STRING-NEXT:   {
+// STRING-NEXT:     key.kind: source.lang.swift.syntaxtype.identifier,
+// STRING-NEXT:     key.offset: 35,
+// STRING-NEXT:     key.length: 1
+// STRING-NEXT:   },
+// STRING-NEXT:   {
+// STRING-NEXT:     key.kind: source.lang.swift.syntaxtype.string,
+// STRING-NEXT:     key.offset: 36,
+// STRING-NEXT:     key.length: 5
+// STRING-NEXT:   },
+// STRING-NEXT:   {
+// STRING-NEXT:     key.kind: source.lang.swift.syntaxtype.identifier,
+// STRING-NEXT:     key.offset: 41,
+// STRING-NEXT:     key.length: 1
+// STRING-NEXT:   },
+// STRING-NEXT:   {
+// STRING-NEXT:     key.kind: source.lang.swift.syntaxtype.string,
+// STRING-NEXT:     key.offset: 42,
+// STRING-NEXT:     key.length: 1
+// STRING-NEXT:   }
+// STRING-NEXT: ],
+
+// After commenting out the last line
+
+// COMMENT: {{^}}{
+// COMMENT-NEXT: key.offset: 44,
+// COMMENT-NEXT: key.length: 15,
+// COMMENT-NEXT: key.diagnostic_stage: source.diagnostic.stage.swift.parse,
+// COMMENT-NEXT: key.syntaxmap: [
+// COMMENT-NEXT:   {
+// COMMENT-NEXT:     key.kind: source.lang.swift.syntaxtype.comment,
+// COMMENT-NEXT:     key.offset: 44,
+// COMMENT-NEXT:     key.length: 15
+// COMMENT-NEXT:   }
+// COMMENT-NEXT: ],
+
+// After replacing '1' with '#line'
+
+// DIRECTIVE: {{^}}{
+// DIRECTIVE-NEXT: key.offset: 10,
+// DIRECTIVE-NEXT: key.length: 5,
+// DIRECTIVE-NEXT: key.diagnostic_stage: source.diagnostic.stage.swift.parse,
+// DIRECTIVE-NEXT: key.syntaxmap: [
+// DIRECTIVE-NEXT:   {
+// DIRECTIVE-NEXT:     key.kind: source.lang.swift.syntaxtype.keyword,
+// DIRECTIVE-NEXT:     key.offset: 10,
+// DIRECTIVE-NEXT:     key.length: 5
+// DIRECTIVE-NEXT:   }
+// DIRECTIVE-NEXT: ],
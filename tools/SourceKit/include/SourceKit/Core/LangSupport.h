@@ -816,6 +816,18 @@ public:
                                        ConformingMethodListConsumer &Consumer,
                                        Optional<VFSOptions> vfsOptions) = 0;
 
+  /// Warm up the shared module caches for the given compiler arguments by
+  /// building an AST for \p PrimaryFile on a background queue, resolving and
+  /// loading the module dependency closure along the way.  Editors can issue
+  /// this when a project is opened so that the first semantic request only
+  /// pays the warm-path cost.
+  ///
+  /// \p Receiver is invoked once the warmup finishes, with an empty error
+  /// string on success.
+  virtual void warmupCaches(StringRef PrimaryFile,
+                            ArrayRef<const char *> Args,
+                            std::function<void(StringRef Error)> Receiver) = 0;
+
   virtual void getStatistics(StatisticsReceiver) = 0;
 };
 } // namespace SourceKit
@@ -21,6 +21,7 @@
 #include "SourceKit/Support/Tracing.h"
 
 #include "swift/Basic/Cache.h"
+#include "swift/Basic/FileSystem.h"
 #include "swift/Driver/FrontendUtil.h"
 #include "swift/Frontend/Frontend.h"
 #include "swift/Frontend/PrintingDiagnosticConsumer.h"
@@ -288,6 +289,12 @@ class ASTProducer : public ThreadSafeRefCountedBase<ASTProducer> {
   std::vector<QueuedConsumer> QueuedConsumers;
   llvm::sys::Mutex Mtx;
 
+  /// Serializes builds for this producer, since they mutate \c AST and the
+  /// dependency stamps. Different producers build on their own lanes, so a
+  /// slow build for one document does not block requests for the others.
+  WorkQueue BuildQueue{ WorkQueue::Dequeuing::Serial,
+                        "sourcekit.swift.ASTBuilding" };
+
 public:
   explicit ASTProducer(SwiftInvocationRef InvokRef)
     : InvokRef(std::move(InvokRef)) {}
@@ -388,9 +395,6 @@ struct SwiftASTManager::Implementation {
   llvm::sys::Mutex CacheMtx;
   std::time_t SessionTimestamp;
 
-  WorkQueue ASTBuildQueue{ WorkQueue::Dequeuing::Serial,
-                           "sourcekit.swift.ASTBuilding" };
-
   ASTProducerRef getASTProducer(SwiftInvocationRef InvokRef);
   FileContent
   getFileContent(StringRef FilePath, bool IsPrimary,
@@ -421,6 +425,12 @@ SwiftASTManager::getMemoryBuffer(StringRef Filename, std::string &Error) {
   return Impl.getMemoryBuffer(Filename, llvm::vfs::getRealFileSystem(), Error);
 }
 
+uint64_t SwiftASTManager::getBufferStamp(
+    StringRef FilePath,
+    llvm::IntrusiveRefCntPtr<llvm::vfs::FileSystem> FileSystem) {
+  return Impl.getBufferStamp(FilePath, std::move(FileSystem));
+}
+
 static FrontendInputsAndOutputs
 convertFileContentsToInputs(const SmallVectorImpl<FileContent> &contents) {
   FrontendInputsAndOutputs inputsAndOutputs;
@@ -748,6 +758,16 @@ SwiftASTManager::Implementation::getMemoryBuffer(
     llvm::IntrusiveRefCntPtr<llvm::vfs::FileSystem> FileSystem,
     std::string &Error) {
   assert(FileSystem);
+  // For files read off the real file system, hand out zero-copy views of a
+  // process-wide shared mapping so the many CompilerInstances we keep alive
+  // don't each duplicate large sources in memory. Custom file systems (e.g.
+  // snapshot overlays) may serve different content for the same path and
+  // must not share the cache.
+  if (FileSystem == llvm::vfs::getRealFileSystem()) {
+    if (auto SharedBufOrErr =
+            swift::vfs::getSharedBufferForFile(*FileSystem, Filename))
+      return std::move(SharedBufOrErr.get());
+  }
   llvm::ErrorOr<std::unique_ptr<llvm::MemoryBuffer>> FileBufOrErr =
       FileSystem->getBufferForFile(Filename);
   if (FileBufOrErr)
@@ -769,7 +789,7 @@ void ASTProducer::getASTUnitAsync(
   SmallVector<ImmutableTextSnapshotRef, 4> Snapshots;
   Snapshots.append(Snaps.begin(), Snaps.end());
 
-  Mgr->Impl.ASTBuildQueue.dispatch(
+  BuildQueue.dispatch(
       [ThisProducer, Mgr, fileSystem, Snapshots, Receiver] {
         std::string Error;
         ASTUnitRef Unit = ThisProducer->getASTUnitImpl(Mgr->Impl, fileSystem,
@@ -149,6 +149,13 @@ public:
 
   void removeCachedAST(SwiftInvocationRef Invok);
 
+  /// Returns a stamp that changes whenever the content of \p FilePath does,
+  /// consulting open editor documents before the file system. Returns -1 if
+  /// the file cannot be stat'ed.
+  uint64_t getBufferStamp(
+      StringRef FilePath,
+      llvm::IntrusiveRefCntPtr<llvm::vfs::FileSystem> FileSystem);
+
   struct Implementation;
   Implementation &Impl;
 };
@@ -28,6 +28,7 @@
 #include "swift/IDE/ModuleInterfacePrinting.h"
 #include "swift/IDE/SourceEntityWalker.h"
 #include "swift/IDE/SyntaxModel.h"
+#include "swift/Markup/Markup.h"
 #include "swift/IDE/Refactoring.h"
 // This is included only for createLazyResolver(). Move to different header ?
 #include "swift/Sema/IDETypeChecking.h"
@@ -313,7 +314,8 @@ static bool initDocEntityInfo(const Decl *D,
                               const Decl *DefaultImplementationOf, bool IsRef,
                               bool IsSynthesizedExtension, DocEntityInfo &Info,
                               StringRef Arg = StringRef(),
-                              ModuleDecl *DeclaringModForCrossImport = nullptr){
+                              ModuleDecl *DeclaringModForCrossImport = nullptr,
+                              swift::markup::MarkupContext *MC = nullptr) {
   if (!IsRef && D->isImplicit())
     return true;
   if (!D || isa<ParamDecl>(D) ||
@@ -376,7 +378,10 @@ static bool initDocEntityInfo(const Decl *D,
       llvm::SmallString<128> DocBuffer;
       {
         llvm::raw_svector_ostream OSS(DocBuffer);
-        ide::getDocumentationCommentAsXML(D, OSS);
+        if (MC)
+          ide::getDocumentationCommentAsXML(D, OSS, *MC);
+        else
+          ide::getDocumentationCommentAsXML(D, OSS);
       }
       StringRef DocRef = (StringRef)DocBuffer;
       if (IsSynthesizedExtension &&
@@ -467,12 +472,13 @@ static bool initDocEntityInfo(const Decl *D,
 }
 
 static bool initDocEntityInfo(const TextEntity &Entity,
-                              DocEntityInfo &Info) {
+                              DocEntityInfo &Info,
+                              swift::markup::MarkupContext &MC) {
   if (initDocEntityInfo(Entity.Dcl, Entity.SynthesizeTarget,
                         Entity.DefaultImplementationOf,
                         /*IsRef=*/false, Entity.IsSynthesizedExtension,
                         Info, Entity.Argument,
-                        Entity.DeclaringModIfFromCrossImportOverlay))
+                        Entity.DeclaringModIfFromCrossImportOverlay, &MC))
     return true;
   Info.Offset = Entity.Range.Offset;
   Info.Length = Entity.Range.Length;
@@ -669,17 +675,21 @@ static void reportAttributes(ASTContext &Ctx,
 
 static void reportDocEntities(ASTContext &Ctx,
                               ArrayRef<TextEntity> Entities,
-                              DocInfoConsumer &Consumer) {
+                              DocInfoConsumer &Consumer,
+                              swift::markup::MarkupContext &MC) {
   for (auto &Entity : Entities) {
     DocEntityInfo EntInfo;
-    if (initDocEntityInfo(Entity, EntInfo))
+    // The documentation is serialized into EntInfo, so the markup arena can
+    // be recycled for each entity.
+    MC.reset();
+    if (initDocEntityInfo(Entity, EntInfo, MC))
       continue;
     Consumer.startSourceEntity(EntInfo);
     reportRelated(Ctx, Entity.Dcl,
                   Entity.IsSynthesizedExtension ? Entity.SynthesizeTarget
                                                 : TypeOrExtensionDecl(),
                   Consumer);
-    reportDocEntities(Ctx, Entity.SubEntities, Consumer);
+    reportDocEntities(Ctx, Entity.SubEntities, Consumer, MC);
     reportAttributes(Ctx, Entity.Dcl, Consumer);
     Consumer.finishSourceEntity(EntInfo.Kind);
   }
@@ -1025,7 +1035,8 @@ static bool reportModuleDocInfo(CompilerInvocation Invocation,
   addParameterEntities(ParseCI, IFaceInfo);
 
   Consumer.handleSourceText(IFaceInfo.Text);
-  reportDocEntities(Ctx, IFaceInfo.TopEntities, Consumer);
+  swift::markup::MarkupContext MC;
+  reportDocEntities(Ctx, IFaceInfo.TopEntities, Consumer, MC);
   reportSourceAnnotations(IFaceInfo, ParseCI, Consumer);
 
   return false;
@@ -1146,7 +1157,8 @@ static bool reportSourceDocInfo(CompilerInvocation Invocation,
     return true;
   addParameterEntities(CI, SourceInfo);
 
-  reportDocEntities(Ctx, SourceInfo.TopEntities, Consumer);
+  swift::markup::MarkupContext MC;
+  reportDocEntities(Ctx, SourceInfo.TopEntities, Consumer, MC);
   reportSourceAnnotations(SourceInfo, CI, Consumer);
   for (auto &Diag : DiagConsumer.getDiagnosticsForBuffer(
                                                 CI.getInputBufferIDs().back()))
@@ -561,6 +561,31 @@ struct SwiftSyntaxMap {
 
     return true;
   }
+
+  /// Replaces the tokens intersecting \p Range with the tokens of \p Region,
+  /// dropping any tokens that were marked invalid by \c adjustForReplacement.
+  /// \p Region must only contain tokens within \p Range.
+  void spliceRegion(const SwiftEditorCharRange &Range,
+                    const SwiftSyntaxMap &Region) {
+    std::vector<SwiftSyntaxToken> Spliced;
+    Spliced.reserve(Tokens.size() + Region.Tokens.size());
+    auto Token = Tokens.begin();
+    auto End = Tokens.end();
+    for (; Token != End; ++Token) {
+      if (Token->isInvalid())
+        continue;
+      if (Token->endOffset() > Range.Offset)
+        break;
+      Spliced.push_back(*Token);
+    }
+    Spliced.insert(Spliced.end(), Region.Tokens.begin(), Region.Tokens.end());
+    for (; Token != End; ++Token) {
+      if (Token->isInvalid() || Token->Offset < Range.EndOffset)
+        continue;
+      Spliced.push_back(*Token);
+    }
+    Tokens = std::move(Spliced);
+  }
 };
 
 struct EditorConsumerSyntaxMapEntry {
@@ -676,6 +701,11 @@ class SwiftDocumentSyntaxInfo {
   unsigned BufferID;
   std::vector<std::string> Args;
   std::string PrimaryFile;
+  /// The document revision this syntax info was built from. Used to serve
+  /// repeated syntactic requests against the same revision from one parse.
+  ImmutableTextSnapshotRef Snapshot;
+  /// Whether a syntax tree was built alongside the AST.
+  bool BuiltSyntaxTree;
   /// Whether or not the AST stored in the source file is up-to-date or just an
   /// artifact of incremental syntax parsing
   bool HasUpToDateAST;
@@ -685,7 +715,8 @@ public:
                           ImmutableTextSnapshotRef Snapshot,
                           std::vector<std::string> &Args,
                           StringRef FilePath)
-        : Args(Args), PrimaryFile(FilePath) {
+        : Args(Args), PrimaryFile(FilePath), Snapshot(Snapshot),
+          BuiltSyntaxTree(CompInv.getLangOptions().BuildSyntaxTree) {
 
     std::unique_ptr<llvm::MemoryBuffer> BufCopy =
       llvm::MemoryBuffer::getMemBufferCopy(
@@ -743,6 +774,17 @@ public:
 
   bool hasUpToDateAST() { return HasUpToDateAST; }
 
+  /// Whether this syntax info can serve requests against \p NewSnapshot
+  /// without re-lexing and re-parsing the buffer. Requires a full (non
+  /// incremental) parse of the same revision, with a syntax tree if the new
+  /// consumer needs one.
+  bool canServeSnapshot(ImmutableTextSnapshotRef NewSnapshot,
+                        bool NeedsSyntaxTree) {
+    return HasUpToDateAST && Snapshot->isFromSameBuffer(NewSnapshot) &&
+           Snapshot->getStamp() == NewSnapshot->getStamp() &&
+           (BuiltSyntaxTree || !NeedsSyntaxTree);
+  }
+
   ArrayRef<DiagnosticEntryInfo> getDiagnostics() {
     return DiagConsumer.getDiagnosticsForBuffer(BufferID);
   }
@@ -1062,6 +1104,12 @@ struct SwiftEditorDocument::Implementation {
   SwiftSyntaxMap SyntaxMap;
   /// The minimal range of syntax highlighted tokens affected by the last edit
   llvm::Optional<SwiftEditorCharRange> AffectedRange;
+  /// The range the last edit rewrote, in the coordinates of the new buffer
+  llvm::Optional<SwiftEditorCharRange> EditedRange;
+  /// Whether the last edit is known to leave the lexing of the rest of the
+  /// document unchanged, i.e. it did not insert or remove string or comment
+  /// delimiters, escapes, or directives
+  bool EditIsLexicallyLocal = false;
   /// Whether the last operation was an edit rather than a document open
   bool Edited;
   /// The syntax tree of the document
@@ -1411,14 +1459,18 @@ class SwiftEditorSyntaxWalker: public ide::SyntaxModelWalker {
   SourceManager &SrcManager;
   unsigned BufferID;
   SwiftDocumentStructureWalker DocStructureWalker;
+  /// When set, only tokens intersecting this range are added to the map
+  llvm::Optional<SwiftEditorCharRange> FilterRange;
   /// The current token nesting level (e.g. for a field in a doc comment)
   unsigned NestingLevel = 0;
 public:
-  SwiftEditorSyntaxWalker(SwiftSyntaxMap &SyntaxMap,
-                          SourceManager &SrcManager, EditorConsumer &Consumer,
-                          unsigned BufferID)
+  SwiftEditorSyntaxWalker(
+      SwiftSyntaxMap &SyntaxMap, SourceManager &SrcManager,
+      EditorConsumer &Consumer, unsigned BufferID,
+      llvm::Optional<SwiftEditorCharRange> FilterRange = llvm::None)
     : SyntaxMap(SyntaxMap), SrcManager(SrcManager), BufferID(BufferID),
-      DocStructureWalker(SrcManager, BufferID, Consumer) { }
+      DocStructureWalker(SrcManager, BufferID, Consumer),
+      FilterRange(FilterRange) { }
 
   bool walkToNodePre(SyntaxNode Node) override {
     if (Node.Kind == SyntaxNodeKind::CommentMarker)
@@ -1428,6 +1480,13 @@ public:
     auto End = SrcManager.getLocOffsetInBuffer(Node.Range.getEnd(), BufferID),
       Start = SrcManager.getLocOffsetInBuffer(Node.Range.getStart(), BufferID);
 
+    if (FilterRange &&
+        (End <= FilterRange->Offset || Start >= FilterRange->EndOffset)) {
+      // Outside the range we're rebuilding - keep nesting balanced but don't
+      // record the token
+      return true;
+    }
+
     if (NestingLevel > 1) {
       // We're nested inside the previously reported token - merge
       SyntaxMap.mergeToken({Start, End - Start, Node.Kind});
@@ -1800,6 +1859,8 @@ ImmutableTextSnapshotRef SwiftEditorDocument::initializeText(
   // Reset the syntax map data and affected range
   Impl.SyntaxMap.Tokens.clear();
   Impl.AffectedRange = {0, static_cast<unsigned>(Buf->getBufferSize())};
+  Impl.EditedRange = llvm::None;
+  Impl.EditIsLexicallyLocal = false;
 
   // Try to create a compiler invocation object if needing semantic info
   // or it's syntactic-only but with passed-in compiler arguments.
@@ -1840,6 +1901,16 @@ ImmutableTextSnapshotRef SwiftEditorDocument::replaceText(
     Impl.Edited = true;
     llvm::StringRef Str = Buf->getBuffer();
 
+    // An edit can only change lexing outside the replaced range if it adds or
+    // removes a string/comment delimiter, an escape, or a directive. Note this
+    // must be checked before the replacement below consumes the old text.
+    llvm::StringRef Removed =
+        EditableBuffer->getBuffer()->getText().substr(Offset, Length);
+    Impl.EditIsLexicallyLocal =
+        Removed.find_first_of("\"/*`#\\") == StringRef::npos &&
+        Str.find_first_of("\"/*`#\\") == StringRef::npos;
+    Impl.EditedRange = {Offset, Offset + static_cast<unsigned>(Str.size())};
+
     // Update the buffer itself
     Snapshot = EditableBuffer->replace(Offset, Length, Str);
 
@@ -1888,6 +1959,15 @@ void SwiftEditorDocument::parse(ImmutableTextSnapshotRef Snapshot,
 
   assert(Impl.SemanticInfo && "Impl.SemanticInfo must be set");
 
+  // One lex and parse per document revision: if the retained syntax info was
+  // built from a snapshot with the same stamp and compatible settings, every
+  // syntactic consumer (syntax map, SyntaxModel, formatting, placeholder
+  // expansion) can be served from it directly. Incremental reparses always
+  // come with a new stamp and take the full path below.
+  if (Impl.SyntaxInfo && !SyntaxCache &&
+      Impl.SyntaxInfo->canServeSnapshot(Snapshot, BuildSyntaxTree))
+    return;
+
   std::vector<std::string> Args;
   std::string PrimaryFile; // Ignored, Impl.FilePath will be used
 
@@ -1918,11 +1998,54 @@ void SwiftEditorDocument::parse(ImmutableTextSnapshotRef Snapshot,
   Impl.SyntaxInfo->parse();
 }
 
+/// Computes the range of the buffer whose syntax map tokens have to be rebuilt
+/// after the last edit, or \c None if the whole map has to be rebuilt.
+///
+/// The range covers the edited text, any tokens the edit invalidated, and the
+/// adjacent tokens on either side (the edit may have joined with them to form
+/// longer tokens, e.g. by inserting characters directly in front of an
+/// identifier). If the resulting region contains string or comment delimiters,
+/// escapes, or directives, it may not lex independently of the rest of the
+/// buffer (e.g. the edit could terminate a previously unterminated string) and
+/// \c None is returned.
+static llvm::Optional<SwiftEditorCharRange>
+getLocalRebuildRange(const SwiftSyntaxMap &OldMap,
+                     llvm::Optional<SwiftEditorCharRange> EditedRange,
+                     llvm::Optional<SwiftEditorCharRange> AffectedRange,
+                     StringRef BufferText) {
+  if (!EditedRange)
+    return llvm::None;
+  SwiftEditorCharRange Range = *EditedRange;
+  if (AffectedRange)
+    Range.extendToInclude(*AffectedRange);
+
+  for (auto &Token : OldMap.Tokens) {
+    if (Token.isInvalid())
+      continue;
+    if (Token.Offset < Range.Offset && Token.endOffset() >= Range.Offset)
+      Range.Offset = Token.Offset;
+    if (Token.Offset <= Range.EndOffset && Token.endOffset() > Range.EndOffset)
+      Range.EndOffset = Token.endOffset();
+    if (Token.Offset > Range.EndOffset)
+      break;
+  }
+  if (Range.EndOffset > BufferText.size())
+    Range.EndOffset = BufferText.size();
+
+  if (BufferText.substr(Range.Offset, Range.length())
+          .find_first_of("\"/*`#\\") != StringRef::npos)
+    return llvm::None;
+  return Range;
+}
+
 void SwiftEditorDocument::readSyntaxInfo(EditorConsumer &Consumer) {
   llvm::sys::ScopedLock L(Impl.AccessMtx);
 
   Impl.ParserDiagnostics = Impl.SyntaxInfo->getDiagnostics();
 
+  auto EditedRange = Impl.EditedRange;
+  Impl.EditedRange = llvm::None;
+
   SwiftSyntaxMap NewMap = SwiftSyntaxMap(Impl.SyntaxMap.Tokens.size() + 16);
 
   if (Consumer.syntaxTreeEnabled()) {
@@ -1942,11 +2065,35 @@ void SwiftEditorDocument::readSyntaxInfo(EditorConsumer &Consumer) {
     }
   } else {
     ide::SyntaxModelContext ModelContext(Impl.SyntaxInfo->getSourceFile());
-
-    SwiftEditorSyntaxWalker SyntaxWalker(
-        NewMap, Impl.SyntaxInfo->getSourceManager(), Consumer,
-        Impl.SyntaxInfo->getBufferID());
-    ModelContext.walk(SyntaxWalker);
+    auto &SM = Impl.SyntaxInfo->getSourceManager();
+    unsigned BufferID = Impl.SyntaxInfo->getBufferID();
+
+    // For an edit that cannot have changed lexing elsewhere in the document,
+    // rebuild the syntax map for the edited region only and splice it into
+    // the previous (already position-adjusted) map. Document structure
+    // consumers always need a full walk.
+    llvm::Optional<SwiftEditorCharRange> RebuildRange;
+    if (Impl.Edited && Impl.EditIsLexicallyLocal &&
+        !Consumer.documentStructureEnabled()) {
+      RebuildRange =
+          getLocalRebuildRange(Impl.SyntaxMap, EditedRange, Impl.AffectedRange,
+                               SM.getEntireTextForBuffer(BufferID));
+    }
+
+    if (RebuildRange) {
+      SwiftSyntaxMap RegionMap;
+      SwiftEditorSyntaxWalker SyntaxWalker(RegionMap, SM, Consumer, BufferID,
+                                           RebuildRange);
+      ModelContext.walk(SyntaxWalker,
+                        CharSourceRange(
+                            SM.getLocForOffset(BufferID, RebuildRange->Offset),
+                            RebuildRange->length()));
+      NewMap = Impl.SyntaxMap;
+      NewMap.spliceRegion(*RebuildRange, RegionMap);
+    } else {
+      SwiftEditorSyntaxWalker SyntaxWalker(NewMap, SM, Consumer, BufferID);
+      ModelContext.walk(SyntaxWalker);
+    }
 
     bool SawChanges = true;
     if (Impl.Edited) {
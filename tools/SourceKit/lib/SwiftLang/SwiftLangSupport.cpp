@@ -904,6 +904,43 @@ std::string SwiftLangSupport::resolvePathSymlinks(StringRef FilePath) {
   return std::string(output.str());
 }
 
+namespace {
+/// An AST consumer that only cares that the AST was built: building it
+/// resolves and loads the module dependency closure into the shared caches,
+/// and the manager retains the AST itself for reuse by later requests.
+class CacheWarmupASTConsumer : public SwiftASTConsumer {
+  std::function<void(StringRef Error)> Receiver;
+
+public:
+  explicit CacheWarmupASTConsumer(
+      std::function<void(StringRef Error)> Receiver)
+      : Receiver(std::move(Receiver)) {}
+
+  void handlePrimaryAST(ASTUnitRef AstUnit) override { Receiver(StringRef()); }
+  void failed(StringRef Error) override { Receiver(Error); }
+  void cancelled() override { Receiver("warmup request cancelled"); }
+};
+} // end anonymous namespace
+
+void SwiftLangSupport::warmupCaches(
+    StringRef PrimaryFile, ArrayRef<const char *> Args,
+    std::function<void(StringRef Error)> Receiver) {
+  std::string Error;
+  SwiftInvocationRef Invok = ASTMgr->getInvocation(Args, PrimaryFile, Error);
+  if (!Invok) {
+    Receiver(Error);
+    return;
+  }
+
+  // The AST manager builds the AST on its own queue, so this returns
+  // immediately and the warmup proceeds in the background.
+  ASTMgr->processASTAsync(Invok,
+                          std::make_shared<CacheWarmupASTConsumer>(
+                              std::move(Receiver)),
+                          /*OncePerASTToken=*/nullptr,
+                          llvm::vfs::getRealFileSystem());
+}
+
 void SwiftLangSupport::getStatistics(StatisticsReceiver receiver) {
   std::vector<Statistic *> stats = {
 #define SWIFT_STATISTIC(VAR, UID, DESC) &Stats->VAR,
@@ -250,6 +250,29 @@ struct SwiftCustomCompletions
   std::vector<CustomCompletionInfo> customCompletions;
 };
 
+/// Caches the expensive printed pieces of a cursor-info result — the doc
+/// comment XML and the annotated declarations — so repeated hovers on the
+/// same (typically SDK) symbol don't re-print and re-convert them. Entries
+/// carry the stamp of the symbol's defining file and are replaced when it
+/// changes.
+class SwiftCursorInfoCache {
+public:
+  struct Entry {
+    uint64_t Stamp;
+    std::string DocCommentXML;
+    std::string AnnotatedDeclaration;
+    std::string FullyAnnotatedDeclaration;
+  };
+
+  /// Returns the cached entry for \p Key if its stamp matches \p Stamp.
+  llvm::Optional<Entry> get(StringRef Key, uint64_t Stamp);
+  void set(StringRef Key, Entry E);
+
+private:
+  llvm::StringMap<Entry> Entries;
+  mutable llvm::sys::Mutex Mtx;
+};
+
 class RequestRefactoringEditConsumer: public swift::ide::SourceEditConsumer,
                                       public swift::DiagnosticConsumer {
   class Implementation;
@@ -296,6 +319,7 @@ class SwiftLangSupport : public LangSupport {
   std::shared_ptr<SwiftStatistics> Stats;
   llvm::StringMap<std::unique_ptr<FileSystemProvider>> FileSystemProviders;
   std::shared_ptr<swift::ide::CompletionInstance> CompletionInst;
+  SwiftCursorInfoCache CursorInfoCache;
 
 public:
   explicit SwiftLangSupport(SourceKit::Context &SKCtx);
@@ -319,6 +343,8 @@ public:
     return CompletionInst;
   }
 
+  SwiftCursorInfoCache &getCursorInfoCache() { return CursorInfoCache; }
+
   /// Returns the FileSystemProvider registered under Name, or nullptr if not
   /// found.
   FileSystemProvider *getFileSystemProvider(StringRef Name);
@@ -604,6 +630,9 @@ public:
                                ConformingMethodListConsumer &Consumer,
                                Optional<VFSOptions> vfsOptions) override;
 
+  void warmupCaches(StringRef PrimaryFile, ArrayRef<const char *> Args,
+                    std::function<void(StringRef Error)> Receiver) override;
+
   void getStatistics(StatisticsReceiver) override;
 
 private:
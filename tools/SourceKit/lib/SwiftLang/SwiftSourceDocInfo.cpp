@@ -715,6 +715,20 @@ getParamParentNameOffset(const ValueDecl *VD, SourceLoc Cursor) {
   return SM.getLocOffsetInBuffer(Loc, SM.findBufferContainingLoc(Loc));
 }
 
+llvm::Optional<SwiftCursorInfoCache::Entry>
+SwiftCursorInfoCache::get(StringRef Key, uint64_t Stamp) {
+  llvm::sys::ScopedLock L(Mtx);
+  auto It = Entries.find(Key);
+  if (It == Entries.end() || It->second.Stamp != Stamp)
+    return None;
+  return It->second;
+}
+
+void SwiftCursorInfoCache::set(StringRef Key, Entry E) {
+  llvm::sys::ScopedLock L(Mtx);
+  Entries[Key] = std::move(E);
+}
+
 /// Returns true on success, false on error (and sets `Diagnostic` accordingly).
 static bool passCursorInfoForDecl(SourceFile* SF,
                                   const ValueDecl *VD,
@@ -796,30 +810,81 @@ static bool passCursorInfoForDecl(SourceFile* SF,
   }
   unsigned MangledContainerTypeEnd = SS.size();
 
+  // The doc comment XML and annotated declarations below are expensive to
+  // produce but depend only on the declaration and the (archetype-free)
+  // container type, so reuse them across requests until the defining file
+  // changes. The display name is part of the key because a property wrapper's
+  // backing storage and projected value share the wrapped property's USR. Skip
+  // the cache when the declarations would be printed against a container type
+  // that the mangled container type USR above doesn't capture.
+  std::string CacheKey;
+  uint64_t DeclStamp = 0;
+  llvm::Optional<SwiftCursorInfoCache::Entry> Cached;
+  if (!BaseType || MangledContainerTypeEnd != MangledContainerTypeStart) {
+    llvm::Optional<std::pair<unsigned, unsigned>> DefLoc;
+    StringRef DefFilename;
+    getLocationInfo(OriginalProperty, DefLoc, DefFilename);
+    std::string DefiningFile = DefFilename.str();
+    if (DefiningFile.empty())
+      DefiningFile = VD->getModuleContext()->getModuleFilename().str();
+    if (!DefiningFile.empty()) {
+      DeclStamp = Lang.getASTManager()->getBufferStamp(
+          DefiningFile, llvm::vfs::getRealFileSystem());
+      if (DeclStamp != (uint64_t)-1) {
+        llvm::raw_string_ostream KeyOS(CacheKey);
+        KeyOS << StringRef(SS.begin() + USRBegin, USREnd - USRBegin) << '\0'
+              << StringRef(SS.begin() + NameBegin, NameEnd - NameBegin) << '\0'
+              << StringRef(SS.begin() + MangledContainerTypeStart,
+                           MangledContainerTypeEnd - MangledContainerTypeStart);
+        KeyOS.flush();
+        Cached = Lang.getCursorInfoCache().get(CacheKey, DeclStamp);
+      }
+    }
+  }
+
   // If VD is the syntehsized property wrapper backing storage (_foo) or
   // projected value ($foo) of a property (foo), use that property's
   // documentation instead.
   unsigned DocCommentBegin = SS.size();
-  {
+  if (Cached) {
+    SS += Cached->DocCommentXML;
+  } else {
     llvm::raw_svector_ostream OS(SS);
     ide::getDocumentationCommentAsXML(OriginalProperty, OS);
   }
   unsigned DocCommentEnd = SS.size();
 
   unsigned DeclBegin = SS.size();
-  {
+  if (Cached) {
+    SS += Cached->AnnotatedDeclaration;
+  } else {
     llvm::raw_svector_ostream OS(SS);
     printAnnotatedDeclaration(VD, BaseType, OS);
   }
   unsigned DeclEnd = SS.size();
 
   unsigned FullDeclBegin = SS.size();
-  {
+  if (Cached) {
+    SS += Cached->FullyAnnotatedDeclaration;
+  } else {
     llvm::raw_svector_ostream OS(SS);
     SwiftLangSupport::printFullyAnnotatedDeclaration(VD, BaseType, OS);
   }
   unsigned FullDeclEnd = SS.size();
 
+  if (!Cached && !CacheKey.empty()) {
+    SwiftCursorInfoCache::Entry NewEntry;
+    NewEntry.Stamp = DeclStamp;
+    NewEntry.DocCommentXML =
+        StringRef(SS.begin() + DocCommentBegin, DocCommentEnd - DocCommentBegin)
+            .str();
+    NewEntry.AnnotatedDeclaration =
+        StringRef(SS.begin() + DeclBegin, DeclEnd - DeclBegin).str();
+    NewEntry.FullyAnnotatedDeclaration =
+        StringRef(SS.begin() + FullDeclBegin, FullDeclEnd - FullDeclBegin).str();
+    Lang.getCursorInfoCache().set(CacheKey, std::move(NewEntry));
+  }
+
   unsigned GroupBegin = SS.size();
   {
     llvm::raw_svector_ostream OS(SS);
@@ -1008,6 +1008,15 @@ static void handleSemanticRequest(
     return Rec(indexSource(*SourceFile, Args));
   }
 
+  if (ReqUID == RequestWarmup) {
+    LangSupport &Lang = getGlobalContext().getSwiftLangSupport();
+    return Lang.warmupCaches(*SourceFile, Args, [Rec](StringRef Error) {
+      if (!Error.empty())
+        return Rec(createErrorRequestFailed(Error.str().c_str()));
+      Rec(ResponseBuilder().createResponse());
+    });
+  }
+
   if (ReqUID == RequestCursorInfo) {
     LangSupport &Lang = getGlobalContext().getSwiftLangSupport();
 
@@ -2732,32 +2741,52 @@ void SKEditorConsumer::handleSourceText(StringRef Text) {
   Dict.set(KeySourceText, Text);
 }
 
+namespace {
+/// A response buffer that takes ownership of the bytes produced by the
+/// ByteTree serializer instead of copying them.
+class ByteTreeResponseBuffer : public llvm::MemoryBuffer {
+  llvm::SmallVector<uint8_t, 0> Data;
+
+public:
+  explicit ByteTreeResponseBuffer(llvm::SmallVector<uint8_t, 0> Data)
+      : Data(std::move(Data)) {
+    init(reinterpret_cast<const char *>(this->Data.begin()),
+         reinterpret_cast<const char *>(this->Data.end()),
+         /*RequiresNullTerminator=*/false);
+  }
+
+  BufferKind getBufferKind() const override { return MemoryBuffer_Malloc; }
+};
+} // end anonymous namespace
+
 void serializeSyntaxTreeAsByteTree(
     const swift::syntax::SourceFileSyntax &SyntaxTree,
     std::unordered_set<unsigned> &ReusedNodeIds,
     ResponseBuilder::Dictionary &Dict) {
   auto StartClock = clock();
-  // Serialize the syntax tree as a ByteTree
+  // Serialize the syntax tree as a ByteTree. The custom buffer kind is
+  // written directly into the stream so that the finished bytes can be handed
+  // to the response without copying the entire tree again.
   auto Stream = swift::ExponentialGrowthAppendingBinaryByteStream();
   Stream.reserve(32 * 1024);
+  auto Error = Stream.writeInteger(/*Offset=*/0,
+                                   (uint64_t)CustomBufferKind::RawData);
+  (void)Error;
+  assert(!Error);
   std::map<void *, void *> UserInfo;
   UserInfo[swift::byteTree::UserInfoKeyReusedNodeIds] = &ReusedNodeIds;
   swift::byteTree::ByteTreeWriter::write(Stream,
                                          swift::byteTree::SYNTAX_TREE_VERSION,
                                          *SyntaxTree.getRaw(), UserInfo);
 
-  std::unique_ptr<llvm::WritableMemoryBuffer> Buf =
-      llvm::WritableMemoryBuffer::getNewUninitMemBuffer(sizeof(uint64_t) + Stream.data().size());
-  *reinterpret_cast<uint64_t*>(Buf->getBufferStart()) =
-      (uint64_t)CustomBufferKind::RawData;
-  memcpy(Buf->getBufferStart() + sizeof(uint64_t),
-         Stream.data().data(), Stream.data().size());
-
-  Dict.setCustomBuffer(KeySerializedSyntaxTree, std::move(Buf));
+  size_t SerializedSize = Stream.getLength() - sizeof(uint64_t);
+  Dict.setCustomBuffer(
+      KeySerializedSyntaxTree,
+      std::make_unique<ByteTreeResponseBuffer>(Stream.takeData()));
 
   auto EndClock = clock();
   LOG_SECTION("incrParse Performance", InfoLowPrio) {
-    Log->getOS() << "Serialized " << Stream.data().size()
+    Log->getOS() << "Serialized " << SerializedSize
                  << " bytes as ByteTree in ";
     auto Seconds = (double)(EndClock - StartClock) * 1000 / CLOCKS_PER_SEC;
     llvm::write_double(Log->getOS(), Seconds, llvm::FloatStyle::Fixed, 2);
@@ -1,7 +1,10 @@
 #include "llvm/ADT/STLExtras.h"
+#include "llvm/Support/MD5.h"
+#include "llvm/Support/ThreadPool.h"
 #include "swift/SIL/SILDeclRef.h"
 #include <ModuleAnalyzerNodes.h>
 #include <algorithm>
+#include <atomic>
 
 using namespace swift;
 using namespace ide;
@@ -2237,6 +2240,162 @@ int swift::ide::api::dumpSDKContent(const CompilerInvocation &InitInvok,
   return 0;
 }
 
+// Locate the serialized module an import of \p ModuleName would find under
+// \p Invok's search paths. The result may be a .swiftmodule file or a
+// directory of per-target module files.
+static Optional<std::string>
+findSerializedModule(const CompilerInvocation &Invok, StringRef ModuleName) {
+  auto &SearchOpts = Invok.getSearchPathOptions();
+  llvm::SmallString<256> Scratch;
+  auto probe = [&](StringRef Parent, bool Framework) -> bool {
+    Scratch = Parent;
+    if (Framework)
+      path::append(Scratch, ModuleName + ".framework", "Modules");
+    path::append(Scratch, ModuleName + ".swiftmodule");
+    return fs::exists(Scratch);
+  };
+  for (auto &Dir : SearchOpts.ImportSearchPaths)
+    if (probe(Dir, /*Framework=*/false))
+      return Scratch.str().str();
+  for (auto &Dir : SearchOpts.RuntimeLibraryImportPaths)
+    if (probe(Dir, /*Framework=*/false))
+      return Scratch.str().str();
+  for (auto &Dir : SearchOpts.FrameworkSearchPaths)
+    if (probe(Dir.Path, /*Framework=*/true))
+      return Scratch.str().str();
+  if (!SearchOpts.SDKPath.empty()) {
+    llvm::SmallString<256> Dir(SearchOpts.SDKPath);
+    path::append(Dir, "System", "Library", "Frameworks");
+    if (probe(Dir, /*Framework=*/true))
+      return Scratch.str().str();
+  }
+  return None;
+}
+
+// Returns a hex digest of the contents of the module's serialized files, or
+// None when the module cannot be found on disk, in which case its digest
+// cannot be cached.
+static Optional<llvm::SmallString<32>>
+hashSerializedModule(const CompilerInvocation &Invok, StringRef ModuleName) {
+  auto Found = findSerializedModule(Invok, ModuleName);
+  if (!Found)
+    return None;
+  llvm::MD5 Hash;
+  auto addFile = [&](StringRef Path) -> bool {
+    auto Buffer = llvm::MemoryBuffer::getFile(Path);
+    if (!Buffer)
+      return false;
+    Hash.update((*Buffer)->getBuffer());
+    return true;
+  };
+  if (fs::is_directory(*Found)) {
+    std::vector<std::string> Entries;
+    std::error_code EC;
+    for (fs::directory_iterator It(*Found, EC), End; It != End && !EC;
+         It.increment(EC))
+      Entries.push_back(It->path());
+    // Hash in a stable order, independent of directory enumeration.
+    llvm::sort(Entries);
+    for (auto &Entry : Entries)
+      if (!fs::is_directory(Entry) && !addFile(Entry))
+        return None;
+  } else if (!addFile(*Found)) {
+    return None;
+  }
+  llvm::MD5::MD5Result Result;
+  Hash.final(Result);
+  llvm::SmallString<32> Digest;
+  llvm::MD5::stringifyResult(Result, Digest);
+  return Digest;
+}
+
+int swift::ide::api::dumpSDKContentParallel(
+    const CompilerInvocation &InitInvok, const llvm::StringSet<> &ModuleNames,
+    StringRef OutputFile, StringRef CachePath, unsigned Jobs,
+    CheckerOptions Opts) {
+  // Decide where each module's digest will live. Sorting the names keeps the
+  // merged output independent of worker scheduling.
+  std::vector<std::string> Names;
+  for (auto &Entry : ModuleNames)
+    Names.push_back(Entry.getKey().str());
+  llvm::sort(Names);
+
+  llvm::SmallString<128> TempDir;
+  if (!CachePath.empty()) {
+    if (auto EC = fs::create_directories(CachePath)) {
+      llvm::errs() << "Failed to create digest cache directory: "
+                   << EC.message() << '\n';
+      return 1;
+    }
+  } else if (auto EC = fs::createUniqueDirectory("api-digests", TempDir)) {
+    llvm::errs() << "Failed to create temporary directory: " << EC.message()
+                 << '\n';
+    return 1;
+  }
+  StringRef DigestDir = CachePath.empty() ? StringRef(TempDir) : CachePath;
+
+  struct ModuleDigest {
+    std::string Name;
+    std::string Path;
+    bool Cached;
+  };
+  std::vector<ModuleDigest> Digests;
+  for (auto &Name : Names) {
+    llvm::SmallString<256> Path(DigestDir);
+    bool Cached = false;
+    if (!CachePath.empty()) {
+      if (auto Digest = hashSerializedModule(InitInvok, Name)) {
+        path::append(Path, llvm::Twine(Name) + "-" + *Digest +
+                               (Opts.ABI ? ".abi.json" : ".api.json"));
+        Cached = fs::exists(Path);
+      }
+    }
+    if (Path.size() == DigestDir.size())
+      path::append(Path, Name + ".json");
+    Digests.push_back({Name, Path.str().str(), Cached});
+  }
+
+  std::atomic<bool> Failed(false);
+  {
+    llvm::ThreadPool Pool(std::max(1u, Jobs));
+    for (auto &Digest : Digests) {
+      if (Digest.Cached) {
+        if (Opts.Verbose)
+          llvm::errs() << "Reusing cached digest for " << Digest.Name << '\n';
+        continue;
+      }
+      Pool.async([&InitInvok, &Failed, Opts, &Digest] {
+        SDKContext Ctx(Opts);
+        llvm::StringSet<> Single;
+        Single.insert(Digest.Name);
+        if (auto *Root = getSDKNodeRoot(Ctx, InitInvok, Single))
+          SwiftDeclCollector::serialize(Digest.Path, Root);
+        else
+          Failed = true;
+      });
+    }
+    Pool.wait();
+  }
+  if (Failed)
+    return 1;
+
+  // Merge the per-module trees into a single root for emission. The nodes
+  // live in per-worker contexts that are gone by now, so they are rebuilt in
+  // the merged context from the serialized digests rather than adopted
+  // directly.
+  SDKContext MergeCtx(Opts);
+  SDKNodeRoot *Root = getEmptySDKNodeRoot(MergeCtx);
+  for (auto &Digest : Digests) {
+    auto Pair = parseJsonEmit(MergeCtx, Digest.Path);
+    for (auto *Child : Pair.second->getChildren())
+      Root->addChild(Child);
+  }
+  dumpSDKRoot(Root, OutputFile);
+  if (CachePath.empty())
+    fs::remove_directories(DigestDir);
+  return 0;
+}
+
 int swift::ide::api::deserializeSDKDump(StringRef dumpPath, StringRef OutputPath,
     CheckerOptions Opts) {
   std::error_code EC;
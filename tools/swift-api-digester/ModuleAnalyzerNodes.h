@@ -792,6 +792,17 @@ int dumpSDKContent(const CompilerInvocation &InitInvok,
                    const llvm::StringSet<> &ModuleNames,
                    StringRef OutputFile, CheckerOptions Opts);
 
+/// Digests each module with its own SDKContext and CompilerInstance, running
+/// up to \p Jobs digestions concurrently, and merges the per-module trees
+/// when emitting the JSON dump. When \p CachePath is not empty, each
+/// per-module digest is also kept there in a file keyed by the hash of the
+/// module's serialized files on disk, and a module whose digest is already
+/// present is not digested again.
+int dumpSDKContentParallel(const CompilerInvocation &InitInvok,
+                           const llvm::StringSet<> &ModuleNames,
+                           StringRef OutputFile, StringRef CachePath,
+                           unsigned Jobs, CheckerOptions Opts);
+
 /// Mostly for testing purposes, this function de-serializes the SDK dump in
 /// dumpPath and re-serialize them to OutputPath. If the tool performs correctly,
 /// the contents in dumpPath and OutputPath should be identical.
@@ -79,6 +79,17 @@ static llvm::cl::opt<std::string>
 OutputFile("o", llvm::cl::desc("Output file"),
            llvm::cl::cat(Category));
 
+static llvm::cl::opt<unsigned>
+Jobs("j", llvm::cl::desc("Number of parallel module digestion jobs"),
+     llvm::cl::init(1), llvm::cl::cat(Category));
+
+static llvm::cl::opt<std::string>
+DigestCachePath("digest-cache-path",
+                llvm::cl::desc("Directory keeping per-module digests keyed by "
+                               "the module file's hash; unchanged modules are "
+                               "not digested again"),
+                llvm::cl::cat(Category));
+
 static llvm::cl::opt<std::string>
 SDK("sdk", llvm::cl::desc("path to the SDK to build against"),
     llvm::cl::cat(Category));
@@ -2740,8 +2751,13 @@ int main(int argc, char *argv[]) {
     PrintApis.push_back(Name);
   switch (options::Action) {
   case ActionType::DumpSDK:
-    return (prepareForDump(argv[0], InitInvok, Modules)) ? 1 :
-      dumpSDKContent(InitInvok, Modules, options::OutputFile, Opts);
+    if (prepareForDump(argv[0], InitInvok, Modules))
+      return 1;
+    if (options::Jobs > 1 || !options::DigestCachePath.empty())
+      return dumpSDKContentParallel(InitInvok, Modules, options::OutputFile,
+                                    options::DigestCachePath, options::Jobs,
+                                    Opts);
+    return dumpSDKContent(InitInvok, Modules, options::OutputFile, Opts);
   case ActionType::MigratorGen:
   case ActionType::DiagnoseSDKs: {
     ComparisonInputMode Mode = checkComparisonInputMode();
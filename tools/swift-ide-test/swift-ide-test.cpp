@@ -62,6 +62,7 @@
 #include "llvm/Support/TargetSelect.h"
 #include "llvm/Support/raw_ostream.h"
 #include "llvm/Support/ManagedStatic.h"
+#include <chrono>
 #include <system_error>
 
 #include <string>
@@ -75,6 +76,7 @@ namespace {
 enum class ActionType {
   None,
   CodeCompletion,
+  BatchCodeCompletionBench,
   REPLCodeCompletion,
   DumpCompletionCache,
   DumpImporterLookupTable,
@@ -160,6 +162,10 @@ Action(llvm::cl::desc("Mode:"), llvm::cl::init(ActionType::None),
        llvm::cl::values(
            clEnumValN(ActionType::CodeCompletion,
                       "code-completion", "Perform code completion"),
+           clEnumValN(ActionType::BatchCodeCompletionBench,
+                      "batch-code-completion-bench",
+                      "Replay a corpus of code completion positions and "
+                      "report latency percentiles"),
            clEnumValN(ActionType::REPLCodeCompletion,
                       "repl-code-completion", "Perform REPL-style code completion"),
            clEnumValN(ActionType::DumpCompletionCache,
@@ -435,6 +441,20 @@ CodeCOmpletionAnnotateResults("code-completion-annotate-results",
                               llvm::cl::cat(Category),
                               llvm::cl::init(false));
 
+// '-batch-code-completion-bench' options.
+
+static llvm::cl::opt<std::string>
+CompletionBenchCorpus("completion-bench-corpus",
+    llvm::cl::desc("Path to a file listing '<source-path>,<byte-offset>' "
+                   "completion positions, one per line. Lines starting with "
+                   "'#' are ignored"),
+    llvm::cl::cat(Category));
+
+static llvm::cl::opt<unsigned>
+CompletionBenchIterations("completion-bench-iterations",
+    llvm::cl::desc("Number of times each completion position is replayed"),
+    llvm::cl::cat(Category), llvm::cl::init(10));
+
 static llvm::cl::opt<std::string>
 DebugClientDiscriminator("debug-client-discriminator",
   llvm::cl::desc("A discriminator to prefer in lookups"),
@@ -876,6 +896,112 @@ static int doCodeCompletion(const CompilerInvocation &InitInvok,
                               CodeCompletionDiagnostics);
 }
 
+namespace {
+/// Counts the results of a completion instead of printing them.
+struct CountingCodeCompletionConsumer
+    : public ide::SimpleCachingCodeCompletionConsumer {
+  unsigned Count = 0;
+
+  void handleResults(
+      MutableArrayRef<CodeCompletionResult *> Results) override {
+    Count = Results.size();
+  }
+};
+} // end anonymous namespace
+
+/// Returns the \p Percentile -th latency of the sorted \p Samples.
+static unsigned getPercentile(ArrayRef<unsigned> Samples, unsigned Percentile) {
+  assert(!Samples.empty());
+  return Samples[std::min(Samples.size() - 1,
+                          (Samples.size() * Percentile) / 100)];
+}
+
+static int doBatchCodeCompletionBench(const CompilerInvocation &InitInvok,
+                                      StringRef CorpusFilename,
+                                      unsigned Iterations) {
+  std::unique_ptr<llvm::MemoryBuffer> CorpusBuf;
+  if (setBufferForFile(CorpusFilename, CorpusBuf))
+    return 1;
+
+  // Share one completion cache across all positions and iterations, like a
+  // long-lived IDE session would, so the reported percentiles reflect the
+  // steady state rather than repeated cache warm-up.
+  ide::CodeCompletionCache CompletionCache;
+  CompletionInstance CompletionInst;
+  PrintingDiagnosticConsumer PrintDiags;
+
+  llvm::outs() << "file,offset,samples,results,min_us,p50_us,p99_us,max_us\n";
+
+  SmallVector<StringRef, 16> Lines;
+  CorpusBuf->getBuffer().split(Lines, '\n');
+  for (StringRef Line : Lines) {
+    Line = Line.trim();
+    if (Line.empty() || Line.startswith("#"))
+      continue;
+
+    StringRef Filename, OffsetStr;
+    std::tie(Filename, OffsetStr) = Line.rsplit(',');
+    unsigned Offset;
+    if (Filename.empty() || OffsetStr.getAsInteger(10, Offset)) {
+      llvm::errs() << "malformed corpus line '" << Line
+                   << "' (expected '<source-path>,<byte-offset>')\n";
+      return 1;
+    }
+
+    std::unique_ptr<llvm::MemoryBuffer> FileBuf;
+    if (setBufferForFile(Filename, FileBuf))
+      return 1;
+    if (Offset > FileBuf->getBufferSize()) {
+      llvm::errs() << "offset " << Offset << " is past the end of '"
+                   << Filename << "'\n";
+      return 1;
+    }
+
+    std::vector<unsigned> SampleLatencies;
+    SampleLatencies.reserve(Iterations);
+    unsigned ResultCount = 0;
+    for (unsigned i = 0; i < Iterations; ++i) {
+      ide::CodeCompletionContext CompletionContext(CompletionCache);
+      CountingCodeCompletionConsumer Consumer;
+      std::unique_ptr<CodeCompletionCallbacksFactory> callbacksFactory(
+          ide::makeCodeCompletionCallbacksFactory(CompletionContext, Consumer));
+
+      CompilerInvocation Invocation(InitInvok);
+      std::string Error;
+      auto StartTime = std::chrono::steady_clock::now();
+      bool isSuccess = CompletionInst.performOperation(
+          Invocation, /*Args=*/{}, llvm::vfs::getRealFileSystem(),
+          FileBuf.get(), Offset, /*EnableASTCaching=*/false, Error,
+          options::CodeCompletionDiagnostics ? &PrintDiags : nullptr,
+          [&](CompilerInstance &CI, bool reusingASTContext) {
+            auto SF = CI.getCodeCompletionFile();
+            performCodeCompletionSecondPass(*SF.get(), *callbacksFactory);
+          });
+      auto EndTime = std::chrono::steady_clock::now();
+      if (!isSuccess) {
+        llvm::errs() << "completion at '" << Filename << ":" << Offset
+                     << "' failed: " << Error << "\n";
+        return 1;
+      }
+      SampleLatencies.push_back(
+          std::chrono::duration_cast<std::chrono::microseconds>(EndTime -
+                                                                StartTime)
+              .count());
+      ResultCount = Consumer.Count;
+    }
+
+    llvm::sort(SampleLatencies);
+    llvm::outs() << Filename << "," << Offset << ","
+                 << SampleLatencies.size() << "," << ResultCount << ","
+                 << SampleLatencies.front() << ","
+                 << getPercentile(SampleLatencies, 50) << ","
+                 << getPercentile(SampleLatencies, 99) << ","
+                 << SampleLatencies.back() << "\n";
+  }
+
+  return 0;
+}
+
 static int doREPLCodeCompletion(const CompilerInvocation &InitInvok,
                                 StringRef SourceFilename) {
   std::unique_ptr<llvm::MemoryBuffer> FileBuf;
@@ -3542,6 +3668,16 @@ int main(int argc, char *argv[]) {
                                 options::CodeCOmpletionAnnotateResults);
     break;
 
+  case ActionType::BatchCodeCompletionBench:
+    if (options::CompletionBenchCorpus.empty()) {
+      llvm::errs() << "completion bench corpus required\n";
+      return 1;
+    }
+    ExitCode = doBatchCodeCompletionBench(InitInvok,
+                                          options::CompletionBenchCorpus,
+                                          options::CompletionBenchIterations);
+    break;
+
   case ActionType::REPLCodeCompletion:
     ExitCode = doREPLCodeCompletion(InitInvok, options::SourceFilename);
     break;
@@ -40,7 +40,9 @@
 #endif
 
 #include <algorithm>
+#include <atomic>
 #include <csignal>
+#include <thread>
 
 using llvm::ArrayRef;
 using llvm::dyn_cast;
@@ -75,6 +77,12 @@ static llvm::cl::opt<std::string>
     Architecture("arch",
                  llvm::cl::desc("Architecture to inspect in the binary"),
                  llvm::cl::Required);
+
+static llvm::cl::list<std::string>
+    Sections("sections", llvm::cl::CommaSeparated,
+             llvm::cl::desc("Only dump the named reflection sections "
+                            "(fieldmd, assocty, builtin, capture); dumps "
+                            "all of them when omitted"));
 } // end namespace options
 
 template <typename T> static T unwrap(llvm::Expected<T> value) {
@@ -621,6 +629,130 @@ makeReflectionContextForObjectFiles(
   }
 }
 
+namespace {
+struct SectionDumpFilter {
+  bool FieldMD = true;
+  bool AssocTy = true;
+  bool Builtin = true;
+  bool Capture = true;
+};
+} // end anonymous namespace
+
+static SectionDumpFilter parseSectionFilter() {
+  SectionDumpFilter Filter;
+  if (options::Sections.empty())
+    return Filter;
+
+  Filter = {false, false, false, false};
+  for (const auto &Name : options::Sections) {
+    if (Name == "fieldmd")
+      Filter.FieldMD = true;
+    else if (Name == "assocty")
+      Filter.AssocTy = true;
+    else if (Name == "builtin")
+      Filter.Builtin = true;
+    else if (Name == "capture")
+      Filter.Capture = true;
+    else {
+      llvm::errs() << "swift-reflection-dump error: unknown section '" << Name
+                   << "'; expected fieldmd, assocty, builtin, or capture\n";
+      exit(EXIT_FAILURE);
+    }
+  }
+  return Filter;
+}
+
+/// Dump the selected sections, matching the output of
+/// TypeRefBuilder::dumpAllSections when no filter is in effect.
+static void dumpSections(TypeRefBuilder &builder,
+                         const SectionDumpFilter &filter, FILE *file) {
+  if (filter.FieldMD) {
+    fprintf(file, "FIELDS:\n");
+    fprintf(file, "=======\n");
+    builder.dumpFieldSection(file);
+    fprintf(file, "\n");
+  }
+  if (filter.AssocTy) {
+    fprintf(file, "ASSOCIATED TYPES:\n");
+    fprintf(file, "=================\n");
+    builder.dumpAssociatedTypeSection(file);
+    fprintf(file, "\n");
+  }
+  if (filter.Builtin) {
+    fprintf(file, "BUILTIN TYPES:\n");
+    fprintf(file, "==============\n");
+    builder.dumpBuiltinTypeSection(file);
+    fprintf(file, "\n");
+  }
+  if (filter.Capture) {
+    fprintf(file, "CAPTURE DESCRIPTORS:\n");
+    fprintf(file, "====================\n");
+    builder.dumpCaptureSection(file);
+    fprintf(file, "\n");
+  }
+}
+
+static void dumpObjectFileSections(const ObjectFile *O,
+                                   const SectionDumpFilter &filter,
+                                   FILE *file) {
+  std::vector<const ObjectFile *> SingleFile{O};
+  auto context = makeReflectionContextForObjectFiles(SingleFile);
+  dumpSections(context.second, filter, file);
+}
+
+static void copyAndClose(FILE *from, FILE *to) {
+  char Buf[64 * 1024];
+  size_t n;
+  rewind(from);
+  while ((n = fread(Buf, 1, sizeof(Buf), from)) > 0)
+    fwrite(Buf, 1, n, to);
+  fclose(from);
+}
+
+/// Dump each image through its own reflection context on a pool of worker
+/// threads, then stitch the buffered results together in input order.
+/// Section dumps never resolve symbols across images, so per-image contexts
+/// produce the same per-image output as one combined context.
+static void dumpReflectionSectionsParallel(
+    const std::vector<const ObjectFile *> &objectFiles,
+    const SectionDumpFilter &filter, FILE *file) {
+  std::vector<FILE *> outputs(objectFiles.size(), nullptr);
+  for (auto &out : outputs) {
+    out = tmpfile();
+    if (!out) {
+      // Without somewhere to buffer results, dump serially.
+      for (auto *opened : outputs)
+        if (opened)
+          fclose(opened);
+      for (auto *O : objectFiles)
+        dumpObjectFileSections(O, filter, file);
+      return;
+    }
+  }
+
+  std::atomic<size_t> nextImage(0);
+  auto worker = [&] {
+    while (true) {
+      size_t idx = nextImage.fetch_add(1, std::memory_order_relaxed);
+      if (idx >= objectFiles.size())
+        break;
+      dumpObjectFileSections(objectFiles[idx], filter, outputs[idx]);
+    }
+  };
+
+  size_t numWorkers =
+      std::min<size_t>(std::max(1u, std::thread::hardware_concurrency()),
+                       objectFiles.size());
+  std::vector<std::thread> workers;
+  for (size_t i = 0; i < numWorkers; ++i)
+    workers.emplace_back(worker);
+  for (auto &thread : workers)
+    thread.join();
+
+  for (auto *out : outputs)
+    copyAndClose(out, file);
+}
+
 static int doDumpReflectionSections(ArrayRef<std::string> BinaryFilenames,
                                     StringRef Arch, ActionType Action,
                                     FILE *file) {
@@ -650,15 +782,22 @@ static int doDumpReflectionSections(ArrayRef<std::string> BinaryFilenames,
     ObjectFiles.push_back(O);
   }
   
-  auto context = makeReflectionContextForObjectFiles(ObjectFiles);
-  auto &builder = context.second;
-
   switch (Action) {
-  case ActionType::DumpReflectionSections:
-    // Dump everything
-    builder.dumpAllSections(file);
+  case ActionType::DumpReflectionSections: {
+    auto filter = parseSectionFilter();
+    if (ObjectFiles.size() > 1) {
+      dumpReflectionSectionsParallel(ObjectFiles, filter, file);
+      break;
+    }
+    auto context = makeReflectionContextForObjectFiles(ObjectFiles);
+    dumpSections(context.second, filter, file);
     break;
+  }
   case ActionType::DumpTypeLowering: {
+    // Type lowering resolves field descriptors across all of the images, so
+    // the object files have to share one context.
+    auto context = makeReflectionContextForObjectFiles(ObjectFiles);
+    auto &builder = context.second;
     for (std::string Line; std::getline(std::cin, Line);) {
       if (Line.empty())
         continue;
@@ -35,11 +35,13 @@
 #include "swift/Syntax/SyntaxNodes.h"
 #include "llvm/Support/BinaryByteStream.h"
 #include "llvm/Support/CommandLine.h"
-#include "llvm/Support/FileOutputBuffer.h"
 #include "llvm/Support/FileSystem.h"
+#include "llvm/Support/Format.h"
 #include "llvm/Support/Regex.h"
 #include "llvm/Support/raw_ostream.h"
 
+#include <chrono>
+
 using namespace swift;
 using namespace swift::syntax;
 using llvm::StringRef;
@@ -53,6 +55,7 @@ enum class ActionType {
   ParseOnly,
   ParserGen,
   EOFPos,
+  Benchmark,
   None
 };
 
@@ -93,7 +96,12 @@ Action(llvm::cl::desc("Action (required):"),
                    "eof",
                    "Parse the source file, calculate the absolute position"
                    "of the EOF token, and dump the buffer from the start of the"
-                   "file to the EOF token")));
+                   "file to the EOF token"),
+        clEnumValN(ActionType::Benchmark,
+                   "benchmark",
+                   "Run lex-only, parse-only and parse-with-syntax-tree "
+                   "passes over the input several times and report their "
+                   "throughput")));
 
 static llvm::cl::opt<std::string>
 InputSourceFilename("input-source-filename",
@@ -222,6 +230,15 @@ static llvm::cl::opt<std::string>
 GraphVisPath("output-request-graphviz",
              llvm::cl::desc("Emit GraphViz output visualizing the request graph."),
              llvm::cl::cat(Category));
+
+static llvm::cl::opt<unsigned>
+BenchmarkIterations("benchmark-iterations",
+                    llvm::cl::desc("Number of measured iterations to run for "
+                                   "each pass of the benchmark action. An "
+                                   "additional warm-up iteration is run first "
+                                   "and discarded"),
+                    llvm::cl::cat(Category),
+                    llvm::cl::init(10));
 } // end namespace options
 
 namespace {
@@ -501,6 +518,13 @@ void saveReuseLog(SyntaxParsingCache *Cache,
              << '\n';
     ReuseLog << '\n';
   }
+
+  auto FileLength = NewSyntaxTree.getTextLength();
+  ReuseLog << "Reuse ratio: "
+           << unsigned(Cache->getReuseRatio(FileLength) * 100) << "% ("
+           << Cache->getReusedBytes() << " of " << FileLength << " bytes, "
+           << Cache->getHitCount() << " of " << Cache->getLookupCount()
+           << " lookups)\n";
 }
 
 bool verifyReusedRegions(ByteBasedSourceRangeSet ExpectedReparseRegions,
@@ -760,15 +784,12 @@ int doSerializeRawTree(const char *MainExecutablePath,
       swift::byteTree::ByteTreeWriter::write(Stream,
                                              byteTree::SYNTAX_TREE_VERSION,
                                              *Root, UserInfo);
-      auto OutputBufferOrError = llvm::FileOutputBuffer::create(
-          options::OutputFilename, Stream.data().size());
-      assert(OutputBufferOrError && "Couldn't open output file");
-      auto &OutputBuffer = OutputBufferOrError.get();
-      memcpy(OutputBuffer->getBufferStart(), Stream.data().data(),
-             Stream.data().size());
-      auto Error = OutputBuffer->commit();
-      (void)Error;
-      assert(!Error && "Unable to write output file");
+      std::error_code ErrorCode;
+      llvm::raw_fd_ostream OutputStream(options::OutputFilename, ErrorCode,
+                                        llvm::sys::fs::F_None);
+      assert(!ErrorCode && "Couldn't open output file");
+      (void)ErrorCode;
+      Stream.writeTo(OutputStream);
     } else {
       // Serialize as JSON
       auto SerializeTree = [&ReusedNodeIds](llvm::raw_ostream &os,
@@ -872,6 +893,114 @@ int dumpEOFSourceLoc(const char *MainExecutablePath,
     return EXIT_SUCCESS;
   });
 }
+
+/// Run one discarded warm-up invocation of \p Body followed by \p Iterations
+/// measured ones and return the accumulated wall time in nanoseconds.
+template <typename FnTy>
+uint64_t measureBenchmarkPass(unsigned Iterations, FnTy Body) {
+  Body();
+  auto Start = std::chrono::steady_clock::now();
+  for (unsigned I = 0; I < Iterations; ++I) {
+    Body();
+  }
+  auto End = std::chrono::steady_clock::now();
+  return std::chrono::duration_cast<std::chrono::nanoseconds>(End - Start)
+      .count();
+}
+
+/// Print one machine-readable result line for a benchmark pass. Throughput
+/// numbers are averaged over all measured iterations.
+void printBenchmarkResult(StringRef Pass, StringRef InputFile, size_t NumBytes,
+                          uint64_t NumTokens, unsigned Iterations,
+                          uint64_t TotalNanos) {
+  double Seconds = double(TotalNanos) / 1e9;
+  double MBPerSec =
+      double(NumBytes) * Iterations / (1024.0 * 1024.0) / Seconds;
+  double NsPerToken = double(TotalNanos) / (double(NumTokens) * Iterations);
+  llvm::outs() << "benchmark"
+               << " file=" << InputFile << " pass=" << Pass
+               << " iterations=" << Iterations << " bytes=" << NumBytes
+               << " tokens=" << NumTokens << " ns-total=" << TotalNanos
+               << " mb-per-sec=" << llvm::format("%.2f", MBPerSec)
+               << " ns-per-token=" << llvm::format("%.2f", NsPerToken) << '\n';
+}
+
+int doBenchmark(const char *MainExecutablePath, const StringRef InputFile) {
+  unsigned Iterations = options::BenchmarkIterations;
+  if (Iterations == 0) {
+    llvm::errs() << "benchmark-iterations must be non-zero\n";
+    return EXIT_FAILURE;
+  }
+
+  LangOptions LangOpts;
+  SourceManager SourceMgr;
+  auto Buffer = llvm::MemoryBuffer::getFile(InputFile);
+  if (!Buffer) {
+    llvm::errs() << "error opening file '" << InputFile
+                 << "': " << Buffer.getError().message() << '\n';
+    return EXIT_FAILURE;
+  }
+  size_t NumBytes = Buffer.get()->getBufferSize();
+  unsigned BufferID = SourceMgr.addNewSourceBuffer(std::move(Buffer.get()));
+
+  // Lex-only pass. The token count it produces is also used to report
+  // per-token timings for the parser passes, which consume the same token
+  // stream.
+  uint64_t NumTokens = 0;
+  uint64_t LexNanos = measureBenchmarkPass(Iterations, [&] {
+    Lexer Lex(LangOpts, SourceMgr, BufferID, /*Diags=*/nullptr,
+              LexerMode::Swift);
+    Token Tok;
+    uint64_t Count = 0;
+    do {
+      Lex.lex(Tok);
+      ++Count;
+    } while (Tok.isNot(tok::eof));
+    NumTokens = Count;
+  });
+  printBenchmarkResult("lex", InputFile, NumBytes, NumTokens, Iterations,
+                       LexNanos);
+
+  // Parser passes. These measure a whole compiler instance performing a
+  // parse-only invocation, with and without building the libSyntax tree.
+  auto RunParse = [&](bool BuildSyntaxTree) -> bool {
+    CompilerInvocation Invocation;
+    Invocation.getLangOptions().BuildSyntaxTree = BuildSyntaxTree;
+    Invocation.getLangOptions().ParseForSyntaxTreeOnly = BuildSyntaxTree;
+    Invocation.getFrontendOptions().InputsAndOutputs.addInputFile(InputFile);
+    Invocation.setMainExecutablePath(llvm::sys::fs::getMainExecutable(
+        MainExecutablePath,
+        reinterpret_cast<void *>(&anchorForGetMainExecutable)));
+    Invocation.setModuleName("Test");
+
+    CompilerInstance Instance;
+    if (Instance.setup(Invocation)) {
+      llvm::errs() << "Unable to set up compiler instance\n";
+      return false;
+    }
+    Instance.performParseOnly();
+    return true;
+  };
+
+  bool ParseFailed = false;
+  uint64_t ParseNanos = measureBenchmarkPass(Iterations, [&] {
+    ParseFailed |= !RunParse(/*BuildSyntaxTree=*/false);
+  });
+  if (ParseFailed)
+    return EXIT_FAILURE;
+  printBenchmarkResult("parse", InputFile, NumBytes, NumTokens, Iterations,
+                       ParseNanos);
+
+  uint64_t TreeNanos = measureBenchmarkPass(Iterations, [&] {
+    ParseFailed |= !RunParse(/*BuildSyntaxTree=*/true);
+  });
+  if (ParseFailed)
+    return EXIT_FAILURE;
+  printBenchmarkResult("parse-with-tree", InputFile, NumBytes, NumTokens,
+                       Iterations, TreeNanos);
+
+  return EXIT_SUCCESS;
+}
 }// end of anonymous namespace
 
 static int invokeCommand(const char *MainExecutablePath,
@@ -904,6 +1033,9 @@ static int invokeCommand(const char *MainExecutablePath,
     case ActionType::EOFPos:
       ExitCode = dumpEOFSourceLoc(MainExecutablePath, InputSourceFilename);
       break;
+    case ActionType::Benchmark:
+      ExitCode = doBenchmark(MainExecutablePath, InputSourceFilename);
+      break;
     case ActionType::None:
       llvm::errs() << "an action is required\n";
       llvm::cl::PrintHelpMessage();
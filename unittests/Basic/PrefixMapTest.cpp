@@ -180,6 +180,30 @@ TEST(PrefixMapTest, Test3) {
   tester.find("wbuqbtaprrpooqteftzdhjdqkemtcl");
 }
 
+TEST(PrefixMapTest, SharedPrefixStress) {
+  // Keys sharing long common prefixes exercise the bulk key comparison,
+  // node splitting, and multi-node key chains (keys here are much longer
+  // than the inline key capacity).
+  Tester tester;
+  std::string key = "m";
+  for (int i = 0; i != 64; ++i) {
+    tester.insert(key, i);
+    tester.find(key + "q");
+    key += char('a' + (i % 26));
+  }
+  tester.validate();
+
+  // A copy of the map must compare equal to the original.
+  PrefixMap<char, int> copy(tester.PreMap);
+  llvm::SmallString<128> buffer;
+  for (auto i = copy.begin(), e = copy.end(); i != e; ++i) {
+    auto entry = *i;
+    auto original = tester.PreMap.findPrefix(entry.getKey(buffer));
+    EXPECT_TRUE(bool(original.first));
+    EXPECT_EQ(*original.first, entry.getValue());
+  }
+}
+
 TEST(PrefixMapTest, Test4) {
   Tester tester;
   tester.find("");